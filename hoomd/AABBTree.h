@@ -3,6 +3,8 @@
 
 #include "HOOMDMath.h"
 #include "VectorMath.h"
+#include <cmath>
+#include <limits>
 #include <stack>
 #include <vector>
 
@@ -28,8 +30,10 @@ namespace hoomd
     {
 namespace detail
     {
-const unsigned int NODE_CAPACITY = 16;        //!< Maximum number of particles in a node
-const unsigned int INVALID_NODE = 0xffffffff; //!< Invalid node index sentinel
+const unsigned int NODE_CAPACITY = 16;          //!< Maximum number of particles in a node
+const unsigned int INVALID_NODE = 0xffffffff;   //!< Invalid node index sentinel
+const unsigned int WIDE_NODE_WIDTH = 4;         //!< Number of children in a wide node
+const unsigned int WIDE_LEAF_FLAG = 0x80000000; //!< Marks a wide node child that is a leaf
 
 #ifndef __HIPCC__
 
@@ -59,6 +63,93 @@ struct PYBIND11_EXPORT AABBNode
     unsigned int num_particles;       //!< Number of particles contained in the node
     } __attribute__((aligned(32)));
 
+//! Round a bound down to the nearest single precision value
+inline float roundDown(Scalar x)
+    {
+    float f = float(x);
+    if (Scalar(f) > x)
+        f = std::nextafter(f, -std::numeric_limits<float>::infinity());
+    return f;
+    }
+
+//! Round a bound up to the nearest single precision value
+inline float roundUp(Scalar x)
+    {
+    float f = float(x);
+    if (Scalar(f) < x)
+        f = std::nextafter(f, std::numeric_limits<float>::infinity());
+    return f;
+    }
+
+//! Node in the wide query layout of an AABBTree
+/*! A wide node stores the bounds of up to WIDE_NODE_WIDTH children in structure of arrays form so
+    that one query box is tested against all children at once. Bounds are single precision values
+    rounded outward, so the test is conservative for both float and double Scalar. Each child is
+    either the index of another wide node or the index of a leaf AABBNode combined with
+    WIDE_LEAF_FLAG. Unused children have inverted bounds and never overlap.
+*/
+struct PYBIND11_EXPORT AABBNodeWide
+    {
+    //! Default constructor
+    AABBNodeWide()
+        {
+        for (unsigned int k = 0; k < WIDE_NODE_WIDTH; k++)
+            {
+            lower_x[k] = lower_y[k] = lower_z[k] = std::numeric_limits<float>::infinity();
+            upper_x[k] = upper_y[k] = upper_z[k] = -std::numeric_limits<float>::infinity();
+            child[k] = INVALID_NODE;
+            }
+        }
+
+    //! Set the bounds of a child
+    inline void setChildAABB(unsigned int k, const AABB& aabb)
+        {
+        vec3<Scalar> lower = aabb.getLower();
+        vec3<Scalar> upper = aabb.getUpper();
+        lower_x[k] = roundDown(lower.x);
+        lower_y[k] = roundDown(lower.y);
+        lower_z[k] = roundDown(lower.z);
+        upper_x[k] = roundUp(upper.x);
+        upper_y[k] = roundUp(upper.y);
+        upper_z[k] = roundUp(upper.z);
+        }
+
+    //! Test all children against a query box
+    /*! \param lower Lower corner of the query box
+        \param upper Upper corner of the query box
+        \returns A bit mask with bit k set when child k overlaps the query box
+    */
+    inline unsigned int overlaps(const float* lower, const float* upper) const
+        {
+#if defined(__SSE__)
+        __m128 hit = _mm_and_ps(_mm_cmple_ps(_mm_load_ps(lower_x), _mm_set1_ps(upper[0])),
+                                _mm_cmpge_ps(_mm_load_ps(upper_x), _mm_set1_ps(lower[0])));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_load_ps(lower_y), _mm_set1_ps(upper[1])));
+        hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_load_ps(upper_y), _mm_set1_ps(lower[1])));
+        hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_load_ps(lower_z), _mm_set1_ps(upper[2])));
+        hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_load_ps(upper_z), _mm_set1_ps(lower[2])));
+        return (unsigned int)_mm_movemask_ps(hit);
+#else
+        unsigned int hit = 0;
+        for (unsigned int k = 0; k < WIDE_NODE_WIDTH; k++)
+            {
+            if (lower_x[k] <= upper[0] && upper_x[k] >= lower[0] && lower_y[k] <= upper[1]
+                && upper_y[k] >= lower[1] && lower_z[k] <= upper[2] && upper_z[k] >= lower[2])
+                hit |= 1u << k;
+            }
+        return hit;
+#endif
+        }
+
+    float lower_x[WIDE_NODE_WIDTH];      //!< Lower x bound of each child
+    float lower_y[WIDE_NODE_WIDTH];      //!< Lower y bound of each child
+    float lower_z[WIDE_NODE_WIDTH];      //!< Lower z bound of each child
+    float upper_x[WIDE_NODE_WIDTH];      //!< Upper x bound of each child
+    float upper_y[WIDE_NODE_WIDTH];      //!< Upper y bound of each child
+    float upper_z[WIDE_NODE_WIDTH];      //!< Upper z bound of each child
+    unsigned int child[WIDE_NODE_WIDTH]; //!< Child wide node, or leaf node | WIDE_LEAF_FLAG
+    } __attribute__((aligned(32)));
+
 //! AABB Tree
 /*! An AABBTree stores a binary tree of AABBs. A leaf node stores up to NODE_CAPACITY particles by
    index. The bounding box of a leaf node surrounds all the bounding boxes of its contained
@@ -73,6 +164,12 @@ struct PYBIND11_EXPORT AABBNode
    periodically instead of continually updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each
    particle.
+    - Refit : Recompute all node bounds bottom-up from a new set of AABBs while keeping the tree
+   topology. Runs in O(N) time. refit() reports when the summed surface area of the nodes has
+   grown past a given ratio of its value after the last build, so that the caller can rebuild.
+    - Traverse : Search a 4-wide collapsed copy of the tree and call a function for every leaf
+   node that intersects the query AABB. Each wide node tests all of its children with one set of
+   SIMD comparisons.
 
     **Implementation details**
 
@@ -83,6 +180,10 @@ struct PYBIND11_EXPORT AABBNode
    allocate(). With multiple particles per leaf node, the total number of internal nodes needed is
    not known (but can be estimated) until build time.
 
+    The wide nodes are built by collapsing the binary tree after every build. Each binary node that
+   is a child of a wide node records its slot in m_wide_slot so that update() and refit() can keep
+   the wide bounds in sync.
+
     For performance, no recursive calls are used. Instead, each function is either turned into a
    loop if it uses tail recursion, or it uses a local stack to traverse the tree. The stack is
    cached between calls to limit the amount of dynamic memory allocation.
@@ -91,7 +192,7 @@ class PYBIND11_EXPORT AABBTree
     {
     public:
     //! Construct an AABBTree
-    AABBTree() : m_nodes(0), m_num_nodes(0), m_node_capacity(0), m_root(0) { }
+    AABBTree() : m_nodes(0), m_num_nodes(0), m_node_capacity(0), m_root(0), m_build_cost(0) { }
 
     // Destructor
     ~AABBTree()
@@ -107,6 +208,9 @@ class PYBIND11_EXPORT AABBTree
         m_node_capacity = from.m_node_capacity;
         m_root = from.m_root;
         m_mapping = from.m_mapping;
+        m_wide_nodes = from.m_wide_nodes;
+        m_wide_slot = from.m_wide_slot;
+        m_build_cost = from.m_build_cost;
 
         m_nodes = NULL;
 
@@ -131,6 +235,9 @@ class PYBIND11_EXPORT AABBTree
         m_node_capacity = from.m_node_capacity;
         m_root = from.m_root;
         m_mapping = from.m_mapping;
+        m_wide_nodes = from.m_wide_nodes;
+        m_wide_slot = from.m_wide_slot;
+        m_build_cost = from.m_build_cost;
 
         if (m_nodes)
             free(m_nodes);
@@ -155,9 +262,16 @@ class PYBIND11_EXPORT AABBTree
     //! Build a tree smartly from a list of AABBs
     inline void buildTree(AABB* aabbs, unsigned int N);
 
+    //! Recompute the node bounds from a new list of AABBs without changing the topology
+    inline bool refit(const AABB* aabbs, unsigned int N, Scalar max_cost_ratio);
+
     //! Find all particles that overlap with the query AABB
     inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
+    //! Call a function for every leaf node that overlaps the query AABB
+    template<class LeafCallback>
+    inline bool traverse(const AABB& aabb, LeafCallback&& callback) const;
+
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
@@ -251,6 +365,15 @@ class PYBIND11_EXPORT AABBTree
     /// Temporary index list used when partitioning nodes.
     std::vector<AABB> m_aabb_right;
 
+    /// Wide nodes used by traverse(), the root is the first element.
+    std::vector<AABBNodeWide> m_wide_nodes;
+
+    /// Wide node slot (wide node * WIDE_NODE_WIDTH + child) of each node, or INVALID_NODE.
+    std::vector<unsigned int> m_wide_slot;
+
+    /// Summed surface area of all nodes after the last build.
+    Scalar m_build_cost;
+
     //! Initialize the tree to hold N particles
     inline void init(unsigned int N);
 
@@ -266,6 +389,24 @@ class PYBIND11_EXPORT AABBTree
 
     //! Update the skip value for a node
     inline unsigned int updateSkip(unsigned int idx);
+
+    //! Build the wide nodes from the binary tree
+    inline void buildWideNodes();
+
+    //! Collapse the binary subtree below a node into a wide node
+    inline unsigned int collapseNode(unsigned int idx);
+
+    //! Copy the bounds of a node to its wide node slot
+    inline void updateWideSlot(unsigned int idx)
+        {
+        unsigned int slot = m_wide_slot[idx];
+        if (slot != INVALID_NODE)
+            m_wide_nodes[slot / WIDE_NODE_WIDTH].setChildAABB(slot % WIDE_NODE_WIDTH,
+                                                              m_nodes[idx].aabb);
+        }
+
+    //! Compute the summed surface area of all nodes
+    inline Scalar computeCost() const;
     };
 
 /*! \param N Number of particles to allocate space for
@@ -325,6 +466,118 @@ inline unsigned int AABBTree::query(std::vector<unsigned int>& hits, const AABB&
     return box_overlap_counts;
     }
 
+/*! \param aabb The AABB to query
+    \param callback Function called with the index of each intersecting leaf node
+    \returns true when the callback stopped the traversal early
+
+    traverse() searches the wide nodes and calls *callback* (which takes the leaf node index and
+   returns a bool) for every leaf node that intersects *aabb*. The traversal stops as soon as the
+   callback returns true. Use the node accessors (e.g. getNodeParticle()) to visit the particles.
+*/
+template<class LeafCallback>
+inline bool AABBTree::traverse(const AABB& aabb, LeafCallback&& callback) const
+    {
+    if (m_wide_nodes.size() == 0)
+        return false;
+
+    // round the query box outward to match the precision of the wide node bounds
+    const vec3<Scalar> aabb_lower = aabb.getLower();
+    const vec3<Scalar> aabb_upper = aabb.getUpper();
+    const float lower[3]
+        = {roundDown(aabb_lower.x), roundDown(aabb_lower.y), roundDown(aabb_lower.z)};
+    const float upper[3] = {roundUp(aabb_upper.x), roundUp(aabb_upper.y), roundUp(aabb_upper.z)};
+
+    // keep the stack local, very deep trees spill over to the heap
+    const unsigned int max_stack = 64;
+    unsigned int stack[max_stack];
+    unsigned int n_stack = 0;
+    std::vector<unsigned int> overflow;
+
+    stack[n_stack++] = 0;
+    while (n_stack > 0 || overflow.size() > 0)
+        {
+        unsigned int wide_idx;
+        if (overflow.size() > 0)
+            {
+            wide_idx = overflow.back();
+            overflow.pop_back();
+            }
+        else
+            {
+            wide_idx = stack[--n_stack];
+            }
+
+        const AABBNodeWide& node = m_wide_nodes[wide_idx];
+        unsigned int hits = node.overlaps(lower, upper);
+        for (unsigned int k = 0; k < WIDE_NODE_WIDTH; k++)
+            {
+            if (!(hits & (1u << k)))
+                continue;
+
+            unsigned int child = node.child[k];
+            if (child & WIDE_LEAF_FLAG)
+                {
+                if (callback(child & ~WIDE_LEAF_FLAG))
+                    return true;
+                }
+            else if (n_stack < max_stack)
+                {
+                stack[n_stack++] = child;
+                }
+            else
+                {
+                overflow.push_back(child);
+                }
+            }
+        }
+
+    return false;
+    }
+
+/*! \param aabbs List of AABBs for each particle, in particle index order
+    \param N Number of AABBs in the list
+    \param max_cost_ratio Largest accepted ratio of the refit cost to the cost after the last build
+    \returns true when the tree was refit, false when it needs to be rebuilt with buildTree()
+
+    refit() recomputes the AABB of every node from *aabbs* while leaving the topology unchanged.
+   The result is valid whenever the tree holds the same number of particles, but the node bounds
+   grow looser as particles move away from their neighbors at build time. refit() measures this
+   with the summed surface area of the nodes and returns false without updating the wide nodes
+   when it exceeds *max_cost_ratio* times its value after the last build.
+*/
+inline bool AABBTree::refit(const AABB* aabbs, unsigned int N, Scalar max_cost_ratio)
+    {
+    if (m_num_nodes == 0 || N != m_mapping.size())
+        return false;
+
+    // nodes are allocated before their children, so a reverse pass visits children first
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0;)
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (node.left == INVALID_NODE)
+            {
+            node.aabb = aabbs[node.particles[0]];
+            for (unsigned int i = 0; i < node.num_particles; i++)
+                {
+                node.aabb = merge(node.aabb, aabbs[node.particles[i]]);
+                node.particle_tags[i] = aabbs[node.particles[i]].tag;
+                }
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+
+    if (computeCost() > max_cost_ratio * m_build_cost)
+        return false;
+
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        updateWideSlot(node_idx);
+
+    return true;
+    }
+
 /*! \param idx Particle index to update
     \param aabb New AABB for particle *idx*
 
@@ -343,6 +596,7 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
     if (!contains(m_nodes[node_idx].aabb, aabb))
         {
         m_nodes[node_idx].aabb = merge(m_nodes[node_idx].aabb, aabb);
+        updateWideSlot(node_idx);
 
         // update all parent node AABBs
         unsigned int current_node = m_nodes[node_idx].parent;
@@ -352,6 +606,7 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
             unsigned int right_idx = m_nodes[current_node].right;
 
             m_nodes[current_node].aabb = merge(m_nodes[left_idx].aabb, m_nodes[right_idx].aabb);
+            updateWideSlot(current_node);
             current_node = m_nodes[current_node].parent;
             }
         }
@@ -401,6 +656,8 @@ inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
 
     m_root = buildNode(aabbs, m_idx, 0, N, INVALID_NODE);
     updateSkip(m_root);
+    buildWideNodes();
+    m_build_cost = computeCost();
     }
 
 /*! \param aabbs List of AABBs
@@ -565,6 +822,92 @@ inline unsigned int AABBTree::updateSkip(unsigned int idx)
         }
     }
 
+/*! buildWideNodes() collapses the binary tree into wide nodes. Every wide node replaces its
+   largest internal children with their two children until it holds WIDE_NODE_WIDTH children or
+   only leaves remain.
+*/
+inline void AABBTree::buildWideNodes()
+    {
+    m_wide_nodes.clear();
+    m_wide_slot.assign(m_num_nodes, INVALID_NODE);
+    if (m_num_nodes > 0)
+        collapseNode(m_root);
+    }
+
+/*! \param idx Index of the binary node to collapse
+    \returns Index of the new wide node
+*/
+inline unsigned int AABBTree::collapseNode(unsigned int idx)
+    {
+    unsigned int wide_idx = (unsigned int)m_wide_nodes.size();
+    m_wide_nodes.push_back(AABBNodeWide());
+
+    unsigned int children[WIDE_NODE_WIDTH];
+    unsigned int n_children = 0;
+    if (isNodeLeaf(idx))
+        {
+        children[n_children++] = idx;
+        }
+    else
+        {
+        children[n_children++] = m_nodes[idx].left;
+        children[n_children++] = m_nodes[idx].right;
+        }
+
+    // open the internal child with the largest surface area until the wide node is full
+    while (n_children < WIDE_NODE_WIDTH)
+        {
+        unsigned int open = WIDE_NODE_WIDTH;
+        Scalar max_area = -1;
+        for (unsigned int k = 0; k < n_children; k++)
+            {
+            if (isNodeLeaf(children[k]))
+                continue;
+            const AABB& child_aabb = m_nodes[children[k]].aabb;
+            vec3<Scalar> d = child_aabb.getUpper() - child_aabb.getLower();
+            Scalar area = d.x * d.y + d.y * d.z + d.z * d.x;
+            if (area > max_area)
+                {
+                max_area = area;
+                open = k;
+                }
+            }
+
+        if (open == WIDE_NODE_WIDTH)
+            break;
+
+        unsigned int node = children[open];
+        children[open] = m_nodes[node].left;
+        children[n_children++] = m_nodes[node].right;
+        }
+
+    for (unsigned int k = 0; k < n_children; k++)
+        {
+        // collapseNode may reallocate m_wide_nodes, so index it after the call returns
+        unsigned int child = children[k];
+        unsigned int wide_child
+            = isNodeLeaf(child) ? (child | WIDE_LEAF_FLAG) : collapseNode(child);
+        m_wide_nodes[wide_idx].child[k] = wide_child;
+        m_wide_nodes[wide_idx].setChildAABB(k, m_nodes[child].aabb);
+        m_wide_slot[child] = wide_idx * WIDE_NODE_WIDTH + k;
+        }
+
+    return wide_idx;
+    }
+
+/*! \returns The summed surface area of all nodes, which estimates the cost of a query
+ */
+inline Scalar AABBTree::computeCost() const
+    {
+    Scalar cost = 0;
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        {
+        vec3<Scalar> d = m_nodes[node_idx].aabb.getUpper() - m_nodes[node_idx].aabb.getLower();
+        cost += Scalar(2.0) * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+    return cost;
+    }
+
 /*! Allocates a new node in the tree
  */
 inline unsigned int AABBTree::allocateNode()
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <array>
 #include <cfloat>
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <sstream>
@@ -79,6 +80,16 @@ class PYBIND11_EXPORT AutotunerBase
     virtual void setParameterPython(pybind11::tuple parameter) {};
 #endif
 
+    /// Build a list of the number of tasks per thread to split CPU loops into.
+    /*! Each value divides a loop over n items into blocked ranges with a grain size of
+        n / (num_threads * tasks_per_thread). Fewer tasks reduce scheduling overhead, more tasks
+        balance uneven work.
+    */
+    static std::vector<unsigned int> getTasksPerThreadRange()
+        {
+        return {1, 2, 4, 8, 16};
+        }
+
 #ifdef ENABLE_HIP
     /// Build a block size range that steps on the warp size.
     static std::vector<unsigned int>
@@ -134,14 +145,18 @@ class PYBIND11_EXPORT AutotunerBase
     std::string m_name;
     };
 
-//! Autotuner for low level GPU kernel parameters
-/*! Autotuner is autotunes GPU kernel parameters (such as block size) for performance. It runs an
-    internal state machine and makes sweeps over all valid parameter values. Each parameter value is
-    a std::array<unsigned int, n_dimensions>. Performance is measured just for the single kernel in
-    question with cudaEvent timers. A number of sweeps are combined with a median to determine the
-    fastest parameter. The sampling mode can also be changed to average or maximum. The latter is
-    helpful when the distribution of kernel runtimes is bimodal, e.g. because it depends on input of
-    variable size.
+//! Autotuner for low level kernel parameters
+/*! Autotuner is autotunes GPU kernel parameters (such as block size) and CPU loop parameters (such
+    as the number of tasks per thread) for performance. It runs an internal state machine and makes
+    sweeps over all valid parameter values. Each parameter value is a
+    std::array<unsigned int, n_dimensions>. Performance is measured just for the single kernel in
+    question with cudaEvent timers on the GPU and with std::chrono::steady_clock on the CPU. A
+    number of sweeps are combined with a median to determine the fastest parameter. The sampling
+    mode can also be changed to average or maximum. The latter is helpful when the distribution of
+    kernel runtimes is bimodal, e.g. because it depends on input of variable size.
+
+    CPU loop parameters must not change the results. Loops that reduce values across tasks sum
+    them over fixed chunks that do not depend on the tuned parameter.
 
     The begin() and end() methods must be called before and after the kernel launch to be tuned. The
     value of the tuned parameter should be set to the return value of getParam(). begin() and end()
@@ -151,8 +166,9 @@ class PYBIND11_EXPORT AutotunerBase
 
     Each Autotuner instance has a string name to help identify it's output on the notice stream.
 
-    Autotuner is not useful in non-GPU builds. Timing is performed with CUDA events and requires
-    ENABLE_HIP=on. Behavior of Autotuner is undefined when ENABLE_HIP=off.
+    When the execution configuration has CUDA enabled, timing is performed with CUDA events.
+    Otherwise, begin() and end() read the wall clock, so the code between them must complete its
+    work on the host before end() is called.
 
     Internally, m_n_samples is the number of samples to take (odd for median computation).
     m_current_sample is the current sample being taken, and m_current_element is the index of the
@@ -215,15 +231,22 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
             m_state = SCANNING;
             }
 
-#ifdef ENABLE_HIP
-        // if we are scanning, record a cuda event - otherwise do nothing
+        // if we are scanning, record a cuda event or the host time - otherwise do nothing
         if (m_state == SCANNING)
             {
-            hipEventRecord(m_start, 0);
-            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
+#ifdef ENABLE_HIP
+            if (m_exec_conf->isCUDAEnabled())
+                {
+                hipEventRecord(m_start, 0);
+                if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                }
+            else
 #endif
+                {
+                m_host_start = std::chrono::steady_clock::now();
+                }
+            }
         }
 
     /// Call after kernel launch.
@@ -381,6 +404,9 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
     hipEvent_t m_stop;  //!< CUDA event for recording end times
 #endif
 
+    /// Host time recorded by begin() when timing on the CPU.
+    std::chrono::steady_clock::time_point m_host_start;
+
     /// Synchronize results over MPI when true.
     bool m_sync;
 
@@ -502,23 +528,32 @@ Autotuner<n_dimensions>::Autotuner(
 
 template<size_t n_dimensions> void Autotuner<n_dimensions>::end()
     {
-#ifdef ENABLE_HIP
     // handle timing updates if scanning
     if (m_state == SCANNING)
         {
-        hipEventRecord(m_stop, 0);
-        hipEventSynchronize(m_stop);
-        hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            hipEventRecord(m_stop, 0);
+            hipEventSynchronize(m_stop);
+            hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
+
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+#endif
+            {
+            std::chrono::duration<float, std::milli> elapsed
+                = std::chrono::steady_clock::now() - m_host_start;
+            m_samples[m_current_element][m_current_sample] = elapsed.count();
+            }
 
         m_exec_conf->msg->notice(9)
             << "Autotuner " << m_name << ": t[" << formatParam(m_current_param) << ","
             << m_current_sample << "] = " << m_samples[m_current_element][m_current_sample]
             << std::endl;
-
-        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
         }
-#endif
 
     // Handle state data updates and transitions.
     if (m_state == SCANNING)
@@ -646,8 +681,10 @@ template<size_t n_dimensions> size_t Autotuner<n_dimensions>::computeOptimalPara
                 }
             }
 
-        // Get the optimal parameter.
-        unsigned int percent = int(max_value / min_value * 100.0f) - 100;
+        // Get the performance spread (host timers may report 0 for very short loops).
+        unsigned int percent = 0;
+        if (min_value > 0.0f)
+            percent = int(max_value / min_value * 100.0f) - 100;
 
         // Notify user ot optimal parameter selection.
         m_exec_conf->msg->notice(4)
@@ -0,0 +1,301 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// inclusion guard
+#ifndef _BLOCK_SCATTER_H_
+#define _BLOCK_SCATTER_H_
+
+/*! \file BlockScatter.h
+    \brief Declares helpers for block parallel loops that scatter into shared arrays
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ExecutionConfiguration.h"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+namespace hoomd
+    {
+namespace detail
+    {
+/*! \param exec_conf Execution configuration that provides the task arena
+    \param n Number of items
+    \param n_blocks Number of blocks to split [0, n) into
+    \param kernel Callable taking the first and one past the last item of a block and its index
+
+    The blocks are run in parallel when more than one thread is available.
+*/
+template<class Kernel>
+void forEachBlock(const ExecutionConfiguration& exec_conf,
+                  unsigned int n,
+                  unsigned int n_blocks,
+                  const Kernel& kernel)
+    {
+    const unsigned int block_size = (n + n_blocks - 1) / n_blocks;
+    auto run_block = [&](unsigned int block)
+    {
+        unsigned int first = std::min(block * block_size, n);
+        unsigned int last = std::min(first + block_size, n);
+        kernel(first, last, block);
+    };
+
+#ifdef ENABLE_TBB
+    if (exec_conf.getNumThreads() > 1 && n_blocks > 1)
+        {
+        exec_conf.getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_blocks, 1),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int block = r.begin(); block != r.end();
+                                           ++block)
+                                          run_block(block);
+                                  });
+            });
+        }
+    else
+#endif
+        {
+        for (unsigned int block = 0; block < n_blocks; block++)
+            run_block(block);
+        }
+    }
+
+//! Partition of work items into blocks that each accumulate into a window of a shared array
+/*! Loops where item i also adds to other entries of the output arrays (third law updates, three
+    body forces) cannot write to the outputs from several threads. Instead, each block of items
+    accumulates into a buffer of its own and the buffers are summed in block order afterwards,
+    which makes the result reproducible for a fixed number of threads.
+
+    A buffer only covers the window of indices its block writes: one interval of local indices
+    [0, n_local) and one of ghost indices [n_local, n_all). With spatially sorted particles these
+    windows are little larger than the block itself. When the windows add up to more than
+    max_buffer_factor * n_all entries, neighboring blocks are merged, so the buffers never hold
+    more than that many entries regardless of the number of threads.
+
+    Callers size their buffers with getBufferSize(), zero and fill the part of each block in
+    forEach(), map indices to buffer entries with getSlot(), and add the buffers to the outputs in
+    reduce().
+*/
+class BlockScatter
+    {
+    public:
+    //! Most entries the buffers may hold, in units of the number of indices
+    static const unsigned int max_buffer_factor = 2;
+
+    //! Indices written by a block of items
+    struct Window
+        {
+        unsigned int n_local = 0;         //!< Number of local indices
+        unsigned int lo = UINT_MAX;       //!< First local index written
+        unsigned int hi = 0;              //!< One past the last local index written
+        unsigned int ghost_lo = UINT_MAX; //!< First ghost index written
+        unsigned int ghost_hi = 0;        //!< One past the last ghost index written
+
+        //! Add index \a k to the window
+        void add(unsigned int k)
+            {
+            if (k < n_local)
+                {
+                lo = std::min(lo, k);
+                hi = std::max(hi, k + 1);
+                }
+            else
+                {
+                ghost_lo = std::min(ghost_lo, k);
+                ghost_hi = std::max(ghost_hi, k + 1);
+                }
+            }
+
+        //! Add the indices of another window
+        void add(const Window& other)
+            {
+            lo = std::min(lo, other.lo);
+            hi = std::max(hi, other.hi);
+            ghost_lo = std::min(ghost_lo, other.ghost_lo);
+            ghost_hi = std::max(ghost_hi, other.ghost_hi);
+            }
+
+        //! Number of local indices in the window
+        unsigned int getLocalSize() const
+            {
+            return hi > lo ? hi - lo : 0;
+            }
+
+        //! Number of ghost indices in the window
+        unsigned int getGhostSize() const
+            {
+            return ghost_hi > ghost_lo ? ghost_hi - ghost_lo : 0;
+            }
+
+        //! Position of index \a k among the local and then the ghost indices of the window
+        size_t getIndex(unsigned int k) const
+            {
+            if (k < n_local)
+                return k - lo;
+            return size_t(getLocalSize()) + (k - ghost_lo);
+            }
+        };
+
+    //! A contiguous range of items and the buffer entries they write
+    struct Block
+        {
+        unsigned int first; //!< First item
+        unsigned int last;  //!< One past the last item
+        Window window;      //!< Indices written by the items
+        size_t offset;      //!< Offset of the block's entries in the buffers
+        };
+
+    /*! \param exec_conf Execution configuration
+        \param n_items Number of work items
+        \param n_local Number of local indices
+        \param n_all Number of local and ghost indices
+        \param reach Callable reach(first, last, window) that adds to \a window every index
+                     written by items [first, last)
+
+        Items are split into one block per thread before merging.
+    */
+    template<class Reach>
+    void partition(const ExecutionConfiguration& exec_conf,
+                   unsigned int n_items,
+                   unsigned int n_local,
+                   unsigned int n_all,
+                   const Reach& reach)
+        {
+        const unsigned int n_blocks = std::max(std::min(exec_conf.getNumThreads(), n_items), 1u);
+        m_blocks.resize(n_blocks);
+        forEachBlock(exec_conf,
+                     n_items,
+                     n_blocks,
+                     [&](unsigned int first, unsigned int last, unsigned int block)
+                     {
+                         Block& b = m_blocks[block];
+                         b.first = first;
+                         b.last = last;
+                         b.window = Window();
+                         b.window.n_local = n_local;
+                         reach(first, last, b.window);
+                     });
+
+        // merge neighboring blocks until the buffers fit
+        const size_t max_size = size_t(max_buffer_factor) * n_all;
+        while (m_blocks.size() > 1 && computeOffsets() > max_size)
+            {
+            for (size_t b = 0; b < m_blocks.size() / 2; b++)
+                {
+                Block merged = m_blocks[2 * b];
+                merged.last = m_blocks[2 * b + 1].last;
+                merged.window.add(m_blocks[2 * b + 1].window);
+                m_blocks[b] = merged;
+                }
+            // an odd last block is kept as it is
+            if (m_blocks.size() % 2)
+                m_blocks[m_blocks.size() / 2] = m_blocks.back();
+            m_blocks.resize((m_blocks.size() + 1) / 2);
+            }
+        m_buffer_size = computeOffsets();
+        }
+
+    //! Get the number of blocks
+    unsigned int getNBlocks() const
+        {
+        return (unsigned int)m_blocks.size();
+        }
+
+    //! Get a block
+    const Block& getBlock(unsigned int block) const
+        {
+        return m_blocks[block];
+        }
+
+    //! Get the number of entries the buffers of all blocks need
+    size_t getBufferSize() const
+        {
+        return m_buffer_size;
+        }
+
+    //! Get the buffer entry of index \a k in block \a block
+    size_t getSlot(unsigned int block, unsigned int k) const
+        {
+        const Block& b = m_blocks[block];
+        return b.offset + b.window.getIndex(k);
+        }
+
+    /*! \param exec_conf Execution configuration
+        \param kernel Callable kernel(block, b) for each Block \a b and its index \a block
+    */
+    template<class Kernel>
+    void forEach(const ExecutionConfiguration& exec_conf, const Kernel& kernel)
+        {
+        forEachBlock(exec_conf,
+                     getNBlocks(),
+                     getNBlocks(),
+                     [&](unsigned int first, unsigned int last, unsigned int block)
+                     { kernel(m_blocks[block], block); });
+        }
+
+    /*! \param exec_conf Execution configuration
+        \param n_all Number of local and ghost indices
+        \param add Callable add(k, slot) that adds buffer entry \a slot to output index \a k
+
+        For each index, the entries of the blocks are added in block order.
+    */
+    template<class Add>
+    void reduce(const ExecutionConfiguration& exec_conf, unsigned int n_all, const Add& add) const
+        {
+        const unsigned int n_chunks
+            = std::max(std::min(8 * exec_conf.getNumThreads(), n_all), 1u);
+        forEachBlock(exec_conf,
+                     n_all,
+                     n_chunks,
+                     [&](unsigned int first, unsigned int last, unsigned int chunk)
+                     {
+                         for (const Block& b : m_blocks)
+                             {
+                             const Window& w = b.window;
+                             for (unsigned int k = std::max(first, w.lo);
+                                  k < std::min(last, w.hi);
+                                  k++)
+                                 add(k, b.offset + (k - w.lo));
+
+                             const size_t ghost_offset = b.offset + w.getLocalSize();
+                             for (unsigned int k = std::max(first, w.ghost_lo);
+                                  k < std::min(last, w.ghost_hi);
+                                  k++)
+                                 add(k, ghost_offset + (k - w.ghost_lo));
+                             }
+                     });
+        }
+
+    private:
+    std::vector<Block> m_blocks; //!< The blocks in item order
+    size_t m_buffer_size = 0;    //!< Total number of buffer entries
+
+    //! Assign the buffer offsets of the blocks and return the total size
+    size_t computeOffsets()
+        {
+        size_t offset = 0;
+        for (Block& b : m_blocks)
+            {
+            b.offset = offset;
+            offset += size_t(b.window.getLocalSize()) + b.window.getGhostSize();
+            }
+        return offset;
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace hoomd
+
+#endif // _BLOCK_SCATTER_H_
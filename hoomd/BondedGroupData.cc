@@ -92,11 +92,13 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
 /*! \param exec_conf Execution configuration
     \param pdata The particle data to associate with
     \param snapshot Snapshot to initialize from
+    \param distributed_snapshot True if each rank holds a part of the snapshot
  */
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
-    const Snapshot& snapshot)
+    const Snapshot& snapshot,
+    bool distributed_snapshot)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
       m_groups_dirty(true)
     {
@@ -109,7 +111,10 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
             this);
 
     // initialize from snapshot
-    initializeFromSnapshot(snapshot);
+    if (distributed_snapshot)
+        initializeFromDistributedSnapshot(snapshot);
+    else
+        initializeFromSnapshot(snapshot);
 
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
@@ -318,6 +323,250 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+//! Initialize from a snapshot that is distributed over the ranks
+/*! \param snapshot This rank's part of the groups
+
+    Rank r holds the groups with tags [first_tag, first_tag + snapshot.size), where first_tag is
+    the total size of the snapshots on ranks 0 to r-1. The member tags refer to global particle
+    tags, and the particle data must already be initialized.
+
+    No rank holds the full list of groups. Each group is sent to the directory ranks of its
+    members, where the directory rank of a particle tag is the rank of the DistributeIndexOrder
+    slab that contains the tag. The directory ranks know which rank owns each particle and
+    forward the group to those ranks.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromDistributedSnapshot(
+    const Snapshot& snapshot)
+    {
+#ifdef ENABLE_MPI
+    if (!m_pdata->getDomainDecomposition())
+#endif
+        {
+        // with a single rank, the distributed snapshot is the whole snapshot
+        initializeFromSnapshot(snapshot);
+        return;
+        }
+
+#ifdef ENABLE_MPI
+    // each rank checks its own part of the snapshot
+    snapshot.validate();
+
+    if (snapshot.type_mapping.size() >= 40 && m_exec_conf->getRank() == 0)
+        {
+        std::ostringstream s;
+        s << "Systems with many " << name
+          << " types perform poorly or result "
+             "in shared memory errors on the GPU.";
+        m_exec_conf->msg->warning() << s.str() << std::endl;
+        }
+
+    // re-initialize data structures
+    initialize();
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    const int n_ranks = m_exec_conf->getNRanks();
+    const int my_rank = m_exec_conf->getRank();
+
+    // use the type mapping of the root rank
+    m_type_mapping = snapshot.type_mapping;
+    bcast(m_type_mapping, 0, mpi_comm);
+
+    // the tags of this rank's groups follow those of the lower ranks
+    unsigned int snapshot_size = (unsigned int)snapshot.groups.size();
+    unsigned int first_tag = 0;
+    unsigned int nglobal = 0;
+    MPI_Exscan(&snapshot_size, &first_tag, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    MPI_Allreduce(&snapshot_size, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+
+    const unsigned int n_particles = m_pdata->getNGlobal();
+    auto directory_rank = [&](unsigned int tag)
+    { return DistributeIndexOrder::computeSlabRank(tag, n_ranks, n_particles); };
+
+    // validate the groups on all ranks before any communication that depends on them
+    std::ostringstream error;
+    for (unsigned int group_idx = 0; group_idx < snapshot.groups.size() && error.str().empty();
+         ++group_idx)
+        {
+        const members_t& member_tags = snapshot.groups[group_idx];
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            for (unsigned int j = 0; j < group_size; ++j)
+                {
+                if (member_tags.tag[i] >= n_particles
+                    || (i != j && member_tags.tag[i] == member_tags.tag[j]))
+                    {
+                    error << "Invalid particle tags in " << name << " " << first_tag + group_idx
+                          << ": ";
+                    for (unsigned int k = 0; k < group_size; ++k)
+                        error << member_tags.tag[k] << ((k != group_size - 1) ? "," : "");
+                    break;
+                    }
+                }
+            if (!error.str().empty())
+                break;
+            }
+
+        if (has_type_mapping && error.str().empty()
+            && snapshot.type_id[group_idx] >= m_type_mapping.size())
+            {
+            error << "Invalid " << name << " typeid " << snapshot.type_id[group_idx]
+                  << ". The number of types is " << m_type_mapping.size() << ".";
+            }
+        }
+
+    bool valid = error.str().empty();
+    MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_CXX_BOOL, MPI_LAND, mpi_comm);
+    if (!valid)
+        {
+        if (!error.str().empty())
+            throw std::runtime_error(error.str());
+        throw std::runtime_error(std::string("Error initializing ") + name + "s.");
+        }
+
+    // register the owner of every particle with the directory rank of its tag
+    unsigned int directory_begin
+        = DistributeIndexOrder::computeSlabBegin(my_rank, n_ranks, n_particles);
+    unsigned int directory_end
+        = DistributeIndexOrder::computeSlabBegin(my_rank + 1, n_ranks, n_particles);
+    std::vector<unsigned int> particle_owner(directory_end - directory_begin, 0);
+        {
+        std::vector<std::vector<uint2>> send_owners(n_ranks);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+            {
+            unsigned int tag = h_tag.data[idx];
+            send_owners[directory_rank(tag)].push_back(
+                make_uint2(tag, static_cast<unsigned int>(my_rank)));
+            }
+
+        std::vector<uint2> recv_owners;
+        all_to_all_v(send_owners, recv_owners, mpi_comm);
+
+        for (const uint2& entry : recv_owners)
+            particle_owner[entry.x - directory_begin] = entry.y;
+        }
+
+    //! A group on its way to the ranks that own its members
+    struct group_record
+        {
+        unsigned int tag;
+        members_t members;
+        typeval_t typeval;
+        };
+
+    // send each group to the directory ranks of its members
+    std::vector<std::vector<group_record>> send_groups(n_ranks);
+    for (unsigned int group_idx = 0; group_idx < snapshot.groups.size(); ++group_idx)
+        {
+        group_record g;
+        g.tag = first_tag + group_idx;
+        g.members = snapshot.groups[group_idx];
+        if (has_type_mapping)
+            g.typeval.type = snapshot.type_id[group_idx];
+        else
+            g.typeval.val = snapshot.val[group_idx];
+
+        int destinations[group_size];
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            destinations[i] = directory_rank(g.members.tag[i]);
+            if (std::find(destinations, destinations + i, destinations[i]) == destinations + i)
+                send_groups[destinations[i]].push_back(g);
+            }
+        }
+
+    std::vector<group_record> recv_groups;
+    all_to_all_v(send_groups, recv_groups, mpi_comm);
+
+    // forward each group to the owners of the members in this directory slab
+    for (auto& v : send_groups)
+        v.clear();
+
+    for (const group_record& g : recv_groups)
+        {
+        int destinations[group_size];
+        unsigned int n_destinations = 0;
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            unsigned int tag = g.members.tag[i];
+            if (tag < directory_begin || tag >= directory_end)
+                continue;
+
+            int owner = particle_owner[tag - directory_begin];
+            if (std::find(destinations, destinations + n_destinations, owner)
+                == destinations + n_destinations)
+                {
+                destinations[n_destinations++] = owner;
+                send_groups[owner].push_back(g);
+                }
+            }
+        }
+
+    all_to_all_v(send_groups, recv_groups, mpi_comm);
+    std::vector<std::vector<group_record>>().swap(send_groups);
+
+    // a group may arrive from several directory ranks, store each local group once in tag order
+    std::sort(recv_groups.begin(),
+              recv_groups.end(),
+              [](const group_record& a, const group_record& b) { return a.tag < b.tag; });
+    recv_groups.erase(std::unique(recv_groups.begin(),
+                                  recv_groups.end(),
+                                  [](const group_record& a, const group_record& b)
+                                  { return a.tag == b.tag; }),
+                      recv_groups.end());
+
+    m_n_groups = (unsigned int)recv_groups.size();
+    reallocate(m_n_groups);
+    m_group_rtag.resize(nglobal);
+
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(m_group_typeval,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag,
+                                               access_location::host,
+                                               access_mode::overwrite);
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks,
+                                           access_location::host,
+                                           access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < nglobal; ++tag)
+            h_group_rtag.data[tag] = GROUP_NOT_LOCAL;
+
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            {
+            const group_record& g = recv_groups[group_idx];
+            h_groups.data[group_idx] = g.members;
+            h_typeval.data[group_idx] = g.typeval;
+            h_group_tag.data[group_idx] = g.tag;
+            h_group_rtag.data[g.tag] = group_idx;
+
+            // initialize with zero
+            for (unsigned int i = 0; i < group_size; ++i)
+                h_group_ranks.data[group_idx].idx[i] = 0;
+            }
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; ++tag)
+        m_tag_set.insert(tag);
+    m_invalid_cached_tags = true;
+
+    m_nglobal = nglobal;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+#endif
+    }
+
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
@@ -261,7 +261,9 @@ class BondedGroupData
     BondedGroupData(std::shared_ptr<ParticleData> pdata, unsigned int n_group_types);
 
     //! Constructor to initialize from a snapshot
-    BondedGroupData(std::shared_ptr<ParticleData> pdata, const Snapshot& snapshot);
+    BondedGroupData(std::shared_ptr<ParticleData> pdata,
+                    const Snapshot& snapshot,
+                    bool distributed_snapshot = false);
 
     virtual ~BondedGroupData();
 
@@ -271,6 +273,9 @@ class BondedGroupData
     //! Initialize from a snapshot
     virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+    //! Initialize from a snapshot that is distributed over the ranks
+    void initializeFromDistributedSnapshot(const Snapshot& snapshot);
+
     //! Take a snapshot
     std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
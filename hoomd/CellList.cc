@@ -10,6 +10,11 @@
 
 #include <algorithm>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 
 namespace hoomd
@@ -19,13 +24,15 @@ namespace hoomd
 CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     : Compute(sysdef), m_nominal_width(Scalar(1.0)), m_radius(1), m_compute_xyzf(true),
       m_compute_type_body(false), m_compute_orientation(false), m_compute_idx(false),
-      m_flag_charge(false), m_flag_type(false), m_sort_cell_list(false), m_compute_adj_list(true)
+      m_compute_soa(false), m_compressed(false), m_flag_charge(false), m_flag_type(false),
+      m_sort_cell_list(false), m_compute_adj_list(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing CellList" << endl;
 
     // allocation is deferred until the first compute() call - initialize values to dummy variables
     m_dim = make_uint3(0, 0, 0);
     m_Nmax = 0;
+    m_n_slots = 0;
     m_params_changed = true;
     m_particles_sorted = false;
     m_box_changed = false;
@@ -240,12 +247,35 @@ void CellList::initializeMemory()
             m_Nmax = 1;
         }
 
-    m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y << " x "
-                                << m_dim.z << " x " << m_Nmax << endl;
-
     // initialize indexers
     m_cell_indexer = Index3D(m_dim.x, m_dim.y, m_dim.z);
-    m_cell_list_indexer = Index2D(m_Nmax, m_cell_indexer.getNumElements());
+
+    size_t n_slots;
+    if (m_compressed)
+        {
+        m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y
+                                    << " x " << m_dim.z << " compressed" << endl;
+
+        // compressed cell lists have no fixed number of slots per cell
+        m_cell_list_indexer = Index2D();
+        n_slots = std::max(m_pdata->getN() + m_pdata->getNGhosts(), 1u);
+
+        GlobalArray<unsigned int> cell_start(m_cell_indexer.getNumElements() + 1, m_exec_conf);
+        m_cell_start.swap(cell_start);
+        TAG_ALLOCATION(m_cell_start);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y
+                                    << " x " << m_dim.z << " x " << m_Nmax << endl;
+
+        m_cell_list_indexer = Index2D(m_Nmax, m_cell_indexer.getNumElements());
+        n_slots = m_cell_list_indexer.getNumElements();
+
+        // array is not needed, discard it
+        GlobalArray<unsigned int> cell_start;
+        m_cell_start.swap(cell_start);
+        }
 
     // allocate memory
     GlobalArray<unsigned int> cell_size(m_cell_indexer.getNumElements(), m_exec_conf);
@@ -287,9 +317,20 @@ void CellList::initializeMemory()
         m_cell_adj.swap(cell_adj);
         }
 
+    allocateCellData(n_slots);
+
+    // only initialize the adjacency list if requested
+    if (m_compute_adj_list)
+        initializeCellAdj();
+    }
+
+/*! \param n_slots Number of particle slots to allocate in each requested cell list array
+ */
+void CellList::allocateCellData(size_t n_slots)
+    {
     if (m_compute_xyzf)
         {
-        GlobalArray<Scalar4> xyzf(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<Scalar4> xyzf(n_slots, m_exec_conf);
         m_xyzf.swap(xyzf);
         TAG_ALLOCATION(m_xyzf);
         }
@@ -301,7 +342,7 @@ void CellList::initializeMemory()
 
     if (m_compute_type_body)
         {
-        GlobalArray<uint2> type_body(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<uint2> type_body(n_slots, m_exec_conf);
         m_type_body.swap(type_body);
         TAG_ALLOCATION(m_type_body);
         }
@@ -314,7 +355,7 @@ void CellList::initializeMemory()
 
     if (m_compute_orientation)
         {
-        GlobalArray<Scalar4> orientation(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<Scalar4> orientation(n_slots, m_exec_conf);
         m_orientation.swap(orientation);
         TAG_ALLOCATION(m_orientation);
         }
@@ -327,7 +368,7 @@ void CellList::initializeMemory()
 
     if (m_compute_idx || m_sort_cell_list)
         {
-        GlobalArray<unsigned int> idx(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        GlobalArray<unsigned int> idx(n_slots, m_exec_conf);
         m_idx.swap(idx);
         TAG_ALLOCATION(m_idx);
         }
@@ -338,9 +379,32 @@ void CellList::initializeMemory()
         m_idx.swap(idx);
         }
 
-    // only initialize the adjacency list if requested
-    if (m_compute_adj_list)
-        initializeCellAdj();
+    if (m_compute_soa)
+        {
+        GlobalArray<Scalar> x(n_slots, m_exec_conf);
+        m_x.swap(x);
+        TAG_ALLOCATION(m_x);
+
+        GlobalArray<Scalar> y(n_slots, m_exec_conf);
+        m_y.swap(y);
+        TAG_ALLOCATION(m_y);
+
+        GlobalArray<Scalar> z(n_slots, m_exec_conf);
+        m_z.swap(z);
+        TAG_ALLOCATION(m_z);
+        }
+    else
+        {
+        // arrays are no longer needed, discard them
+        GlobalArray<Scalar> x;
+        m_x.swap(x);
+        GlobalArray<Scalar> y;
+        m_y.swap(y);
+        GlobalArray<Scalar> z;
+        m_z.swap(z);
+        }
+
+    m_n_slots = n_slots;
     }
 
 void CellList::initializeCellAdj()
@@ -401,8 +465,80 @@ void CellList::initializeCellAdj()
                 }
     }
 
+//! Sentinel returned by getParticleBin() for particles that cannot be placed in a cell
+static const unsigned int invalid_bin = 0xffffffff;
+
+/*! \param n Particle index
+    \param postype Particle position and type
+    \param box Local simulation box
+    \param periodic Periodic flags of \a box
+    \param conditions Condition flags: y is set to n + 1 when the position is NaN, z is set to n + 1
+           when a local particle lies outside the addressable cells
+    \returns The index of the cell the particle belongs in, or invalid_bin
+*/
+unsigned int CellList::getParticleBin(unsigned int n,
+                                      const Scalar4& postype,
+                                      const BoxDim& box,
+                                      uchar3 periodic,
+                                      uint3& conditions) const
+    {
+    Scalar3 p = make_scalar3(postype.x, postype.y, postype.z);
+    if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
+        {
+        conditions.y = n + 1;
+        return invalid_bin;
+        }
+
+    // find the bin each particle belongs in
+    Scalar3 f = box.makeFraction(p, m_ghost_width);
+    int ib = (int)(f.x * m_dim.x);
+    int jb = (int)(f.y * m_dim.y);
+    int kb = (int)(f.z * m_dim.z);
+
+    // check if the particle is inside the unit cell + ghost layer in all dimensions
+    if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
+        || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
+        || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
+        {
+        // if a ghost particle is out of bounds, silently ignore it
+        if (n < m_pdata->getN())
+            conditions.z = n + 1;
+        return invalid_bin;
+        }
+
+    // need to handle the case where the particle is exactly at the box hi
+    if (ib == (int)m_dim.x && periodic.x)
+        ib = 0;
+    if (jb == (int)m_dim.y && periodic.y)
+        jb = 0;
+    if (kb == (int)m_dim.z && periodic.z)
+        kb = 0;
+
+    // sanity check
+    assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z))
+           || n >= m_pdata->getN());
+
+    // all particles should be in a valid cell
+    if (ib < 0 || ib >= (int)m_dim.x || jb < 0 || jb >= (int)m_dim.y || kb < 0
+        || kb >= (int)m_dim.z)
+        {
+        // but ghost particles that are out of range should not produce an error
+        if (n < m_pdata->getN())
+            conditions.z = n + 1;
+        return invalid_bin;
+        }
+
+    return m_cell_indexer(ib, jb, kb);
+    }
+
 void CellList::computeCellList()
     {
+    if (m_compressed)
+        {
+        computeCellListCompressed();
+        return;
+        }
+
     // acquire the particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
@@ -424,17 +560,17 @@ void CellList::computeCellList()
                                             access_mode::overwrite);
     ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
     ArrayHandle<uint2> h_type_body(m_type_body, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_x(m_x, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_y(m_y, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_z(m_z, access_location::host, access_mode::overwrite);
     uint3 conditions = make_uint3(0, 0, 0);
 
     // shorthand copies of the indexers
-    Index3D ci = m_cell_indexer;
     Index2D cli = m_cell_list_indexer;
 
     // clear the bin sizes to 0
     memset(h_cell_size.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
 
-    Scalar3 ghost_width = getGhostWidth();
-
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
@@ -443,54 +579,10 @@ void CellList::computeCellList()
 
     for (unsigned int n = 0; n < n_tot_particles; n++)
         {
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
-            {
-            conditions.y = n + 1;
-            continue;
-            }
-
-        // find the bin each particle belongs in
-        Scalar3 f = box.makeFraction(p, ghost_width);
-        int ib = (int)(f.x * m_dim.x);
-        int jb = (int)(f.y * m_dim.y);
-        int kb = (int)(f.z * m_dim.z);
-
-        // check if the particle is inside the unit cell + ghost layer in all dimensions
-        if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
-            || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
-            || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
-            {
-            // if a ghost particle is out of bounds, silently ignore it
-            if (n < m_pdata->getN())
-                conditions.z = n + 1;
-            continue;
-            }
-
-        // need to handle the case where the particle is exactly at the box hi
-        if (ib == (int)m_dim.x && periodic.x)
-            ib = 0;
-        if (jb == (int)m_dim.y && periodic.y)
-            jb = 0;
-        if (kb == (int)m_dim.z && periodic.z)
-            kb = 0;
-
-        // sanity check
-        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z))
-               || n >= m_pdata->getN());
-
         // record its bin
-        unsigned int bin = ci(ib, jb, kb);
-
-        // all particles should be in a valid cell
-        if (ib < 0 || ib >= (int)m_dim.x || jb < 0 || jb >= (int)m_dim.y || kb < 0
-            || kb >= (int)m_dim.z)
-            {
-            // but ghost particles that are out of range should not produce an error
-            if (n < m_pdata->getN())
-                conditions.z = n + 1;
+        unsigned int bin = getParticleBin(n, h_pos.data[n], box, periodic, conditions);
+        if (bin == invalid_bin)
             continue;
-            }
 
         // setup the flag value to store
         Scalar flag;
@@ -527,6 +619,13 @@ void CellList::computeCellList()
                 {
                 h_cell_idx.data[cli(offset, bin)] = n;
                 }
+
+            if (m_compute_soa)
+                {
+                h_x.data[cli(offset, bin)] = h_pos.data[n].x;
+                h_y.data[cli(offset, bin)] = h_pos.data[n].y;
+                h_z.data[cli(offset, bin)] = h_pos.data[n].z;
+                }
             }
         else
             {
@@ -546,6 +645,232 @@ void CellList::computeCellList()
         }
     }
 
+/*! The particles are sorted into cells with a counting sort. The particles are split into one
+    contiguous block per thread, with fewer blocks on fine grids so that the n_blocks * n_cells
+    counts stay O(N + n_cells). The first pass computes each particle's cell and per block cell
+    counts, the counts are then scanned into cell offsets, and the second pass scatters each block
+    into its reserved slots. Particles within a cell are therefore ordered by index regardless of
+    the number of threads, and the build never overflows.
+*/
+void CellList::computeCellListCompressed()
+    {
+    const unsigned int n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int n_cells = m_cell_indexer.getNumElements();
+
+    // grow the per particle arrays when the number of ghosts increases
+    if (n_tot_particles > m_n_slots)
+        allocateCellData(n_tot_particles);
+
+    // acquire the particle data
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+    uchar3 periodic = box.getPeriodic();
+
+    // access the cell list data arrays
+    ArrayHandle<unsigned int> h_cell_size(m_cell_size,
+                                          access_location::host,
+                                          access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_start(m_cell_start,
+                                           access_location::host,
+                                           access_mode::overwrite);
+    ArrayHandle<Scalar4> h_xyzf(m_xyzf, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_cell_orientation(m_orientation,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::overwrite);
+    ArrayHandle<uint2> h_type_body(m_type_body, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_x(m_x, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_y(m_y, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_z(m_z, access_location::host, access_mode::overwrite);
+
+    // one block of particles per thread, limited so that the per block cell counts take no more
+    // than about two entries per particle on top of one entry per cell
+    unsigned int n_blocks = 1;
+#ifdef ENABLE_TBB
+    const unsigned int max_blocks
+        = 1 + static_cast<unsigned int>(2 * size_t(n_tot_particles) / std::max(n_cells, 1u));
+    n_blocks = std::max(std::min({m_exec_conf->getNumThreads(), n_tot_particles, max_blocks}), 1u);
+#endif
+    const unsigned int block_size = (n_tot_particles + n_blocks - 1) / n_blocks;
+
+    m_bin.resize(n_tot_particles);
+    m_block_count.assign(size_t(n_blocks) * n_cells, 0);
+    std::vector<uint3> block_conditions(n_blocks, make_uint3(0, 0, 0));
+
+    // call f(first, last) over [0, n) in parallel when threads are available
+    auto for_range = [&](unsigned int n, unsigned int grain_size, auto&& f)
+    {
+#ifdef ENABLE_TBB
+        if (n_blocks > 1)
+            {
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n, grain_size),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      { f(r.begin(), r.end()); });
+                });
+            return;
+            }
+#endif
+        f(0, n);
+    };
+
+    // first pass: find the cell of each particle and count the particles in each block
+    for_range(n_blocks,
+              1,
+              [&](unsigned int first_block, unsigned int last_block)
+              {
+                  for (unsigned int block = first_block; block < last_block; block++)
+                      {
+                      unsigned int* count = m_block_count.data() + size_t(block) * n_cells;
+                      unsigned int first = std::min(block * block_size, n_tot_particles);
+                      unsigned int last = std::min(first + block_size, n_tot_particles);
+                      for (unsigned int n = first; n < last; n++)
+                          {
+                          unsigned int bin = getParticleBin(n,
+                                                            h_pos.data[n],
+                                                            box,
+                                                            periodic,
+                                                            block_conditions[block]);
+                          m_bin[n] = bin;
+                          if (bin != invalid_bin)
+                              count[bin]++;
+                          }
+                      }
+              });
+
+    // sum the block counts into the cell sizes
+    for_range(n_cells,
+              1024,
+              [&](unsigned int first, unsigned int last)
+              {
+                  for (unsigned int cell = first; cell < last; cell++)
+                      {
+                      unsigned int size = 0;
+                      for (unsigned int block = 0; block < n_blocks; block++)
+                          size += m_block_count[size_t(block) * n_cells + cell];
+                      h_cell_size.data[cell] = size;
+                      }
+              });
+
+    // exclusive scan of the cell sizes gives the start of each cell
+    unsigned int Nmax = 0;
+    unsigned int start = 0;
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        {
+        h_cell_start.data[cell] = start;
+        start += h_cell_size.data[cell];
+        Nmax = std::max(Nmax, h_cell_size.data[cell]);
+        }
+    h_cell_start.data[n_cells] = start;
+
+    // convert the block counts into the first slot each block writes in each cell
+    for_range(n_cells,
+              1024,
+              [&](unsigned int first, unsigned int last)
+              {
+                  for (unsigned int cell = first; cell < last; cell++)
+                      {
+                      unsigned int offset = h_cell_start.data[cell];
+                      for (unsigned int block = 0; block < n_blocks; block++)
+                          {
+                          unsigned int& count = m_block_count[size_t(block) * n_cells + cell];
+                          unsigned int block_count = count;
+                          count = offset;
+                          offset += block_count;
+                          }
+                      }
+              });
+
+    // second pass: scatter the particles of each block into their slots
+    for_range(
+        n_blocks,
+        1,
+        [&](unsigned int first_block, unsigned int last_block)
+        {
+            for (unsigned int block = first_block; block < last_block; block++)
+                {
+                unsigned int* offset = m_block_count.data() + size_t(block) * n_cells;
+                unsigned int first = std::min(block * block_size, n_tot_particles);
+                unsigned int last = std::min(first + block_size, n_tot_particles);
+                for (unsigned int n = first; n < last; n++)
+                    {
+                    unsigned int bin = m_bin[n];
+                    if (bin == invalid_bin)
+                        continue;
+
+                    unsigned int slot = offset[bin]++;
+
+                    if (m_compute_xyzf)
+                        {
+                        // setup the flag value to store
+                        Scalar flag;
+                        if (m_flag_charge)
+                            flag = h_charge.data[n];
+                        else if (m_flag_type)
+                            flag = h_pos.data[n].w;
+                        else
+                            flag = __int_as_scalar(n);
+
+                        h_xyzf.data[slot]
+                            = make_scalar4(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z, flag);
+                        }
+
+                    if (m_compute_type_body)
+                        {
+                        h_type_body.data[slot]
+                            = make_uint2(__scalar_as_int(h_pos.data[n].w), h_body.data[n]);
+                        }
+
+                    if (m_compute_orientation)
+                        {
+                        h_cell_orientation.data[slot] = h_orientation.data[n];
+                        }
+
+                    if (m_compute_idx)
+                        {
+                        h_cell_idx.data[slot] = n;
+                        }
+
+                    if (m_compute_soa)
+                        {
+                        h_x.data[slot] = h_pos.data[n].x;
+                        h_y.data[slot] = h_pos.data[n].y;
+                        h_z.data[slot] = h_pos.data[n].z;
+                        }
+                    }
+                }
+        });
+
+    // report the largest cell occupancy through getNmax()
+    m_Nmax = std::max(Nmax, 1u);
+
+    // merge the block conditions in particle order (the last flagged particle is reported, as in
+    // the serial build)
+    uint3 conditions = make_uint3(0, 0, 0);
+    for (unsigned int block = 0; block < n_blocks; block++)
+        {
+        conditions.y = std::max(conditions.y, block_conditions[block].y);
+        conditions.z = std::max(conditions.z, block_conditions[block].z);
+        }
+
+        {
+        // write out conditions
+        ArrayHandle<uint3> h_conditions(m_conditions,
+                                        access_location::host,
+                                        access_mode::overwrite);
+        *h_conditions.data = conditions;
+        }
+    }
+
 bool CellList::checkConditions()
     {
     bool result = false;
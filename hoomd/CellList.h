@@ -9,6 +9,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
 
 /*! \file CellList.h
     \brief Declares the CellList class
@@ -55,6 +56,8 @@ namespace hoomd
      - The \c idx array contains unsigned int elements listing the index of each particle. It is
    useful when xyzf is set to hold type. It is only computed is requested to reduce the computation
    time when it is not needed.
+     - The \c x, \c y, and \c z arrays contain the particle coordinates as a structure of arrays.
+   They are only computed if requested and are laid out identically to \c xyzf.
      - The cell_adj array lists indices of adjacent cells. A specified radius (3,5,7,...) of cells
    is included in the list.
 
@@ -75,6 +78,15 @@ namespace hoomd
      - <code>cell_adj[cell_adj_indexer(offset,cidx)]</code> is the cell index for neighboring cell
    \c offset to \c cidx. \c offset can vary from 0 to (radius*2+1)^3-1 (typically 26 with radius 1)
 
+    <b>Compressed storage:</b>
+    When setCompressed(true) is set, the per particle arrays are stored in compressed sparse row
+   form instead of the padded Ncells x Nmax layout. Particles are sorted into cells with a two pass
+   counting sort (parallel when TBB threads are available) and the data for particle \c offset in
+   cell \c cidx is at <code>cell_start[cidx] + offset</code>. Compressed cell lists never overflow,
+   use memory proportional to the number of particles, and order the particles in each cell by
+   index. getCellListIndexer() is empty in this mode and getNmax() reports the largest cell
+   occupancy. Compressed storage is only available on the CPU.
+
     <b>Parameters:</b>
      - \c width - minimum width of a cell in any x,y,z direction
      - \c radius - integer radius of cells to generate in \c cell_adj (1,2,3,4,...)
@@ -149,6 +161,26 @@ class PYBIND11_EXPORT CellList : public Compute
         m_params_changed = true;
         }
 
+    //! Specify if the x, y, z structure of arrays cell lists are to be computed
+    virtual void setComputeSoA(bool compute_soa)
+        {
+        m_compute_soa = compute_soa;
+        m_params_changed = true;
+        }
+
+    //! Specify if the cell list is stored in compressed sparse row form
+    virtual void setCompressed(bool compressed)
+        {
+        m_compressed = compressed;
+        m_params_changed = true;
+        }
+
+    /// Get whether the cell list is stored in compressed sparse row form
+    bool getCompressed() const
+        {
+        return m_compressed;
+        }
+
     //! Specify that the flag is to be filled with the particle charge
     void setFlagCharge()
         {
@@ -337,6 +369,34 @@ class PYBIND11_EXPORT CellList : public Compute
         throw std::runtime_error("Per-device cell index array not available in base class.\n");
         }
 
+    //! Get the offset of the first particle in each cell (compressed storage only)
+    const GlobalArray<unsigned int>& getCellStartArray() const
+        {
+        if (!m_compressed)
+            {
+            throw std::runtime_error("Cell start array is only available in compressed cell lists");
+            }
+        return m_cell_start;
+        }
+
+    //! Get the cell list containing x coordinates
+    const GlobalArray<Scalar>& getXArray() const
+        {
+        return m_x;
+        }
+
+    //! Get the cell list containing y coordinates
+    const GlobalArray<Scalar>& getYArray() const
+        {
+        return m_y;
+        }
+
+    //! Get the cell list containing z coordinates
+    const GlobalArray<Scalar>& getZArray() const
+        {
+        return m_z;
+        }
+
     //! Compute the cell list given the current particle positions
     void compute(uint64_t timestep);
 
@@ -362,6 +422,8 @@ class PYBIND11_EXPORT CellList : public Compute
     bool m_compute_type_body;   //!< true if the TypeBody list should be computed
     bool m_compute_orientation; //!< true if the orientation list should be computed
     bool m_compute_idx;         //!< true if the idx list should be computed
+    bool m_compute_soa;         //!< true if the x, y, z lists should be computed
+    bool m_compressed;          //!< true if the cell list is stored in compressed sparse row form
     bool m_flag_charge;      //!< true if the flag should be set to the charge, it will be index (or
                              //!< type) otherwise
     bool m_flag_type;        //!< true if the flag should be set to type, it will be index otherwise
@@ -380,12 +442,17 @@ class PYBIND11_EXPORT CellList : public Compute
     Scalar3 m_ghost_width;       //!< Width of ghost layer sized for (on one side only)
 
     // values computed by compute()
-    GlobalArray<unsigned int> m_cell_size; //!< Number of members in each cell
-    GlobalArray<unsigned int> m_cell_adj;  //!< Cell adjacency list
-    GlobalArray<Scalar4> m_xyzf;           //!< Cell list with position and flags
-    GlobalArray<uint2> m_type_body;        //!< Cell list with type,body
-    GlobalArray<Scalar4> m_orientation;    //!< Cell list with orientation
-    GlobalArray<unsigned int> m_idx;       //!< Cell list with index
+    GlobalArray<unsigned int> m_cell_size;  //!< Number of members in each cell
+    GlobalArray<unsigned int> m_cell_adj;   //!< Cell adjacency list
+    GlobalArray<Scalar4> m_xyzf;            //!< Cell list with position and flags
+    GlobalArray<uint2> m_type_body;         //!< Cell list with type,body
+    GlobalArray<Scalar4> m_orientation;     //!< Cell list with orientation
+    GlobalArray<unsigned int> m_idx;        //!< Cell list with index
+    GlobalArray<Scalar> m_x;                //!< Cell list with x coordinates
+    GlobalArray<Scalar> m_y;                //!< Cell list with y coordinates
+    GlobalArray<Scalar> m_z;                //!< Cell list with z coordinates
+    GlobalArray<unsigned int> m_cell_start; //!< Offset of each cell in the compressed cell list
+    size_t m_n_slots;                       //!< Number of particle slots allocated in the cell list
     GlobalArray<uint3> m_conditions; //!< Condition flags set during the computeCellList() call
 
     bool m_sort_cell_list;   //!< If true, sort cell list
@@ -411,9 +478,22 @@ class PYBIND11_EXPORT CellList : public Compute
     //! Initializes values in the cell_adj array
     void initializeCellAdj();
 
+    //! Allocate the per particle cell list arrays
+    void allocateCellData(size_t n_slots);
+
     //! Compute the cell list
     virtual void computeCellList();
 
+    //! Compute the cell list in compressed sparse row form
+    void computeCellListCompressed();
+
+    //! Find the cell that a particle belongs in
+    unsigned int getParticleBin(unsigned int n,
+                                const Scalar4& postype,
+                                const BoxDim& box,
+                                uchar3 periodic,
+                                uint3& conditions) const;
+
     //! Check the status of the conditions
     bool checkConditions();
 
@@ -424,6 +504,10 @@ class PYBIND11_EXPORT CellList : public Compute
     virtual void resetConditions();
 
     Nano::Signal<void()> m_width_change; //!< Signal that is triggered when the cell width changes
+
+    std::vector<unsigned int> m_bin;         //!< Cell of each particle (compressed build)
+    /// Per block cell counts and offsets (compressed build)
+    std::vector<unsigned int> m_block_count;
     };
 
 namespace detail
@@ -48,6 +48,21 @@ class PYBIND11_EXPORT CellListGPU : public CellList
         return m_per_device;
         }
 
+    //! Compressed cell lists are not supported on the GPU
+    virtual void setCompressed(bool compressed)
+        {
+        if (compressed)
+            throw std::runtime_error("Compressed cell lists are not supported on the GPU.");
+        }
+
+    //! Structure of arrays cell lists are not supported on the GPU
+    virtual void setComputeSoA(bool compute_soa)
+        {
+        if (compute_soa)
+            throw std::runtime_error(
+                "Structure of arrays cell lists are not supported on the GPU.");
+        }
+
     //! Get the cell list containing index (per device)
     virtual const GlobalArray<unsigned int>& getIndexArrayPerDevice() const
         {
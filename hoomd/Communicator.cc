@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <pybind11/stl.h>
 
 using namespace std;
@@ -1213,6 +1214,8 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
         m_copy_ghosts[dir].swap(copy_ghosts);
         m_num_copy_ghosts[dir] = 0;
         m_num_recv_ghosts[dir] = 0;
+        m_num_copy_local_ghosts[dir] = 0;
+        m_num_recv_local_ghosts[dir] = 0;
         }
 
     // All buffers corresponding to sending ghosts in reverse
@@ -1379,6 +1382,9 @@ Communicator::~Communicator()
         }
 
     MPI_Type_free(&m_mpi_pdata_element);
+
+    if (m_ghost_graph_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_ghost_graph_comm);
     }
 
 void Communicator::updateMeshDefinition()
@@ -1520,6 +1526,10 @@ void Communicator::communicate(uint64_t timestep)
         {
         // do an obligatory update before determining whether to migrate
         beginUpdateGhosts(timestep);
+
+        // compute with local particles while the ghost update is in flight
+        m_ghost_overlap_callbacks.emit(timestep);
+
         finishUpdateGhosts(timestep);
 
         // call subscribers after ghost update, but before distance check
@@ -1916,12 +1926,18 @@ void Communicator::exchangeGhosts()
     // ghost particle flags
     CommFlags flags = getFlags();
 
+    // reverse ghosts are only routed by the staged exchange
+    m_direct_ghosts = m_direct_ghost_exchange && !flags[comm_flag::reverse_net_force];
+    if (m_direct_ghosts)
+        exchangeGhostsDirect(flags, mask);
+
     for (unsigned int dir = 0; dir < 6; dir++)
         {
-        if (!isCommunicating(dir))
+        if (!isCommunicating(dir) || m_direct_ghosts)
             continue;
 
         m_num_copy_ghosts[dir] = 0;
+        m_num_copy_local_ghosts[dir] = 0;
 
         // resize array of ghost particle tags
         unsigned int max_copy_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
@@ -2033,6 +2049,10 @@ void Communicator::exchangeGhosts()
 
                     h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
                     m_num_copy_ghosts[dir]++;
+
+                    // local particles precede the forwarded ghosts in the send list
+                    if (idx < m_pdata->getN())
+                        m_num_copy_local_ghosts[dir]++;
                     }
                 }
             }
@@ -2065,8 +2085,24 @@ void Communicator::exchangeGhosts()
                   m_mpi_comm,
                   &req);
         m_reqs.push_back(req);
+        MPI_Isend(&m_num_copy_local_ghosts[dir],
+                  sizeof(unsigned int),
+                  MPI_BYTE,
+                  send_neighbor,
+                  1,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+        MPI_Irecv(&m_num_recv_local_ghosts[dir],
+                  sizeof(unsigned int),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  1,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
 
-        m_stats.resize(2);
+        m_stats.resize(m_reqs.size());
         MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
         // append ghosts at the end of particle data array
@@ -2633,6 +2669,18 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
     // to send to neighboring processors
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
+    if (m_direct_ghosts)
+        {
+        beginUpdateGhostsDirect(timestep);
+        return;
+        }
+
+    if (!m_ghost_overlap_callbacks.empty())
+        {
+        beginUpdateGhostsSplit(timestep);
+        return;
+        }
+
     // update data in these arrays
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
@@ -2853,6 +2901,854 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         } // end dir loop
     }
 
+void Communicator::finishUpdateGhosts(uint64_t timestep)
+    {
+    if (m_comm_pending)
+        {
+        if (m_direct_ghosts)
+            finishUpdateGhostsDirect(timestep);
+        else
+            finishUpdateGhostsSplit(timestep);
+        }
+
+    m_comm_pending = false;
+    }
+
+/*! Ghosts that are local particles on the sending processor are at the front of every send list,
+    and their positions are current before any ghost data arrives. These are posted for all
+    directions at once, so the ghost overlap callbacks run while they are in flight. Ghosts that
+    are forwarded from one neighbor to the next are sent in finishUpdateGhostsSplit().
+*/
+void Communicator::beginUpdateGhostsSplit(uint64_t timestep)
+    {
+    CommFlags flags = getFlags();
+    const unsigned int n_fields = (flags[comm_flag::position] ? 1 : 0)
+                                  + (flags[comm_flag::velocity] ? 1 : 0)
+                                  + (flags[comm_flag::orientation] ? 1 : 0);
+    if (n_fields == 0)
+        return;
+
+    size_t n_send = 0;
+    size_t n_recv = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        n_send += m_num_copy_local_ghosts[dir];
+        n_recv += m_num_recv_local_ghosts[dir];
+        }
+
+    m_ghost_update_sendbuf.resize(n_send * n_fields);
+    m_ghost_update_recvbuf.resize(n_recv * n_fields);
+
+    m_reqs.clear();
+    size_t send_offset = 0;
+    size_t recv_offset = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        Scalar4* sendbuf = m_ghost_update_sendbuf.data() + send_offset;
+            {
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                    access_location::host,
+                                                    access_mode::read);
+            packGhostUpdate(sendbuf, h_copy_ghosts.data, m_num_copy_local_ghosts[dir]);
+            }
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+        MPI_Request req;
+        MPI_Isend(sendbuf,
+                  int(m_num_copy_local_ghosts[dir] * n_fields * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  send_neighbor,
+                  10 + dir,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+        MPI_Irecv(m_ghost_update_recvbuf.data() + recv_offset,
+                  int(m_num_recv_local_ghosts[dir] * n_fields * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  10 + dir,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+
+        send_offset += size_t(m_num_copy_local_ghosts[dir]) * n_fields;
+        recv_offset += size_t(m_num_recv_local_ghosts[dir]) * n_fields;
+        }
+
+    m_comm_pending = true;
+    }
+
+/*! Ghosts of ghosts can only be sent once the ghost they copy has been received, so the forwarded
+    part of every send list is exchanged one direction at a time, in the same order in which
+    exchangeGhosts() built the lists.
+*/
+void Communicator::finishUpdateGhostsSplit(uint64_t timestep)
+    {
+    CommFlags flags = getFlags();
+    const unsigned int n_fields = (flags[comm_flag::position] ? 1 : 0)
+                                  + (flags[comm_flag::velocity] ? 1 : 0)
+                                  + (flags[comm_flag::orientation] ? 1 : 0);
+
+    if (!m_reqs.empty())
+        {
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+        }
+
+    // place the ghosts that are local particles on the sending processor
+    unsigned int start_idx[6];
+    unsigned int num_tot_recv_ghosts = 0;
+    size_t recv_offset = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        start_idx[dir] = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+        unpackGhostUpdate(m_ghost_update_recvbuf.data() + recv_offset,
+                          m_num_recv_local_ghosts[dir],
+                          start_idx[dir]);
+        recv_offset += size_t(m_num_recv_local_ghosts[dir]) * n_fields;
+        }
+
+    // forward the remaining ghosts
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        unsigned int n_send = m_num_copy_ghosts[dir] - m_num_copy_local_ghosts[dir];
+        unsigned int n_recv = m_num_recv_ghosts[dir] - m_num_recv_local_ghosts[dir];
+        if (n_send == 0 && n_recv == 0)
+            continue;
+
+        m_ghost_update_sendbuf.resize(size_t(n_send) * n_fields);
+        m_ghost_update_recvbuf.resize(size_t(n_recv) * n_fields);
+            {
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                    access_location::host,
+                                                    access_mode::read);
+            packGhostUpdate(m_ghost_update_sendbuf.data(),
+                            h_copy_ghosts.data + m_num_copy_local_ghosts[dir],
+                            n_send);
+            }
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+        m_reqs.clear();
+        MPI_Request req;
+        if (n_send > 0)
+            {
+            MPI_Isend(m_ghost_update_sendbuf.data(),
+                      int(n_send * n_fields * sizeof(Scalar4)),
+                      MPI_BYTE,
+                      send_neighbor,
+                      20 + dir,
+                      m_mpi_comm,
+                      &req);
+            m_reqs.push_back(req);
+            }
+        if (n_recv > 0)
+            {
+            MPI_Irecv(m_ghost_update_recvbuf.data(),
+                      int(n_recv * n_fields * sizeof(Scalar4)),
+                      MPI_BYTE,
+                      recv_neighbor,
+                      20 + dir,
+                      m_mpi_comm,
+                      &req);
+            m_reqs.push_back(req);
+            }
+
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+        unpackGhostUpdate(m_ghost_update_recvbuf.data(),
+                          n_recv,
+                          start_idx[dir] + m_num_recv_local_ghosts[dir]);
+        }
+    }
+
+/*! \param buf Output buffer, holding \a n entries of every communicated field one after another
+    \param tags Tags of the ghosts to copy
+    \param n Number of entries to copy
+*/
+void Communicator::packGhostUpdate(Scalar4* buf, const unsigned int* tags, unsigned int n)
+    {
+    CommFlags flags = getFlags();
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    unsigned int field = 0;
+    auto pack_field = [&](const GlobalArray<Scalar4>& array)
+    {
+        ArrayHandle<Scalar4> h_data(array, access_location::host, access_mode::read);
+        Scalar4* field_buf = buf + size_t(field) * n;
+        for (unsigned int ghost_idx = 0; ghost_idx < n; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[tags[ghost_idx]];
+
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+            field_buf[ghost_idx] = h_data.data[idx];
+            }
+        field++;
+    };
+
+    if (flags[comm_flag::position])
+        pack_field(m_pdata->getPositions());
+    if (flags[comm_flag::velocity])
+        pack_field(m_pdata->getVelocities());
+    if (flags[comm_flag::orientation])
+        pack_field(m_pdata->getOrientationArray());
+    }
+
+/*! \param buf Input buffer, laid out as in packGhostUpdate()
+    \param n Number of ghosts in \a buf
+    \param first_idx Particle index of the first ghost
+*/
+void Communicator::unpackGhostUpdate(const Scalar4* buf, unsigned int n, unsigned int first_idx)
+    {
+    CommFlags flags = getFlags();
+    assert(first_idx + n <= m_pdata->getN() + m_pdata->getNGhosts());
+
+    unsigned int field = 0;
+    if (flags[comm_flag::position])
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+        for (unsigned int ghost_idx = 0; ghost_idx < n; ghost_idx++)
+            {
+            Scalar4 pos = buf[ghost_idx];
+
+            // wrap particles received across a global boundary
+            int3 img = make_int3(0, 0, 0);
+            shifted_box.wrap(pos, img);
+            h_pos.data[first_idx + ghost_idx] = pos;
+            }
+        field++;
+        }
+
+    if (flags[comm_flag::velocity])
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        const Scalar4* field_buf = buf + size_t(field) * n;
+        std::copy(field_buf, field_buf + n, h_vel.data + first_idx);
+        field++;
+        }
+
+    if (flags[comm_flag::orientation])
+        {
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        const Scalar4* field_buf = buf + size_t(field) * n;
+        std::copy(field_buf, field_buf + n, h_orientation.data + first_idx);
+        }
+    }
+
+/*! Every combination of the face flags in a particle's plan names one of the up to 26 neighbors
+    that the particle is copied to, so the send lists to all neighbors are known before any ghost
+    is received and no ghost needs to be forwarded. A neighbor that lies in several directions
+    (when a dimension has only two domains) receives the ghosts of all of them in one message.
+
+    \param flags Ghost fields to exchange
+    \param mask Plan flags of the directions that are communicating
+*/
+void Communicator::exchangeGhostsDirect(const CommFlags& flags, unsigned int mask)
+    {
+    if (!m_ghost_graph_initialized)
+        initializeGhostGraph();
+
+    const unsigned int n_neigh = (unsigned int)m_direct_neighbors.size();
+
+    // call f(neighbor) for every neighbor that a particle with the given plan is copied to
+    auto for_each_target = [this](unsigned int plan, auto&& f)
+    {
+        for (int iz = -1; iz <= 1; iz++)
+            {
+            if ((iz == 1 && !(plan & send_up)) || (iz == -1 && !(plan & send_down)))
+                continue;
+
+            for (int iy = -1; iy <= 1; iy++)
+                {
+                if ((iy == 1 && !(plan & send_north)) || (iy == -1 && !(plan & send_south)))
+                    continue;
+
+                for (int ix = -1; ix <= 1; ix++)
+                    {
+                    if ((ix == 1 && !(plan & send_east)) || (ix == -1 && !(plan & send_west)))
+                        continue;
+
+                    // exclude ourselves
+                    if (!ix && !iy && !iz)
+                        continue;
+
+                    unsigned int dir = ((iz + 1) * 3 + (iy + 1)) * 3 + (ix + 1);
+                    assert(m_direct_neighbor_slot[dir] < m_direct_neighbors.size());
+                    f(m_direct_neighbor_slot[dir]);
+                    }
+                }
+            }
+    };
+
+    // the plan and tag are always sent, followed by the fields requested by the flags
+    size_t record_size = 2 * sizeof(unsigned int);
+    if (flags[comm_flag::position])
+        record_size += sizeof(Scalar4);
+    if (flags[comm_flag::charge])
+        record_size += sizeof(Scalar);
+    if (flags[comm_flag::diameter])
+        record_size += sizeof(Scalar);
+    if (flags[comm_flag::body])
+        record_size += sizeof(unsigned int);
+    if (flags[comm_flag::image])
+        record_size += sizeof(int3);
+    if (flags[comm_flag::velocity])
+        record_size += sizeof(Scalar4);
+    if (flags[comm_flag::orientation])
+        record_size += sizeof(Scalar4);
+
+    // count the ghosts sent to every neighbor
+    m_direct_send_counts.assign(n_neigh, 0);
+
+        {
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+            for_each_target(h_plan.data[idx] & mask,
+                            [&](unsigned int neigh) { m_direct_send_counts[neigh]++; });
+        }
+
+    std::vector<unsigned int> send_offset(n_neigh);
+    unsigned int n_send = 0;
+    for (unsigned int i = 0; i < n_neigh; i++)
+        {
+        send_offset[i] = n_send;
+        n_send += m_direct_send_counts[i];
+        }
+
+    m_direct_copy_ghosts.resize(n_send);
+    m_direct_sendbuf.resize(n_send * record_size);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+            {
+            unsigned int plan = h_plan.data[idx];
+
+            for_each_target(
+                plan & mask,
+                [&](unsigned int neigh)
+                {
+                    unsigned int k = send_offset[neigh]++;
+                    m_direct_copy_ghosts[k] = h_tag.data[idx];
+
+                    char* p = m_direct_sendbuf.data() + k * record_size;
+                    auto pack = [&p](const auto& value)
+                    {
+                        std::memcpy(p, &value, sizeof(value));
+                        p += sizeof(value);
+                    };
+
+                    pack(plan);
+                    pack(h_tag.data[idx]);
+                    if (flags[comm_flag::position])
+                        pack(h_pos.data[idx]);
+                    if (flags[comm_flag::charge])
+                        pack(h_charge.data[idx]);
+                    if (flags[comm_flag::diameter])
+                        pack(h_diameter.data[idx]);
+                    if (flags[comm_flag::body])
+                        pack(h_body.data[idx]);
+                    if (flags[comm_flag::image])
+                        pack(h_image.data[idx]);
+                    if (flags[comm_flag::velocity])
+                        pack(h_vel.data[idx]);
+                    if (flags[comm_flag::orientation])
+                        pack(h_orientation.data[idx]);
+                });
+            }
+        }
+
+    // exchange the number of ghosts
+    std::vector<unsigned int> one_per_neighbor(n_neigh, 1);
+    m_direct_recv_counts.resize(n_neigh);
+
+    m_reqs.clear();
+    beginDirectExchange(m_direct_send_counts.data(),
+                        one_per_neighbor,
+                        m_direct_recv_counts.data(),
+                        one_per_neighbor,
+                        sizeof(unsigned int));
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+    unsigned int n_recv = 0;
+    for (unsigned int i = 0; i < n_neigh; i++)
+        n_recv += m_direct_recv_counts[i];
+
+    // exchange the ghosts
+    m_direct_recvbuf.resize(n_recv * record_size);
+
+    m_reqs.clear();
+    beginDirectExchange(m_direct_sendbuf.data(),
+                        m_direct_send_counts,
+                        m_direct_recvbuf.data(),
+                        m_direct_recv_counts,
+                        record_size);
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+    // append ghosts at the end of particle data array
+    unsigned int start_idx = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // accommodate new ghost particles
+    m_pdata->addGhostParticles(n_recv);
+
+    // resize plan array
+    m_plan.resize(m_pdata->getN() + m_pdata->getNGhosts());
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
+
+        const BoxDim shifted_box = getShiftedBox();
+
+        for (unsigned int i = 0; i < n_recv; i++)
+            {
+            unsigned int idx = start_idx + i;
+
+            const char* p = m_direct_recvbuf.data() + size_t(i) * record_size;
+            auto unpack = [&p](auto& value)
+            {
+                std::memcpy(&value, p, sizeof(value));
+                p += sizeof(value);
+            };
+
+            unpack(h_plan.data[idx]);
+            unpack(h_tag.data[idx]);
+            if (flags[comm_flag::position])
+                unpack(h_pos.data[idx]);
+            if (flags[comm_flag::charge])
+                unpack(h_charge.data[idx]);
+            if (flags[comm_flag::diameter])
+                unpack(h_diameter.data[idx]);
+            if (flags[comm_flag::body])
+                unpack(h_body.data[idx]);
+            if (flags[comm_flag::image])
+                unpack(h_image.data[idx]);
+            if (flags[comm_flag::velocity])
+                unpack(h_vel.data[idx]);
+            if (flags[comm_flag::orientation])
+                unpack(h_orientation.data[idx]);
+
+            // wrap particles received across a global boundary
+            if (flags[comm_flag::position])
+                shifted_box.wrap(h_pos.data[idx], h_image.data[idx]);
+
+            // set reverse-lookup tag -> idx
+            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+            assert(h_rtag.data[h_tag.data[idx]] == NOT_LOCAL);
+            h_rtag.data[h_tag.data[idx]] = idx;
+            }
+        }
+    }
+
+/*! The unique neighbors are the distinct ranks among the up to 26 domains adjacent to this one.
+    They are connected by a distributed graph communicator so that every direct exchange is a
+    single neighborhood collective.
+*/
+void Communicator::initializeGhostGraph()
+    {
+    Index3D di = m_decomposition->getDomainIndexer();
+    uint3 mypos = m_decomposition->getGridPos();
+
+    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                           access_location::host,
+                                           access_mode::read);
+
+    m_direct_neighbors.clear();
+    std::fill(m_direct_neighbor_slot, m_direct_neighbor_slot + 27, 0xffffffff);
+
+    for (int ix = -1; ix <= 1; ix++)
+        {
+        // only if communicating along x-direction
+        if (ix && di.getW() == 1)
+            continue;
+
+        unsigned int i = ((int)mypos.x + ix + (int)di.getW()) % di.getW();
+
+        for (int iy = -1; iy <= 1; iy++)
+            {
+            // only if communicating along y-direction
+            if (iy && di.getH() == 1)
+                continue;
+
+            unsigned int j = ((int)mypos.y + iy + (int)di.getH()) % di.getH();
+
+            for (int iz = -1; iz <= 1; iz++)
+                {
+                // only if communicating along z-direction
+                if (iz && di.getD() == 1)
+                    continue;
+
+                // exclude ourselves
+                if (!ix && !iy && !iz)
+                    continue;
+
+                unsigned int k = ((int)mypos.z + iz + (int)di.getD()) % di.getD();
+
+                unsigned int neighbor = h_cart_ranks.data[di(i, j, k)];
+                auto it = std::find(m_direct_neighbors.begin(), m_direct_neighbors.end(), neighbor);
+                unsigned int slot = (unsigned int)(it - m_direct_neighbors.begin());
+                if (it == m_direct_neighbors.end())
+                    m_direct_neighbors.push_back(neighbor);
+
+                unsigned int dir = ((iz + 1) * 3 + (iy + 1)) * 3 + (ix + 1);
+                m_direct_neighbor_slot[dir] = slot;
+                }
+            }
+        }
+
+#if MPI_VERSION >= 3
+    // the neighbor relation is symmetric, so every rank sends to and receives from the same ranks
+    std::vector<int> ranks(m_direct_neighbors.begin(), m_direct_neighbors.end());
+    MPI_Dist_graph_create_adjacent(m_mpi_comm,
+                                   (int)ranks.size(),
+                                   ranks.data(),
+                                   MPI_UNWEIGHTED,
+                                   (int)ranks.size(),
+                                   ranks.data(),
+                                   MPI_UNWEIGHTED,
+                                   MPI_INFO_NULL,
+                                   0,
+                                   &m_ghost_graph_comm);
+#endif
+
+    m_ghost_graph_initialized = true;
+    }
+
+/*! \param sendbuf Records sent, grouped by neighbor in the order of m_direct_neighbors
+    \param send_counts Number of records sent to every neighbor
+    \param recvbuf Buffer for the received records, grouped the same way
+    \param recv_counts Number of records received from every neighbor
+    \param record_size Size of one record in bytes
+
+    The requests are appended to m_reqs. The buffers must not be touched until they complete.
+    MPI implementations without neighborhood collectives use point to point messages instead.
+*/
+void Communicator::beginDirectExchange(const void* sendbuf,
+                                       const std::vector<unsigned int>& send_counts,
+                                       void* recvbuf,
+                                       const std::vector<unsigned int>& recv_counts,
+                                       size_t record_size)
+    {
+    const unsigned int n_neigh = (unsigned int)m_direct_neighbors.size();
+
+    m_direct_send_bytes.resize(n_neigh);
+    m_direct_send_displs.resize(n_neigh);
+    m_direct_recv_bytes.resize(n_neigh);
+    m_direct_recv_displs.resize(n_neigh);
+
+    int send_offset = 0;
+    int recv_offset = 0;
+    for (unsigned int i = 0; i < n_neigh; i++)
+        {
+        m_direct_send_bytes[i] = int(send_counts[i] * record_size);
+        m_direct_send_displs[i] = send_offset;
+        send_offset += m_direct_send_bytes[i];
+
+        m_direct_recv_bytes[i] = int(recv_counts[i] * record_size);
+        m_direct_recv_displs[i] = recv_offset;
+        recv_offset += m_direct_recv_bytes[i];
+        }
+
+    MPI_Request req;
+#if MPI_VERSION >= 3
+    MPI_Ineighbor_alltoallv(sendbuf,
+                            m_direct_send_bytes.data(),
+                            m_direct_send_displs.data(),
+                            MPI_BYTE,
+                            recvbuf,
+                            m_direct_recv_bytes.data(),
+                            m_direct_recv_displs.data(),
+                            MPI_BYTE,
+                            m_ghost_graph_comm,
+                            &req);
+    m_reqs.push_back(req);
+#else
+    for (unsigned int i = 0; i < n_neigh; i++)
+        {
+        MPI_Isend(static_cast<char*>(const_cast<void*>(sendbuf)) + m_direct_send_displs[i],
+                  m_direct_send_bytes[i],
+                  MPI_BYTE,
+                  m_direct_neighbors[i],
+                  30,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+        MPI_Irecv(static_cast<char*>(recvbuf) + m_direct_recv_displs[i],
+                  m_direct_recv_bytes[i],
+                  MPI_BYTE,
+                  m_direct_neighbors[i],
+                  30,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+        }
+#endif
+    }
+
+/*! All ghosts are local particles on the sending processor, so the complete update is posted at
+    once and the ghost overlap callbacks run while it is in flight.
+*/
+void Communicator::beginUpdateGhostsDirect(uint64_t timestep)
+    {
+    CommFlags flags = getFlags();
+    const unsigned int n_fields = (flags[comm_flag::position] ? 1 : 0)
+                                  + (flags[comm_flag::velocity] ? 1 : 0)
+                                  + (flags[comm_flag::orientation] ? 1 : 0);
+    if (n_fields == 0)
+        return;
+
+    const unsigned int n_neigh = (unsigned int)m_direct_neighbors.size();
+
+    size_t n_recv = 0;
+    for (unsigned int i = 0; i < n_neigh; i++)
+        n_recv += m_direct_recv_counts[i];
+
+    m_ghost_update_sendbuf.resize(m_direct_copy_ghosts.size() * n_fields);
+    m_ghost_update_recvbuf.resize(n_recv * n_fields);
+
+    // the part of every neighbor holds its ghosts' fields one after another
+    size_t offset = 0;
+    for (unsigned int i = 0; i < n_neigh; i++)
+        {
+        packGhostUpdate(m_ghost_update_sendbuf.data() + offset * n_fields,
+                        m_direct_copy_ghosts.data() + offset,
+                        m_direct_send_counts[i]);
+        offset += m_direct_send_counts[i];
+        }
+
+    m_reqs.clear();
+    beginDirectExchange(m_ghost_update_sendbuf.data(),
+                        m_direct_send_counts,
+                        m_ghost_update_recvbuf.data(),
+                        m_direct_recv_counts,
+                        n_fields * sizeof(Scalar4));
+
+    m_comm_pending = true;
+    }
+
+void Communicator::finishUpdateGhostsDirect(uint64_t timestep)
+    {
+    CommFlags flags = getFlags();
+    const unsigned int n_fields = (flags[comm_flag::position] ? 1 : 0)
+                                  + (flags[comm_flag::velocity] ? 1 : 0)
+                                  + (flags[comm_flag::orientation] ? 1 : 0);
+
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+    // ghosts are stored in the order of the neighbors they were received from
+    size_t offset = 0;
+    for (unsigned int i = 0; i < m_direct_neighbors.size(); i++)
+        {
+        unpackGhostUpdate(m_ghost_update_recvbuf.data() + offset * n_fields,
+                          m_direct_recv_counts[i],
+                          m_pdata->getN() + (unsigned int)offset);
+        offset += m_direct_recv_counts[i];
+        }
+    }
+
+/*! \param flags Ghost communication flags
+ */
+void Communicator::updateNetForceDirect(const CommFlags& flags)
+    {
+    // number of values sent per ghost
+    const unsigned int n_values = (flags[comm_flag::net_force] ? 4 : 0)
+                                  + (flags[comm_flag::net_torque] ? 4 : 0)
+                                  + (flags[comm_flag::net_virial] ? 6 : 0);
+    if (n_values == 0)
+        return;
+
+    const unsigned int n_send = (unsigned int)m_direct_copy_ghosts.size();
+    unsigned int n_recv = 0;
+    for (unsigned int i = 0; i < m_direct_neighbors.size(); i++)
+        n_recv += m_direct_recv_counts[i];
+
+    m_direct_netforce_sendbuf.resize(size_t(n_send) * n_values);
+    m_direct_netforce_recvbuf.resize(size_t(n_recv) * n_values);
+
+        {
+        ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> h_nettorque(m_pdata->getNetTorqueArray(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar> h_netvirial(m_pdata->getNetVirial(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+
+        size_t pitch = m_pdata->getNetVirial().getPitch();
+
+        for (unsigned int ghost_idx = 0; ghost_idx < n_send; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[m_direct_copy_ghosts[ghost_idx]];
+
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+            Scalar* p = m_direct_netforce_sendbuf.data() + size_t(ghost_idx) * n_values;
+            if (flags[comm_flag::net_force])
+                {
+                Scalar4 f = h_netforce.data[idx];
+                *p++ = f.x;
+                *p++ = f.y;
+                *p++ = f.z;
+                *p++ = f.w;
+                }
+            if (flags[comm_flag::net_torque])
+                {
+                Scalar4 t = h_nettorque.data[idx];
+                *p++ = t.x;
+                *p++ = t.y;
+                *p++ = t.z;
+                *p++ = t.w;
+                }
+            if (flags[comm_flag::net_virial])
+                {
+                for (unsigned int j = 0; j < 6; j++)
+                    *p++ = h_netvirial.data[j * pitch + idx];
+                }
+            }
+        }
+
+    m_reqs.clear();
+    beginDirectExchange(m_direct_netforce_sendbuf.data(),
+                        m_direct_send_counts,
+                        m_direct_netforce_recvbuf.data(),
+                        m_direct_recv_counts,
+                        n_values * sizeof(Scalar));
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+    ArrayHandle<Scalar4> h_nettorque(m_pdata->getNetTorqueArray(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+    ArrayHandle<Scalar> h_netvirial(m_pdata->getNetVirial(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+
+    size_t pitch = m_pdata->getNetVirial().getPitch();
+
+    for (unsigned int i = 0; i < n_recv; i++)
+        {
+        unsigned int idx = m_pdata->getN() + i;
+
+        const Scalar* p = m_direct_netforce_recvbuf.data() + size_t(i) * n_values;
+        if (flags[comm_flag::net_force])
+            {
+            h_netforce.data[idx] = make_scalar4(p[0], p[1], p[2], p[3]);
+            p += 4;
+            }
+        if (flags[comm_flag::net_torque])
+            {
+            h_nettorque.data[idx] = make_scalar4(p[0], p[1], p[2], p[3]);
+            p += 4;
+            }
+        if (flags[comm_flag::net_virial])
+            {
+            for (unsigned int j = 0; j < 6; j++)
+                h_netvirial.data[j * pitch + idx] = p[j];
+            }
+        }
+    }
+
 void Communicator::updateNetForce(uint64_t timestep)
     {
     CommFlags flags = getFlags();
@@ -2883,6 +3779,12 @@ void Communicator::updateNetForce(uint64_t timestep)
 
     m_exec_conf->msg->notice(7) << oss.str() << std::endl;
 
+    if (m_direct_ghosts && !flags[comm_flag::reverse_net_force])
+        {
+        updateNetForceDirect(flags);
+        return;
+        }
+
     // Set some global counters
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
     unsigned int num_tot_recv_ghosts_reverse
@@ -3280,6 +4182,93 @@ void Communicator::updateNetForce(uint64_t timestep)
         } // end dir loop
     }
 
+/*! \param data Array with one value per local and ghost particle
+ */
+void Communicator::updateGhostScalar(Scalar* data)
+    {
+    m_exec_conf->msg->notice(7) << "Communicator: update ghost scalar" << std::endl;
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    if (m_direct_ghosts)
+        {
+        const unsigned int n_send = (unsigned int)m_direct_copy_ghosts.size();
+        m_ghost_scalar_sendbuf.resize(n_send);
+        for (unsigned int ghost_idx = 0; ghost_idx < n_send; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[m_direct_copy_ghosts[ghost_idx]];
+
+            assert(idx < m_pdata->getN());
+
+            m_ghost_scalar_sendbuf[ghost_idx] = data[idx];
+            }
+
+        // the ghosts are stored in the order they were received from the neighbors
+        m_reqs.clear();
+        beginDirectExchange(m_ghost_scalar_sendbuf.data(),
+                            m_direct_send_counts,
+                            data + m_pdata->getN(),
+                            m_direct_recv_counts,
+                            sizeof(Scalar));
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+        return;
+        }
+
+    unsigned int start_idx = m_pdata->getN();
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        // ghosts received in earlier directions are forwarded with their updated values
+            {
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                    access_location::host,
+                                                    access_mode::read);
+
+            m_ghost_scalar_sendbuf.resize(m_num_copy_ghosts[dir]);
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                m_ghost_scalar_sendbuf[ghost_idx] = data[idx];
+                }
+            }
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+        m_reqs.resize(2);
+        m_stats.resize(2);
+        MPI_Isend(m_ghost_scalar_sendbuf.data(),
+                  (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar)),
+                  MPI_BYTE,
+                  send_neighbor,
+                  10,
+                  m_mpi_comm,
+                  &m_reqs[0]);
+        MPI_Irecv(data + start_idx,
+                  (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar)),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  10,
+                  m_mpi_comm,
+                  &m_reqs[1]);
+        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+
+        start_idx += m_num_recv_ghosts[dir];
+        }
+    }
+
 void Communicator::removeGhostParticleTags()
     {
     // wipe out reverse-lookup tag -> idx for old ghost atoms
@@ -3409,6 +4398,9 @@ void export_Communicator(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>,
                             std::shared_ptr<DomainDecomposition>>())
         .def("addMeshDefinition", &Communicator::addMeshDefinition)
+        .def_property("direct_ghost_exchange",
+                      &Communicator::getDirectGhostExchange,
+                      &Communicator::setDirectGhostExchange)
         .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition);
     }
     } // end namespace detail
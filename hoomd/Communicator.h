@@ -231,6 +231,21 @@ class PYBIND11_EXPORT Communicator
         return m_compute_callbacks;
         }
 
+    //! Subscribe to list of call-backs that overlap computation with the ghost update
+    /*!
+     * When the list is not empty, the ghost update of every time step is split into phases. The
+     * positions of ghosts that neighbors own locally are sent with non-blocking messages, the
+     * call-backs are called while these messages are in flight, and the remaining ghost data is
+     * received after the call-backs return. Subscribers may only access local particle data,
+     * because ghost positions are not current until the update has finished.
+     *
+     * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+     */
+    Nano::Signal<void(uint64_t timestep)>& getGhostOverlapCallbackSignal()
+        {
+        return m_ghost_overlap_callbacks;
+        }
+
     //! Get the ghost communication flags
     CommFlags getFlags()
         {
@@ -303,6 +318,46 @@ class PYBIND11_EXPORT Communicator
             m_force_migrate = true;
         }
 
+    //! Add wall clock time (in seconds) that this rank spent on local work
+    /*! Integrator records the time it spends computing forces so that LoadBalancer can balance
+        the measured cost of the domains instead of their particle counts.
+    */
+    void addLocalWorkTime(double t)
+        {
+        m_local_work_time += t;
+        }
+
+    //! Get the wall clock time (in seconds) spent on local work since the last reset
+    double getLocalWorkTime() const
+        {
+        return m_local_work_time;
+        }
+
+    //! Reset the local work time
+    void resetLocalWorkTime()
+        {
+        m_local_work_time = 0.0;
+        }
+
+    //! Set whether ghosts are sent directly to all neighbors in a single round
+    /*! When enabled, exchangeGhosts() builds one send list per neighboring rank (up to 26 of them)
+        instead of forwarding edge and corner ghosts through up to three face exchanges. Ghost
+        exchange, ghost updates, and net force updates then each take a single communication round.
+        The setting takes effect at the next ghost exchange. Direct exchange is not used when the
+        reverse net force is requested.
+    */
+    void setDirectGhostExchange(bool direct)
+        {
+        m_direct_ghost_exchange = direct;
+        forceMigrate();
+        }
+
+    //! Get whether ghosts are sent directly to all neighbors in a single round
+    bool getDirectGhostExchange() const
+        {
+        return m_direct_ghost_exchange;
+        }
+
     /*! Exchange positions of ghost particles
      * Using the previously constructed ghost exchange lists, ghost positions are updated on the
      * neighboring processors.
@@ -322,17 +377,26 @@ class PYBIND11_EXPORT Communicator
      *
      * \param timestep The time step
      */
-    virtual void finishUpdateGhosts(uint64_t timestep)
-        {
-        // the base class implementation is currently empty
-        m_comm_pending = false;
-        }
+    virtual void finishUpdateGhosts(uint64_t timestep);
 
     /*! Communicate the net particle force
      * \parm timestep The time step
      */
     virtual void updateNetForce(uint64_t timestep);
 
+    /*! Copy a per-particle value of the local particles to their ghost copies on the
+     * neighboring processors
+     *
+     * Forces with many-body terms call this in the middle of computeForces() so that the ghost
+     * entries of an intermediate per-particle quantity (such as the embedding function derivative
+     * of EAM) hold the values computed by the owning processors. The ghost lists of the last
+     * exchangeGhosts() are used, so the ghosts are in the same order as in the particle data.
+     * This call is blocking and only supported by the CPU communicator.
+     *
+     * \param data Host array with getN() + getNGhosts() values, the ghost entries are overwritten
+     */
+    virtual void updateGhostScalar(Scalar* data);
+
     /*! This methods finds all the particles that are no longer inside the domain
      * boundaries and transfers them to neighboring processors.
      *
@@ -474,8 +538,9 @@ class PYBIND11_EXPORT Communicator
     const MPI_Comm m_mpi_comm;                                 //!< MPI communicator
     std::shared_ptr<DomainDecomposition> m_decomposition;      //!< Domain decomposition information
 
-    bool m_is_communicating; //!< Whether we are currently communicating
-    bool m_force_migrate;    //!< True if particle migration is forced
+    bool m_is_communicating;        //!< Whether we are currently communicating
+    bool m_force_migrate;           //!< True if particle migration is forced
+    double m_local_work_time = 0.0; //!< Local work time recorded since the last reset
 
     unsigned int m_is_at_boundary[6]; //!< Array of flags indicating whether this box lies at a
                                       //!< global boundary
@@ -507,6 +572,9 @@ class PYBIND11_EXPORT Communicator
     unsigned int
         m_num_copy_ghosts[6]; //!< Number of local particles that are sent to neighboring processors
     unsigned int m_num_recv_ghosts[6]; //!< Number of ghosts received per direction
+    unsigned int m_num_copy_local_ghosts[6]; //!< Number of sent ghosts that are local particles
+    unsigned int m_num_recv_local_ghosts[6]; //!< Number of received ghosts that are local on the
+                                             //!< sending processor
 
     GlobalVector<unsigned int>
         m_plan; //!< Array of per-direction flags that determine the sending route
@@ -585,6 +653,9 @@ class PYBIND11_EXPORT Communicator
     Nano::Signal<void(const GlobalArray<unsigned int>&)>
         m_comm_callbacks; //!< List of functions that are called after the compute callbacks
 
+    /// List of functions that are called while the ghost update is in flight
+    Nano::Signal<void(uint64_t timestep)> m_ghost_overlap_callbacks;
+
     CommFlags m_flags;      //!< The ghost communication flags
     CommFlags m_last_flags; //!< Flags of last ghost exchange
 
@@ -592,6 +663,65 @@ class PYBIND11_EXPORT Communicator
     std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
     std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
 
+    std::vector<Scalar4> m_ghost_update_sendbuf; //!< Send buffer of the split ghost update
+    std::vector<Scalar4> m_ghost_update_recvbuf; //!< Receive buffer of the split ghost update
+    std::vector<Scalar> m_ghost_scalar_sendbuf;  //!< Send buffer of updateGhostScalar()
+
+    //! Post the non-blocking exchange of ghosts that are local on the sending processor
+    void beginUpdateGhostsSplit(uint64_t timestep);
+
+    //! Complete the split ghost update and forward the remaining ghosts direction by direction
+    void finishUpdateGhostsSplit(uint64_t timestep);
+
+    //! Copy the fields of a list of ghosts into a ghost update buffer
+    void packGhostUpdate(Scalar4* buf, const unsigned int* tags, unsigned int n);
+
+    //! Copy the fields of a range of received ghosts out of a ghost update buffer
+    void unpackGhostUpdate(const Scalar4* buf, unsigned int n, unsigned int first_idx);
+
+    /* Direct ghost exchange */
+    bool m_direct_ghost_exchange = false;   //!< True if ghosts should be sent directly
+    bool m_direct_ghosts = false;           //!< True if the current ghosts were sent directly
+    bool m_ghost_graph_initialized = false; //!< True if the neighbor graph has been set up
+    MPI_Comm m_ghost_graph_comm = MPI_COMM_NULL; //!< Distributed graph of the unique neighbors
+
+    std::vector<unsigned int> m_direct_neighbors;   //!< Ranks of the unique neighbors
+    unsigned int m_direct_neighbor_slot[27];        //!< Unique neighbor of every 3x3x3 direction
+    std::vector<unsigned int> m_direct_copy_ghosts; //!< Tags of sent ghosts, grouped by neighbor
+    std::vector<unsigned int> m_direct_send_counts; //!< Number of ghosts sent to every neighbor
+    std::vector<unsigned int> m_direct_recv_counts; //!< Number of ghosts received per neighbor
+
+    std::vector<int> m_direct_send_bytes;  //!< Send sizes of the pending direct exchange
+    std::vector<int> m_direct_send_displs; //!< Send offsets of the pending direct exchange
+    std::vector<int> m_direct_recv_bytes;  //!< Receive sizes of the pending direct exchange
+    std::vector<int> m_direct_recv_displs; //!< Receive offsets of the pending direct exchange
+    std::vector<char> m_direct_sendbuf;    //!< Send buffer of the direct ghost exchange
+    std::vector<char> m_direct_recvbuf;    //!< Receive buffer of the direct ghost exchange
+    std::vector<Scalar> m_direct_netforce_sendbuf; //!< Send buffer of the net force update
+    std::vector<Scalar> m_direct_netforce_recvbuf; //!< Receive buffer of the net force update
+
+    //! Find the unique neighbors and create the distributed graph communicator
+    void initializeGhostGraph();
+
+    //! Build the per neighbor send lists and exchange ghosts in a single round
+    void exchangeGhostsDirect(const CommFlags& flags, unsigned int mask);
+
+    //! Post a non-blocking exchange of fixed size records with all unique neighbors
+    void beginDirectExchange(const void* sendbuf,
+                             const std::vector<unsigned int>& send_counts,
+                             void* recvbuf,
+                             const std::vector<unsigned int>& recv_counts,
+                             size_t record_size);
+
+    //! Post the single round ghost update
+    void beginUpdateGhostsDirect(uint64_t timestep);
+
+    //! Complete the single round ghost update
+    void finishUpdateGhostsDirect(uint64_t timestep);
+
+    //! Update the net force, torque, and virial of the ghosts in a single round
+    void updateNetForceDirect(const CommFlags& flags);
+
     /* Bonds communication */
     bool m_bonds_changed; //!< True if bond information needs to be refreshed
     void setBondsChanged()
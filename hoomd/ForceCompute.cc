@@ -212,11 +212,18 @@ ForceCompute::~ForceCompute()
  */
 Scalar ForceCompute::calcEnergySum()
     {
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
     double pe_total = m_external_energy;
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    if (m_net_force_accumulated)
+        {
+        pe_total += m_accumulated_energy;
+        }
+    else
         {
-        pe_total += (double)h_force.data[i].w;
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            pe_total += (double)h_force.data[i].w;
+            }
         }
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
@@ -238,6 +245,7 @@ Scalar ForceCompute::calcEnergySum()
  */
 Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
     {
+    updatePerParticleArrays();
     unsigned int group_size = group->getNumMembers();
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
 
@@ -268,6 +276,7 @@ Scalar ForceCompute::calcEnergyGroup(std::shared_ptr<ParticleGroup> group)
 
 vec3<double> ForceCompute::calcForceGroup(std::shared_ptr<ParticleGroup> group)
     {
+    updatePerParticleArrays();
     unsigned int group_size = group->getNumMembers();
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
 
@@ -299,6 +308,7 @@ vec3<double> ForceCompute::calcForceGroup(std::shared_ptr<ParticleGroup> group)
  */
 std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup> group)
     {
+    updatePerParticleArrays();
     const unsigned int group_size = group->getNumMembers();
     const ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::read);
 
@@ -328,6 +338,7 @@ std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup>
 
 pybind11::object ForceCompute::getEnergiesPython()
     {
+    updatePerParticleArrays();
     bool root = true;
 #ifdef ENABLE_MPI
     // if we are not the root processor, return None
@@ -378,6 +389,7 @@ pybind11::object ForceCompute::getEnergiesPython()
 
 pybind11::object ForceCompute::getForcesPython()
     {
+    updatePerParticleArrays();
     bool root = true;
 #ifdef ENABLE_MPI
     // if we are not the root processor, return None
@@ -434,6 +446,7 @@ pybind11::object ForceCompute::getForcesPython()
 
 pybind11::object ForceCompute::getTorquesPython()
     {
+    updatePerParticleArrays();
     bool root = true;
 #ifdef ENABLE_MPI
     // if we are not the root processor, return None
@@ -490,6 +503,7 @@ pybind11::object ForceCompute::getTorquesPython()
 
 pybind11::object ForceCompute::getVirialsPython()
     {
+    updatePerParticleArrays();
     if (!m_computed_flags[pdata_flag::pressure_tensor])
         {
         return pybind11::none();
@@ -567,17 +581,61 @@ void ForceCompute::compute(uint64_t timestep)
     if (m_particles_sorted || shouldCompute(timestep) || m_pdata->getFlags() != m_computed_flags)
         {
         computeForces(timestep);
+        m_net_force_accumulated = false;
         }
 
     m_particles_sorted = false;
     m_computed_flags = m_pdata->getFlags();
     }
 
+/*! Computes the forces and adds them directly into the given net force, virial, and torque arrays
+    without storing them in m_force, m_virial, and m_torque. The caller must call this at most once
+    per time step and only when supportsNetForceAccumulation() returns true. The per-particle
+    arrays are filled in later by updatePerParticleArrays() when a caller requests them.
+
+    \param timestep Current time step
+    \param net_force Net force array to add into
+    \param net_virial Net virial array to add into
+    \param net_virial_pitch Pitch of \a net_virial
+    \param net_torque Net torque array to add into
+*/
+void ForceCompute::accumulateNetForce(uint64_t timestep,
+                                      Scalar4* net_force,
+                                      Scalar* net_virial,
+                                      size_t net_virial_pitch,
+                                      Scalar4* net_torque)
+    {
+    Compute::compute(timestep);
+    // mark this time step as computed so that a later call to compute() does not repeat the work
+    shouldCompute(timestep);
+
+    m_accumulated_energy
+        = accumulateForces(timestep, net_force, net_virial, net_virial_pitch, net_torque);
+    m_net_force_accumulated = true;
+    m_accumulated_timestep = timestep;
+
+    m_particles_sorted = false;
+    m_computed_flags = m_pdata->getFlags();
+    }
+
+/*! Fills m_force, m_virial, and m_torque when the last computation added directly into the net
+    force arrays. Does nothing otherwise.
+*/
+void ForceCompute::updatePerParticleArrays()
+    {
+    if (m_net_force_accumulated)
+        {
+        computeForces(m_accumulated_timestep);
+        m_net_force_accumulated = false;
+        }
+    }
+
 /*! \param tag Global particle tag
     \returns Torque of particle referenced by tag
  */
 Scalar4 ForceCompute::getTorque(unsigned int tag)
     {
+    updatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar4 result = make_scalar4(0.0, 0.0, 0.0, 0.0);
@@ -605,6 +663,7 @@ Scalar4 ForceCompute::getTorque(unsigned int tag)
  */
 Scalar3 ForceCompute::getForce(unsigned int tag)
     {
+    updatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar3 result = make_scalar3(0.0, 0.0, 0.0);
@@ -633,6 +692,7 @@ Scalar3 ForceCompute::getForce(unsigned int tag)
  */
 Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
     {
+    updatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -656,6 +716,7 @@ Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
  */
 Scalar ForceCompute::getEnergy(unsigned int tag)
     {
+    updatePerParticleArrays();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
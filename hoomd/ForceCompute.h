@@ -18,6 +18,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <stdexcept>
 
 /*! \file ForceCompute.h
     \brief Declares the ForceCompute class
@@ -71,6 +72,14 @@ class PYBIND11_EXPORT ForceCompute : public Compute
      * and can be used to overlap computation with communication
      */
     virtual void preCompute(uint64_t timestep) { }
+
+    //! Compute the forces that do not depend on ghost particles
+    /*! This method is called in MPI simulations while the ghost positions are being updated. A
+     * derived class may compute the contributions of interactions that involve only local
+     * particles here and add the remaining contributions in the next call to computeForces() for
+     * the same time step. The base class implementation does nothing.
+     */
+    virtual void computeInterior(uint64_t timestep) { }
 #endif
 
     //! Computes the forces
@@ -174,6 +183,22 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         return false;
         }
 
+    //! Returns true when this ForceCompute can add its forces directly into the net force arrays
+    virtual bool supportsNetForceAccumulation()
+        {
+        return false;
+        }
+
+    //! Compute the forces and add them directly into the net force, virial, and torque arrays
+    void accumulateNetForce(uint64_t timestep,
+                            Scalar4* net_force,
+                            Scalar* net_virial,
+                            size_t net_virial_pitch,
+                            Scalar4* net_torque);
+
+    //! Recompute the per-particle arrays when the last computation only updated the net force
+    void updatePerParticleArrays();
+
     bool getLocalBuffersWriteable() const
         {
         return m_buffers_writeable;
@@ -245,6 +270,36 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     // Store local tags for gathering particle forces, energies, torques, and virials
     std::vector<uint32_t> m_local_tag;
 
+    /// Set when the last computation added directly into the net force arrays instead of m_force,
+    /// m_virial, and m_torque
+    bool m_net_force_accumulated = false;
+
+    /// Time step of the last computation that added directly into the net force arrays
+    uint64_t m_accumulated_timestep = 0;
+
+    /// Local potential energy added to the net force arrays by the last accumulation
+    double m_accumulated_energy = 0.0;
+
+    //! Add the forces, virials, and torques directly into the given arrays
+    /*! Sub-classes that return true from supportsNetForceAccumulation() implement this to add
+        their contributions for all local and ghost particles into the arrays without clearing
+        them first.
+        \param timestep Current time step
+        \param force Force array to add into
+        \param virial Virial array to add into (only when the pressure tensor flag is set)
+        \param virial_pitch Pitch of \a virial
+        \param torque Torque array to add into
+        \returns The potential energy added to the local particles
+    */
+    virtual double accumulateForces(uint64_t timestep,
+                                    Scalar4* force,
+                                    Scalar* virial,
+                                    size_t virial_pitch,
+                                    Scalar4* torque)
+        {
+        throw std::runtime_error("This force does not support net force accumulation.");
+        }
+
     //! Actually perform the computation of the forces
     /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
         the base class compute() when the forces need to be computed.
@@ -269,6 +324,7 @@ class PYBIND11_EXPORT LocalForceComputeData : public GhostLocalDataAccess<Output
           m_virial_pitch(data.getVirialArray().getPitch()),
           m_buffers_writeable(data.getLocalBuffersWriteable())
         {
+        data.updatePerParticleArrays();
         }
 
     virtual ~LocalForceComputeData() = default;
@@ -0,0 +1,583 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "GSDCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <pybind11/numpy.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+/*! \file GSDCompression.cc
+    \brief Defines the compressed encoding of GSD per-particle float chunks
+*/
+
+namespace hoomd
+    {
+namespace detail
+    {
+namespace
+    {
+//! Quotients at or above this value are stored as raw 64-bit values
+const unsigned int rice_escape = 24;
+
+//! Largest magnitude of a quantized value (keeps all residuals within int64_t)
+const double max_quantized = 4503599627370496.0; // 2^52
+
+//! Map a signed residual to an unsigned value with small magnitudes first
+inline uint64_t zigzagEncode(int64_t v)
+    {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+    }
+
+//! Inverse of zigzagEncode
+inline int64_t zigzagDecode(uint64_t v)
+    {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+//! Append bits to a byte buffer, least significant bit first
+class BitWriter
+    {
+    public:
+    explicit BitWriter(std::vector<char>& out) : m_out(out) { }
+
+    //! Write the low \a n bits of \a value
+    void write(uint64_t value, unsigned int n)
+        {
+        while (n > 32)
+            {
+            write(value & 0xffffffff, 32);
+            value >>= 32;
+            n -= 32;
+            }
+
+        if (n < 64)
+            value &= (uint64_t(1) << n) - 1;
+        m_acc |= value << m_nbits;
+        m_nbits += n;
+        while (m_nbits >= 8)
+            {
+            m_out.push_back(static_cast<char>(m_acc & 0xff));
+            m_acc >>= 8;
+            m_nbits -= 8;
+            }
+        }
+
+    //! Write the remaining partial byte
+    void flush()
+        {
+        if (m_nbits > 0)
+            {
+            m_out.push_back(static_cast<char>(m_acc & 0xff));
+            m_acc = 0;
+            m_nbits = 0;
+            }
+        }
+
+    private:
+    std::vector<char>& m_out;
+    uint64_t m_acc = 0;
+    unsigned int m_nbits = 0;
+    };
+
+//! Read bits written by BitWriter
+class BitReader
+    {
+    public:
+    BitReader(const unsigned char* data, size_t size) : m_data(data), m_size(size) { }
+
+    //! Read \a n bits
+    uint64_t read(unsigned int n)
+        {
+        if (n > 32)
+            {
+            uint64_t low = read(32);
+            return low | (read(n - 32) << 32);
+            }
+
+        while (m_nbits < n)
+            {
+            if (m_pos >= m_size)
+                {
+                m_overrun = true;
+                return 0;
+                }
+            m_acc |= uint64_t(m_data[m_pos++]) << m_nbits;
+            m_nbits += 8;
+            }
+
+        uint64_t value = m_acc & ((uint64_t(1) << n) - 1);
+        m_acc >>= n;
+        m_nbits -= n;
+        return value;
+        }
+
+    //! Return true when a read went past the end of the data
+    bool overrun() const
+        {
+        return m_overrun;
+        }
+
+    private:
+    const unsigned char* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    uint64_t m_acc = 0;
+    unsigned int m_nbits = 0;
+    bool m_overrun = false;
+    };
+
+//! Number of bits needed to Rice code \a values with parameter \a k
+uint64_t riceCost(const uint64_t* values, size_t n, unsigned int k)
+    {
+    uint64_t cost = 0;
+    for (size_t i = 0; i < n; i++)
+        {
+        uint64_t q = values[i] >> k;
+        cost += (q < rice_escape) ? q + 1 + k : rice_escape + 64;
+        }
+    return cost;
+    }
+
+//! Rice code a block of values
+void encodeBlock(std::vector<char>& out, const uint64_t* values, size_t n)
+    {
+    // estimate the parameter from the mean and refine it with the exact cost of its neighbors
+    double mean = 0;
+    for (size_t i = 0; i < n; i++)
+        mean += double(values[i]);
+    mean /= double(n);
+
+    unsigned int k_estimate = 0;
+    while (k_estimate < 62 && double(uint64_t(1) << (k_estimate + 1)) <= mean)
+        k_estimate++;
+
+    unsigned int k = k_estimate;
+    uint64_t best_cost = riceCost(values, n, k);
+    for (unsigned int trial : {k_estimate - 1, k_estimate + 1})
+        {
+        if (trial > 63)
+            continue;
+        uint64_t cost = riceCost(values, n, trial);
+        if (cost < best_cost)
+            {
+            best_cost = cost;
+            k = trial;
+            }
+        }
+
+    out.clear();
+    out.reserve(1 + best_cost / 8 + 1);
+    out.push_back(static_cast<char>(k));
+
+    BitWriter writer(out);
+    for (size_t i = 0; i < n; i++)
+        {
+        uint64_t q = values[i] >> k;
+        if (q < rice_escape)
+            {
+            // q one bits followed by a zero bit
+            writer.write((uint64_t(1) << q) - 1, static_cast<unsigned int>(q) + 1);
+            writer.write(values[i], k);
+            }
+        else
+            {
+            writer.write((uint64_t(1) << rice_escape) - 1, rice_escape);
+            writer.write(values[i], 64);
+            }
+        }
+    writer.flush();
+    }
+
+//! Decode a Rice coded block
+bool decodeBlock(uint64_t* values, size_t n, const unsigned char* data, size_t size)
+    {
+    if (size < 1)
+        return false;
+
+    unsigned int k = data[0];
+    if (k > 63)
+        return false;
+
+    BitReader reader(data + 1, size - 1);
+    for (size_t i = 0; i < n; i++)
+        {
+        unsigned int q = 0;
+        while (q < rice_escape && reader.read(1))
+            q++;
+
+        if (q == rice_escape)
+            values[i] = reader.read(64);
+        else
+            values[i] = (uint64_t(q) << k) | reader.read(k);
+
+        if (reader.overrun())
+            return false;
+        }
+    return true;
+    }
+
+//! Call kernel(b) for every block b in [0, n_blocks), in parallel when threads are available
+template<class Kernel>
+void forEachBlock(uint64_t n_blocks,
+                  [[maybe_unused]] std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                  const Kernel& kernel)
+    {
+#ifdef ENABLE_TBB
+    if (exec_conf && exec_conf->getNumThreads() > 1 && n_blocks > 1)
+        {
+        exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<uint64_t>(0, n_blocks),
+                                  [&](const tbb::blocked_range<uint64_t>& r)
+                                  {
+                                      for (uint64_t b = r.begin(); b != r.end(); ++b)
+                                          kernel(b);
+                                  });
+            });
+        }
+    else
+#endif
+        {
+        for (uint64_t b = 0; b < n_blocks; b++)
+            kernel(b);
+        }
+    }
+
+    } // end anonymous namespace
+
+/*! \param out Buffer to write the compressed chunk to
+    \param data N x M values to encode
+    \param N Number of rows
+    \param M Number of columns
+    \param precision Quantization step
+    \param frame Index of the frame the chunk will be written to
+    \param keyframe_interval Maximum number of frames between key frames
+    \param exec_conf Execution configuration (used for threading)
+
+    \returns false when the data cannot be represented at the given precision (non-finite or
+    too large values). The compressor is reset in that case and \a out is not modified.
+*/
+bool GSDCompressor::encode(std::vector<char>& out,
+                           const float* data,
+                           uint64_t N,
+                           uint32_t M,
+                           double precision,
+                           uint64_t frame,
+                           unsigned int keyframe_interval,
+                           std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    const uint64_t n_values = N * M;
+    if (!(precision > 0) || n_values == 0)
+        {
+        reset();
+        return false;
+        }
+
+    // quantize
+    m_quantized.resize(n_values);
+    const double inv_precision = 1.0 / precision;
+    for (uint64_t i = 0; i < N; i++)
+        {
+        for (uint32_t c = 0; c < M; c++)
+            {
+            double x = double(data[i * M + c]) * inv_precision;
+            if (!std::isfinite(x) || std::abs(x) >= max_quantized)
+                {
+                reset();
+                return false;
+                }
+            m_quantized[uint64_t(c) * N + i] = std::llround(x);
+            }
+        }
+
+    bool keyframe = !m_have_reference || m_N != N || m_M != M || m_precision != precision
+                    || frame <= m_reference_frame || keyframe_interval <= 1
+                    || frame - m_keyframe >= keyframe_interval;
+
+    const uint64_t n_blocks = (n_values + block_size - 1) / block_size;
+    m_residuals.resize(n_values);
+    m_block_data.resize(n_blocks);
+
+    forEachBlock(n_blocks,
+                 exec_conf,
+                 [&](uint64_t b)
+                 {
+                     const uint64_t start = b * block_size;
+                     const uint64_t end = std::min(start + block_size, n_values);
+                     for (uint64_t k = start; k < end; k++)
+                         {
+                         int64_t prediction = 0;
+                         if (!keyframe)
+                             prediction = m_reference[k];
+                         else if (k > start)
+                             prediction = m_quantized[k - 1];
+                         m_residuals[k] = zigzagEncode(m_quantized[k] - prediction);
+                         }
+                     encodeBlock(m_block_data[b], m_residuals.data() + start, end - start);
+                 });
+
+    // assemble the chunk
+    GSDCompressedHeader header;
+    header.magic = magic;
+    header.version = version;
+    header.N = N;
+    header.M = M;
+    header.block_size = block_size;
+    header.precision = precision;
+    header.reference = keyframe ? 0 : frame - m_reference_frame;
+    header.n_blocks = n_blocks;
+
+    std::vector<uint64_t> offsets(n_blocks + 1);
+    offsets[0] = 0;
+    for (uint64_t b = 0; b < n_blocks; b++)
+        offsets[b + 1] = offsets[b] + m_block_data[b].size();
+
+    const size_t offsets_size = offsets.size() * sizeof(uint64_t);
+    out.resize(sizeof(header) + offsets_size + offsets[n_blocks]);
+    memcpy(out.data(), &header, sizeof(header));
+    memcpy(out.data() + sizeof(header), offsets.data(), offsets_size);
+    char* block_start = out.data() + sizeof(header) + offsets_size;
+    for (uint64_t b = 0; b < n_blocks; b++)
+        memcpy(block_start + offsets[b], m_block_data[b].data(), m_block_data[b].size());
+
+    // this frame is the reference for the next one
+    m_reference.swap(m_quantized);
+    m_reference_frame = frame;
+    if (keyframe)
+        m_keyframe = frame;
+    m_N = N;
+    m_M = M;
+    m_precision = precision;
+    m_have_reference = true;
+    return true;
+    }
+
+/*! \param header Header to fill out
+    \param chunk Compressed chunk data
+    \param size Size of the chunk in bytes
+
+    \returns true when the chunk starts with a valid header and is large enough to hold the
+    offset table.
+*/
+bool GSDCompressor::readHeader(GSDCompressedHeader& header, const char* chunk, size_t size)
+    {
+    if (size < sizeof(header))
+        return false;
+
+    memcpy(&header, chunk, sizeof(header));
+    if (header.magic != magic || header.version != version || header.block_size == 0
+        || !(header.precision > 0) || header.M == 0)
+        return false;
+
+    const uint64_t n_values = header.N * header.M;
+    if (header.n_blocks != (n_values + header.block_size - 1) / header.block_size)
+        return false;
+
+    return (size - sizeof(header)) / sizeof(uint64_t) >= header.n_blocks + 1;
+    }
+
+/*! \param values Output quantized values in component major order (value of column c of row i
+           at c * N + i)
+    \param chunk Compressed chunk data
+    \param size Size of the chunk in bytes
+    \param reference Quantized values of the reference frame (required when the header's
+           reference is not 0)
+    \param exec_conf Execution configuration (used for threading)
+
+    \returns false when the chunk is invalid or the reference is missing.
+*/
+bool GSDCompressor::decode(std::vector<int64_t>& values,
+                           const char* chunk,
+                           size_t size,
+                           const std::vector<int64_t>* reference,
+                           std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    GSDCompressedHeader header;
+    if (!readHeader(header, chunk, size))
+        return false;
+
+    const uint64_t n_blocks = header.n_blocks;
+    std::vector<uint64_t> offsets(n_blocks + 1);
+    memcpy(offsets.data(), chunk + sizeof(header), offsets.size() * sizeof(uint64_t));
+
+    const size_t data_start = sizeof(header) + offsets.size() * sizeof(uint64_t);
+    if (offsets[n_blocks] > size - data_start)
+        return false;
+
+    std::vector<uint64_t> blocks(n_blocks);
+    for (uint64_t b = 0; b < n_blocks; b++)
+        blocks[b] = b;
+
+    // with all blocks, the layout of decodeBlocks() is the component major order
+    return decodeBlocks(values, header, blocks, chunk + data_start, offsets, reference, exec_conf);
+    }
+
+/*! \param header Header of the compressed chunk
+    \param begin First row
+    \param end One past the last row
+
+    Values are stored column by column, so rows [begin, end) of each column fall into a
+    contiguous run of blocks.
+*/
+std::vector<uint64_t>
+GSDCompressor::findBlocks(const GSDCompressedHeader& header, uint64_t begin, uint64_t end)
+    {
+    std::vector<uint64_t> blocks;
+    if (begin >= end)
+        return blocks;
+
+    for (uint32_t c = 0; c < header.M; c++)
+        {
+        const uint64_t first = (uint64_t(c) * header.N + begin) / header.block_size;
+        const uint64_t last = (uint64_t(c) * header.N + end - 1) / header.block_size;
+        for (uint64_t b = first; b <= last; b++)
+            {
+            // neighboring columns may share a block
+            if (blocks.empty() || blocks.back() < b)
+                blocks.push_back(b);
+            }
+        }
+    return blocks;
+    }
+
+/*! \param values Output quantized values. Value k of block blocks[j] is stored at
+           j * block_size + k - blocks[j] * block_size, only the last block may be partial.
+    \param header Header of the compressed chunk
+    \param blocks Sorted indices of the blocks to decode
+    \param block_data Encoded data of the blocks
+    \param block_offsets blocks.size() + 1 offsets of the blocks in \a block_data
+    \param reference Quantized values of the same blocks of the reference frame, in the same
+           layout (required when the header's reference is not 0)
+    \param exec_conf Execution configuration (used for threading)
+
+    Blocks are coded independently, so a reader only needs the blocks that hold its rows.
+
+    \returns false when a block is invalid or the reference is missing.
+*/
+bool GSDCompressor::decodeBlocks(std::vector<int64_t>& values,
+                                 const GSDCompressedHeader& header,
+                                 const std::vector<uint64_t>& blocks,
+                                 const char* block_data,
+                                 const std::vector<uint64_t>& block_offsets,
+                                 const std::vector<int64_t>* reference,
+                                 std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    const uint64_t n_values = header.N * header.M;
+    const uint64_t block_size = header.block_size;
+    if (block_offsets.size() != blocks.size() + 1)
+        return false;
+
+    for (size_t j = 0; j < blocks.size(); j++)
+        {
+        if (blocks[j] >= header.n_blocks || block_offsets[j] > block_offsets[j + 1])
+            return false;
+        }
+
+    uint64_t n_out = 0;
+    if (!blocks.empty())
+        n_out = (blocks.size() - 1) * block_size
+                + std::min(block_size, n_values - blocks.back() * block_size);
+
+    const bool keyframe = header.reference == 0;
+    if (!keyframe && (!reference || reference->size() != n_out))
+        return false;
+
+    values.resize(n_out);
+    std::vector<uint64_t> residuals(n_out);
+    std::vector<char> block_valid(blocks.size(), 0);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(block_data);
+
+    forEachBlock(blocks.size(),
+                 exec_conf,
+                 [&](uint64_t j)
+                 {
+                     const uint64_t start = blocks[j] * block_size;
+                     const uint64_t n = std::min(start + block_size, n_values) - start;
+                     const uint64_t out = j * block_size;
+                     if (!decodeBlock(residuals.data() + out,
+                                      n,
+                                      data + block_offsets[j],
+                                      block_offsets[j + 1] - block_offsets[j]))
+                         return;
+
+                     for (uint64_t k = out; k < out + n; k++)
+                         {
+                         int64_t prediction = 0;
+                         if (!keyframe)
+                             prediction = (*reference)[k];
+                         else if (k > out)
+                             prediction = values[k - 1];
+                         values[k] = prediction + zigzagDecode(residuals[k]);
+                         }
+                     block_valid[j] = 1;
+                 });
+
+    for (size_t j = 0; j < blocks.size(); j++)
+        {
+        if (!block_valid[j])
+            return false;
+        }
+    return true;
+    }
+
+namespace
+    {
+//! A compressed chunk as read by gsd.fl.GSDFile.read_chunk()
+template<class T>
+using ContiguousArray = pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>;
+using ChunkArray = ContiguousArray<uint8_t>;
+
+//! Get the rows, columns, precision, and number of frames back to the reference of a chunk
+pybind11::tuple readHeaderPy(const ChunkArray& chunk)
+    {
+    GSDCompressedHeader header;
+    const char* data = reinterpret_cast<const char*>(chunk.data());
+    if (!GSDCompressor::readHeader(header, data, chunk.size()))
+        {
+        throw std::runtime_error("Invalid compressed chunk.");
+        }
+    return pybind11::make_tuple(header.N, header.M, header.precision, header.reference);
+    }
+
+//! Decode the quantized values of a chunk given those of its reference frame (or None)
+pybind11::array_t<int64_t> decodePy(const ChunkArray& chunk, pybind11::object reference)
+    {
+    std::vector<int64_t> reference_values;
+    if (!reference.is_none())
+        {
+        auto array = reference.cast<ContiguousArray<int64_t>>();
+        reference_values.assign(array.data(), array.data() + array.size());
+        }
+
+    std::vector<int64_t> values;
+    if (!GSDCompressor::decode(values,
+                               reinterpret_cast<const char*>(chunk.data()),
+                               chunk.size(),
+                               reference.is_none() ? nullptr : &reference_values,
+                               nullptr))
+        {
+        throw std::runtime_error("Invalid compressed chunk or reference.");
+        }
+    return pybind11::array_t<int64_t>(values.size(), values.data());
+    }
+    } // end anonymous namespace
+
+void export_GSDCompressor(pybind11::module& m)
+    {
+    pybind11::class_<GSDCompressor>(m, "GSDCompressor")
+        .def_static("readHeader", &readHeaderPy)
+        .def_static("decode", &decodePy);
+    }
+
+    } // end namespace detail
+    } // end namespace hoomd
@@ -0,0 +1,141 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ExecutionConfiguration.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+/*! \file GSDCompression.h
+    \brief Declares the compressed encoding of GSD per-particle float chunks
+    \details A compressed chunk stores an N x M float array as fixed point integers with a
+    user chosen precision. Values are quantized to q = round(x / precision) and each stored value
+    is the difference between q and a prediction:
+
+    - Key frames predict each value from the previous value in the same block, which is the
+      previous particle's value of the same component everywhere except at component
+      boundaries. Frames are written in tag order, not in the order of the particle sorter, so
+      these residuals are only small when particles with consecutive tags are close to each
+      other (e.g. systems initialized on a lattice). Otherwise they are of the order of the box
+      length, and key frames save little more than the quantization itself.
+    - Other frames predict each value from the reference frame's quantized value.
+
+    The zigzag encoded residuals are laid out component by component, split into blocks of
+    block_size values, and each block is Rice coded with its own parameter so that blocks can be
+    encoded and decoded independently (and in parallel when TBB is enabled).
+
+    The chunk is written to the GSD file as a uint8 array named compressed_chunk_prefix + name
+    (e.g. compressed/particles/position) containing a GSDCompressedHeader, n_blocks + 1 byte
+    offsets of the blocks relative to the end of the offset table, and the block data. Non key
+    frames refer to their reference frame by the number of frames back, so decoding frame i may
+    require decoding up to keyframe_interval - 1 earlier frames.
+
+    GSDDumpWriter also writes the uncompressed name with zero rows to the same frame. Readers
+    that do not know the encoding find an empty chunk (or fail to read it) instead of silently
+    using the data of frame 0 or default values.
+*/
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Prefix prepended to the chunk name of compressed chunks
+const std::string gsd_compressed_prefix = "compressed/";
+
+//! Header of a compressed chunk
+struct GSDCompressedHeader
+    {
+    uint32_t magic;      //!< Identifies the encoding (gsd_compressed_magic)
+    uint32_t version;    //!< Encoding version
+    uint64_t N;          //!< Number of rows
+    uint32_t M;          //!< Number of columns
+    uint32_t block_size; //!< Number of values in each Rice coded block
+    double precision;    //!< Quantization step
+    uint64_t reference;  //!< Number of frames back to the reference frame (0 for a key frame)
+    uint64_t n_blocks;   //!< Number of blocks
+    };
+
+//! Encodes and decodes compressed GSD chunks
+/*! A GSDCompressor holds the quantized values of the last frame it encoded so that the following
+    frames can be delta encoded. Use one instance per chunk name.
+*/
+class PYBIND11_EXPORT GSDCompressor
+    {
+    public:
+    //! Magic number at the start of every compressed chunk
+    static const uint32_t magic = 0x43445347;
+
+    //! Current encoding version
+    static const uint32_t version = 1;
+
+    //! Number of values in each Rice coded block
+    static const uint32_t block_size = 4096;
+
+    //! Encode an N x M float array
+    bool encode(std::vector<char>& out,
+                const float* data,
+                uint64_t N,
+                uint32_t M,
+                double precision,
+                uint64_t frame,
+                unsigned int keyframe_interval,
+                std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+    //! Forget the previous frame so that the next encoded frame is a key frame
+    void reset()
+        {
+        m_have_reference = false;
+        }
+
+    //! Read and validate the header of a compressed chunk
+    static bool readHeader(GSDCompressedHeader& header, const char* chunk, size_t size);
+
+    //! Decode the quantized values of a compressed chunk
+    static bool decode(std::vector<int64_t>& values,
+                       const char* chunk,
+                       size_t size,
+                       const std::vector<int64_t>* reference,
+                       std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+    //! Get the sorted indices of the blocks that hold rows [begin, end) of every column
+    static std::vector<uint64_t>
+    findBlocks(const GSDCompressedHeader& header, uint64_t begin, uint64_t end);
+
+    //! Decode the quantized values of some of the blocks of a compressed chunk
+    static bool decodeBlocks(std::vector<int64_t>& values,
+                             const GSDCompressedHeader& header,
+                             const std::vector<uint64_t>& blocks,
+                             const char* block_data,
+                             const std::vector<uint64_t>& block_offsets,
+                             const std::vector<int64_t>* reference,
+                             std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+    private:
+    bool m_have_reference = false;    //!< True when m_reference holds a valid frame
+    std::vector<int64_t> m_reference; //!< Quantized values of the reference frame
+    uint64_t m_reference_frame = 0;   //!< Frame index of the reference frame
+    uint64_t m_keyframe = 0;          //!< Frame index of the last key frame
+    uint64_t m_N = 0;                 //!< Number of rows in the reference frame
+    uint32_t m_M = 0;                 //!< Number of columns in the reference frame
+    double m_precision = 0;           //!< Precision of the reference frame
+
+    std::vector<int64_t> m_quantized;            //!< Quantized values of the current frame
+    std::vector<uint64_t> m_residuals;           //!< Zigzag encoded residuals
+    std::vector<std::vector<char>> m_block_data; //!< Encoded data of each block
+    };
+
+/// Exports the compressed chunk decoder to python
+void export_GSDCompressor(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace hoomd
@@ -8,6 +8,10 @@
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 #include <pybind11/numpy.h>
@@ -23,6 +27,9 @@ using namespace hoomd::detail;
 
 namespace hoomd
     {
+/// Set on GSD I/O threads.
+static thread_local bool on_io_thread = false;
+
 std::list<std::string> GSDDumpWriter::particle_chunks {"particles/position",
                                                        "particles/typeid",
                                                        "particles/mass",
@@ -69,6 +76,7 @@ GSDDumpWriter::GSDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
         {
         m_gather_tag_order = GatherTagOrder(m_exec_conf->getMPICommunicator());
         }
+    m_distribute_index_order = DistributeIndexOrder(m_exec_conf->getMPICommunicator());
 #endif
 
     m_dynamic.reset();
@@ -148,6 +156,9 @@ pybind11::tuple GSDDumpWriter::getDynamic()
 
 void GSDDumpWriter::setDynamic(pybind11::object dynamic)
     {
+    // the I/O thread reads m_dynamic while writing queued frames
+    waitForQueuedFrames();
+
     pybind11::list dynamic_list = dynamic;
     m_dynamic.reset();
     m_write_topology = false;
@@ -220,6 +231,11 @@ void GSDDumpWriter::setDynamic(pybind11::object dynamic)
 
 void GSDDumpWriter::flush()
     {
+    waitForQueuedFrames();
+#ifdef ENABLE_MPI
+    syncDistributed();
+#endif
+
     if (m_exec_conf->isRoot())
         {
         m_exec_conf->msg->notice(5) << "GSD: flush gsd file " << m_fname << endl;
@@ -230,6 +246,8 @@ void GSDDumpWriter::flush()
 
 void GSDDumpWriter::setMaximumWriteBufferSize(uint64_t size)
     {
+    waitForQueuedFrames();
+
     if (m_exec_conf->isRoot())
         {
         int retval = gsd_set_maximum_write_buffer_size(&m_handle, size);
@@ -243,6 +261,8 @@ void GSDDumpWriter::setMaximumWriteBufferSize(uint64_t size)
 
 uint64_t GSDDumpWriter::getMaximumWriteBufferSize()
     {
+    waitForQueuedFrames();
+
     if (m_exec_conf->isRoot())
         {
         return gsd_get_maximum_write_buffer_size(&m_handle);
@@ -325,11 +345,39 @@ GSDDumpWriter::~GSDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying GSDDumpWriter" << endl;
 
+    // write all queued frames before closing the file
+    stopIOThread();
+    if (m_io_error)
+        {
+        try
+            {
+            std::rethrow_exception(m_io_error);
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->error() << "GSD: error writing " << m_fname << ": " << e.what()
+                                      << endl;
+            }
+        }
+
     if (m_exec_conf->isRoot())
         {
         m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
+
+#ifdef ENABLE_MPI
+    if (m_fd != -1)
+        {
+        // Other ranks may already be gone, so sync this rank's slabs without a barrier.
+        if (fsync(m_fd) != 0)
+            {
+            m_exec_conf->msg->error()
+                << "GSD: error syncing " << m_fname << ": " << strerror(errno) << endl;
+            }
+        close(m_fd);
+        }
+#endif
     }
 
 //! Get the logged data for the current frame if any.
@@ -356,9 +404,14 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     // truncate the file if requested
     if (m_truncate)
         {
+#ifdef ENABLE_MPI
+        // slabs of the previous frame must not land in the truncated file
+        syncDistributed();
+#endif
         if (m_exec_conf->isRoot())
             {
-            m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
+            waitForQueuedFrames();
+            writeNotice() << "GSD: truncating file" << endl;
             retval = gsd_truncate(&m_handle);
             GSDUtils::checkError(retval, m_fname);
             }
@@ -373,52 +426,296 @@ void GSDDumpWriter::analyze(uint64_t timestep)
 
 void GSDDumpWriter::write(GSDDumpWriter::GSDFrame& frame, pybind11::dict log_data)
     {
+    frame.first_frame = m_nframes == 0;
+
+    // topology is only meaningful if this is the all group
+    bool write_topology = m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
+                          && (m_write_topology || m_nframes == 0);
+
 #ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed())
+    // Distributed writes also run on a single rank, which writes the whole slab.
+    if (m_distributed_write)
+        {
+        waitForQueuedFrames();
+        writeDistributed(frame, log_data);
+
+        if (m_exec_conf->isRoot())
+            {
+            if (write_topology)
+                {
+                writeTopology(frame.bond_data,
+                              frame.angle_data,
+                              frame.dihedral_data,
+                              frame.improper_data,
+                              frame.constraint_data,
+                              frame.pair_data);
+                }
+
+            writeNotice() << "GSD: ending frame" << endl;
+            int retval = gsd_end_frame(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+            }
+        }
+    else if (m_sysdef->isDomainDecomposed())
         {
         gatherGlobalFrame(frame);
 
         if (m_exec_conf->isRoot())
             {
-            writeFrameHeader(m_global_frame);
-            writeAttributes(m_global_frame);
-            writeProperties(m_global_frame);
-            writeMomenta(m_global_frame);
-            writeLogQuantities(log_data);
+            m_global_frame.first_frame = frame.first_frame;
+            if (write_topology)
+                {
+                // the local frame holds the global topology
+                std::swap(m_global_frame.bond_data, frame.bond_data);
+                std::swap(m_global_frame.angle_data, frame.angle_data);
+                std::swap(m_global_frame.dihedral_data, frame.dihedral_data);
+                std::swap(m_global_frame.improper_data, frame.improper_data);
+                std::swap(m_global_frame.constraint_data, frame.constraint_data);
+                std::swap(m_global_frame.pair_data, frame.pair_data);
+                }
+            queueFrame(m_global_frame, log_data, write_topology);
             }
         }
     else
 #endif
         {
-        writeFrameHeader(frame);
-        writeAttributes(frame);
-        writeProperties(frame);
-        writeMomenta(frame);
-        writeLogQuantities(log_data);
+        queueFrame(frame, log_data, write_topology);
         }
-    // topology is only meaningful if this is the all group
-    if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
-        && (m_write_topology || m_nframes == 0))
+
+    m_nframes++;
+    }
+
+/*! \param frame Frame to write
+    \param log Log quantities to write
+    \param write_topology Set to true to write the topology in \a frame
+
+    Called on the thread that writes the file: the caller's thread in synchronous mode and the I/O
+    thread in asynchronous mode.
+*/
+void GSDDumpWriter::writeFrame(const GSDFrame& frame,
+                               const std::vector<LogChunk>& log,
+                               bool write_topology)
+    {
+    writeFrameHeader(frame);
+    writeAttributes(frame);
+    writeProperties(frame);
+    writeMomenta(frame);
+    writeLogChunks(log);
+
+    if (write_topology)
         {
-        if (m_exec_conf->isRoot())
+        writeTopology(frame.bond_data,
+                      frame.angle_data,
+                      frame.dihedral_data,
+                      frame.improper_data,
+                      frame.constraint_data,
+                      frame.pair_data);
+        }
+
+    writeNotice() << "GSD: ending frame" << endl;
+    int retval = gsd_end_frame(&m_handle);
+    GSDUtils::checkError(retval, m_fname);
+    }
+
+/*! \param frame Frame to write
+    \param log_data Log quantities to write
+    \param write_topology Set to true to write the topology in \a frame
+
+    In synchronous mode, write the frame immediately. In asynchronous mode, wait for room in the
+    write queue and then swap the frame's contents into it. \a frame receives the allocations of a
+    previously written frame so that populating the next frame does not reallocate.
+*/
+void GSDDumpWriter::queueFrame(GSDFrame& frame, pybind11::dict log_data, bool write_topology)
+    {
+    // Python objects must be converted on this thread
+    std::vector<LogChunk> log = convertLogQuantities(log_data);
+
+    if (frame.first_frame)
+        {
+        updateNonDefault(frame);
+        }
+
+    if (!m_async_write)
+        {
+        writeFrame(frame, log, write_topology);
+        return;
+        }
+
+    if (!m_io_thread.joinable())
+        {
+        m_stop_io_thread = false;
+        m_io_thread = std::thread(&GSDDumpWriter::writeQueuedFrames, this);
+        }
+
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    m_queue_cv.wait(lock,
+                    [this]
+                    { return m_write_queue.size() < m_maximum_write_queue_size || m_io_error; });
+    rethrowIOError();
+
+    QueuedFrame queued;
+    if (!m_free_frames.empty())
+        {
+        queued.frame = std::move(m_free_frames.back());
+        m_free_frames.pop_back();
+        }
+    std::swap(queued.frame, frame);
+    queued.log = std::move(log);
+    queued.write_topology = write_topology;
+    m_write_queue.push_back(std::move(queued));
+    m_queue_cv.notify_all();
+    }
+
+/*! Write frames from the front of the queue until asked to stop. The front frame stays in the
+    queue while it is written so that the queue size bounds the number of frames in memory. After
+    an error, discard the remaining frames: the main thread reports the error.
+*/
+void GSDDumpWriter::writeQueuedFrames()
+    {
+    on_io_thread = true;
+
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    while (true)
+        {
+        m_queue_cv.wait(lock, [this] { return m_stop_io_thread || !m_write_queue.empty(); });
+        if (m_write_queue.empty())
+            {
+            return;
+            }
+
+        // the main thread only appends to the queue, so this reference remains valid
+        QueuedFrame& queued = m_write_queue.front();
+        bool failed = bool(m_io_error);
+        lock.unlock();
+
+        std::exception_ptr error;
+        if (!failed)
+            {
+            try
+                {
+                writeFrame(queued.frame, queued.log, queued.write_topology);
+                }
+            catch (...)
+                {
+                error = std::current_exception();
+                }
+            }
+
+        lock.lock();
+        if (error)
+            {
+            m_io_error = error;
+            }
+        if (m_free_frames.size() < m_maximum_write_queue_size)
             {
-            writeTopology(frame.bond_data,
-                          frame.angle_data,
-                          frame.dihedral_data,
-                          frame.improper_data,
-                          frame.constraint_data,
-                          frame.pair_data);
+            m_free_frames.push_back(std::move(queued.frame));
             }
+        m_write_queue.pop_front();
+        m_queue_cv.notify_all();
         }
+    }
 
-    if (m_exec_conf->isRoot())
+void GSDDumpWriter::waitForQueuedFrames()
+    {
+    std::unique_lock<std::mutex> lock(m_queue_mutex);
+    m_queue_cv.wait(lock, [this] { return m_write_queue.empty(); });
+    rethrowIOError();
+    }
+
+void GSDDumpWriter::stopIOThread()
+    {
+    if (!m_io_thread.joinable())
         {
-        m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
-        int retval = gsd_end_frame(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        return;
         }
 
-    m_nframes++;
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_stop_io_thread = true;
+        }
+    m_queue_cv.notify_all();
+    m_io_thread.join();
+    m_free_frames.clear();
+    }
+
+void GSDDumpWriter::rethrowIOError()
+    {
+    if (m_io_error)
+        {
+        std::exception_ptr error = m_io_error;
+        m_io_error = nullptr;
+        std::rethrow_exception(error);
+        }
+    }
+
+void GSDDumpWriter::setAsyncWrite(bool async_write)
+    {
+    if (!async_write)
+        {
+        stopIOThread();
+            {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            rethrowIOError();
+            }
+        }
+    m_async_write = async_write;
+    }
+
+void GSDDumpWriter::setMaximumWriteQueueSize(unsigned int size)
+    {
+    if (size == 0)
+        {
+        throw std::invalid_argument("maximum_write_queue_size must be at least 1.");
+        }
+
+        {
+        std::lock_guard<std::mutex> lock(m_queue_mutex);
+        m_maximum_write_queue_size = size;
+        }
+    m_queue_cv.notify_all();
+    }
+
+/*! Messenger streams may write to Python, which the I/O thread must not call. Discard diagnostic
+    messages on the I/O thread.
+*/
+std::ostream& GSDDumpWriter::writeNotice()
+    {
+    if (on_io_thread)
+        {
+        static thread_local std::ostream null_stream(nullptr);
+        return null_stream;
+        }
+    return m_exec_conf->msg->notice(10);
+    }
+
+/*! Set the non-default flag of each particle data chunk written in frame 0. The main thread
+    updates the flags before queuing the frame because populateLocalFrame() reads them.
+*/
+void GSDDumpWriter::updateNonDefault(const GSDFrame& frame)
+    {
+    const SnapshotParticleData<float>& data = frame.particle_data;
+    if (data.type.size() != 0)
+        m_nondefault["particles/typeid"] = true;
+    if (data.mass.size() != 0)
+        m_nondefault["particles/mass"] = true;
+    if (data.charge.size() != 0)
+        m_nondefault["particles/charge"] = true;
+    if (m_write_diameter && data.diameter.size() != 0)
+        m_nondefault["particles/diameter"] = true;
+    if (data.body.size() != 0)
+        m_nondefault["particles/body"] = true;
+    if (data.inertia.size() != 0)
+        m_nondefault["particles/moment_inertia"] = true;
+    if (data.pos.size() != 0)
+        m_nondefault["particles/position"] = true;
+    if (data.orientation.size() != 0)
+        m_nondefault["particles/orientation"] = true;
+    if (data.vel.size() != 0)
+        m_nondefault["particles/velocity"] = true;
+    if (data.angmom.size() != 0)
+        m_nondefault["particles/angmom"] = true;
+    if (data.image.size() != 0)
+        m_nondefault["particles/image"] = true;
     }
 
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping)
@@ -431,7 +728,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
     max_len += 1; // for null
 
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing " << chunk << endl;
+        writeNotice() << "GSD: writing " << chunk << endl;
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len * i], type_mapping[i].c_str(), max_len);
@@ -452,7 +749,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
 void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
     {
     int retval;
-    m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
+    writeNotice() << "GSD: writing configuration/step" << endl;
     retval = gsd_write_chunk(&m_handle,
                              "configuration/step",
                              GSD_TYPE_UINT64,
@@ -462,9 +759,9 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
                              (void*)&frame.timestep);
     GSDUtils::checkError(retval, m_fname);
 
-    if (m_nframes == 0)
+    if (frame.first_frame)
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
+        writeNotice() << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
         retval = gsd_write_chunk(&m_handle,
                                  "configuration/dimensions",
@@ -476,9 +773,9 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
         GSDUtils::checkError(retval, m_fname);
         }
 
-    if (m_nframes == 0 || m_dynamic[gsd_flag::configuration_box])
+    if (frame.first_frame || m_dynamic[gsd_flag::configuration_box])
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing configuration/box" << endl;
+        writeNotice() << "GSD: writing configuration/box" << endl;
         float box_a[6];
         box_a[0] = (float)frame.global_box.getL().x;
         box_a[1] = (float)frame.global_box.getL().y;
@@ -496,10 +793,10 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
         GSDUtils::checkError(retval, m_fname);
         }
 
-    if (m_nframes == 0 || m_dynamic[gsd_flag::particles_N])
+    if (frame.first_frame || m_dynamic[gsd_flag::particles_N])
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
-        uint32_t N = m_group->getNumMembersGlobal();
+        writeNotice() << "GSD: writing particles/N" << endl;
+        uint32_t N = frame.N;
         retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
         }
@@ -510,10 +807,10 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
 */
 void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    uint32_t N = frame.N;
     int retval;
 
-    if (m_dynamic[gsd_flag::particles_types] || m_nframes == 0)
+    if (m_dynamic[gsd_flag::particles_types] || frame.first_frame)
         {
         writeTypeMapping("particles/types", frame.particle_data.type_mapping);
         }
@@ -522,7 +819,7 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         {
         assert(frame.particle_data.type.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
+        writeNotice() << "GSD: writing particles/typeid" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "particles/typeid",
                                  GSD_TYPE_UINT32,
@@ -531,15 +828,13 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
                                  0,
                                  (void*)frame.particle_data.type.data());
         GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/typeid"] = true;
         }
 
     if (frame.particle_data.mass.size() != 0)
         {
         assert(frame.particle_data.mass.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
+        writeNotice() << "GSD: writing particles/mass" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "particles/mass",
                                  GSD_TYPE_FLOAT,
@@ -548,15 +843,13 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
                                  0,
                                  (void*)frame.particle_data.mass.data());
         GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/mass"] = true;
         }
 
     if (frame.particle_data.charge.size() != 0)
         {
         assert(frame.particle_data.charge.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
+        writeNotice() << "GSD: writing particles/charge" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "particles/charge",
                                  GSD_TYPE_FLOAT,
@@ -565,8 +858,6 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
                                  0,
                                  (void*)frame.particle_data.charge.data());
         GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/charge"] = true;
         }
 
     if (m_write_diameter)
@@ -575,7 +866,7 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
             {
             assert(frame.particle_data.diameter.size() == N);
 
-            m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
+            writeNotice() << "GSD: writing particles/diameter" << endl;
             retval = gsd_write_chunk(&m_handle,
                                      "particles/diameter",
                                      GSD_TYPE_FLOAT,
@@ -584,8 +875,6 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
                                      0,
                                      (void*)frame.particle_data.diameter.data());
             GSDUtils::checkError(retval, m_fname);
-            if (m_nframes == 0)
-                m_nondefault["particles/diameter"] = true;
             }
         }
 
@@ -593,7 +882,7 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         {
         assert(frame.particle_data.body.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
+        writeNotice() << "GSD: writing particles/body" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "particles/body",
                                  GSD_TYPE_INT32,
@@ -602,15 +891,13 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
                                  0,
                                  (void*)frame.particle_data.body.data());
         GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/body"] = true;
         }
 
     if (frame.particle_data.inertia.size() != 0)
         {
         assert(frame.particle_data.inertia.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
+        writeNotice() << "GSD: writing particles/moment_inertia" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "particles/moment_inertia",
                                  GSD_TYPE_FLOAT,
@@ -619,8 +906,6 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
                                  0,
                                  (void*)frame.particle_data.inertia.data());
         GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/moment_inertia"] = true;
         }
     }
 
@@ -628,41 +913,30 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
  */
 void GSDDumpWriter::writeProperties(const GSDDumpWriter::GSDFrame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
+    uint32_t N = frame.N;
 
     if (frame.particle_data.pos.size() != 0)
         {
         assert(frame.particle_data.pos.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/position",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.pos.data());
-        GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/position"] = true;
+        writeParticleChunk("particles/position",
+                           reinterpret_cast<const float*>(frame.particle_data.pos.data()),
+                           N,
+                           3,
+                           m_position_precision,
+                           m_position_compressor);
         }
 
     if (frame.particle_data.orientation.size() != 0)
         {
         assert(frame.particle_data.orientation.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/orientation",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)frame.particle_data.orientation.data());
-        GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/orientation"] = true;
+        writeParticleChunk("particles/orientation",
+                           reinterpret_cast<const float*>(frame.particle_data.orientation.data()),
+                           N,
+                           4,
+                           m_orientation_precision,
+                           m_orientation_compressor);
         }
     }
 
@@ -670,31 +944,26 @@ void GSDDumpWriter::writeProperties(const GSDDumpWriter::GSDFrame& frame)
  */
 void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
     {
-    uint32_t N = m_group->getNumMembersGlobal();
+    uint32_t N = frame.N;
     int retval;
 
     if (frame.particle_data.vel.size() != 0)
         {
         assert(frame.particle_data.vel.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/velocity",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.vel.data());
-        GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/velocity"] = true;
+        writeParticleChunk("particles/velocity",
+                           reinterpret_cast<const float*>(frame.particle_data.vel.data()),
+                           N,
+                           3,
+                           m_velocity_precision,
+                           m_velocity_compressor);
         }
 
     if (frame.particle_data.angmom.size() != 0)
         {
         assert(frame.particle_data.angmom.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
+        writeNotice() << "GSD: writing particles/angmom" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "particles/angmom",
                                  GSD_TYPE_FLOAT,
@@ -703,15 +972,13 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
                                  0,
                                  (void*)frame.particle_data.angmom.data());
         GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/angmom"] = true;
         }
 
     if (frame.particle_data.image.size() != 0)
         {
         assert(frame.particle_data.image.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
+        writeNotice() << "GSD: writing particles/image" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "particles/image",
                                  GSD_TYPE_INT32,
@@ -720,11 +987,63 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
                                  0,
                                  (void*)frame.particle_data.image.data());
         GSDUtils::checkError(retval, m_fname);
-        if (m_nframes == 0)
-            m_nondefault["particles/image"] = true;
         }
     }
 
+/*! \param name Name of the chunk
+    \param data N x M values to write
+    \param N Number of rows
+    \param M Number of columns
+    \param precision Quantization step (0 writes the uncompressed chunk)
+    \param compressor Encoder state for this chunk
+
+    Values that cannot be represented at the given precision (e.g. NaN) are written uncompressed
+    and the next compressed chunk is a key frame. With a compressed chunk, the uncompressed chunk
+    is written with zero rows as a marker.
+*/
+void GSDDumpWriter::writeParticleChunk(const std::string& name,
+                                       const float* data,
+                                       uint32_t N,
+                                       uint32_t M,
+                                       float precision,
+                                       detail::GSDCompressor& compressor)
+    {
+    int retval;
+
+    if (precision > 0
+        && compressor.encode(m_compressed_buffer,
+                             data,
+                             N,
+                             M,
+                             precision,
+                             gsd_get_nframes(&m_handle),
+                             m_keyframe_interval,
+                             m_exec_conf))
+        {
+        std::string compressed_name = gsd_compressed_prefix + name;
+        writeNotice() << "GSD: writing " << compressed_name << endl;
+        retval = gsd_write_chunk(&m_handle,
+                                 compressed_name.c_str(),
+                                 GSD_TYPE_UINT8,
+                                 m_compressed_buffer.size(),
+                                 1,
+                                 0,
+                                 (void*)m_compressed_buffer.data());
+        GSDUtils::checkError(retval, m_fname);
+
+        // Readers that do not decode compressed chunks must fail instead of falling back to the
+        // data of frame 0 or to default values.
+        retval = gsd_write_chunk(&m_handle, name.c_str(), GSD_TYPE_FLOAT, 0, M, 0, nullptr);
+        }
+    else
+        {
+        compressor.reset();
+        writeNotice() << "GSD: writing " << name << endl;
+        retval = gsd_write_chunk(&m_handle, name.c_str(), GSD_TYPE_FLOAT, N, M, 0, (void*)data);
+        }
+    GSDUtils::checkError(retval, m_fname);
+    }
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -734,23 +1053,23 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
 
     Write out all the snapshot data to the GSD file
 */
-void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
-                                  AngleData::Snapshot& angle,
-                                  DihedralData::Snapshot& dihedral,
-                                  ImproperData::Snapshot& improper,
-                                  ConstraintData::Snapshot& constraint,
-                                  PairData::Snapshot& pair)
+void GSDDumpWriter::writeTopology(const BondData::Snapshot& bond,
+                                  const AngleData::Snapshot& angle,
+                                  const DihedralData::Snapshot& dihedral,
+                                  const ImproperData::Snapshot& improper,
+                                  const ConstraintData::Snapshot& constraint,
+                                  const PairData::Snapshot& pair)
     {
     if (bond.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
+        writeNotice() << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
         int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
+        writeNotice() << "GSD: writing bonds/typeid" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "bonds/typeid",
                                  GSD_TYPE_UINT32,
@@ -760,7 +1079,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
                                  (void*)&bond.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
+        writeNotice() << "GSD: writing bonds/group" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "bonds/group",
                                  GSD_TYPE_UINT32,
@@ -772,14 +1091,14 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         }
     if (angle.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
+        writeNotice() << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
         int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
+        writeNotice() << "GSD: writing angles/typeid" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "angles/typeid",
                                  GSD_TYPE_UINT32,
@@ -789,7 +1108,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
                                  (void*)&angle.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
+        writeNotice() << "GSD: writing angles/group" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "angles/group",
                                  GSD_TYPE_UINT32,
@@ -801,14 +1120,14 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         }
     if (dihedral.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
+        writeNotice() << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
         int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
+        writeNotice() << "GSD: writing dihedrals/typeid" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "dihedrals/typeid",
                                  GSD_TYPE_UINT32,
@@ -818,7 +1137,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
                                  (void*)&dihedral.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
+        writeNotice() << "GSD: writing dihedrals/group" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "dihedrals/group",
                                  GSD_TYPE_UINT32,
@@ -830,14 +1149,14 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         }
     if (improper.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
+        writeNotice() << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
         int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
+        writeNotice() << "GSD: writing impropers/typeid" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "impropers/typeid",
                                  GSD_TYPE_UINT32,
@@ -847,7 +1166,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
                                  (void*)&improper.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
+        writeNotice() << "GSD: writing impropers/group" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "impropers/group",
                                  GSD_TYPE_UINT32,
@@ -860,13 +1179,13 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
 
     if (constraint.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
+        writeNotice() << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
         int retval
             = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
+        writeNotice() << "GSD: writing constraints/value" << endl;
             {
             std::vector<float> data(N);
             data.reserve(1); //! make sure we allocate
@@ -883,7 +1202,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             GSDUtils::checkError(retval, m_fname);
             }
 
-        m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
+        writeNotice() << "GSD: writing constraints/group" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "constraints/group",
                                  GSD_TYPE_UINT32,
@@ -896,14 +1215,14 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
 
     if (pair.size > 0)
         {
-        m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
+        writeNotice() << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
         int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
+        writeNotice() << "GSD: writing pairs/typeid" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "pairs/typeid",
                                  GSD_TYPE_UINT32,
@@ -913,7 +1232,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
                                  (void*)&pair.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
+        writeNotice() << "GSD: writing pairs/group" << endl;
         retval = gsd_write_chunk(&m_handle,
                                  "pairs/group",
                                  GSD_TYPE_UINT32,
@@ -927,10 +1246,33 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
 
 void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
     {
+    writeLogChunks(convertLogQuantities(dict));
+    }
+
+void GSDDumpWriter::writeLogChunks(const std::vector<LogChunk>& log)
+    {
+    for (const auto& chunk : log)
+        {
+        writeNotice() << "GSD: writing " << chunk.name << endl;
+        int retval = gsd_write_chunk(&m_handle,
+                                     chunk.name.c_str(),
+                                     chunk.type,
+                                     chunk.N,
+                                     chunk.M,
+                                     0,
+                                     (void*)chunk.data.data());
+        GSDUtils::checkError(retval, m_fname);
+        }
+    }
+
+/*! Copy the data so that the I/O thread can write it without holding the GIL.
+ */
+std::vector<GSDDumpWriter::LogChunk> GSDDumpWriter::convertLogQuantities(pybind11::dict dict)
+    {
+    std::vector<LogChunk> log;
     for (auto key_iter = dict.begin(); key_iter != dict.end(); ++key_iter)
         {
         std::string name = pybind11::cast<std::string>(key_iter->first);
-        m_exec_conf->msg->notice(10) << "GSD: writing " << name << endl;
 
         pybind11::array arr = pybind11::array::ensure(key_iter->second, pybind11::array::c_style);
         gsd_type type = GSD_TYPE_UINT8;
@@ -1012,10 +1354,14 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
             throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
             }
 
-        int retval
-            = gsd_write_chunk(&m_handle, name.c_str(), type, N, (uint32_t)M, 0, (void*)arr.data());
-        GSDUtils::checkError(retval, m_fname);
+        const char* data = static_cast<const char*>(arr.data());
+        log.push_back(LogChunk {name,
+                                type,
+                                N,
+                                (uint32_t)M,
+                                std::vector<char>(data, data + arr.nbytes())});
         }
+    return log;
     }
 
 /*! Populate the m_nondefault map.
@@ -1047,6 +1393,10 @@ void GSDDumpWriter::populateNonDefault()
     for (auto const& chunk : particle_chunks)
         {
         const gsd_index_entry* entry = gsd_find_chunk(&m_handle, 0, chunk.c_str());
+        if (entry == nullptr)
+            {
+            entry = gsd_find_chunk(&m_handle, 0, (gsd_compressed_prefix + chunk).c_str());
+            }
         m_nondefault[chunk] = (entry != nullptr);
         }
 
@@ -1067,6 +1417,7 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
     std::bitset<n_gsd_flags> all_default;
     all_default.set();
     frame.clear();
+    frame.N = N;
 
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
@@ -1088,6 +1439,7 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
                 }
 
             frame.particle_tags.push_back(h_tag.data[index]);
+            frame.particle_index.push_back(group_tag_index);
             m_index.push_back(index);
             }
         }
@@ -1459,6 +1811,7 @@ void GSDDumpWriter::gatherGlobalFrame(const GSDFrame& local_frame)
 
     m_global_frame.timestep = local_frame.timestep;
     m_global_frame.global_box = local_frame.global_box;
+    m_global_frame.N = local_frame.N;
     m_global_frame.particle_data.type_mapping = local_frame.particle_data.type_mapping;
     m_global_frame.particle_data_present = local_frame.particle_data_present;
 
@@ -1522,6 +1875,233 @@ void GSDDumpWriter::gatherGlobalFrame(const GSDFrame& local_frame)
         }
     }
 
+/*! \param fd File descriptor
+    \param data Data to write
+    \param bytes Number of bytes to write
+    \param offset Offset in the file
+    \param fname File name (for error messages)
+*/
+static void
+writeAtOffset(int fd, const void* data, size_t bytes, uint64_t offset, const string& fname)
+    {
+    const char* ptr = static_cast<const char*>(data);
+    while (bytes > 0)
+        {
+        ssize_t bytes_written = pwrite(fd, ptr, bytes, static_cast<off_t>(offset));
+        if (bytes_written == -1 && errno == EINTR)
+            {
+            continue;
+            }
+        if (bytes_written <= 0)
+            {
+            throw runtime_error("GSD: error writing " + fname + ": " + strerror(errno));
+            }
+
+        ptr += bytes_written;
+        bytes -= bytes_written;
+        offset += bytes_written;
+        }
+    }
+
+/*! Write the frame header and log quantities on the root rank and the particle data chunks from
+    all ranks. The ranks first exchange particles so that each holds a contiguous slab of the
+    group in file order. The root rank then reserves space for every particle data chunk in the
+    frame and broadcasts the chunk locations. Each rank writes its slab of each chunk at the slab's
+    offset in the chunk. The ranks synchronize after writing so that the root rank writes the index
+    in gsd_end_frame() only after all slabs are in the file.
+*/
+void GSDDumpWriter::writeDistributed(const GSDFrame& local_frame, pybind11::dict log_data)
+    {
+    const uint32_t N = local_frame.N;
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+    if (m_exec_conf->isRoot())
+        {
+        writeFrameHeader(local_frame);
+        if (m_dynamic[gsd_flag::particles_types] || m_nframes == 0)
+            {
+            writeTypeMapping("particles/types", local_frame.particle_data.type_mapping);
+            }
+        writeLogQuantities(log_data);
+        }
+
+    m_distribute_index_order.setLocalIndicesSorted(local_frame.particle_index, N);
+    m_slab_frame.clear();
+
+    // Particle data chunk with this rank's slab of the data
+    struct SlabChunk
+        {
+        std::string name;
+        gsd_type type;
+        uint32_t M;
+        size_t row_bytes;
+        const void* data;
+        };
+    std::vector<SlabChunk> chunks;
+
+    // The present flags are the same on all ranks, so all ranks distribute the same arrays.
+    auto distribute = [&](unsigned int flag,
+                          const std::string& name,
+                          gsd_type type,
+                          uint32_t M,
+                          auto& slab,
+                          const auto& local)
+    {
+        if (!local_frame.particle_data_present[flag])
+            {
+            return;
+            }
+
+        m_distribute_index_order.distributeArray(slab, local);
+        chunks.push_back(SlabChunk {name,
+                                    type,
+                                    M,
+                                    sizeof(typename std::decay_t<decltype(slab)>::value_type),
+                                    slab.data()});
+    };
+
+    const SnapshotParticleData<float>& local_data = local_frame.particle_data;
+    SnapshotParticleData<float>& slab_data = m_slab_frame.particle_data;
+    distribute(gsd_flag::particles_type,
+               "particles/typeid",
+               GSD_TYPE_UINT32,
+               1,
+               slab_data.type,
+               local_data.type);
+    distribute(gsd_flag::particles_mass,
+               "particles/mass",
+               GSD_TYPE_FLOAT,
+               1,
+               slab_data.mass,
+               local_data.mass);
+    distribute(gsd_flag::particles_charge,
+               "particles/charge",
+               GSD_TYPE_FLOAT,
+               1,
+               slab_data.charge,
+               local_data.charge);
+    if (m_write_diameter)
+        {
+        distribute(gsd_flag::particles_diameter,
+                   "particles/diameter",
+                   GSD_TYPE_FLOAT,
+                   1,
+                   slab_data.diameter,
+                   local_data.diameter);
+        }
+    distribute(gsd_flag::particles_body,
+               "particles/body",
+               GSD_TYPE_INT32,
+               1,
+               slab_data.body,
+               local_data.body);
+    distribute(gsd_flag::particles_inertia,
+               "particles/moment_inertia",
+               GSD_TYPE_FLOAT,
+               3,
+               slab_data.inertia,
+               local_data.inertia);
+    distribute(gsd_flag::particles_position,
+               "particles/position",
+               GSD_TYPE_FLOAT,
+               3,
+               slab_data.pos,
+               local_data.pos);
+    distribute(gsd_flag::particles_orientation,
+               "particles/orientation",
+               GSD_TYPE_FLOAT,
+               4,
+               slab_data.orientation,
+               local_data.orientation);
+    distribute(gsd_flag::particles_velocity,
+               "particles/velocity",
+               GSD_TYPE_FLOAT,
+               3,
+               slab_data.vel,
+               local_data.vel);
+    distribute(gsd_flag::particles_angmom,
+               "particles/angmom",
+               GSD_TYPE_FLOAT,
+               4,
+               slab_data.angmom,
+               local_data.angmom);
+    distribute(gsd_flag::particles_image,
+               "particles/image",
+               GSD_TYPE_INT32,
+               3,
+               slab_data.image,
+               local_data.image);
+
+    // Reserve the chunks at the end of the file on the root rank. The buffered chunks and any
+    // expansion of the file index are placed after the reserved space.
+    std::vector<uint64_t> locations(chunks.size());
+    if (m_exec_conf->isRoot())
+        {
+        for (size_t i = 0; i < chunks.size(); i++)
+            {
+            writeNotice() << "GSD: reserving " << chunks[i].name << endl;
+            int retval = gsd_reserve_chunk(&m_handle,
+                                           chunks[i].name.c_str(),
+                                           chunks[i].type,
+                                           N,
+                                           chunks[i].M,
+                                           0,
+                                           &locations[i]);
+            GSDUtils::checkError(retval, m_fname);
+            }
+        }
+    MPI_Bcast(locations.data(), int(locations.size()), MPI_UINT64_T, 0, mpi_comm);
+
+    // The root rank created the file in initFileIO(), so every rank can open it now. Use the
+    // root rank's file name in case the ranks were given different relative paths.
+    if (m_fd == -1)
+        {
+        std::string fname = m_fname;
+        bcast(fname, 0, mpi_comm);
+        m_fd = open(fname.c_str(), O_WRONLY);
+        if (m_fd == -1)
+            {
+            throw runtime_error("GSD: unable to open " + fname + ": " + strerror(errno));
+            }
+        }
+
+    const uint64_t slab_begin = m_distribute_index_order.getSlabBegin();
+    const uint64_t slab_size = m_distribute_index_order.getSlabSize();
+    for (size_t i = 0; i < chunks.size(); i++)
+        {
+        writeNotice() << "GSD: writing " << chunks[i].name << endl;
+        writeAtOffset(m_fd,
+                      chunks[i].data,
+                      slab_size * chunks[i].row_bytes,
+                      locations[i] + slab_begin * chunks[i].row_bytes,
+                      m_fname);
+
+        if (m_nframes == 0)
+            m_nondefault[chunks[i].name] = true;
+        }
+
+    // The root rank may write the index for this frame once all slabs are in the file.
+    MPI_Barrier(mpi_comm);
+    }
+
+/*! The root rank syncs its own descriptor when it writes the index of each frame. Sync the
+    descriptors of all ranks as well so that every frame written so far is on disk.
+*/
+void GSDDumpWriter::syncDistributed()
+    {
+    // all ranks open m_fd in the same call to writeDistributed()
+    if (m_fd == -1)
+        {
+        return;
+        }
+
+    if (fsync(m_fd) != 0)
+        {
+        throw runtime_error("GSD: error syncing " + m_fname + ": " + strerror(errno));
+        }
+    MPI_Barrier(m_exec_conf->getMPICommunicator());
+    }
+
 #endif
 
 namespace detail
@@ -1551,7 +2131,26 @@ void export_GSDDumpWriter(pybind11::module& m)
         .def("flush", &GSDDumpWriter::flush)
         .def_property("maximum_write_buffer_size",
                       &GSDDumpWriter::getMaximumWriteBufferSize,
-                      &GSDDumpWriter::setMaximumWriteBufferSize);
+                      &GSDDumpWriter::setMaximumWriteBufferSize)
+        .def_property("distributed_write",
+                      &GSDDumpWriter::getDistributedWrite,
+                      &GSDDumpWriter::setDistributedWrite)
+        .def_property("async_write", &GSDDumpWriter::getAsyncWrite, &GSDDumpWriter::setAsyncWrite)
+        .def_property("maximum_write_queue_size",
+                      &GSDDumpWriter::getMaximumWriteQueueSize,
+                      &GSDDumpWriter::setMaximumWriteQueueSize)
+        .def_property("position_precision",
+                      &GSDDumpWriter::getPositionPrecision,
+                      &GSDDumpWriter::setPositionPrecision)
+        .def_property("orientation_precision",
+                      &GSDDumpWriter::getOrientationPrecision,
+                      &GSDDumpWriter::setOrientationPrecision)
+        .def_property("velocity_precision",
+                      &GSDDumpWriter::getVelocityPrecision,
+                      &GSDDumpWriter::setVelocityPrecision)
+        .def_property("keyframe_interval",
+                      &GSDDumpWriter::getKeyframeInterval,
+                      &GSDDumpWriter::setKeyframeInterval);
     }
 
     } // end namespace detail
@@ -4,12 +4,19 @@
 #pragma once
 
 #include "Analyzer.h"
+#include "GSDCompression.h"
 #include "ParticleGroup.h"
 #include "SharedSignal.h"
 
 #include "hoomd/extern/gsd.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 /*! \file GSDDumpWriter.h
     \brief Declares the GSDDumpWriter class
@@ -30,6 +37,27 @@ namespace hoomd
 
     The file is not opened until the first call to analyze().
 
+    In MPI simulations, GSDDumpWriter gathers all particle data on the root rank, which writes the
+    file. With distributed writes enabled, the ranks instead exchange particle data so that each
+    holds a contiguous slab of particles in file order. The root rank reserves space for each
+    particle data chunk in the frame and writes the index, and every rank writes its own slab of
+    each chunk directly to the file. The ranks synchronize after writing each frame, before the
+    root rank writes the frame's index. flush() also syncs the writes of all ranks to disk.
+
+    With asynchronous writes enabled, the rank that writes the file moves each populated (or
+    gathered) frame into a bounded queue and returns to the simulation. A dedicated I/O thread
+    writes the queued frames in order. When the queue is full, analyze() waits for the I/O thread
+    to finish a frame. flush(), changes to settings that affect the file contents, and the
+    destructor wait until all queued frames have been written. The I/O thread never calls into
+    Python: log quantities are copied out of their numpy arrays before the frame is queued.
+    Distributed writes are always synchronous.
+
+    Position, orientation, and velocity may optionally be written with a lossy compressed encoding
+    (see GSDCompression.h) by setting a positive precision for the quantity. Compressed chunks are
+    written under the name gsd_compressed_prefix + the chunk name and GSDReader decodes them. Every
+    keyframe_interval frames (and whenever N changes or the file is truncated) the chunk is encoded
+    without reference to previous frames. Distributed writes always write uncompressed chunks.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -116,6 +144,7 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Set the write_diameter flag
     void setWriteDiameter(bool write_diameter)
         {
+        waitForQueuedFrames();
         m_write_diameter = write_diameter;
         }
 
@@ -128,6 +157,88 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Get the maximum write buffer size (in bytes)
     uint64_t getMaximumWriteBufferSize();
 
+    /// Get the distributed_write flag
+    bool getDistributedWrite()
+        {
+        return m_distributed_write;
+        }
+
+    /// Set the distributed_write flag
+    void setDistributedWrite(bool distributed_write)
+        {
+        m_distributed_write = distributed_write;
+        }
+
+    /// Get the async_write flag
+    bool getAsyncWrite()
+        {
+        return m_async_write;
+        }
+
+    /// Set the async_write flag
+    void setAsyncWrite(bool async_write);
+
+    /// Get the maximum number of frames waiting to be written by the I/O thread
+    unsigned int getMaximumWriteQueueSize()
+        {
+        return m_maximum_write_queue_size;
+        }
+
+    /// Set the maximum number of frames waiting to be written by the I/O thread
+    void setMaximumWriteQueueSize(unsigned int size);
+
+    /// Get the quantization step of compressed positions (0 writes uncompressed positions)
+    float getPositionPrecision()
+        {
+        return m_position_precision;
+        }
+
+    /// Set the quantization step of compressed positions (0 writes uncompressed positions)
+    void setPositionPrecision(float precision)
+        {
+        waitForQueuedFrames();
+        m_position_precision = precision;
+        }
+
+    /// Get the quantization step of compressed orientations (0 writes uncompressed orientations)
+    float getOrientationPrecision()
+        {
+        return m_orientation_precision;
+        }
+
+    /// Set the quantization step of compressed orientations (0 writes uncompressed orientations)
+    void setOrientationPrecision(float precision)
+        {
+        waitForQueuedFrames();
+        m_orientation_precision = precision;
+        }
+
+    /// Get the quantization step of compressed velocities (0 writes uncompressed velocities)
+    float getVelocityPrecision()
+        {
+        return m_velocity_precision;
+        }
+
+    /// Set the quantization step of compressed velocities (0 writes uncompressed velocities)
+    void setVelocityPrecision(float precision)
+        {
+        waitForQueuedFrames();
+        m_velocity_precision = precision;
+        }
+
+    /// Get the maximum number of frames between compressed key frames
+    unsigned int getKeyframeInterval()
+        {
+        return m_keyframe_interval;
+        }
+
+    /// Set the maximum number of frames between compressed key frames
+    void setKeyframeInterval(unsigned int interval)
+        {
+        waitForQueuedFrames();
+        m_keyframe_interval = interval;
+        }
+
     protected:
     gsd_handle m_handle; //!< Handle to the file
 
@@ -172,8 +283,17 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         uint64_t timestep;
         BoxDim global_box;
 
+        /// Number of particles in the group when the frame was populated.
+        uint32_t N = 0;
+
+        /// True when this frame is frame 0 of the file (set by write()).
+        bool first_frame = false;
+
         std::vector<unsigned int> particle_tags;
 
+        /// Index of each particle in the group (its row in the file), in the same order as tags.
+        std::vector<unsigned int> particle_index;
+
         SnapshotParticleData<float> particle_data;
         BondData::Snapshot bond_data;
         AngleData::Snapshot angle_data;
@@ -188,6 +308,7 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         void clear()
             {
             particle_tags.resize(0);
+            particle_index.resize(0);
             particle_data.resize(0);
             bond_data.resize(0);
             angle_data.resize(0);
@@ -207,8 +328,14 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     pybind11::dict getLogData() const;
 
     //! Write a frame to the GSD file buffer
+    /*! In asynchronous mode, the frame's contents are swapped into the write queue and \a frame
+        is left holding a previously written frame. Callers must repopulate it before reuse.
+    */
     void write(GSDFrame& frame, pybind11::dict log_data);
 
+    /// Wait until the I/O thread has written all queued frames
+    void waitForQueuedFrames();
+
     //! Check and raise an exception if an error occurs
     void checkError(int retval);
 
@@ -224,14 +351,68 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     GatherTagOrder m_gather_tag_order;
 
     void gatherGlobalFrame(const GSDFrame& local_frame);
+
+    /// This rank's slab of the particle data in file order, for distributed writes.
+    GSDFrame m_slab_frame;
+    DistributeIndexOrder m_distribute_index_order;
+
+    /// File descriptor this rank uses for distributed writes (-1 when not open).
+    int m_fd = -1;
+
+    /// Write a frame's header, particle data, and log quantities with all ranks writing.
+    void writeDistributed(const GSDFrame& local_frame, pybind11::dict log_data);
+
+    /// Sync the distributed writes of all ranks to the file.
+    void syncDistributed();
 #endif
 
     private:
-    std::string m_fname;           //!< The file name we are writing to
-    std::string m_mode;            //!< The file open mode
-    bool m_truncate = false;       //!< True if we should truncate the file on every analyze()
-    bool m_write_topology = false; //!< True if topology should be written
-    bool m_write_diameter = false; //!< True if the diameter attribute should be written
+    /// A log quantity copied out of its numpy array.
+    struct LogChunk
+        {
+        std::string name;
+        gsd_type type;
+        uint64_t N;
+        uint32_t M;
+        std::vector<char> data;
+        };
+
+    /// A frame waiting to be written by the I/O thread.
+    struct QueuedFrame
+        {
+        GSDFrame frame;
+        std::vector<LogChunk> log;
+        bool write_topology = false;
+        };
+
+    std::string m_fname;              //!< The file name we are writing to
+    std::string m_mode;               //!< The file open mode
+    bool m_truncate = false;          //!< True if we should truncate the file on every analyze()
+    bool m_write_topology = false;    //!< True if topology should be written
+    bool m_write_diameter = false;    //!< True if the diameter attribute should be written
+    bool m_distributed_write = false; //!< True if all ranks write their particle data
+    bool m_async_write = false;       //!< True if frames are written by the I/O thread
+
+    /// Maximum number of frames in the write queue (including the one being written).
+    unsigned int m_maximum_write_queue_size = 2;
+
+    float m_position_precision = 0;        //!< Quantization step of compressed positions
+    float m_orientation_precision = 0;     //!< Quantization step of compressed orientations
+    float m_velocity_precision = 0;        //!< Quantization step of compressed velocities
+    unsigned int m_keyframe_interval = 10; //!< Maximum number of frames between key frames
+
+    detail::GSDCompressor m_position_compressor;    //!< Encoder state of particles/position
+    detail::GSDCompressor m_orientation_compressor; //!< Encoder state of particles/orientation
+    detail::GSDCompressor m_velocity_compressor;    //!< Encoder state of particles/velocity
+    std::vector<char> m_compressed_buffer;          //!< Holds the encoded chunk being written
+
+    std::thread m_io_thread;               //!< Thread that writes queued frames
+    std::mutex m_queue_mutex;              //!< Protects the write queue state below
+    std::condition_variable m_queue_cv;    //!< Signaled when the write queue state changes
+    std::deque<QueuedFrame> m_write_queue; //!< Frames to write, the front is being written
+    std::vector<GSDFrame> m_free_frames;   //!< Written frames kept to reuse their allocations
+    bool m_stop_io_thread = false;         //!< Set to ask the I/O thread to exit when idle
+    std::exception_ptr m_io_error;         //!< First error raised on the I/O thread
 
     /// Flags indicating which particle fields are dynamic.
     std::bitset<n_gsd_flags> m_dynamic;
@@ -254,6 +435,33 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Working array to sort local particles by tag
     std::vector<unsigned int> m_index;
 
+    /// Copy log quantities out of their numpy arrays.
+    std::vector<LogChunk> convertLogQuantities(pybind11::dict dict);
+
+    /// Write copied log quantities.
+    void writeLogChunks(const std::vector<LogChunk>& log);
+
+    /// Write a whole frame and end it.
+    void writeFrame(const GSDFrame& frame, const std::vector<LogChunk>& log, bool write_topology);
+
+    /// Write the frame now, or queue it for the I/O thread in asynchronous mode.
+    void queueFrame(GSDFrame& frame, pybind11::dict log_data, bool write_topology);
+
+    /// Mark the particle data chunks present in frame 0 as non-default.
+    void updateNonDefault(const GSDFrame& frame);
+
+    /// Entry point of the I/O thread.
+    void writeQueuedFrames();
+
+    /// Write all queued frames and join the I/O thread.
+    void stopIOThread();
+
+    /// Rethrow an error from the I/O thread. Call with m_queue_mutex held.
+    void rethrowIOError();
+
+    /// Stream for diagnostic messages while writing.
+    std::ostream& writeNotice();
+
     //! Write a type mapping out to the file
     void writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping);
 
@@ -269,13 +477,21 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     //! Write particle momenta
     void writeMomenta(const GSDFrame& frame);
 
+    /// Write a float particle chunk, compressed when precision is positive
+    void writeParticleChunk(const std::string& name,
+                            const float* data,
+                            uint32_t N,
+                            uint32_t M,
+                            float precision,
+                            detail::GSDCompressor& compressor);
+
     //! Write bond topology
-    void writeTopology(BondData::Snapshot& bond,
-                       AngleData::Snapshot& angle,
-                       DihedralData::Snapshot& dihedral,
-                       ImproperData::Snapshot& improper,
-                       ConstraintData::Snapshot& constraint,
-                       PairData::Snapshot& pair);
+    void writeTopology(const BondData::Snapshot& bond,
+                       const AngleData::Snapshot& angle,
+                       const DihedralData::Snapshot& dihedral,
+                       const ImproperData::Snapshot& improper,
+                       const ConstraintData::Snapshot& constraint,
+                       const PairData::Snapshot& pair);
 
     friend void export_GSDDumpWriter(pybind11::module& m);
     };
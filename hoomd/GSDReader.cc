@@ -6,8 +6,10 @@
 #include "GSD.h"
 #include "SnapshotSystemData.h"
 #include "hoomd/extern/gsd.h"
+#include <algorithm>
 #include <sstream>
 #include <string.h>
+#include <unistd.h>
 
 #include <stdexcept>
 using namespace std;
@@ -19,21 +21,30 @@ namespace hoomd
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Set to true to read a slab of the particles and groups on every rank
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file
    into memory (on the root rank).
+
+    When \a distributed is set and there is more than one rank, every rank opens the file and
+    reads the rows [computeSlab()) of each per-particle and per-group chunk, in tag order. The
+    resulting snapshot is meant for SystemDefinition with distributed_snapshot set.
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string& name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_distributed(false),
+      m_n_particles(0)
     {
     m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
 
 #ifdef ENABLE_MPI
+    m_distributed = distributed && m_exec_conf->getNRanks() > 1;
+
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -81,7 +92,7 @@ GSDReader::~GSDReader()
     {
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -137,6 +148,257 @@ bool GSDReader::readChunk(void* data,
         }
     }
 
+/*! \param data Pointer to (end - begin) rows to read into
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param row_size Size of one row (N index) of the data chunk in bytes
+    \param cur_n N in the current frame.
+    \param begin First row to read
+    \param end One past the last row to read
+
+    Like readChunk(), but reads only the given rows. A partial read fetches just the needed bytes
+    from the file so that many ranks can each read a slab of a large chunk.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readChunkRange(void* data,
+                               uint64_t frame,
+                               const char* name,
+                               size_t row_size,
+                               unsigned int cur_n,
+                               unsigned int begin,
+                               unsigned int end)
+    {
+    if (begin == 0 && end == cur_n)
+        return readChunk(data, frame, name, row_size * cur_n, cur_n);
+
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name);
+    if (entry == NULL && frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || entry->N != cur_n)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading rows " << begin << " to " << end
+                                << " of chunk " << name << endl;
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != row_size * cur_n)
+        {
+        std::ostringstream s;
+        s << "Expecting " << row_size * cur_n << " bytes in " << name << " but found "
+          << actual_size << ".";
+        throw runtime_error(s.str());
+        }
+
+    // read the bytes of the requested rows directly
+    readBytes(data, entry->location + row_size * begin, row_size * (end - begin));
+    return true;
+    }
+
+/*! \param data Pointer to \a size bytes to read into
+    \param location Position of the first byte in the file
+    \param size Number of bytes to read
+*/
+void GSDReader::readBytes(void* data, uint64_t location, size_t size)
+    {
+    char* out = static_cast<char*>(data);
+    size_t remaining = size;
+    off_t offset = static_cast<off_t>(location);
+    while (remaining > 0)
+        {
+        ssize_t bytes_read = ::pread(m_handle.fd, out, remaining, offset);
+        if (bytes_read <= 0)
+            {
+            GSDUtils::checkError(bytes_read == 0 ? GSD_ERROR_FILE_CORRUPT : GSD_ERROR_IO, m_name);
+            }
+        out += bytes_read;
+        remaining -= bytes_read;
+        offset += bytes_read;
+        }
+    }
+
+/*! \param data Pointer to (end - begin) * M floats to read into
+    \param frame Frame index to read from
+    \param name Name of the (uncompressed) data chunk
+    \param M Number of columns
+    \param cur_n N in the current frame.
+    \param begin First row to read
+    \param end One past the last row to read
+
+    Like readChunkRange(), but also accepts the compressed chunk written by GSDDumpWriter when a
+    precision is set. At each of the given frame and frame 0, the compressed chunk is preferred
+    over the uncompressed one. Of a compressed chunk, only the blocks that hold the requested rows
+    are read and decoded.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readParticleChunk(float* data,
+                                  uint64_t frame,
+                                  const std::string& name,
+                                  uint32_t M,
+                                  unsigned int cur_n,
+                                  unsigned int begin,
+                                  unsigned int end)
+    {
+    const std::string compressed_name = gsd_compressed_prefix + name;
+
+    for (uint64_t f : {frame, uint64_t(0)})
+        {
+        if (gsd_find_chunk(&m_handle, f, compressed_name.c_str()) != NULL)
+            {
+            m_exec_conf->msg->notice(7)
+                << "data.gsd_snapshot: reading chunk " << compressed_name << endl;
+
+            std::vector<int64_t> values;
+            std::vector<uint64_t> blocks;
+            GSDCompressedHeader header;
+            if (!readCompressedValues(values, header, blocks, f, compressed_name, begin, end))
+                {
+                std::ostringstream s;
+                s << "Invalid compressed chunk " << compressed_name << " in frame " << f << ".";
+                throw runtime_error(s.str());
+                }
+
+            if (header.N != cur_n)
+                return false;
+
+            if (header.M != M)
+                {
+                std::ostringstream s;
+                s << "Expecting " << M << " columns in " << compressed_name << " but found "
+                  << header.M << ".";
+                throw runtime_error(s.str());
+                }
+
+            if (begin == end)
+                return true;
+
+            // rows [begin, end) of each column are in consecutive decoded blocks
+            const uint64_t block_size = header.block_size;
+            for (uint32_t c = 0; c < M; c++)
+                {
+                const uint64_t first_value = uint64_t(c) * cur_n + begin;
+                const uint64_t first_block = first_value / block_size;
+                const uint64_t j = std::lower_bound(blocks.begin(), blocks.end(), first_block)
+                                   - blocks.begin();
+                const int64_t* column = values.data() + j * block_size
+                                        + (first_value - first_block * block_size);
+                for (unsigned int i = begin; i < end; i++)
+                    {
+                    data[(i - begin) * M + c]
+                        = static_cast<float>(double(column[i - begin]) * header.precision);
+                    }
+                }
+            return true;
+            }
+
+        if (gsd_find_chunk(&m_handle, f, name.c_str()) != NULL)
+            return readChunkRange(data, f, name.c_str(), size_t(M) * 4, cur_n, begin, end);
+
+        if (frame == 0)
+            break;
+        }
+
+    m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+    return false;
+    }
+
+/*! \param values Output quantized values of \a blocks (see GSDCompressor::decodeBlocks())
+    \param header Output header of the chunk
+    \param blocks Output indices of the blocks that hold rows [begin, end)
+    \param frame Frame index to read from
+    \param name Name of the compressed data chunk
+    \param begin First row to decode
+    \param end One past the last row to decode
+
+    Reads the header, the block offset table, and the encoded data of the needed blocks only.
+    Delta encoded frames are decoded on top of the same blocks of their reference frame, which is
+    read recursively.
+
+    Return false if the chunk is missing or invalid.
+*/
+bool GSDReader::readCompressedValues(std::vector<int64_t>& values,
+                                     GSDCompressedHeader& header,
+                                     std::vector<uint64_t>& blocks,
+                                     uint64_t frame,
+                                     const std::string& name,
+                                     unsigned int begin,
+                                     unsigned int end)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, frame, name.c_str());
+    if (entry == NULL || entry->type != GSD_TYPE_UINT8)
+        return false;
+
+    // readHeader() only accesses the header bytes, the size is that of the whole chunk
+    const uint64_t size = entry->N * entry->M;
+    if (size < sizeof(header))
+        return false;
+    std::vector<char> header_data(sizeof(header));
+    readBytes(header_data.data(), entry->location, header_data.size());
+    if (!GSDCompressor::readHeader(header, header_data.data(), size))
+        return false;
+
+    std::vector<uint64_t> offsets(header.n_blocks + 1);
+    readBytes(offsets.data(), entry->location + sizeof(header), offsets.size() * sizeof(uint64_t));
+    const uint64_t data_start = sizeof(header) + offsets.size() * sizeof(uint64_t);
+
+    blocks = GSDCompressor::findBlocks(header, begin, end);
+    std::vector<uint64_t> block_offsets(blocks.size() + 1, 0);
+    for (size_t j = 0; j < blocks.size(); j++)
+        {
+        const uint64_t b = blocks[j];
+        if (offsets[b] > offsets[b + 1] || offsets[b + 1] > size - data_start)
+            return false;
+        block_offsets[j + 1] = block_offsets[j] + (offsets[b + 1] - offsets[b]);
+        }
+
+    // the data of consecutive blocks is contiguous in the file, read each run at once
+    std::vector<char> block_data(block_offsets.back());
+    for (size_t j = 0; j < blocks.size();)
+        {
+        size_t run_end = j + 1;
+        while (run_end < blocks.size() && blocks[run_end] == blocks[run_end - 1] + 1)
+            run_end++;
+        readBytes(block_data.data() + block_offsets[j],
+                  entry->location + data_start + offsets[blocks[j]],
+                  block_offsets[run_end] - block_offsets[j]);
+        j = run_end;
+        }
+
+    std::vector<int64_t> reference;
+    if (header.reference != 0)
+        {
+        if (header.reference > frame)
+            return false;
+
+        GSDCompressedHeader reference_header;
+        std::vector<uint64_t> reference_blocks;
+        if (!readCompressedValues(reference,
+                                  reference_header,
+                                  reference_blocks,
+                                  frame - header.reference,
+                                  name,
+                                  begin,
+                                  end))
+            return false;
+
+        if (reference_header.N != header.N || reference_header.M != header.M
+            || reference_header.precision != header.precision || reference_blocks != blocks)
+            return false;
+        }
+
+    return GSDCompressor::decodeBlocks(values,
+                                       header,
+                                       blocks,
+                                       block_data.data(),
+                                       block_offsets,
+                                       header.reference != 0 ? &reference : nullptr,
+                                       m_exec_conf);
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -180,6 +442,28 @@ std::vector<std::string> GSDReader::readTypes(uint64_t frame, const char* name)
         }
     }
 
+/*! \param n Number of rows in the chunk
+    \param begin Output first row this rank reads
+    \param end Output one past the last row this rank reads
+
+    Each rank reads the rows of its DistributeIndexOrder slab when the reader is distributed, and
+    all rows otherwise.
+*/
+void GSDReader::computeSlab(unsigned int n, unsigned int& begin, unsigned int& end) const
+    {
+    begin = 0;
+    end = n;
+#ifdef ENABLE_MPI
+    if (m_distributed)
+        {
+        int rank = m_exec_conf->getRank();
+        int n_ranks = m_exec_conf->getNRanks();
+        begin = DistributeIndexOrder::computeSlabBegin(rank, n_ranks, n);
+        end = DistributeIndexOrder::computeSlabBegin(rank + 1, n_ranks, n);
+        }
+#endif
+    }
+
 /*! Read the same data chunks written by GSDDumpWriter::writeFrameHeader
  */
 void GSDReader::readHeader()
@@ -210,111 +494,121 @@ void GSDReader::readHeader()
         s << "Cannot read a file with 0 particles.";
         throw runtime_error(s.str());
         }
-    m_snapshot->particle_data.resize(N);
+    m_n_particles = N;
+
+    unsigned int begin, end;
+    computeSlab(N, begin, end);
+    m_snapshot->particle_data.resize(end - begin);
     }
 
 /*! Read the same data chunks for particles
  */
 void GSDReader::readParticles()
     {
-    unsigned int N = m_snapshot->particle_data.size;
-    m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+    unsigned int N = m_n_particles;
+    unsigned int begin, end;
+    computeSlab(N, begin, end);
+    SnapshotParticleData<float>& pdata = m_snapshot->particle_data;
+    pdata.type_mapping = readTypes(m_frame, "particles/types");
 
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
-    readChunk(m_snapshot->particle_data.type.data(), m_frame, "particles/typeid", N * 4, N);
-    readChunk(m_snapshot->particle_data.mass.data(), m_frame, "particles/mass", N * 4, N);
-    readChunk(m_snapshot->particle_data.charge.data(), m_frame, "particles/charge", N * 4, N);
-    readChunk(m_snapshot->particle_data.diameter.data(), m_frame, "particles/diameter", N * 4, N);
-    readChunk(m_snapshot->particle_data.body.data(), m_frame, "particles/body", N * 4, N);
-    readChunk(m_snapshot->particle_data.inertia.data(),
-              m_frame,
-              "particles/moment_inertia",
-              N * 12,
-              N);
-    readChunk(m_snapshot->particle_data.pos.data(), m_frame, "particles/position", N * 12, N);
-    readChunk(m_snapshot->particle_data.orientation.data(),
-              m_frame,
-              "particles/orientation",
-              N * 16,
-              N);
-    readChunk(m_snapshot->particle_data.vel.data(), m_frame, "particles/velocity", N * 12, N);
-    readChunk(m_snapshot->particle_data.angmom.data(), m_frame, "particles/angmom", N * 16, N);
-    readChunk(m_snapshot->particle_data.image.data(), m_frame, "particles/image", N * 12, N);
+    readChunkRange(pdata.type.data(), m_frame, "particles/typeid", 4, N, begin, end);
+    readChunkRange(pdata.mass.data(), m_frame, "particles/mass", 4, N, begin, end);
+    readChunkRange(pdata.charge.data(), m_frame, "particles/charge", 4, N, begin, end);
+    readChunkRange(pdata.diameter.data(), m_frame, "particles/diameter", 4, N, begin, end);
+    readChunkRange(pdata.body.data(), m_frame, "particles/body", 4, N, begin, end);
+    readChunkRange(pdata.inertia.data(), m_frame, "particles/moment_inertia", 12, N, begin, end);
+    readParticleChunk(reinterpret_cast<float*>(pdata.pos.data()),
+                      m_frame,
+                      "particles/position",
+                      3,
+                      N,
+                      begin,
+                      end);
+    readParticleChunk(reinterpret_cast<float*>(pdata.orientation.data()),
+                      m_frame,
+                      "particles/orientation",
+                      4,
+                      N,
+                      begin,
+                      end);
+    readParticleChunk(reinterpret_cast<float*>(pdata.vel.data()),
+                      m_frame,
+                      "particles/velocity",
+                      3,
+                      N,
+                      begin,
+                      end);
+    readChunkRange(pdata.angmom.data(), m_frame, "particles/angmom", 16, N, begin, end);
+    readChunkRange(pdata.image.data(), m_frame, "particles/image", 12, N, begin, end);
     }
 
-/*! Read the same data chunks for topology
- */
-void GSDReader::readTopology()
+/*! \param snapshot Group snapshot to read into
+    \param prefix Name of the group in the file (e.g. bonds)
+    \param group_row_size Size of one entry of the group chunk in bytes
+*/
+template<class Snapshot>
+void GSDReader::readGroups(Snapshot& snapshot, const std::string& prefix, size_t group_row_size)
     {
     unsigned int N = 0;
-    m_snapshot->bond_data.type_mapping = readTypes(m_frame, "bonds/types");
-    readChunk(&N, m_frame, "bonds/N", 4);
-    if (N > 0)
-        {
-        m_snapshot->bond_data.resize(N);
-        readChunk(m_snapshot->bond_data.type_id.data(), m_frame, "bonds/typeid", N * 4, N);
-        readChunk(m_snapshot->bond_data.groups.data(), m_frame, "bonds/group", N * 8, N);
-        }
-
-    N = 0;
-    m_snapshot->angle_data.type_mapping = readTypes(m_frame, "angles/types");
-    readChunk(&N, m_frame, "angles/N", 4);
+    snapshot.type_mapping = readTypes(m_frame, (prefix + "/types").c_str());
+    readChunk(&N, m_frame, (prefix + "/N").c_str(), 4);
     if (N > 0)
         {
-        m_snapshot->angle_data.resize(N);
-        readChunk(m_snapshot->angle_data.type_id.data(), m_frame, "angles/typeid", N * 4, N);
-        readChunk(m_snapshot->angle_data.groups.data(), m_frame, "angles/group", N * 12, N);
-        }
-
-    N = 0;
-    m_snapshot->dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
-    readChunk(&N, m_frame, "dihedrals/N", 4);
-    if (N > 0)
-        {
-        m_snapshot->dihedral_data.resize(N);
-        readChunk(m_snapshot->dihedral_data.type_id.data(), m_frame, "dihedrals/typeid", N * 4, N);
-        readChunk(m_snapshot->dihedral_data.groups.data(), m_frame, "dihedrals/group", N * 16, N);
+        unsigned int begin, end;
+        computeSlab(N, begin, end);
+        snapshot.resize(end - begin);
+        readChunkRange(snapshot.type_id.data(),
+                       m_frame,
+                       (prefix + "/typeid").c_str(),
+                       4,
+                       N,
+                       begin,
+                       end);
+        readChunkRange(snapshot.groups.data(),
+                       m_frame,
+                       (prefix + "/group").c_str(),
+                       group_row_size,
+                       N,
+                       begin,
+                       end);
         }
+    }
 
-    N = 0;
-    m_snapshot->improper_data.type_mapping = readTypes(m_frame, "impropers/types");
-    readChunk(&N, m_frame, "impropers/N", 4);
-    if (N > 0)
-        {
-        m_snapshot->improper_data.resize(N);
-        readChunk(m_snapshot->improper_data.type_id.data(), m_frame, "impropers/typeid", N * 4, N);
-        readChunk(m_snapshot->improper_data.groups.data(), m_frame, "impropers/group", N * 16, N);
-        }
+/*! Read the same data chunks for topology
+ */
+void GSDReader::readTopology()
+    {
+    readGroups(m_snapshot->bond_data, "bonds", 8);
+    readGroups(m_snapshot->angle_data, "angles", 12);
+    readGroups(m_snapshot->dihedral_data, "dihedrals", 16);
+    readGroups(m_snapshot->improper_data, "impropers", 16);
 
-    N = 0;
+    unsigned int N = 0;
     readChunk(&N, m_frame, "constraints/N", 4);
     if (N > 0)
         {
-        m_snapshot->constraint_data.resize(N);
-        std::vector<float> data(N);
-        readChunk(&data[0], m_frame, "constraints/value", N * 4, N);
-        for (unsigned int i = 0; i < N; i++)
+        unsigned int begin, end;
+        computeSlab(N, begin, end);
+        m_snapshot->constraint_data.resize(end - begin);
+        std::vector<float> data(end - begin);
+        readChunkRange(data.data(), m_frame, "constraints/value", 4, N, begin, end);
+        for (unsigned int i = 0; i < end - begin; i++)
             m_snapshot->constraint_data.val[i] = Scalar(data[i]);
 
-        readChunk(m_snapshot->constraint_data.groups.data(),
-                  m_frame,
-                  "constraints/group",
-                  N * 8,
-                  N);
+        readChunkRange(m_snapshot->constraint_data.groups.data(),
+                       m_frame,
+                       "constraints/group",
+                       8,
+                       N,
+                       begin,
+                       end);
         }
 
     if (m_handle.header.schema_version >= gsd_make_version(1, 1))
         {
-        N = 0;
-        m_snapshot->pair_data.type_mapping = readTypes(m_frame, "pairs/types");
-        readChunk(&N, m_frame, "pairs/N", 4);
-        if (N > 0)
-            {
-            m_snapshot->pair_data.resize(N);
-            readChunk(m_snapshot->pair_data.type_id.data(), m_frame, "pairs/typeid", N * 4, N);
-            readChunk(m_snapshot->pair_data.groups.data(), m_frame, "pairs/group", N * 8, N);
-            }
+        readGroups(m_snapshot->pair_data, "pairs", 8);
         }
     }
 
@@ -336,8 +630,14 @@ void export_GSDReader(pybind11::module& m)
                             const string&,
                             const uint64_t,
                             bool>())
+        .def(pybind11::init<std::shared_ptr<const ExecutionConfiguration>,
+                            const string&,
+                            const uint64_t,
+                            bool,
+                            bool>())
         .def("getTimeStep", &GSDReader::getTimeStep)
         .def("getSnapshot", &GSDReader::getSnapshot)
+        .def("isDistributed", &GSDReader::isDistributed)
         .def("clearSnapshot", &GSDReader::clearSnapshot)
         .def("readTypeShapesPy", &GSDReader::readTypeShapesPy);
     }
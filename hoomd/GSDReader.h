@@ -5,9 +5,11 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "GSDCompression.h"
 #include "ParticleData.h"
 #include "hoomd/extern/gsd.h"
 #include <string>
+#include <vector>
 
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -33,7 +35,8 @@ class PYBIND11_EXPORT GSDReader
     GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
               const std::string& name,
               const uint64_t frame,
-              bool from_end);
+              bool from_end,
+              bool distributed = false);
 
     //! Destructor
     ~GSDReader();
@@ -58,6 +61,12 @@ class PYBIND11_EXPORT GSDReader
         return m_snapshot;
         }
 
+    //! Test if each rank holds only a part of the snapshot
+    bool isDistributed() const
+        {
+        return m_distributed;
+        }
+
     //! initializes a snapshot with the particle data
     uint64_t getFrame() const
         {
@@ -71,6 +80,24 @@ class PYBIND11_EXPORT GSDReader
                    size_t expected_size,
                    unsigned int cur_n = 0);
 
+    //! Helper function to read the rows [begin, end) of a quantity from the file
+    bool readChunkRange(void* data,
+                        uint64_t frame,
+                        const char* name,
+                        size_t row_size,
+                        unsigned int cur_n,
+                        unsigned int begin,
+                        unsigned int end);
+
+    //! Helper function to read a float particle quantity that may be compressed
+    bool readParticleChunk(float* data,
+                           uint64_t frame,
+                           const std::string& name,
+                           uint32_t M,
+                           unsigned int cur_n,
+                           unsigned int begin,
+                           unsigned int end);
+
     //! clears the snapshot object
     void clearSnapshot()
         {
@@ -92,10 +119,31 @@ class PYBIND11_EXPORT GSDReader
     uint64_t m_frame;                                          //!< Cached frame
     std::shared_ptr<SnapshotSystemData<float>> m_snapshot;     //!< The snapshot to read
     gsd_handle m_handle;                                       //!< Handle to the file
+    bool m_distributed;                                        //!< True when each rank reads a slab
+    unsigned int m_n_particles;                                //!< Number of particles in the frame
 
     //! Helper function to read a type list from the file
     std::vector<std::string> readTypes(uint64_t frame, const char* name);
 
+    //! Read \a size bytes at \a location of the file
+    void readBytes(void* data, uint64_t location, size_t size);
+
+    //! Decode rows [begin, end) of a compressed chunk and the frames it refers to
+    bool readCompressedValues(std::vector<int64_t>& values,
+                              detail::GSDCompressedHeader& header,
+                              std::vector<uint64_t>& blocks,
+                              uint64_t frame,
+                              const std::string& name,
+                              unsigned int begin,
+                              unsigned int end);
+
+    //! Determine the slab of \a n rows this rank reads
+    void computeSlab(unsigned int n, unsigned int& begin, unsigned int& end) const;
+
+    //! Read the types and this rank's slab of a bonded group type
+    template<class Snapshot>
+    void readGroups(Snapshot& snapshot, const std::string& prefix, size_t group_row_size);
+
     // helper functions to read sections of the file
     void readHeader();
     void readParticles();
@@ -21,6 +21,8 @@
 #include <mpi.h>
 
 #include <algorithm>
+#include <climits>
+#include <cstring>
 #include <numeric>
 #include <queue>
 #include <sstream>
@@ -508,6 +510,108 @@ template<typename T> void recv(T& val, const unsigned int src, const MPI_Comm mp
     delete[] buf;
     }
 
+//! Wrapper around MPI_Alltoallv that exchanges vectors of trivially copyable values
+/*! \param send_values Values to send to each rank (one vector per rank)
+    \param recv_values Output values received from all ranks, in order of the source rank
+    \param mpi_comm MPI communicator
+
+    MPI_Alltoallv takes int byte counts and displacements. To exchange more than INT_MAX bytes,
+    the values are sent in rounds in which every rank sends at most INT_MAX / size bytes to each
+    other rank, so that the displacements of a round also fit in an int.
+*/
+template<typename T>
+void all_to_all_v(const std::vector<std::vector<T>>& send_values,
+                  std::vector<T>& recv_values,
+                  const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+
+    assert(send_values.size() == (unsigned int)size);
+
+    std::vector<unsigned long long> send_bytes(size), recv_bytes(size);
+    for (int i = 0; i < size; i++)
+        send_bytes[i] = send_values[i].size() * sizeof(T);
+
+    MPI_Alltoall(send_bytes.data(),
+                 1,
+                 MPI_UNSIGNED_LONG_LONG,
+                 recv_bytes.data(),
+                 1,
+                 MPI_UNSIGNED_LONG_LONG,
+                 mpi_comm);
+
+    // offsets of the values from each source rank in the output
+    std::vector<size_t> recv_offset(size);
+    size_t recv_len = 0;
+    for (int i = 0; i < size; i++)
+        {
+        recv_offset[i] = recv_len;
+        recv_len += recv_bytes[i];
+        }
+    recv_values.resize(recv_len / sizeof(T));
+    char* recv_data = reinterpret_cast<char*>(recv_values.data());
+
+    // largest message per rank pair in a round, a multiple of sizeof(T)
+    const unsigned long long max_chunk
+        = std::max((unsigned long long)(INT_MAX / size) / sizeof(T), 1ull) * sizeof(T);
+
+    unsigned long long max_bytes = 0;
+    for (int i = 0; i < size; i++)
+        max_bytes = std::max(max_bytes, std::max(send_bytes[i], recv_bytes[i]));
+    MPI_Allreduce(MPI_IN_PLACE, &max_bytes, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, mpi_comm);
+    const unsigned long long n_rounds = std::max((max_bytes + max_chunk - 1) / max_chunk, 1ull);
+
+    std::vector<int> send_counts(size), send_displs(size), recv_counts(size), recv_displs(size);
+    std::vector<char> sbuf, rbuf;
+    for (unsigned long long round = 0; round < n_rounds; round++)
+        {
+        const unsigned long long begin = round * max_chunk;
+        int send_len = 0;
+        int round_recv_len = 0;
+        for (int i = 0; i < size; i++)
+            {
+            send_counts[i]
+                = int(std::min(send_bytes[i] - std::min(send_bytes[i], begin), max_chunk));
+            recv_counts[i]
+                = int(std::min(recv_bytes[i] - std::min(recv_bytes[i], begin), max_chunk));
+            send_displs[i] = send_len;
+            recv_displs[i] = round_recv_len;
+            send_len += send_counts[i];
+            round_recv_len += recv_counts[i];
+            }
+
+        // pack this round's part of the per-rank vectors into a contiguous send buffer
+        sbuf.resize(send_len);
+        for (int i = 0; i < size; i++)
+            {
+            if (send_counts[i] > 0)
+                memcpy(sbuf.data() + send_displs[i],
+                       reinterpret_cast<const char*>(send_values[i].data()) + begin,
+                       send_counts[i]);
+            }
+
+        rbuf.resize(round_recv_len);
+        MPI_Alltoallv(sbuf.data(),
+                      send_counts.data(),
+                      send_displs.data(),
+                      MPI_BYTE,
+                      rbuf.data(),
+                      recv_counts.data(),
+                      recv_displs.data(),
+                      MPI_BYTE,
+                      mpi_comm);
+
+        for (int i = 0; i < size; i++)
+            {
+            if (recv_counts[i] > 0)
+                memcpy(recv_data + recv_offset[i] + begin,
+                       rbuf.data() + recv_displs[i],
+                       recv_counts[i]);
+            }
+        }
+    }
+
 /// Helper class that gathers local values from ranks and orders them in ascending tag order.
 /**
     To use:
@@ -727,6 +831,183 @@ class GatherTagOrder
         return static_cast<T*>(m_gather_buffer);
         }
     };
+
+/// Helper class that redistributes local values so that each rank holds a contiguous slab of the
+/// global array.
+/**
+    To use:
+    1) Call setLocalIndicesSorted() with the global index of each local value, in ascending order.
+    2) Call distributeArray() to send each value to the rank whose slab contains its index. The
+       output holds the values of indices [getSlabBegin(), getSlabBegin() + getSlabSize()) in
+       ascending index order.
+    3) Repeat step 2 for as many arrays as needed (all must be in the same index order).
+
+    Rank r holds the slab [n * r / P, n * (r + 1) / P) of the n global indices, so every index
+    must be present on exactly one rank. Unlike GatherTagOrder, no single rank receives the whole
+    array.
+**/
+class DistributeIndexOrder
+    {
+    public:
+    /// Construct DistributeIndexOrder
+    /** \param mpi_comm MPI Communicator.
+     */
+    DistributeIndexOrder(const MPI_Comm mpi_comm = MPI_COMM_WORLD) : m_mpi_communicator(mpi_comm)
+        {
+        int n_ranks;
+        MPI_Comm_size(m_mpi_communicator, &n_ranks);
+
+        m_send_counts.resize(n_ranks);
+        m_send_displacements.resize(n_ranks);
+        m_recv_counts.resize(n_ranks);
+        m_recv_displacements.resize(n_ranks);
+        m_send_bytes.resize(n_ranks);
+        m_send_displacement_bytes.resize(n_ranks);
+        m_recv_bytes.resize(n_ranks);
+        m_recv_displacement_bytes.resize(n_ranks);
+        }
+
+    /// Provide the global indices of the local arrays to be distributed.
+    /** \param local_index Global index of each local value, in ascending order.
+        \param n_global Number of global indices.
+    */
+    void setLocalIndicesSorted(const std::vector<unsigned int>& local_index, unsigned int n_global)
+        {
+        int rank, n_ranks;
+        MPI_Comm_rank(m_mpi_communicator, &rank);
+        MPI_Comm_size(m_mpi_communicator, &n_ranks);
+
+        m_slab_begin = computeSlabBegin(rank, n_ranks, n_global);
+        m_slab_size = computeSlabBegin(rank + 1, n_ranks, n_global) - m_slab_begin;
+
+        // The local indices are sorted, so the values sent to each rank are contiguous.
+        std::fill(m_send_counts.begin(), m_send_counts.end(), 0);
+        int dest = 0;
+        for (unsigned int index : local_index)
+            {
+            assert(index < n_global);
+            while (index >= computeSlabBegin(dest + 1, n_ranks, n_global))
+                {
+                dest++;
+                }
+            m_send_counts[dest]++;
+            }
+
+        MPI_Alltoall(m_send_counts.data(),
+                     1,
+                     MPI_INT,
+                     m_recv_counts.data(),
+                     1,
+                     MPI_INT,
+                     m_mpi_communicator);
+
+        m_send_displacements[0] = 0;
+        m_recv_displacements[0] = 0;
+        for (size_t i = 1; i < m_send_displacements.size(); i++)
+            {
+            m_send_displacements[i] = m_send_displacements[i - 1] + m_send_counts[i - 1];
+            m_recv_displacements[i] = m_recv_displacements[i - 1] + m_recv_counts[i - 1];
+            }
+
+        // Send the indices themselves so that each rank can place the received values.
+        m_slab_order.resize(m_slab_size);
+        MPI_Alltoallv((void*)local_index.data(),
+                      m_send_counts.data(),
+                      m_send_displacements.data(),
+                      MPI_UNSIGNED,
+                      m_slab_order.data(),
+                      m_recv_counts.data(),
+                      m_recv_displacements.data(),
+                      MPI_UNSIGNED,
+                      m_mpi_communicator);
+
+        for (unsigned int& index : m_slab_order)
+            {
+            assert(index >= m_slab_begin && index < m_slab_begin + m_slab_size);
+            index -= m_slab_begin;
+            }
+        }
+
+    /// Distribute a given local array into this rank's slab of the global array
+    template<class T>
+    void distributeArray(std::vector<T>& slab_array, const std::vector<T>& local_array)
+        {
+        std::transform(m_send_counts.begin(),
+                       m_send_counts.end(),
+                       m_send_bytes.begin(),
+                       [](int v) { return v * int(sizeof(T)); });
+        std::transform(m_send_displacements.begin(),
+                       m_send_displacements.end(),
+                       m_send_displacement_bytes.begin(),
+                       [](int v) { return v * int(sizeof(T)); });
+        std::transform(m_recv_counts.begin(),
+                       m_recv_counts.end(),
+                       m_recv_bytes.begin(),
+                       [](int v) { return v * int(sizeof(T)); });
+        std::transform(m_recv_displacements.begin(),
+                       m_recv_displacements.end(),
+                       m_recv_displacement_bytes.begin(),
+                       [](int v) { return v * int(sizeof(T)); });
+
+        m_recv_buffer.resize(sizeof(T) * m_slab_size);
+        MPI_Alltoallv((void*)local_array.data(),
+                      m_send_bytes.data(),
+                      m_send_displacement_bytes.data(),
+                      MPI_BYTE,
+                      m_recv_buffer.data(),
+                      m_recv_bytes.data(),
+                      m_recv_displacement_bytes.data(),
+                      MPI_BYTE,
+                      m_mpi_communicator);
+
+        const T* received = reinterpret_cast<const T*>(m_recv_buffer.data());
+        slab_array.resize(m_slab_size);
+        for (unsigned int i = 0; i < m_slab_size; i++)
+            {
+            slab_array[m_slab_order[i]] = received[i];
+            }
+        }
+
+    /// Get the first global index in this rank's slab
+    unsigned int getSlabBegin() const
+        {
+        return m_slab_begin;
+        }
+
+    /// Get the number of global indices in this rank's slab
+    unsigned int getSlabSize() const
+        {
+        return m_slab_size;
+        }
+
+    /// First global index of the slab of a given rank
+    static unsigned int computeSlabBegin(int rank, int n_ranks, unsigned int n_global)
+        {
+        return static_cast<unsigned int>(uint64_t(n_global) * uint64_t(rank) / uint64_t(n_ranks));
+        }
+
+    /// Rank whose slab contains a given global index
+    static int computeSlabRank(unsigned int index, int n_ranks, unsigned int n_global)
+        {
+        return static_cast<int>((uint64_t(index + 1) * uint64_t(n_ranks) - 1) / n_global);
+        }
+
+    private:
+    MPI_Comm m_mpi_communicator;
+
+    std::vector<int> m_send_counts, m_send_displacements, m_recv_counts, m_recv_displacements;
+    std::vector<int> m_send_bytes, m_send_displacement_bytes;
+    std::vector<int> m_recv_bytes, m_recv_displacement_bytes;
+
+    /// Slab offset of each received value
+    std::vector<unsigned int> m_slab_order;
+
+    /// Buffer for received values
+    std::vector<char> m_recv_buffer;
+
+    unsigned int m_slab_begin = 0;
+    unsigned int m_slab_size = 0;
+    };
     } // namespace hoomd
 
 #endif // ENABLE_MPI
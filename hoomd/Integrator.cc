@@ -7,10 +7,17 @@
 #include "Integrator.cuh"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceConstraint>>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceCompute>>);
@@ -41,10 +48,16 @@ Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
 
     if (m_deltaT < 0)
         m_exec_conf->msg->warning() << "A step size dt of less than 0 was specified." << endl;
+
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .connect<Integrator, &Integrator::slotGlobalParticleNumberChange>(this);
     }
 
 Integrator::~Integrator()
     {
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .disconnect<Integrator, &Integrator::slotGlobalParticleNumberChange>(this);
+
 #ifdef ENABLE_MPI
     // disconnect
     if (m_sysdef->isDomainDecomposed())
@@ -54,10 +67,50 @@ Integrator::~Integrator()
 
         m_comm->getComputeCallbackSignal().disconnect<Integrator, &Integrator::computeCallback>(
             this);
+
+        if (m_overlap_ghost_update && !m_exec_conf->isCUDAEnabled())
+            m_comm->getGhostOverlapCallbackSignal()
+                .disconnect<Integrator, &Integrator::overlapCallback>(this);
         }
 #endif
     }
 
+/** @param overlap_ghost_update Set to true to compute interior forces during the ghost update
+
+    Only the CPU communicator splits the ghost update, so the setting has no effect on the GPU and
+    in simulations that are not domain decomposed.
+*/
+void Integrator::setOverlapGhostUpdate(bool overlap_ghost_update)
+    {
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed() && !m_exec_conf->isCUDAEnabled()
+        && overlap_ghost_update != m_overlap_ghost_update)
+        {
+        if (overlap_ghost_update)
+            m_comm->getGhostOverlapCallbackSignal()
+                .connect<Integrator, &Integrator::overlapCallback>(this);
+        else
+            m_comm->getGhostOverlapCallbackSignal()
+                .disconnect<Integrator, &Integrator::overlapCallback>(this);
+        }
+#endif
+
+    m_overlap_ghost_update = overlap_ghost_update;
+    }
+
+/** @param slow_force_interval Number of steps between evaluations of the slow forces
+ */
+void Integrator::setSlowForceInterval(unsigned int slow_force_interval)
+    {
+    if (slow_force_interval == 0)
+        throw std::domain_error("slow_force_interval must be at least 1");
+
+    m_slow_force_interval = slow_force_interval;
+
+    // start a new outer step at the next evaluation
+    m_slow_phase_set = false;
+    }
+
 /** @param deltaT New time step to set
  */
 void Integrator::setDeltaT(Scalar deltaT)
@@ -70,6 +123,11 @@ void Integrator::setDeltaT(Scalar deltaT)
         force->setDeltaT(deltaT);
         }
 
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(deltaT);
@@ -162,14 +220,47 @@ vec3<double> Integrator::computeLinearMomentum()
    \a m_net_virial \note The summation step is performed <b>on the CPU</b> and will result in a lot
    of data traffic back and forth if the forces and/or integrator are on the GPU. Call
    computeNetForcesGPU() to sum the forces on the GPU
+
+    When accumulate_forces is enabled, forces that support it add their contributions directly into
+    the net force arrays and skip the summation pass.
 */
 void Integrator::computeNetForce(uint64_t timestep)
     {
+#ifdef ENABLE_MPI
+    const auto work_start = std::chrono::steady_clock::now();
+#endif
+
     for (auto& force : m_forces)
         {
-        force->compute(timestep);
+        if (!(m_accumulate_forces && force->supportsNetForceAccumulation()))
+            {
+            force->compute(timestep);
+            }
         }
 
+    // The outer steps are counted from the first step with slow forces, so the first evaluation
+    // always applies the opening impulse whatever the phase of the timestep.
+    if (!m_slow_forces.empty() && !m_slow_phase_set)
+        {
+        m_slow_phase = timestep;
+        m_slow_phase_set = true;
+        }
+
+    // evaluate the slow forces at the start of each outer step, and when there are no buffered
+    // energies and virials for the current particles
+    const bool slow_step
+        = !m_slow_forces.empty() && (timestep - m_slow_phase) % m_slow_force_interval == 0;
+    if (!m_slow_forces.empty() && (slow_step || !m_slow_forces_valid))
+        {
+        computeSlowForces(timestep);
+        }
+
+    // The constraint forces must see the whole slow impulse, but their virials must follow from
+    // the slow forces with weight 1. Compute the constraints with weight 1 first, keep their
+    // virials, and then compute them again with the full impulse (see computeSlowConstraints()).
+    const bool split_constraints
+        = slow_step && m_slow_force_interval > 1 && !m_constraint_forces.empty();
+
     Scalar external_virial[6];
     Scalar external_energy;
         {
@@ -204,35 +295,72 @@ void Integrator::computeNetForce(uint64_t timestep)
 
         for (const auto& force : m_forces)
             {
-            const GlobalArray<Scalar4>& h_force_array = force->getForceArray();
-            const GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
-            const GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
-
-            assert(nparticles <= h_force_array.getNumElements());
-            assert(6 * nparticles <= h_virial_array.getNumElements());
-            assert(nparticles <= h_torque_array.getNumElements());
-
-            ArrayHandle<Scalar4> h_force(h_force_array, access_location::host, access_mode::read);
-            ArrayHandle<Scalar> h_virial(h_virial_array, access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_torque(h_torque_array, access_location::host, access_mode::read);
-
-            size_t virial_pitch = h_virial_array.getPitch();
-            for (unsigned int j = 0; j < nparticles; j++)
+            if (m_accumulate_forces && force->supportsNetForceAccumulation())
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
-                h_net_force.data[j].w += h_force.data[j].w;
-
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
-                h_net_torque.data[j].w += h_torque.data[j].w;
+                force->accumulateNetForce(timestep,
+                                          h_net_force.data,
+                                          h_net_virial.data,
+                                          net_virial_pitch,
+                                          h_net_torque.data);
+                }
+            else
+                {
+                const GlobalArray<Scalar4>& h_force_array = force->getForceArray();
+                const GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
+                const GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
+
+                assert(nparticles <= h_force_array.getNumElements());
+                assert(6 * nparticles <= h_virial_array.getNumElements());
+                assert(nparticles <= h_torque_array.getNumElements());
+
+                ArrayHandle<Scalar4> h_force(h_force_array,
+                                             access_location::host,
+                                             access_mode::read);
+                ArrayHandle<Scalar> h_virial(h_virial_array,
+                                             access_location::host,
+                                             access_mode::read);
+                ArrayHandle<Scalar4> h_torque(h_torque_array,
+                                              access_location::host,
+                                              access_mode::read);
 
-                for (unsigned int k = 0; k < 6; k++)
+                size_t virial_pitch = h_virial_array.getPitch();
+                auto add_range = [&](unsigned int first, unsigned int last)
+                {
+                    for (unsigned int j = first; j < last; j++)
+                        {
+                        h_net_force.data[j].x += h_force.data[j].x;
+                        h_net_force.data[j].y += h_force.data[j].y;
+                        h_net_force.data[j].z += h_force.data[j].z;
+                        h_net_force.data[j].w += h_force.data[j].w;
+
+                        h_net_torque.data[j].x += h_torque.data[j].x;
+                        h_net_torque.data[j].y += h_torque.data[j].y;
+                        h_net_torque.data[j].z += h_torque.data[j].z;
+                        h_net_torque.data[j].w += h_torque.data[j].w;
+
+                        for (unsigned int k = 0; k < 6; k++)
+                            {
+                            h_net_virial.data[k * net_virial_pitch + j]
+                                += h_virial.data[k * virial_pitch + j];
+                            }
+                        }
+                };
+
+#ifdef ENABLE_TBB
+                if (m_exec_conf->getNumThreads() > 1)
                     {
-                    h_net_virial.data[k * net_virial_pitch + j]
-                        += h_virial.data[k * virial_pitch + j];
+                    m_exec_conf->getTaskArena()->execute(
+                        [&]
+                        {
+                            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+                                              [&](const tbb::blocked_range<unsigned int>& r)
+                                              { add_range(r.begin(), r.end()); });
+                        });
+                    }
+                else
+#endif
+                    {
+                    add_range(0, nparticles);
                     }
                 }
 
@@ -243,7 +371,32 @@ void Integrator::computeNetForce(uint64_t timestep)
 
             external_energy += force->getExternalEnergy();
             }
+
+        if (!m_slow_forces.empty())
+            {
+            Scalar slow_weight = Scalar(0.0);
+            if (slow_step)
+                slow_weight = split_constraints ? Scalar(1.0) : Scalar(m_slow_force_interval);
+            addSlowForces(slow_weight,
+                          nparticles,
+                          h_net_force.data,
+                          h_net_virial.data,
+                          net_virial_pitch,
+                          h_net_torque.data,
+                          external_virial,
+                          external_energy);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // charge the force evaluation to this rank's load for cost weighted load balancing
+        const std::chrono::duration<double> work_time
+            = std::chrono::steady_clock::now() - work_start;
+        m_comm->addLocalWorkTime(work_time.count());
         }
+#endif
 
     for (unsigned int k = 0; k < 6; k++)
         {
@@ -264,11 +417,21 @@ void Integrator::computeNetForce(uint64_t timestep)
         }
 #endif
 
-    // compute all the constraint forces next
-    // constraint forces only apply a force, not a torque
-    for (auto& constraint_force : m_constraint_forces)
+    // virials of the constraint forces with the slow forces at weight 1
+    std::vector<Scalar> constraint_virial;
+    Scalar constraint_external_virial[6] = {0, 0, 0, 0, 0, 0};
+    if (split_constraints)
         {
-        constraint_force->compute(timestep);
+        computeSlowConstraints(timestep, constraint_virial, constraint_external_virial);
+        }
+    else
+        {
+        // compute all the constraint forces next
+        // constraint forces only apply a force, not a torque
+        for (auto& constraint_force : m_constraint_forces)
+            {
+            constraint_force->compute(timestep);
+            }
         }
 
         {
@@ -313,18 +476,42 @@ void Integrator::computeNetForce(uint64_t timestep)
                 h_net_torque.data[j].z += h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
 
+                if (!split_constraints)
+                    {
+                    for (unsigned int k = 0; k < 6; k++)
+                        {
+                        h_net_virial.data[k * net_virial_pitch + j]
+                            += h_virial.data[k * virial_pitch + j];
+                        }
+                    }
+                }
+
+            if (!split_constraints)
+                {
+                for (unsigned int k = 0; k < 6; k++)
+                    {
+                    external_virial[k] += constraint_force->getExternalVirial(k);
+                    }
+                }
+
+            external_energy += constraint_force->getExternalEnergy();
+            }
+
+        if (split_constraints)
+            {
+            for (unsigned int j = 0; j < nparticles; j++)
+                {
                 for (unsigned int k = 0; k < 6; k++)
                     {
                     h_net_virial.data[k * net_virial_pitch + j]
-                        += h_virial.data[k * virial_pitch + j];
+                        += constraint_virial[k * nparticles + j];
                     }
                 }
+
             for (unsigned int k = 0; k < 6; k++)
                 {
-                external_virial[k] += constraint_force->getExternalVirial(k);
+                external_virial[k] += constraint_external_virial[k];
                 }
-
-            external_energy += constraint_force->getExternalEnergy();
             }
         }
 
@@ -336,6 +523,265 @@ void Integrator::computeNetForce(uint64_t timestep)
     m_pdata->setExternalEnergy(external_energy);
     }
 
+/** @param timestep Current time step of the simulation
+    \post The slow force buffers hold the sum of the forces, energies, virials, and torques of all
+    slow forces for the local and ghost particles.
+*/
+void Integrator::computeSlowForces(uint64_t timestep)
+    {
+    for (auto& force : m_slow_forces)
+        {
+        force->compute(timestep);
+        }
+
+    const unsigned int nparticles = m_pdata->getN() + m_pdata->getNGhosts();
+    m_slow_net_force.assign(nparticles, make_scalar4(0, 0, 0, 0));
+
+    // the tags find the buffered energies and virials after particles are sorted or migrate
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        m_slow_tag.assign(h_tag.data, h_tag.data + m_pdata->getN());
+        }
+
+    m_slow_net_virial.assign(6 * size_t(nparticles), Scalar(0.0));
+    m_slow_net_torque.assign(nparticles, make_scalar4(0, 0, 0, 0));
+
+    for (unsigned int k = 0; k < 6; k++)
+        m_slow_external_virial[k] = Scalar(0.0);
+    m_slow_external_energy = Scalar(0.0);
+
+    for (const auto& force : m_slow_forces)
+        {
+        ArrayHandle<Scalar4> h_force(force->getForceArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar> h_virial(force->getVirialArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar4> h_torque(force->getTorqueArray(),
+                                      access_location::host,
+                                      access_mode::read);
+        size_t virial_pitch = force->getVirialArray().getPitch();
+
+        for (unsigned int j = 0; j < nparticles; j++)
+            {
+            m_slow_net_force[j].x += h_force.data[j].x;
+            m_slow_net_force[j].y += h_force.data[j].y;
+            m_slow_net_force[j].z += h_force.data[j].z;
+            m_slow_net_force[j].w += h_force.data[j].w;
+
+            m_slow_net_torque[j].x += h_torque.data[j].x;
+            m_slow_net_torque[j].y += h_torque.data[j].y;
+            m_slow_net_torque[j].z += h_torque.data[j].z;
+            m_slow_net_torque[j].w += h_torque.data[j].w;
+
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                m_slow_net_virial[k * nparticles + j] += h_virial.data[k * virial_pitch + j];
+                }
+            }
+
+        for (unsigned int k = 0; k < 6; k++)
+            {
+            m_slow_external_virial[k] += force->getExternalVirial(k);
+            }
+
+        m_slow_external_energy += force->getExternalEnergy();
+        }
+
+    m_slow_forces_valid = true;
+    }
+
+/** @param weight Weight of the slow forces and torques, 0 between outer steps
+    @param nparticles Number of local and ghost particles in the net force arrays
+    @param net_force Net force array
+    @param net_virial Net virial array
+    @param net_virial_pitch Pitch of the net virial array
+    @param net_torque Net torque array
+    @param external_virial Net external virial
+    @param external_energy Net external energy
+
+    At the start of each outer step, the slow forces and torques are added with weight
+    m_slow_force_interval (or 1 when computeSlowConstraints() adds the rest later). On all other
+    steps they are not added. The energies and virials are always added with weight 1 so that the
+    thermodynamic quantities include the slow forces at their last evaluation.
+
+    Between evaluations, the buffered energies and virials are found by the tags of the particles,
+    so sorting and migration do not require a new evaluation. The energies and virials of particles
+    that have left this rank are added to the external energy and virial, which keeps the totals
+    over all ranks at their last evaluated values. Particles that arrived since then have no slow
+    energy or virial until the next evaluation.
+*/
+void Integrator::addSlowForces(Scalar weight,
+                               unsigned int nparticles,
+                               Scalar4* net_force,
+                               Scalar* net_virial,
+                               size_t net_virial_pitch,
+                               Scalar4* net_torque,
+                               Scalar* external_virial,
+                               Scalar& external_energy)
+    {
+    const unsigned int n_slow = (unsigned int)m_slow_net_force.size();
+
+    if (weight != Scalar(0.0))
+        {
+        // the slow forces were evaluated on this step for all local and ghost particles
+        assert(n_slow == nparticles);
+        addSlowImpulse(weight, nparticles, net_force, net_torque);
+        }
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    const unsigned int N = m_pdata->getN();
+    for (unsigned int slot = 0; slot < m_slow_tag.size(); slot++)
+        {
+        const unsigned int j = h_rtag.data[m_slow_tag[slot]];
+        if (j < N)
+            {
+            net_force[j].w += m_slow_net_force[slot].w;
+
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                net_virial[k * net_virial_pitch + j] += m_slow_net_virial[k * n_slow + slot];
+                }
+            }
+        else
+            {
+            external_energy += m_slow_net_force[slot].w;
+
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                external_virial[k] += m_slow_net_virial[k * n_slow + slot];
+                }
+            }
+        }
+
+    for (unsigned int k = 0; k < 6; k++)
+        {
+        external_virial[k] += m_slow_external_virial[k];
+        }
+
+    external_energy += m_slow_external_energy;
+    }
+
+/** @param weight Weight of the slow forces and torques
+    @param nparticles Number of particles to add the slow forces to
+    @param net_force Net force array
+    @param net_torque Net torque array
+*/
+void Integrator::addSlowImpulse(Scalar weight,
+                                unsigned int nparticles,
+                                Scalar4* net_force,
+                                Scalar4* net_torque)
+    {
+    for (unsigned int j = 0; j < nparticles; j++)
+        {
+        net_force[j].x += weight * m_slow_net_force[j].x;
+        net_force[j].y += weight * m_slow_net_force[j].y;
+        net_force[j].z += weight * m_slow_net_force[j].z;
+
+        net_torque[j].x += weight * m_slow_net_torque[j].x;
+        net_torque[j].y += weight * m_slow_net_torque[j].y;
+        net_torque[j].z += weight * m_slow_net_torque[j].z;
+        net_torque[j].w += weight * m_slow_net_torque[j].w;
+        }
+    }
+
+/** @param timestep Current time step of the simulation
+    @param constraint_virial Set to the summed virials of the constraint forces (component k of
+           local particle j at k * N + j)
+    @param constraint_external_virial Set to the summed external virials of the constraint forces
+
+    @pre The net force holds the slow forces with weight 1 and the ghost net forces are current.
+    @post The constraint forces hold the forces for the net force with the whole slow impulse.
+
+    Rigid bodies and other constraints derive their virials from the net force. Compute them once
+    with the slow forces at weight 1 and keep the virials, which are the ones the thermodynamic
+    quantities need. Then restore the net force, add the rest of the slow impulse, and compute the
+    constraint forces again for the dynamics.
+*/
+void Integrator::computeSlowConstraints(uint64_t timestep,
+                                        std::vector<Scalar>& constraint_virial,
+                                        Scalar* constraint_external_virial)
+    {
+    const unsigned int N = m_pdata->getN();
+    const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
+    const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+    const GlobalArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
+
+    // constraint forces may modify the net force arrays, keep them to compute again
+    std::vector<Scalar4> saved_net_force;
+    std::vector<Scalar> saved_net_virial;
+    std::vector<Scalar4> saved_net_torque;
+        {
+        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::read);
+        saved_net_force.assign(h_net_force.data, h_net_force.data + net_force.getNumElements());
+        saved_net_virial.assign(h_net_virial.data,
+                                h_net_virial.data + net_virial.getNumElements());
+        saved_net_torque.assign(h_net_torque.data,
+                                h_net_torque.data + net_torque.getNumElements());
+        }
+
+    for (auto& constraint_force : m_constraint_forces)
+        {
+        constraint_force->compute(timestep);
+        }
+
+    constraint_virial.assign(6 * size_t(N), Scalar(0.0));
+    for (unsigned int k = 0; k < 6; k++)
+        {
+        constraint_external_virial[k] = Scalar(0.0);
+        }
+
+    for (const auto& constraint_force : m_constraint_forces)
+        {
+        const GlobalArray<Scalar>& virial_array = constraint_force->getVirialArray();
+        ArrayHandle<Scalar> h_virial(virial_array, access_location::host, access_mode::read);
+        size_t virial_pitch = virial_array.getPitch();
+        for (unsigned int j = 0; j < N; j++)
+            {
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                constraint_virial[k * N + j] += h_virial.data[k * virial_pitch + j];
+                }
+            }
+
+        for (unsigned int k = 0; k < 6; k++)
+            {
+            constraint_external_virial[k] += constraint_force->getExternalVirial(k);
+            }
+        }
+
+        {
+        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_net_torque(net_torque,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        std::copy(saved_net_force.begin(), saved_net_force.end(), h_net_force.data);
+        std::copy(saved_net_virial.begin(), saved_net_virial.end(), h_net_virial.data);
+        std::copy(saved_net_torque.begin(), saved_net_torque.end(), h_net_torque.data);
+
+        addSlowImpulse(Scalar(m_slow_force_interval - 1), N, h_net_force.data, h_net_torque.data);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // communicate the net force with the whole impulse
+        m_comm->updateNetForce(timestep);
+        }
+#endif
+
+    for (auto& constraint_force : m_constraint_forces)
+        {
+        constraint_force->forceCompute(timestep);
+        }
+    }
+
 #ifdef ENABLE_HIP
 /** @param timestep Current time step of the simulation
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and
@@ -348,6 +794,11 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         throw runtime_error("Cannot compute net force on the GPU if CUDA is disabled.");
         }
 
+    if (!m_slow_forces.empty())
+        {
+        throw runtime_error("Slow forces are not supported on the GPU.");
+        }
+
     // compute all the normal forces first
 
     for (auto& force : m_forces)
@@ -805,6 +1256,11 @@ void Integrator::update(uint64_t timestep)
         force->setDeltaT(m_deltaT);
         }
 
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(m_deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(m_deltaT);
@@ -829,10 +1285,18 @@ void Integrator::prepRun(uint64_t timestep)
         force->setDeltaT(m_deltaT);
         }
 
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(m_deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(m_deltaT);
         }
+
+    // the particles may have changed since the slow forces were last evaluated
+    m_slow_forces_valid = false;
     }
 
 #ifdef ENABLE_MPI
@@ -851,6 +1315,11 @@ CommFlags Integrator::determineFlags(uint64_t timestep)
         flags |= force->getRequestedCommFlags(timestep);
         }
 
+    for (const auto& force : m_slow_forces)
+        {
+        flags |= force->getRequestedCommFlags(timestep);
+        }
+
     // query all constraints
     for (const auto& constraint_force : m_constraint_forces)
         {
@@ -867,6 +1336,33 @@ void Integrator::computeCallback(uint64_t timestep)
         {
         force->preCompute(timestep);
         }
+
+    if (timestep % m_slow_force_interval == 0)
+        {
+        for (auto& force : m_slow_forces)
+            {
+            force->preCompute(timestep);
+            }
+        }
+    }
+
+void Integrator::overlapCallback(uint64_t timestep)
+    {
+    if (!canOverlapGhostUpdate())
+        return;
+
+    const auto work_start = std::chrono::steady_clock::now();
+
+    for (auto& force : m_forces)
+        {
+        // accumulated forces are computed in a single pass in computeNetForce
+        if (!(m_accumulate_forces && force->supportsNetForceAccumulation()))
+            force->computeInterior(timestep);
+        }
+
+    // the interior forces are part of this rank's force evaluation cost
+    const std::chrono::duration<double> work_time = std::chrono::steady_clock::now() - work_start;
+    m_comm->addLocalWorkTime(work_time.count());
     }
 #endif
 
@@ -879,6 +1375,11 @@ bool Integrator::areForcesAnisotropic()
         aniso |= force->isAnisotropic();
         }
 
+    for (const auto& force : m_slow_forces)
+        {
+        aniso |= force->isAnisotropic();
+        }
+
     for (const auto& constraint_force : m_constraint_forces)
         {
         aniso |= constraint_force->isAnisotropic();
@@ -897,7 +1398,17 @@ void export_Integrator(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
         .def("updateGroupDOF", &Integrator::updateGroupDOF)
         .def_property("dt", &Integrator::getDeltaT, &Integrator::setDeltaT)
+        .def_property("accumulate_forces",
+                      &Integrator::getAccumulateForces,
+                      &Integrator::setAccumulateForces)
+        .def_property("overlap_ghost_update",
+                      &Integrator::getOverlapGhostUpdate,
+                      &Integrator::setOverlapGhostUpdate)
+        .def_property("slow_force_interval",
+                      &Integrator::getSlowForceInterval,
+                      &Integrator::setSlowForceInterval)
         .def_property_readonly("forces", &Integrator::getForces)
+        .def_property_readonly("slow_forces", &Integrator::getSlowForces)
         .def_property_readonly("constraints", &Integrator::getConstraintForces)
         .def("computeLinearMomentum", &Integrator::computeLinearMomentum);
     }
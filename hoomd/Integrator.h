@@ -45,6 +45,17 @@ namespace hoomd
     convenience in derived classes implementing correct counting in getTranslationalDOF() and
     getRotationalDOF().
 
+    Forces added to m_slow_forces through getSlowForces are evaluated only at the start of each
+    outer step of m_slow_force_interval (k) steps. The outer steps are counted from the first step
+    that computes the net force with slow forces, whatever its phase. At the start of an outer
+    step, the slow forces and torques enter the net force multiplied by k, so that the two half
+    step velocity updates adjacent to the step apply the slow impulse of the r-RESPA (Verlet-I)
+    multiple time step scheme. Their energies and virials always enter with weight 1, and the
+    values from the last evaluation are held in the slow force buffers and added on the steps in
+    between. The buffers are keyed by particle tag, so sorting and migration between evaluations do
+    not trigger additional evaluations. The constraint forces act on the whole impulse, but their
+    virials are those of the slow forces with weight 1 (see computeSlowConstraints()).
+
     Integrators take "ownership" of the particle's accelerations. Any other updater that modifies
     the particles accelerations will produce undefined results. If accelerations are to be modified,
     they must be done through forces, and added to an Integrator via the m_forces std::vector.
@@ -81,6 +92,21 @@ class PYBIND11_EXPORT Integrator : public Updater
         return m_constraint_forces;
         }
 
+    /// Get the list of slow force computes
+    std::vector<std::shared_ptr<ForceCompute>>& getSlowForces()
+        {
+        return m_slow_forces;
+        }
+
+    /// Set the number of steps between evaluations of the slow forces
+    void setSlowForceInterval(unsigned int slow_force_interval);
+
+    /// Get the number of steps between evaluations of the slow forces
+    unsigned int getSlowForceInterval()
+        {
+        return m_slow_force_interval;
+        }
+
     /// Set the half step hook.
     virtual void setHalfStepHook(std::shared_ptr<HalfStepHook> hook)
         {
@@ -99,6 +125,27 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Return the timestep
     Scalar getDeltaT();
 
+    /// Set whether supporting forces add directly into the net force arrays
+    void setAccumulateForces(bool accumulate_forces)
+        {
+        m_accumulate_forces = accumulate_forces;
+        }
+
+    /// Get whether supporting forces add directly into the net force arrays
+    bool getAccumulateForces()
+        {
+        return m_accumulate_forces;
+        }
+
+    /// Set whether forces on interior particles are computed during the ghost update
+    void setOverlapGhostUpdate(bool overlap_ghost_update);
+
+    /// Get whether forces on interior particles are computed during the ghost update
+    bool getOverlapGhostUpdate()
+        {
+        return m_overlap_ghost_update;
+        }
+
     /// Update the number of degrees of freedom for a group
     /** @param group Group to set the degrees of freedom for.
      */
@@ -139,6 +186,9 @@ class PYBIND11_EXPORT Integrator : public Updater
 #ifdef ENABLE_MPI
     /// Callback for pre-computing the forces
     void computeCallback(uint64_t timestep);
+
+    /// Callback for computing interior forces while the ghost update is in flight
+    void overlapCallback(uint64_t timestep);
 #endif
 
     /// Reset stats counters for children objects
@@ -149,6 +199,11 @@ class PYBIND11_EXPORT Integrator : public Updater
             force->resetStats();
             }
 
+        for (auto& force : m_slow_forces)
+            {
+            force->resetStats();
+            }
+
         for (auto& constraint_force : m_constraint_forces)
             {
             constraint_force->resetStats();
@@ -163,6 +218,10 @@ class PYBIND11_EXPORT Integrator : public Updater
             {
             force->startAutotuning();
             }
+        for (auto& force : m_slow_forces)
+            {
+            force->startAutotuning();
+            }
         }
 
     /// Check if autotuning is complete.
@@ -173,6 +232,10 @@ class PYBIND11_EXPORT Integrator : public Updater
             {
             result = result && force->isAutotuningComplete();
             }
+        for (auto& force : m_slow_forces)
+            {
+            result = result && force->isAutotuningComplete();
+            }
         return result;
         }
 
@@ -189,6 +252,72 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// The HalfStepHook, if active
     std::shared_ptr<HalfStepHook> m_half_step_hook;
 
+    /// When true, forces that support it add directly into the net force arrays in computeNetForce
+    bool m_accumulate_forces = false;
+
+    /// When true, forces on interior particles are computed while ghost positions are updated
+    bool m_overlap_ghost_update = false;
+
+    /// Forces evaluated every m_slow_force_interval steps and applied as impulses (r-RESPA)
+    std::vector<std::shared_ptr<ForceCompute>> m_slow_forces;
+
+    /// Number of steps between evaluations of the slow forces
+    unsigned int m_slow_force_interval = 1;
+
+    /// Sum of the slow forces at their last evaluation (energy in w)
+    std::vector<Scalar4> m_slow_net_force;
+
+    /// Sum of the slow virials at their last evaluation (component k of particle j at k * n + j)
+    std::vector<Scalar> m_slow_net_virial;
+
+    /// Sum of the slow torques at their last evaluation
+    std::vector<Scalar4> m_slow_net_torque;
+
+    Scalar m_slow_external_virial[6] = {0, 0, 0, 0, 0, 0}; //!< External virial of the slow forces
+    Scalar m_slow_external_energy = 0;                     //!< External energy of the slow forces
+
+    /// Tags of the local particles at the last evaluation, in the order of the buffers
+    std::vector<unsigned int> m_slow_tag;
+
+    /// True when the slow force buffers hold values for the current particles
+    bool m_slow_forces_valid = false;
+
+    /// Timestep of the first outer step, set at the first net force with slow forces
+    uint64_t m_slow_phase = 0;
+
+    /// True once m_slow_phase is set
+    bool m_slow_phase_set = false;
+
+    /// Mark the slow force buffers invalid when particles are added or removed
+    void slotGlobalParticleNumberChange()
+        {
+        m_slow_forces_valid = false;
+        }
+
+    /// Evaluate the slow forces and store their sums in the slow force buffers
+    void computeSlowForces(uint64_t timestep);
+
+    /// Add the buffered slow forces to the net force arrays
+    void addSlowForces(Scalar weight,
+                       unsigned int nparticles,
+                       Scalar4* net_force,
+                       Scalar* net_virial,
+                       size_t net_virial_pitch,
+                       Scalar4* net_torque,
+                       Scalar* external_virial,
+                       Scalar& external_energy);
+
+    /// Add the buffered slow forces and torques with the given weight
+    void addSlowImpulse(Scalar weight,
+                        unsigned int nparticles,
+                        Scalar4* net_force,
+                        Scalar4* net_torque);
+
+    /// Compute the constraint forces for the whole slow impulse and their virials for weight 1
+    void computeSlowConstraints(uint64_t timestep,
+                                std::vector<Scalar>& constraint_virial,
+                                Scalar* constraint_external_virial);
+
     /// helper function to compute initial accelerations
     void computeAccelerations(uint64_t timestep);
 
@@ -204,6 +333,12 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// helper function to determine the ghost communication flags
     virtual CommFlags determineFlags(uint64_t timestep);
 
+    /// Return true when no callback moves local particles after the ghost update
+    virtual bool canOverlapGhostUpdate()
+        {
+        return true;
+        }
+
     /// The systems's communicator.
     std::shared_ptr<Communicator> m_comm;
 #endif
@@ -33,9 +33,10 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
       m_mpi_comm(m_exec_conf->getMPICommunicator()),
 #endif
       m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
-      m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-      m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
-      m_n_iterations(0), m_n_rebalances(0)
+      m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_weight_time(false),
+      m_max_scale(Scalar(0.05)), m_N_own(m_pdata->getN()), m_cost_per_particle(1.0),
+      m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0), m_n_iterations(0),
+      m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
 
@@ -83,6 +84,7 @@ void LoadBalancer::update(uint64_t timestep)
 
     // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
     resetNOwn(m_pdata->getN());
+    measureCost();
 
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
@@ -101,18 +103,18 @@ void LoadBalancer::update(uint64_t timestep)
         = Scalar(2.0) * m_comm->getGhostLayerMaxWidth() / box.getNearestPlaneDistance();
 
     // compute the current imbalance always for the average in printed stats
-    m_total_max_imbalance += getMaxImbalance();
+    m_total_max_imbalance += computeMaxImbalance();
     ++m_n_calls;
 
     // attempt load balancing
-    for (unsigned int cur_iter = 0; cur_iter < m_maxiter && getMaxImbalance() > m_tolerance;
+    for (unsigned int cur_iter = 0; cur_iter < m_maxiter && computeMaxImbalance() > m_tolerance;
          ++cur_iter)
         {
         // increment the number of attempted balances
         ++m_n_iterations;
 
         for (unsigned int dim = 0;
-             dim < m_sysdef->getNDimensions() && getMaxImbalance() > m_tolerance;
+             dim < m_sysdef->getNDimensions() && computeMaxImbalance() > m_tolerance;
              ++dim)
             {
             Scalar L_i(0.0);
@@ -139,17 +141,17 @@ void LoadBalancer::update(uint64_t timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<double> W_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+            // reduce the load in the slice along dim
+            bool active = reduce(W_i, dim, reduce_root);
 
             // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
             if (active)
                 {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
+                adjusted = adjust(cum_frac, W_i, L_i, min_frac_i);
                 }
 
             // broadcast if an adjustment has been made on the root
@@ -176,21 +178,45 @@ void LoadBalancer::update(uint64_t timestep)
             ++m_n_rebalances;
             }
         }
+
+    // store the imbalance after balancing so that reading it between updates needs no collectives
+    computeMaxImbalance();
 #endif // ENABLE_MPI
     }
 
+/*!
+ * \returns The maximum imbalance factor found by the most recent update(), or 1.0 before the
+ * first update
+ *
+ * The value is cached, so it may be read on any subset of ranks at any time.
+ */
+Scalar LoadBalancer::getMaxImbalance()
+    {
+    return m_max_imbalance;
+    }
+
 #ifdef ENABLE_MPI
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all
- * ranks.
+ * Computes the imbalance factor I = W / <W> for each rank, and computes the maximum among all
+ * ranks. The load W is the number of owned particles, or the estimated compute time when the load
+ * is weighted by time.
+ *
+ * \note The computation uses collective MPI calls, so all ranks must call computeMaxImbalance().
+ * Only update() calls it.
  */
-Scalar LoadBalancer::getMaxImbalance()
+Scalar LoadBalancer::computeMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn())
-                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        double load = getLoad();
+        double total_load = double(m_pdata->getNGlobal());
+        if (m_weight_time)
+            {
+            MPI_Allreduce(&load, &total_load, 1, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+            }
+
+        Scalar cur_imb = Scalar(load / (total_load / double(m_exec_conf->getNRanks())));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -205,37 +231,67 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * Converts the local work time recorded in the Communicator since the last call into a cost per
+ * owned particle, in units of the average cost of all particles. The load of all ranks then sums
+ * to the total number of particles, as it does when weighting by particle number. When no rank has
+ * recorded any time (for example before the first step or when forces run on the GPU), every
+ * particle costs 1 and the balancing falls back to particle numbers.
+ *
+ * \note All ranks must call measureCost() since it performs a collective reduction.
+ */
+void LoadBalancer::measureCost()
+    {
+    m_cost_per_particle = 1.0;
+    if (!m_weight_time)
+        return;
+
+    double local_time = m_comm->getLocalWorkTime();
+    m_comm->resetLocalWorkTime();
+
+    double total_time(0.0);
+    MPI_Allreduce(&local_time, &total_time, 1, MPI_DOUBLE, MPI_SUM, m_mpi_comm);
+
+    const unsigned int N_own = getNOwn();
+    if (total_time > 0.0 && N_own > 0)
+        {
+        const double mean_time = total_time / double(m_pdata->getNGlobal());
+        m_cost_per_particle = local_time / double(N_own) / mean_time;
+        }
+    m_recompute_max_imbalance = true;
+    }
+
+/*!
+ * \param W_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
- * \returns true if the current rank holds the active \a N_i
+ * \returns true if the current rank holds the active \a W_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a W_i holds the load of each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for
  * efficiency the data will be active only on Cartesian rank \a reduce_root, as indicated by the
- * return value. As a result, only \a reduce_root actually needs to allocate memory for \a N_i.
+ * return value. As a result, only \a reduce_root actually needs to allocate memory for \a W_i.
  *
  * The reduction is performed by performing an all-to-one gather, followed by summation on \a
  * reduce_root. This operation may be suboptimal for very large numbers of processors, and could be
  * replaced by cascading send operations down dimensions. Generally, load balancing should not be
  * performed too frequently, and so we do not pursue this optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
+bool LoadBalancer::reduce(std::vector<double>& W_i,
                           unsigned int dim,
                           unsigned int reduce_root)
     {
     // do nothing if there is only one rank
-    if (N_i.size() == 1)
+    if (W_i.size() == 1)
         return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<double> W_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    double W_own = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&W_own, 1, MPI_DOUBLE, &W_per_rank[0], 1, MPI_DOUBLE, reduce_root, m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -245,57 +301,57 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<double> W_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank = 0; cur_rank < di.getNumElements(); ++cur_rank)
         {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
+        W_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = W_per_rank[cur_rank];
         }
 
     // perform the summation along dim in as cache friendly of a way as we can manage
     if (dim == 0) // to x
         {
-        N_i.clear();
-        N_i.resize(di.getW());
+        W_i.clear();
+        W_i.resize(di.getW());
         for (unsigned int i = 0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            W_i[i] = 0.0;
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int j = 0; j < di.getH(); ++j)
                     {
-                    N_i[i] += N_per_cart_rank[di(i, j, k)];
+                    W_i[i] += W_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 1) // to y
         {
-        N_i.clear();
-        N_i.resize(di.getH());
+        W_i.clear();
+        W_i.resize(di.getH());
         for (unsigned int j = 0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            W_i[j] = 0.0;
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[j] += N_per_cart_rank[di(i, j, k)];
+                    W_i[j] += W_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 2) // to z
         {
-        N_i.clear();
-        N_i.resize(di.getD());
+        W_i.clear();
+        W_i.resize(di.getD());
         for (unsigned int k = 0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            W_i[k] = 0.0;
             for (unsigned int j = 0; j < di.getH(); ++j)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[k] += N_per_cart_rank[di(i, j, k)];
+                    W_i[k] += W_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
@@ -310,7 +366,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param W_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -329,31 +385,31 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
  * minimization was successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<double>& W_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
-    if (N_i.size() == 1)
+    if (W_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const double target = std::accumulate(W_i.begin(), W_i.end(), 0.0) / double(W_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
     // if system is overconstrained (exactly decomposed) don't do any adjusting
-    if (min_domain_size * Scalar(N_i.size()) >= L_i)
+    if (min_domain_size * Scalar(W_i.size()) >= L_i)
         {
         return false;
         }
 
     // imbalance factors for each rank
-    vector<Scalar> new_widths(N_i.size());
-    for (unsigned int i = 0; i < N_i.size(); ++i)
+    vector<Scalar> new_widths(W_i.size());
+    for (unsigned int i = 0; i < W_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
+        const Scalar imb_factor = Scalar(W_i[i] / target);
         Scalar scale_factor
-            = (N_i[i] > 0)
+            = (W_i[i] > 0.0)
                   ? Scalar(1.0) / imb_factor
                   : (Scalar(1.0)
                      + m_max_scale); // as in gromacs, use half the imbalance factor to scale
@@ -378,7 +434,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to
     // enforce the inequality constraints correctly)
     const Scalar eps(0.001);
-    unsigned int m = (unsigned int)N_i.size();
+    unsigned int m = (unsigned int)W_i.size();
     unsigned int n = m - 1;
     Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2 * m, n + m);
     A(0, 0) = 1.0;
@@ -628,7 +684,11 @@ void export_LoadBalancer(pybind11::module& m)
                       &LoadBalancer::setMaxIterations)
         .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
         .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
-        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ);
+        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+        .def_property("weight", &LoadBalancer::getWeight, &LoadBalancer::setWeight)
+        .def_property_readonly("max_imbalance", &LoadBalancer::getMaxImbalance)
+        .def_property_readonly("max_max_imbalance", &LoadBalancer::getMaxMaxImbalance)
+        .def_property_readonly("average_max_imbalance", &LoadBalancer::getAverageMaxImbalance);
     }
 
     } // end namespace detail
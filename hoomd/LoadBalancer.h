@@ -27,6 +27,12 @@ namespace hoomd
  * them. The load imbalance is defined as the number of particles owned by a rank divided by the
  * average number of particles per rank if the particles had a uniform distribution.
  *
+ * When the load is weighted by time, each rank instead converts the force computation time that
+ * Integrator recorded in the Communicator since the previous update into a cost per owned
+ * particle. The load of a rank is then its cost per particle times the number of particles it owns,
+ * and the imbalance is the load divided by the average load. Particles that move to a rank during
+ * balancing are assumed to cost as much as the particles already on it.
+ *
  * At each load balancing step, we attempt to rescale the domain size by the inverse of the load
  * balance, subject to the following constraints that are imposed to both maintain a stable
  * balancing and to keep communication isolated to the 26 nearest neighbors of a cell:
@@ -100,6 +106,26 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
             }
         }
 
+    //! Get the quantity that weights the load of each rank ("particles" or "time")
+    std::string getWeight() const
+        {
+        return m_weight_time ? "time" : "particles";
+        }
+
+    //! Set the quantity that weights the load of each rank
+    void setWeight(const std::string& weight)
+        {
+        if (weight == "particles")
+            m_weight_time = false;
+        else if (weight == "time")
+            m_weight_time = true;
+        else
+            {
+            throw std::runtime_error("LoadBalancer: unknown weight " + weight);
+            }
+        m_recompute_max_imbalance = true;
+        }
+
     /// Set m_enable_x
     void setEnableX(bool enable)
         {
@@ -142,6 +168,21 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     //! Reset the counters for the run
     virtual void resetStats();
 
+    //! Get the maximum imbalance factor found by the last update
+    Scalar getMaxImbalance();
+
+    //! Get the largest maximum imbalance found since the last resetStats()
+    Scalar getMaxMaxImbalance() const
+        {
+        return m_max_max_imbalance;
+        }
+
+    //! Get the average maximum imbalance over the updates since the last resetStats()
+    Scalar getAverageMaxImbalance() const
+        {
+        return m_n_calls > 0 ? Scalar(m_total_max_imbalance / double(m_n_calls)) : Scalar(1.0);
+        }
+
     protected:
     std::shared_ptr<DomainDecomposition> m_decomposition; //!< The domain decomposition to balance
     std::shared_ptr<Trigger> m_trigger;
@@ -152,11 +193,8 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     /// The systems's communicator.
     std::shared_ptr<Communicator> m_comm;
 
-    //! Computes the maximum imbalance factor
-    Scalar getMaxImbalance();
-
-    //! Reduce the particle numbers per rank down to one dimension
-    bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+    //! Reduce the load per rank down to one dimension
+    bool reduce(std::vector<double>& W_i, unsigned int dim, unsigned int reduce_root);
 
     //! Set flags within the class that a resize has been performed
     void signalResize()
@@ -168,7 +206,7 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     //! Adjust the partitioning along a single dimension
     bool adjust(std::vector<Scalar>& cum_frac_i,
-                const std::vector<unsigned int>& N_i,
+                const std::vector<double>& W_i,
                 Scalar L_i,
                 Scalar min_domain_frac);
 
@@ -195,6 +233,18 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         m_recompute_max_imbalance = true;
         m_needs_recount = false;
         }
+
+    //! Measure the cost per particle of this rank from the recorded local work time
+    void measureCost();
+
+    //! Computes the maximum imbalance factor over all ranks
+    Scalar computeMaxImbalance();
+
+    //! Gets the load of this rank
+    double getLoad()
+        {
+        return m_cost_per_particle * double(getNOwn());
+        }
 #endif // ENABLE_MPI
 
     Scalar m_max_imbalance;         //!< Maximum imbalance
@@ -208,11 +258,13 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     bool m_enable_x;        //!< Flag to enable balancing in x
     bool m_enable_y;        //!< Flag to enable balancing in y
     bool m_enable_z;        //!< Flag to enable balancing z
+    bool m_weight_time;     //!< Flag to weight the load by the measured compute time
 
     const Scalar m_max_scale; //!< Maximum fraction to rescale either direction (5%)
 
     private:
-    unsigned int m_N_own; //!< Number of particles owned by this rank
+    unsigned int m_N_own;       //!< Number of particles owned by this rank
+    double m_cost_per_particle; //!< Load of each particle owned by this rank
 
     Scalar m_max_max_imbalance;   //!< The maximum imbalance of any check
     double m_total_max_imbalance; //!< The average imbalance over checks
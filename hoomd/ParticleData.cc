@@ -132,12 +132,15 @@ ParticleData::ParticleData(unsigned int N,
  * \param global_box The dimensions of the global simulation box
  * \param exec_conf The execution configuration
  * \param decomposition (optional) Domain decomposition layout
+ * \param distributed_snapshot (optional) Set to true when every rank holds part of the snapshot
+ *        (see initializeFromDistributedSnapshot())
  */
 template<class Real>
 ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            const std::shared_ptr<const BoxDim> global_box,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
-                           std::shared_ptr<DomainDecomposition> decomposition)
+                           std::shared_ptr<DomainDecomposition> decomposition,
+                           bool distributed_snapshot)
     : m_exec_conf(exec_conf), m_nparticles(0), m_nghosts(0), m_max_nparticles(0), m_nglobal(0),
       m_accel_set(false), m_resize_factor(9. / 8.), m_arrays_allocated(false)
     {
@@ -152,8 +155,11 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     // initialize box dimensions on all processors
     setGlobalBox(global_box);
 
+    // a distributed snapshot is only meaningful with domain decomposition
+    distributed_snapshot = distributed_snapshot && decomposition;
+
     // it is an error for particles to be initialized outside of their box
-    if (!inBox(snapshot))
+    if (!inBox(snapshot, distributed_snapshot))
         {
         m_exec_conf->msg->warning() << "Not all particles were found inside the given box" << endl;
         throw runtime_error("Error initializing ParticleData");
@@ -172,7 +178,10 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
     TAG_ALLOCATION(m_rtag);
 
     // initialize particle data with snapshot contents
-    initializeFromSnapshot(snapshot);
+    if (distributed_snapshot)
+        initializeFromDistributedSnapshot(snapshot);
+    else
+        initializeFromSnapshot(snapshot);
 
     // reset external virial
     for (unsigned int i = 0; i < 6; i++)
@@ -932,10 +941,11 @@ void ParticleData::maybe_rebuild_tag_cache()
 
 /*! \return true If and only if all particles are in the simulation box
  */
-template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>& snap)
+template<class Real>
+bool ParticleData::inBox(const SnapshotParticleData<Real>& snap, bool distributed)
     {
     bool in_box = true;
-    if (m_exec_conf->getRank() == 0)
+    if (m_exec_conf->getRank() == 0 || distributed)
         {
         Scalar3 lo = m_global_box->getLo();
         Scalar3 hi = m_global_box->getHi();
@@ -961,7 +971,16 @@ template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>&
             }
         }
 #ifdef ENABLE_MPI
-    if (m_decomposition)
+    if (m_decomposition && distributed)
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &in_box,
+                      1,
+                      MPI_CXX_BOOL,
+                      MPI_LAND,
+                      m_exec_conf->getMPICommunicator());
+        }
+    else if (m_decomposition)
         {
         bcast(in_box, 0, m_exec_conf->getMPICommunicator());
         }
@@ -969,6 +988,78 @@ template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>&
     return in_box;
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle (wrapped into the box when it is exactly on a boundary)
+    \param image Image of the particle (updated when the position is wrapped)
+    \param snap_idx Index of the particle in the snapshot (for error messages)
+    \param cart_ranks Map from cartesian domain index to rank
+
+    \returns The rank of the domain that contains the particle.
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos,
+                                                 int3& image,
+                                                 unsigned int snap_idx,
+                                                 const unsigned int* cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    BoxDim global_box = *m_global_box;
+
+    // determine domain the particle is placed into
+    Scalar3 f = m_global_box->makeFraction(pos);
+    int i = int(f.x * ((Scalar)di.getW()));
+    int j = int(f.y * ((Scalar)di.getH()));
+    int k = int(f.z * ((Scalar)di.getD()));
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0, 0, 0);
+    if (i == (int)di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int)di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int)di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, image, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(global_box, pos, cart_ranks);
+
+    if (rank >= m_exec_conf->getNRanks())
+        {
+        ostringstream s;
+        s << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
+        s << "Cartesian coordinates: " << std::endl;
+        s << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+        s << "Fractional coordinates: " << std::endl;
+        s << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+        Scalar3 lo = m_global_box->getLo();
+        Scalar3 hi = m_global_box->getHi();
+        s << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+        s << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+        throw std::runtime_error(s.str());
+        }
+
+    return rank;
+    }
+#endif
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
     \param ignore_bodies If True, ignore particles that have a body flag set
@@ -1059,11 +1150,6 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                                                    access_location::host,
                                                    access_mode::read);
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-
-            BoxDim global_box = *m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector<vec3<Real>>::const_iterator it = snapshot.pos.begin();
                  it != snapshot.pos.end();
@@ -1078,63 +1164,9 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                     continue;
                     }
 
-                // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box->makeFraction(pos);
-                int i = int(f.x * ((Scalar)di.getW()));
-                int j = int(f.y * ((Scalar)di.getH()));
-                int k = int(f.z * ((Scalar)di.getD()));
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0, 0, 0);
-                if (i == (int)di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int)di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int)di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank
-                    = m_decomposition->placeParticle(global_box, pos, h_cart_ranks.data);
-
-                if (rank >= n_ranks)
-                    {
-                    ostringstream s;
-                    s << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    s << "Cartesian coordinates: " << std::endl;
-                    s << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    s << "Fractional coordinates: " << std::endl;
-                    s << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box->getLo();
-                    Scalar3 hi = m_global_box->getHi();
-                    s << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")"
-                      << std::endl;
-                    s << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")"
-                      << std::endl;
-
-                    throw std::runtime_error(s.str());
-                    }
+                unsigned int rank = placeSnapshotParticle(pos, img, snap_idx, h_cart_ranks.data);
 
                 // fill up per-processor data structures
                 pos_proc[rank].push_back(pos);
@@ -1378,6 +1410,205 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         }
     }
 
+/*! \param snapshot This rank's part of the initial particle data
+
+    Rank r holds the particles with tags [first_tag, first_tag + snapshot.size), where first_tag
+    is the total size of the snapshots on ranks 0 to r-1. Every rank must hold the same type
+    mapping.
+
+    \post the particle data arrays are initialized from the snapshot, in tag order
+
+    \pre The local box size must be set before a call to initializeFromDistributedSnapshot().
+*/
+template<class Real>
+void ParticleData::initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot)
+    {
+#ifdef ENABLE_MPI
+    if (!m_decomposition)
+#endif
+        {
+        // with a single rank, the distributed snapshot is the whole snapshot
+        initializeFromSnapshot(snapshot);
+        return;
+        }
+
+#ifdef ENABLE_MPI
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from distributed snapshot"
+                                << std::endl;
+    if (snapshot.type_mapping.size() >= 40 && m_exec_conf->getRank() == 0)
+        {
+        m_exec_conf->msg->warning() << "Systems with many particle types perform poorly or result "
+                                       "in shared memory errors on the GPU."
+                                    << std::endl;
+        }
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // each rank checks its own part of the snapshot
+    snapshot.validate();
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+
+    // the tags of this rank's particles follow those of the lower ranks
+    unsigned int snapshot_size = snapshot.size;
+    unsigned int first_tag = 0;
+    unsigned int nglobal = 0;
+    MPI_Exscan(&snapshot_size, &first_tag, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    MPI_Allreduce(&snapshot_size, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+
+    // place the particles into domains
+    std::vector<std::vector<detail::pdata_element>> send_particles(n_ranks);
+    unsigned int max_typeid = 0;
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
+
+        for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+            {
+            unsigned int tag = first_tag + snap_idx;
+            Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+            int3 img = snapshot.image[snap_idx];
+            unsigned int rank = placeSnapshotParticle(pos, img, tag, h_cart_ranks.data);
+
+            detail::pdata_element p;
+            p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(snapshot.type[snap_idx]));
+            p.vel = make_scalar4(snapshot.vel[snap_idx].x,
+                                 snapshot.vel[snap_idx].y,
+                                 snapshot.vel[snap_idx].z,
+                                 snapshot.mass[snap_idx]);
+            p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+            p.charge = snapshot.charge[snap_idx];
+            p.diameter = snapshot.diameter[snap_idx];
+            p.image = img;
+            p.body = snapshot.body[snap_idx];
+            p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+            p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+            p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+            p.tag = tag;
+            p.net_force = make_scalar4(0, 0, 0, 0);
+            p.net_torque = make_scalar4(0, 0, 0, 0);
+            for (unsigned int i = 0; i < 6; i++)
+                p.net_virial[i] = Scalar(0.0);
+            send_particles[rank].push_back(p);
+
+            max_typeid = std::max(max_typeid, snapshot.type[snap_idx]);
+            }
+        }
+
+    // send every particle to the rank of its domain
+    std::vector<detail::pdata_element> particles;
+    all_to_all_v(send_particles, particles, mpi_comm);
+    std::vector<std::vector<detail::pdata_element>>().swap(send_particles);
+
+    // store local particles in ascending tag order, as initializeFromSnapshot() does
+    std::sort(particles.begin(),
+              particles.end(),
+              [](const detail::pdata_element& a, const detail::pdata_element& b)
+              { return a.tag < b.tag; });
+
+    // use the type mapping of the root rank
+    m_type_mapping = snapshot.type_mapping;
+    bcast(m_type_mapping, 0, mpi_comm);
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    m_nparticles = (unsigned int)particles.size();
+    resize(m_nparticles);
+
+        {
+        // Load particle data
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            const detail::pdata_element& p = particles[idx];
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_accel.data[idx] = p.accel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_tag.data[idx] = p.tag;
+            h_rtag.data[p.tag] = idx;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
+        }
+
+    // copy over accel_set flag from the root rank's snapshot
+    m_accel_set = snapshot.is_accel_set;
+    bcast(m_accel_set, 0, mpi_comm);
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+
+    // Raise an exception if there are any invalid type ids (on all ranks, to avoid deadlocks)
+    MPI_Allreduce(MPI_IN_PLACE, &max_typeid, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+    if (nglobal != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+#endif
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -2741,19 +2972,25 @@ string print_ParticleData(ParticleData* pdata)
 template ParticleData::ParticleData(const SnapshotParticleData<double>& snapshot,
                                     const std::shared_ptr<const BoxDim> global_box,
                                     std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                    std::shared_ptr<DomainDecomposition> decomposition);
+                                    std::shared_ptr<DomainDecomposition> decomposition,
+                                    bool distributed_snapshot);
 template void
 ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double>& snapshot,
                                              bool ignore_bodies);
+template void ParticleData::initializeFromDistributedSnapshot<double>(
+    const SnapshotParticleData<double>& snapshot);
 template void ParticleData::takeSnapshot<double>(SnapshotParticleData<double>& snapshot);
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                     const std::shared_ptr<const BoxDim> global_box,
                                     std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                    std::shared_ptr<DomainDecomposition> decomposition);
+                                    std::shared_ptr<DomainDecomposition> decomposition,
+                                    bool distributed_snapshot);
 template void
 ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float>& snapshot,
                                             bool ignore_bodies);
+template void ParticleData::initializeFromDistributedSnapshot<float>(
+    const SnapshotParticleData<float>& snapshot);
 template void ParticleData::takeSnapshot<float>(SnapshotParticleData<float>& snapshot);
 
 namespace detail
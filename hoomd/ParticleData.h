@@ -432,7 +432,8 @@ class PYBIND11_EXPORT ParticleData
                  const std::shared_ptr<const BoxDim> global_box,
                  std::shared_ptr<ExecutionConfiguration> exec_conf,
                  std::shared_ptr<DomainDecomposition> decomposition
-                 = std::shared_ptr<DomainDecomposition>());
+                 = std::shared_ptr<DomainDecomposition>(),
+                 bool distributed_snapshot = false);
 
     //! Destructor
     virtual ~ParticleData();
@@ -1130,6 +1131,14 @@ class PYBIND11_EXPORT ParticleData
     void initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot,
                                 bool ignore_bodies = false);
 
+    //! Initialize from a snapshot distributed over all ranks
+    /*! Each rank holds a contiguous range of the particles in ascending tag order (rank 0 holds
+        the first range). The ranks send the particles to the ranks of their domains with one all
+        to all exchange, so that no rank needs to hold the whole system.
+    */
+    template<class Real>
+    void initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot);
+
     //! Take a snapshot
     template<class Real> void takeSnapshot(SnapshotParticleData<Real>& snapshot);
 
@@ -1367,8 +1376,18 @@ class PYBIND11_EXPORT ParticleData
     //! Helper function to check that particles of a snapshot are in the box
     /*! \return true If and only if all particles are in the simulation box
      * \param Snapshot to check
+     * \param distributed Set to true when every rank holds part of the snapshot
      */
-    template<class Real> bool inBox(const SnapshotParticleData<Real>& snap);
+    template<class Real>
+    bool inBox(const SnapshotParticleData<Real>& snap, bool distributed = false);
+
+#ifdef ENABLE_MPI
+    //! Helper function to find the rank of the domain a snapshot particle is placed in
+    unsigned int placeSnapshotParticle(Scalar3& pos,
+                                       int3& image,
+                                       unsigned int snap_idx,
+                                       const unsigned int* cart_ranks);
+#endif
 
     //! Update the CUDA memory hints
     void setGPUAdvice();
@@ -70,6 +70,7 @@ struct RNGIdentifier
     static const uint8_t BussiThermostat = 45;
     static const uint8_t ConstantPressure = 46;
     static const uint8_t MPCDCellList = 47;
+    static const uint8_t HPMCMonoCheckerboard = 48;
     };
 
     } // namespace hoomd
@@ -203,6 +203,10 @@ void System::resetStats()
     for (auto& updater : m_updaters)
         updater->resetStats();
 
+    // tuners
+    for (auto& tuner : m_tuners)
+        tuner->resetStats();
+
     // computes
     for (auto compute : m_computes)
         compute->resetStats();
@@ -104,16 +104,24 @@ SystemDefinition::SystemDefinition(unsigned int N,
     \param snapshot Snapshot to use
     \param exec_conf Execution configuration to run on
     \param decomposition (optional) The domain decomposition layout
+    \param distributed_snapshot True if each rank holds a part of the particles and groups
+
+    With \a distributed_snapshot, the particles and bonded groups of rank r follow those of ranks
+    0 to r-1 in tag order. The box, dimensions, and type names are taken from rank 0.
 */
 template<class Real>
 SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<Real>> snapshot,
                                    std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                   std::shared_ptr<DomainDecomposition> decomposition)
+                                   std::shared_ptr<DomainDecomposition> decomposition,
+                                   bool distributed_snapshot)
     {
     setNDimensions(snapshot->dimensions);
 
-    m_particle_data = std::shared_ptr<ParticleData>(
-        new ParticleData(snapshot->particle_data, snapshot->global_box, exec_conf, decomposition));
+    m_particle_data = std::shared_ptr<ParticleData>(new ParticleData(snapshot->particle_data,
+                                                                     snapshot->global_box,
+                                                                     exec_conf,
+                                                                     decomposition,
+                                                                     distributed_snapshot));
 
 #ifdef ENABLE_MPI
     // in MPI simulations, broadcast dimensionality from rank zero
@@ -121,19 +129,22 @@ SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<Real>> sna
         bcast(m_n_dimensions, 0, exec_conf->getMPICommunicator());
 #endif
 
-    m_bond_data = std::shared_ptr<BondData>(new BondData(m_particle_data, snapshot->bond_data));
+    m_bond_data = std::shared_ptr<BondData>(
+        new BondData(m_particle_data, snapshot->bond_data, distributed_snapshot));
 
-    m_angle_data = std::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data));
+    m_angle_data = std::shared_ptr<AngleData>(
+        new AngleData(m_particle_data, snapshot->angle_data, distributed_snapshot));
 
-    m_dihedral_data
-        = std::shared_ptr<DihedralData>(new DihedralData(m_particle_data, snapshot->dihedral_data));
+    m_dihedral_data = std::shared_ptr<DihedralData>(
+        new DihedralData(m_particle_data, snapshot->dihedral_data, distributed_snapshot));
 
-    m_improper_data
-        = std::shared_ptr<ImproperData>(new ImproperData(m_particle_data, snapshot->improper_data));
+    m_improper_data = std::shared_ptr<ImproperData>(
+        new ImproperData(m_particle_data, snapshot->improper_data, distributed_snapshot));
 
     m_constraint_data = std::shared_ptr<ConstraintData>(
-        new ConstraintData(m_particle_data, snapshot->constraint_data));
-    m_pair_data = std::shared_ptr<PairData>(new PairData(m_particle_data, snapshot->pair_data));
+        new ConstraintData(m_particle_data, snapshot->constraint_data, distributed_snapshot));
+    m_pair_data = std::shared_ptr<PairData>(
+        new PairData(m_particle_data, snapshot->pair_data, distributed_snapshot));
 
 #ifdef BUILD_MPCD
     m_mpcd_data = std::make_shared<mpcd::ParticleData>(snapshot->mpcd_data,
@@ -238,14 +249,16 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr<SnapshotSystemData
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<float>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                            std::shared_ptr<DomainDecomposition> decomposition);
+                                            std::shared_ptr<DomainDecomposition> decomposition,
+                                            bool distributed_snapshot);
 template std::shared_ptr<SnapshotSystemData<float>> SystemDefinition::takeSnapshot<float>();
 template void SystemDefinition::initializeFromSnapshot<float>(
     std::shared_ptr<SnapshotSystemData<float>> snapshot);
 
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<double>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
-                                            std::shared_ptr<DomainDecomposition> decomposition);
+                                            std::shared_ptr<DomainDecomposition> decomposition,
+                                            bool distributed_snapshot);
 template std::shared_ptr<SnapshotSystemData<double>> SystemDefinition::takeSnapshot<double>();
 template void SystemDefinition::initializeFromSnapshot<double>(
     std::shared_ptr<SnapshotSystemData<double>> snapshot);
@@ -276,11 +289,19 @@ void export_SystemDefinition(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SnapshotSystemData<float>>,
                             std::shared_ptr<ExecutionConfiguration>,
                             std::shared_ptr<DomainDecomposition>>())
+        .def(pybind11::init<std::shared_ptr<SnapshotSystemData<float>>,
+                            std::shared_ptr<ExecutionConfiguration>,
+                            std::shared_ptr<DomainDecomposition>,
+                            bool>())
         .def(pybind11::init<std::shared_ptr<SnapshotSystemData<float>>,
                             std::shared_ptr<ExecutionConfiguration>>())
         .def(pybind11::init<std::shared_ptr<SnapshotSystemData<double>>,
                             std::shared_ptr<ExecutionConfiguration>,
                             std::shared_ptr<DomainDecomposition>>())
+        .def(pybind11::init<std::shared_ptr<SnapshotSystemData<double>>,
+                            std::shared_ptr<ExecutionConfiguration>,
+                            std::shared_ptr<DomainDecomposition>,
+                            bool>())
         .def(pybind11::init<std::shared_ptr<SnapshotSystemData<double>>,
                             std::shared_ptr<ExecutionConfiguration>>())
         .def("setNDimensions", &SystemDefinition::setNDimensions)
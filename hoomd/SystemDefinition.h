@@ -108,7 +108,8 @@ class PYBIND11_EXPORT SystemDefinition
                      std::shared_ptr<ExecutionConfiguration> exec_conf
                      = std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration()),
                      std::shared_ptr<DomainDecomposition> decomposition
-                     = std::shared_ptr<DomainDecomposition>());
+                     = std::shared_ptr<DomainDecomposition>(),
+                     bool distributed_snapshot = false);
 
     //! Set the dimensionality of the system
     void setNDimensions(unsigned int);
@@ -561,8 +561,14 @@ def autotuned_kernel_parameter_check(instance, activate, all_optional=False):
     initial_kernel_parameters = instance.kernel_parameters
 
     if isinstance(instance._simulation.device, hoomd.device.CPU):
-        # CPU instances have no parameters and are always complete.
-        assert initial_kernel_parameters == {}
+        # CPU instances only have optional parameters and are always
+        # complete.
+        assert instance.is_tuning_complete
+
+        # Ensure that we can set parameters.
+        instance.kernel_parameters = initial_kernel_parameters
+        activate()
+        assert instance.kernel_parameters == initial_kernel_parameters
         assert instance.is_tuning_complete
     else:
         # GPU instances have parameters and start incomplete.
@@ -267,6 +267,9 @@ void export_IntegratorHPMC(pybind11::module& m)
         .def_property("translation_move_probability",
                       &IntegratorHPMC::getTranslationMoveProbability,
                       &IntegratorHPMC::setTranslationMoveProbability)
+        .def_property("checkerboard",
+                      &IntegratorHPMC::getCheckerboard,
+                      &IntegratorHPMC::setCheckerboard)
         .def_property_readonly("pair_potentials", &IntegratorHPMC::getPairPotentials)
         .def("computeTotalPairEnergy", &IntegratorHPMC::computeTotalPairEnergy)
         .def_property_readonly("external_potentials", &IntegratorHPMC::getExternalPotentials)
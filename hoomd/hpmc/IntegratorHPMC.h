@@ -332,6 +332,20 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return m_nselect;
         }
 
+    //! Set whether the CPU implementation performs checkerboard sweeps
+    /*! \param checkerboard true to attempt trial moves in parallel over alternating sets of cells
+     */
+    void setCheckerboard(bool checkerboard)
+        {
+        m_checkerboard = checkerboard;
+        }
+
+    //! Get whether the CPU implementation performs checkerboard sweeps
+    inline bool getCheckerboard()
+        {
+        return m_checkerboard;
+        }
+
     //! Get performance in moves per second
     virtual double getMPS()
         {
@@ -503,6 +517,40 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                                                         LongReal d_j,
                                                                         LongReal charge_j)
         {
+        LongReal energy = computeOnePatchEnergy(r_squared,
+                                                r_ij,
+                                                type_i,
+                                                q_i,
+                                                d_i,
+                                                charge_i,
+                                                type_j,
+                                                q_j,
+                                                d_j,
+                                                charge_j);
+        for (const auto& pair : m_pair_potentials)
+            {
+            if (r_squared < pair->getRCutSquaredTotal(type_i, type_j))
+                {
+                energy
+                    += pair->energy(r_squared, r_ij, type_i, q_i, charge_i, type_j, q_j, charge_j);
+                }
+            }
+
+        return energy;
+        }
+
+    /// Evaluate the legacy patch energy between one pair of particles.
+    __attribute__((always_inline)) inline LongReal computeOnePatchEnergy(const LongReal r_squared,
+                                                                         const vec3<LongReal>& r_ij,
+                                                                         unsigned int type_i,
+                                                                         const quat<LongReal>& q_i,
+                                                                         LongReal d_i,
+                                                                         LongReal charge_i,
+                                                                         unsigned int type_j,
+                                                                         const quat<LongReal>& q_j,
+                                                                         LongReal d_j,
+                                                                         LongReal charge_j)
+        {
         LongReal energy = 0;
         if (m_patch)
             {
@@ -523,13 +571,30 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                           float(charge_j));
                 }
             }
+
+        return energy;
+        }
+
+    /*** Evaluate the total energy of all pair potentials between particle i and a batch of j
+        particles.
+
+        The legacy patch energy is not included, evaluate it with computeOnePatchEnergy.
+
+        @param type_i Type index of particle i.
+        @param q_i Orientation of particle i.
+        @param charge_i Charge of particle i.
+        @param batch The j particles in the coordinate system of particle i.
+        @returns Sum of the pair energies.
+    */
+    LongReal computePairEnergyBatch(unsigned int type_i,
+                                    const quat<LongReal>& q_i,
+                                    LongReal charge_i,
+                                    const PairEnergyBatch& batch) const
+        {
+        LongReal energy = 0;
         for (const auto& pair : m_pair_potentials)
             {
-            if (r_squared < pair->getRCutSquaredTotal(type_i, type_j))
-                {
-                energy
-                    += pair->energy(r_squared, r_ij, type_i, q_i, charge_i, type_j, q_j, charge_j);
-                }
+            energy += pair->energyBatch(type_i, q_i, charge_i, batch);
             }
 
         return energy;
@@ -596,6 +661,9 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     unsigned int m_translation_move_probability; //!< Fraction of moves that are translation moves.
     unsigned int m_nselect;                      //!< Number of particles to select for trial moves
 
+    /// Set to true to perform checkerboard sweeps in parallel on the CPU
+    bool m_checkerboard = false;
+
     GPUVector<Scalar> m_d; //!< Maximum move displacement by type
     GPUVector<Scalar> m_a; //!< Maximum angular displacement by type
 
@@ -446,6 +446,9 @@ class IntegratorHPMCMono : public IntegratorHPMC
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
 
+        /// Rebuild the AABB tree when refitting grows the node surface area past this ratio
+        static constexpr Scalar aabb_tree_max_cost_ratio = Scalar(1.5);
+
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
@@ -456,6 +459,9 @@ class IntegratorHPMCMono : public IntegratorHPMC
         /// Cached shape radius by type.
         std::vector<LongReal> m_shape_circumsphere_radius;
 
+        /// Neighbors of the particle being moved, evaluated with PairPotential::energyBatch
+        PairEnergyBatch m_pair_energy_batch;
+
         /* Depletants related data members */
 
         GlobalVector<Scalar> m_fugacity;            //!< Average depletant number density in free volume, per type
@@ -472,6 +478,23 @@ class IntegratorHPMCMono : public IntegratorHPMC
             uint64_t timestep, hoomd::RandomGenerator& rng_depletants,
             unsigned int seed_i_old, unsigned int seed_i_new);
 
+        /// Number of checkerboard cells in each direction
+        uint3 m_checkerboard_dim;
+
+        /// Offset of the first particle of each checkerboard cell in m_checkerboard_particles
+        std::vector<unsigned int> m_checkerboard_cell_start;
+
+        /// Local particle indices sorted by checkerboard cell
+        std::vector<unsigned int> m_checkerboard_particles;
+
+        bool m_checkerboard_warning_issued;                  //!< True if the checkerboard fallback warning has been issued
+
+        //! Test whether this step can use checkerboard sweeps and size the cell grid
+        bool setupCheckerboard(const BoxDim& box, bool has_depletants);
+
+        //! Perform nselect checkerboard sweeps over the local particles
+        void updateCheckerboard(uint64_t timestep, const unsigned int* h_overlaps, hpmc_counters_t& counters);
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -532,6 +555,9 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_image_list_warning_issued = false;
     m_hkl_max_warning_issued = false;
 
+    m_checkerboard_dim = make_uint3(0, 0, 0);
+    m_checkerboard_warning_issued = false;
+
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
@@ -670,8 +696,15 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
         m_max_pair_additive_cutoff.push_back(getMaxPairInteractionAdditiveRCut(type));
         }
 
-    // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+    // attempt the trial moves in parallel over alternating sets of cells when requested
+    const bool use_checkerboard = m_checkerboard && setupCheckerboard(box, has_depletants);
+    if (use_checkerboard)
+        {
+        updateCheckerboard(timestep, h_overlaps.data, counters);
+        }
+
+    // otherwise, loop over local particles nselect times
+    for (unsigned int i_nselect = 0; !use_checkerboard && i_nselect < m_nselect; i_nselect++)
         {
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -768,6 +801,10 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
+            // collect the neighbors and evaluate the pair potentials once per potential
+            const bool batch_pair_energy = !m_pair_potentials.empty();
+            m_pair_energy_batch.clear();
+
             // check for overlaps with neighboring particle's positions (also calculate the new energy)
             // All image boxes (including the primary)
             const unsigned int n_images = (unsigned int)m_image_list.size();
@@ -777,160 +814,159 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 hoomd::detail::AABB aabb = aabb_i_local;
                 aabb.translate(pos_i_image);
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                // search the wide nodes, stop at the first overlap
+                overlap = m_aabb_tree.traverse(aabb, [&](unsigned int cur_node_idx)
                     {
-                    if (aabb.overlaps(m_aabb_tree.getNodeAABB(cur_node_idx)))
+                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                         {
-                        if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        // read in its position and orientation
+                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        quat<LongReal> orientation_j;
+
+                        // handle j==i situations
+                        if ( j != i )
                             {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            // load the position and orientation of the j particle
+                            postype_j = h_postype.data[j];
+                            orientation_j = quat<LongReal>(h_orientation.data[j]);
+                            }
+                        else
+                            {
+                            if (cur_image == 0)
                                 {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                Scalar4 postype_j;
-                                quat<LongReal> orientation_j;
+                                // in the first image, skip i == j
+                                continue;
+                                }
+                            else
+                                {
+                                // If this is particle i and we are in an outside image, use the translated position and orientation
+                                postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                                orientation_j = shape_i.orientation;
+                                }
+                            }
 
-                                // handle j==i situations
-                                if ( j != i )
-                                    {
-                                    // load the position and orientation of the j particle
-                                    postype_j = h_postype.data[j];
-                                    orientation_j = quat<LongReal>(h_orientation.data[j]);
-                                    }
-                                else
-                                    {
-                                    if (cur_image == 0)
-                                        {
-                                        // in the first image, skip i == j
-                                        continue;
-                                        }
-                                    else
-                                        {
-                                        // If this is particle i and we are in an outside image, use the translated position and orientation
-                                        postype_j = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
-                                        orientation_j = shape_i.orientation;
-                                        }
-                                    }
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(orientation_j, m_params[typ_j]);
 
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(orientation_j, m_params[typ_j]);
+                        LongReal r_squared = dot(r_ij, r_ij);
+                        LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[typ_j];
 
-                                LongReal r_squared = dot(r_ij, r_ij);
-                                LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[typ_j];
+                        counters.overlap_checks++;
+                        if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                            && r_squared < max_overlap_distance * max_overlap_distance
+                            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            return true;
+                            }
 
-                                counters.overlap_checks++;
-                                if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
-                                    && r_squared < max_overlap_distance * max_overlap_distance
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
-                                    {
-                                    overlap = true;
-                                    break;
-                                    }
+                        // deltaU = U_old - U_new: subtract energy of new configuration
+                        patch_field_energy_diff -= computeOnePatchEnergy(r_squared, r_ij, typ_i,
+                                                shape_i.orientation,
+                                                h_diameter.data[i],
+                                                h_charge.data[i],
+                                                typ_j,
+                                                shape_j.orientation,
+                                                h_diameter.data[j],
+                                                h_charge.data[j]
+                                                );
 
-                                // deltaU = U_old - U_new: subtract energy of new configuration
-                                patch_field_energy_diff -= computeOnePairEnergy(r_squared, r_ij, typ_i,
-                                                        shape_i.orientation,
-                                                        h_diameter.data[i],
-                                                        h_charge.data[i],
-                                                        typ_j,
-                                                        shape_j.orientation,
-                                                        h_diameter.data[j],
-                                                        h_charge.data[j]
-                                                        );
-                                }
-                           }
-                        }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                        if (batch_pair_energy)
+                            {
+                            m_pair_energy_batch.push_back(r_squared, r_ij, typ_j, shape_j.orientation, h_charge.data[j]);
+                            }
                         }
-
-                    if (overlap)
-                        break;
-                    }  // end loop over AABB nodes
+                    return false;
+                    });
 
                 if (overlap)
                     break;
                 } // end loop over images
 
+            if (batch_pair_energy && !overlap)
+                {
+                patch_field_energy_diff -= computePairEnergyBatch(typ_i, shape_i.orientation, h_charge.data[i], m_pair_energy_batch);
+                }
+
             // Calculate old pair energy only when there are pair energies to calculate.
             if (hasPairInteractions() && !overlap)
                 {
+                m_pair_energy_batch.clear();
+
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
                     hoomd::detail::AABB aabb = aabb_i_local;
                     aabb.translate(pos_i_image);
 
-                    // stackless search
-                    for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                    // search the wide nodes
+                    m_aabb_tree.traverse(aabb, [&](unsigned int cur_node_idx)
                         {
-                        if (aabb.overlaps(m_aabb_tree.getNodeAABB(cur_node_idx)))
+                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
                             {
-                            if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            // read in its position and orientation
+                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            Scalar4 postype_j;
+                            quat<LongReal> orientation_j;
+
+                            // handle j==i situations
+                            if ( j != i )
                                 {
-                                for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                // load the position and orientation of the j particle
+                                postype_j = h_postype.data[j];
+                                orientation_j = quat<LongReal>(h_orientation.data[j]);
+                                }
+                            else
+                                {
+                                if (cur_image == 0)
+                                    {
+                                    // in the first image, skip i == j
+                                    continue;
+                                    }
+                                else
                                     {
-                                    // read in its position and orientation
-                                    unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                    Scalar4 postype_j;
-                                    quat<LongReal> orientation_j;
-
-                                    // handle j==i situations
-                                    if ( j != i )
-                                        {
-                                        // load the position and orientation of the j particle
-                                        postype_j = h_postype.data[j];
-                                        orientation_j = quat<LongReal>(h_orientation.data[j]);
-                                        }
-                                    else
-                                        {
-                                        if (cur_image == 0)
-                                            {
-                                            // in the first image, skip i == j
-                                            continue;
-                                            }
-                                        else
-                                            {
-                                            // If this is particle i and we are in an outside image, use the translated position and orientation
-                                            postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
-                                            orientation_j = shape_old.orientation;
-                                            }
-                                        }
-
-                                    // put particles in coordinate system of particle i
-                                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-                                    unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                    Shape shape_j(orientation_j, m_params[typ_j]);
-
-                                    // deltaU = U_old - U_new: add energy of old configuration
-                                    patch_field_energy_diff += computeOnePairEnergy(dot(r_ij, r_ij),
-                                                            r_ij,
-                                                            typ_i,
-                                                            shape_old.orientation,
-                                                            h_diameter.data[i],
-                                                            h_charge.data[i],
-                                                            typ_j,
-                                                            shape_j.orientation,
-                                                            h_diameter.data[j],
-                                                            h_charge.data[j]);
+                                    // If this is particle i and we are in an outside image, use the translated position and orientation
+                                    postype_j = make_scalar4(pos_old.x, pos_old.y, pos_old.z, postype_i.w);
+                                    orientation_j = shape_old.orientation;
                                     }
                                 }
+
+                            // put particles in coordinate system of particle i
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            Shape shape_j(orientation_j, m_params[typ_j]);
+
+                            // deltaU = U_old - U_new: add energy of old configuration
+                            LongReal r_squared = dot(r_ij, r_ij);
+                            patch_field_energy_diff += computeOnePatchEnergy(r_squared,
+                                                    r_ij,
+                                                    typ_i,
+                                                    shape_old.orientation,
+                                                    h_diameter.data[i],
+                                                    h_charge.data[i],
+                                                    typ_j,
+                                                    shape_j.orientation,
+                                                    h_diameter.data[j],
+                                                    h_charge.data[j]);
+
+                            if (batch_pair_energy)
+                                {
+                                m_pair_energy_batch.push_back(r_squared, r_ij, typ_j, shape_j.orientation, h_charge.data[j]);
+                                }
                             }
-                        else
-                            {
-                            // skip ahead
-                            cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
-                            }
-                        }  // end loop over AABB nodes
+                        return false;
+                        });
                     } // end loop over images
+
+                if (batch_pair_energy)
+                    {
+                    patch_field_energy_diff += computePairEnergyBatch(typ_i, shape_old.orientation, h_charge.data[i], m_pair_energy_batch);
+                    }
                 }
 
             // Add external energetic contribution if there are no overlaps
@@ -1068,6 +1104,422 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     m_mps = double(run_counters.getNMoves()) / cur_time;
     }
 
+/*! \param box Local simulation box
+    \param has_depletants Set to true when any depletant fugacity is non-zero
+    \returns true when the trial moves of this step can be performed with checkerboard sweeps
+
+    Checkerboard sweeps need cells at least as wide as the nominal width and an even number of
+    cells (at least 2) in each direction so that two cells in the same set never share a neighbor.
+    Depletants and legacy external fields access shared state during a trial move and domain
+    decomposition already restricts moves to the active region, so these fall back to the serial
+    sweep.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::setupCheckerboard(const BoxDim& box, bool has_depletants)
+    {
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    std::string reason;
+
+    if (has_depletants)
+        {
+        reason = "depletants";
+        }
+    else if (m_external)
+        {
+        reason = "external fields";
+        }
+    #ifdef ENABLE_MPI
+    else if (m_sysdef->isDomainDecomposed())
+        {
+        reason = "domain decomposition";
+        }
+    #endif
+    else
+        {
+        // use cells no narrower than the interaction range, but avoid grids much larger than the
+        // number of particles
+        const unsigned int N = std::max(m_pdata->getN(), 1u);
+        const Scalar volume_per_particle = box.getVolume(ndim == 2) / Scalar(N);
+        const Scalar width = std::max(m_nominal_width,
+                                      Scalar(pow(volume_per_particle, Scalar(1.0) / Scalar(ndim))));
+
+        // round down to an even number of cells in each direction
+        const Scalar3 npd = box.getNearestPlaneDistance();
+        m_checkerboard_dim.x = (unsigned int)(npd.x / width) & ~1u;
+        m_checkerboard_dim.y = (unsigned int)(npd.y / width) & ~1u;
+        m_checkerboard_dim.z = (ndim == 2) ? 1 : (unsigned int)(npd.z / width) & ~1u;
+
+        if (m_checkerboard_dim.x < 2 || m_checkerboard_dim.y < 2
+            || (ndim == 3 && m_checkerboard_dim.z < 2))
+            {
+            reason = "a box narrower than two cells";
+            }
+        }
+
+    if (!reason.empty())
+        {
+        if (!m_checkerboard_warning_issued)
+            {
+            m_checkerboard_warning_issued = true;
+            m_exec_conf->msg->warning() << "Checkerboard sweeps are not supported with " << reason
+                                        << ", performing serial trial moves." << std::endl
+                                        << "This message will not be repeated." << std::endl;
+            }
+        return false;
+        }
+
+    m_exec_conf->msg->notice(10) << "HPMCMono checkerboard: " << m_checkerboard_dim.x << " x "
+                                 << m_checkerboard_dim.y << " x " << m_checkerboard_dim.z
+                                 << " cells" << std::endl;
+    return true;
+    }
+
+/*! \param timestep Current time step
+    \param h_overlaps Interaction matrix
+    \param counters Acceptance counters to accumulate into
+
+    The local box is split into the cells sized by setupCheckerboard() with a grid that is shifted
+    randomly every step, and the cells are divided into 2^dim sets by the parity of their indices.
+    Each sweep visits the sets in a random order and attempts trial moves in all cells of the
+    active set concurrently. Only a cell's own particles move while its neighbors are inactive, so
+    the cells of one set are independent. Trial moves that would leave the cell are rejected. Each
+    cell draws its trial moves from a random number stream seeded by the cell index and the sweep,
+    so the trajectory does not depend on the number of threads.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateCheckerboard(uint64_t timestep,
+                                                   const unsigned int* h_overlaps,
+                                                   hpmc_counters_t& counters)
+    {
+    const BoxDim box = m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const uint16_t seed = m_sysdef->getSeed();
+    const unsigned int rank = m_exec_conf->getRank();
+    const unsigned int N = m_pdata->getN();
+
+    const uint3 dim = m_checkerboard_dim;
+    const Index3D cell_indexer(dim.x, dim.y, dim.z);
+    const unsigned int n_cells = cell_indexer.getNumElements();
+    const unsigned int n_sets = (ndim == 2) ? 4 : 8;
+
+    // shift the grid randomly so that cell boundaries do not stay in place
+    hoomd::RandomGenerator rng_step(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoCheckerboard, timestep, seed),
+                                    hoomd::Counter(rank));
+    Scalar3 shift = make_scalar3(0, 0, 0);
+    shift.x = hoomd::UniformDistribution<Scalar>(0, Scalar(1.0) / Scalar(dim.x))(rng_step);
+    shift.y = hoomd::UniformDistribution<Scalar>(0, Scalar(1.0) / Scalar(dim.y))(rng_step);
+    if (ndim == 3)
+        shift.z = hoomd::UniformDistribution<Scalar>(0, Scalar(1.0) / Scalar(dim.z))(rng_step);
+
+    auto compute_cell = [&box, &shift, &dim, &cell_indexer](const vec3<Scalar>& r)
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(r));
+        f.x += shift.x;
+        f.y += shift.y;
+        f.z += shift.z;
+        f.x -= std::floor(f.x);
+        f.y -= std::floor(f.y);
+        f.z -= std::floor(f.z);
+        return cell_indexer(std::min((unsigned int)(f.x * Scalar(dim.x)), dim.x - 1),
+                            std::min((unsigned int)(f.y * Scalar(dim.y)), dim.y - 1),
+                            std::min((unsigned int)(f.z * Scalar(dim.z)), dim.z - 1));
+        };
+
+    // access particle data and move sizes
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+    // sort the particles by cell, keeping the shuffled update order within each cell
+    std::vector<unsigned int> particle_cell(N);
+    m_checkerboard_cell_start.assign(n_cells + 1, 0);
+    m_checkerboard_particles.resize(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        particle_cell[i] = compute_cell(vec3<Scalar>(h_postype.data[i]));
+        m_checkerboard_cell_start[particle_cell[i] + 1]++;
+        }
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        m_checkerboard_cell_start[cell + 1] += m_checkerboard_cell_start[cell];
+    {
+    std::vector<unsigned int> fill(m_checkerboard_cell_start.begin(), m_checkerboard_cell_start.end() - 1);
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+        m_checkerboard_particles[fill[particle_cell[i]]++] = i;
+        }
+    }
+
+    const unsigned int* cell_start = m_checkerboard_cell_start.data();
+    const unsigned int* cell_particles = m_checkerboard_particles.data();
+    const bool has_pair_interactions = hasPairInteractions();
+
+    // attempt trial moves for all particles in one cell
+    auto sweep_cell = [&](unsigned int cell, unsigned int i_nselect, hpmc_counters_t& cell_counters)
+        {
+        // collect the distinct neighboring cells, there are fewer than 27 when a direction has 2 cells
+        auto neighbor_range = [](unsigned int c, unsigned int n, unsigned int* out) -> unsigned int
+            {
+            if (n == 1)
+                {
+                out[0] = c;
+                return 1;
+                }
+            if (n == 2)
+                {
+                out[0] = c;
+                out[1] = c ^ 1;
+                return 2;
+                }
+            out[0] = (c + n - 1) % n;
+            out[1] = c;
+            out[2] = (c + 1) % n;
+            return 3;
+            };
+
+        const uint3 c = cell_indexer.getTriple(cell);
+        unsigned int nx[3], ny[3], nz[3];
+        const unsigned int n_x = neighbor_range(c.x, dim.x, nx);
+        const unsigned int n_y = neighbor_range(c.y, dim.y, ny);
+        const unsigned int n_z = neighbor_range(c.z, dim.z, nz);
+        unsigned int neighbors[27];
+        unsigned int n_neighbors = 0;
+        for (unsigned int a = 0; a < n_x; a++)
+            for (unsigned int b = 0; b < n_y; b++)
+                for (unsigned int d = 0; d < n_z; d++)
+                    neighbors[n_neighbors++] = cell_indexer(nx[a], ny[b], nz[d]);
+
+        hoomd::RandomGenerator rng_cell(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoCheckerboard, timestep, seed),
+                                        hoomd::Counter(cell, rank, i_nselect + 1));
+
+        for (unsigned int cur_particle = cell_start[cell]; cur_particle < cell_start[cell + 1]; cur_particle++)
+            {
+            unsigned int i = cell_particles[cur_particle];
+
+            // read in the current position and orientation
+            Scalar4 postype_i = h_postype.data[i];
+            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+            // make a trial move for i
+            int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<LongReal>(h_orientation.data[i]), m_params[typ_i]);
+            unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_cell);
+            bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_translation_move_probability);
+
+            Shape shape_old(shape_i.orientation, m_params[typ_i]);
+            vec3<Scalar> pos_old = pos_i;
+
+            if (move_type_translate)
+                {
+                // skip if no overlap check is required
+                if (h_d.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        cell_counters.translate_accept_count++;
+                    continue;
+                    }
+
+                move_translate(pos_i, rng_cell, h_d.data[typ_i], ndim);
+
+                // a particle that leaves its cell could interact with another active cell
+                if (compute_cell(pos_i) != cell)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        cell_counters.translate_reject_count++;
+                    continue;
+                    }
+                }
+            else
+                {
+                if (h_a.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        cell_counters.rotate_accept_count++;
+                    continue;
+                    }
+
+                if (ndim == 2)
+                    move_rotate<2>(shape_i.orientation, rng_cell, h_a.data[typ_i]);
+                else
+                    move_rotate<3>(shape_i.orientation, rng_cell, h_a.data[typ_i]);
+                }
+
+            bool overlap = false;
+
+            // patch + field interaction deltaU
+            double patch_field_energy_diff = 0;
+
+            // check for overlaps with the particles in the neighboring cells and compute the
+            // change in pair energy
+            for (unsigned int cur_neighbor = 0; cur_neighbor < n_neighbors && !overlap; cur_neighbor++)
+                {
+                const unsigned int neigh_cell = neighbors[cur_neighbor];
+                for (unsigned int cur_j = cell_start[neigh_cell]; cur_j < cell_start[neigh_cell + 1]; cur_j++)
+                    {
+                    unsigned int j = cell_particles[cur_j];
+                    if (j == i)
+                        continue;
+
+                    Scalar4 postype_j = h_postype.data[j];
+                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                    Shape shape_j(quat<LongReal>(h_orientation.data[j]), m_params[typ_j]);
+
+                    // put particles in coordinate system of particle i
+                    vec3<Scalar> r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_i)));
+
+                    LongReal r_squared = dot(r_ij, r_ij);
+                    LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[typ_j];
+
+                    cell_counters.overlap_checks++;
+                    if (h_overlaps[m_overlap_idx(typ_i, typ_j)]
+                        && r_squared < max_overlap_distance * max_overlap_distance
+                        && test_overlap(r_ij, shape_i, shape_j, cell_counters.overlap_err_count))
+                        {
+                        overlap = true;
+                        break;
+                        }
+
+                    if (has_pair_interactions)
+                        {
+                        vec3<Scalar> r_ij_old = vec3<Scalar>(box.minImage(vec_to_scalar3(vec3<Scalar>(postype_j) - pos_old)));
+
+                        // deltaU = U_old - U_new
+                        patch_field_energy_diff += computeOnePairEnergy(dot(r_ij_old, r_ij_old),
+                                                r_ij_old,
+                                                typ_i,
+                                                shape_old.orientation,
+                                                h_diameter.data[i],
+                                                h_charge.data[i],
+                                                typ_j,
+                                                shape_j.orientation,
+                                                h_diameter.data[j],
+                                                h_charge.data[j]);
+                        patch_field_energy_diff -= computeOnePairEnergy(r_squared,
+                                                r_ij,
+                                                typ_i,
+                                                shape_i.orientation,
+                                                h_diameter.data[i],
+                                                h_charge.data[i],
+                                                typ_j,
+                                                shape_j.orientation,
+                                                h_diameter.data[j],
+                                                h_charge.data[j]);
+                        }
+                    }
+                }
+
+            // Add external energetic contribution if there are no overlaps
+            if (!overlap)
+                {
+                // U_old - U_new
+                patch_field_energy_diff +=
+                    this->computeOneExternalEnergy(typ_i, pos_old, shape_old.orientation, h_charge.data[i], false) -
+                    this->computeOneExternalEnergy(typ_i, pos_i, shape_i.orientation, h_charge.data[i], true);
+                }
+
+            bool accept = !overlap && hoomd::detail::generate_canonical<double>(rng_cell) < slow::exp(patch_field_energy_diff);
+
+            if (accept)
+                {
+                if (!shape_i.ignoreStatistics())
+                    {
+                    if (move_type_translate)
+                        cell_counters.translate_accept_count++;
+                    else
+                        cell_counters.rotate_accept_count++;
+                    }
+
+                // update position of particle, keeping it inside the box for the minimum image
+                // convention used by the neighbors
+                h_postype.data[i] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                box.wrap(h_postype.data[i], h_image.data[i]);
+
+                if (shape_i.hasOrientation())
+                    {
+                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    }
+                }
+            else
+                {
+                if (!shape_i.ignoreStatistics())
+                    {
+                    // increment reject counter
+                    if (move_type_translate)
+                        cell_counters.translate_reject_count++;
+                    else
+                        cell_counters.rotate_reject_count++;
+                    }
+                }
+            } // end loop over particles in the cell
+        };
+
+    // the cells of one set are every other cell in each direction
+    const uint3 set_dim = make_uint3(dim.x / 2, dim.y / 2, (ndim == 2) ? 1 : dim.z / 2);
+    const unsigned int n_set_cells = set_dim.x * set_dim.y * set_dim.z;
+    const Index3D set_indexer(set_dim.x, set_dim.y, set_dim.z);
+
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+    #endif
+
+    unsigned int set_order[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+        {
+        // visit the sets in a random order
+        for (unsigned int i = n_sets - 1; i > 0; i--)
+            {
+            unsigned int j = hoomd::UniformIntDistribution(i)(rng_step);
+            std::swap(set_order[i], set_order[j]);
+            }
+
+        for (unsigned int cur_set = 0; cur_set < n_sets; cur_set++)
+            {
+            const unsigned int set = set_order[cur_set];
+            const uint3 parity = make_uint3(set & 1, (set >> 1) & 1, (set >> 2) & 1);
+
+            auto set_cell = [&](unsigned int k)
+                {
+                const uint3 s = set_indexer.getTriple(k);
+                return cell_indexer(2 * s.x + parity.x, 2 * s.y + parity.y, 2 * s.z + parity.z);
+                };
+
+            #ifdef ENABLE_TBB
+            if (m_exec_conf->getNumThreads() > 1)
+                {
+                m_exec_conf->getTaskArena()->execute(
+                    [&]
+                    {
+                        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_set_cells),
+                                          [&](const tbb::blocked_range<unsigned int>& r)
+                                          {
+                                              hpmc_counters_t& local_counters = thread_counters.local();
+                                              for (unsigned int k = r.begin(); k != r.end(); ++k)
+                                                  sweep_cell(set_cell(k), i_nselect, local_counters);
+                                          });
+                    });
+                }
+            else
+            #endif
+                {
+                for (unsigned int k = 0; k < n_set_cells; k++)
+                    sweep_cell(set_cell(k), i_nselect, counters);
+                }
+            }
+        }
+
+    #ifdef ENABLE_TBB
+    // reduce counters
+    for (auto i = thread_counters.begin(); i != thread_counters.end(); ++i)
+        {
+        counters = counters + *i;
+        }
+    #endif
+    }
+
 /*! \param timestep current step
     \param early_exit exit at first overlap found if true
     \returns number of overlaps if early_exit=false, 1 if early_exit=true
@@ -1726,8 +2178,7 @@ const hoomd::detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     {
     if (m_aabb_tree_invalid)
         {
-        m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
-        // build the AABB tree
+        // update the AABB tree
             {
             ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
@@ -1763,7 +2214,14 @@ const hoomd::detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = hoomd::detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                // refit the existing tree after small displacements, rebuild it when the node
+                // bounds have become too loose
+                if (!m_aabb_tree.refit(m_aabbs, n_aabb, aabb_tree_max_cost_ratio))
+                    {
+                    m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
+                    m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                    }
                 }
             }
 
@@ -10,6 +10,59 @@ namespace hoomd
     {
 namespace hpmc
     {
+/*** Structure of arrays holding the j particles of a batched pair energy evaluation.
+
+    IntegratorHPMC fills a PairEnergyBatch with all the candidate neighbors of a particle i found
+    by the spatial data structure and then calls PairPotential::energyBatch once per potential.
+    Entry k of every array describes one j particle in the coordinate system of particle i.
+    clear() keeps the allocated capacity so that the same batch can be reused without
+    reallocation.
+*/
+struct PairEnergyBatch
+    {
+    /// Number of j particles in the batch
+    size_t size() const
+        {
+        return r_squared.size();
+        }
+
+    /// Remove all j particles from the batch
+    void clear()
+        {
+        r_squared.clear();
+        r_x.clear();
+        r_y.clear();
+        r_z.clear();
+        type_j.clear();
+        q_j.clear();
+        charge_j.clear();
+        }
+
+    /// Add a j particle to the batch
+    void push_back(LongReal r_squared_ij,
+                   const vec3<LongReal>& r_ij,
+                   unsigned int type,
+                   const quat<LongReal>& q,
+                   LongReal charge)
+        {
+        r_squared.push_back(r_squared_ij);
+        r_x.push_back(r_ij.x);
+        r_y.push_back(r_ij.y);
+        r_z.push_back(r_ij.z);
+        type_j.push_back(type);
+        q_j.push_back(q);
+        charge_j.push_back(charge);
+        }
+
+    std::vector<LongReal> r_squared;  //!< dot(r_ij, r_ij)
+    std::vector<LongReal> r_x;        //!< x component of r_ij
+    std::vector<LongReal> r_y;        //!< y component of r_ij
+    std::vector<LongReal> r_z;        //!< z component of r_ij
+    std::vector<unsigned int> type_j; //!< Type index of particle j
+    std::vector<quat<LongReal>> q_j;  //!< Orientation of particle j
+    std::vector<LongReal> charge_j;   //!< Charge of particle j
+    };
+
 /*** Functor that computes pair interactions between particles
 
     PairPotential allows energetic interactions to be included in an HPMC simulation. This
@@ -47,7 +100,7 @@ namespace hpmc
     r_cut values. The cached values ensure that we can use non-virtual inlined calls in the
     inner loops where the total r_cut values are checked.
 */
-class PairPotential
+class PYBIND11_EXPORT PairPotential
     {
     public:
     PairPotential(std::shared_ptr<SystemDefinition> sysdef)
@@ -125,6 +178,44 @@ class PairPotential
         return 0;
         }
 
+    /*** Evaluate the total energy of particle i interacting with a batch of j particles
+
+        Unlike energy, energyBatch performs the r_cut check itself: only the entries with
+        r_squared < getRCutSquaredTotal(type_i, type_j) contribute. The base implementation calls
+        energy for each pair within the cutoff. Subclasses override energyBatch with loops that
+        avoid the per-pair virtual call and hoist the mode selection out of the loop.
+
+        @param type_i Integer type index of particle i.
+        @param q_i Orientation quaternion of particle i.
+        @param charge_i Charge of particle i.
+        @param batch The j particles.
+        @returns Sum of the pair energies.
+    */
+    virtual LongReal energyBatch(const unsigned int type_i,
+                                 const quat<LongReal>& q_i,
+                                 const LongReal charge_i,
+                                 const PairEnergyBatch& batch) const
+        {
+        LongReal energy = 0;
+        const size_t n = batch.size();
+        for (size_t k = 0; k < n; k++)
+            {
+            if (batch.r_squared[k] < getRCutSquaredTotal(type_i, batch.type_j[k]))
+                {
+                energy += this->energy(batch.r_squared[k],
+                                       vec3<LongReal>(batch.r_x[k], batch.r_y[k], batch.r_z[k]),
+                                       type_i,
+                                       q_i,
+                                       charge_i,
+                                       batch.type_j[k],
+                                       batch.q_j[k],
+                                       batch.charge_j[k]);
+                }
+            }
+
+        return energy;
+        }
+
     /// Compute the non-additive cuttoff radius
     virtual LongReal computeRCutNonAdditive(unsigned int type_i, unsigned int type_j) const
         {
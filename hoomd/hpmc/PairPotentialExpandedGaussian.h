@@ -14,7 +14,7 @@ namespace hpmc
 
 For use with HPMC simulations.
 */
-class PairPotentialExpandedGaussian : public hpmc::PairPotential
+class PYBIND11_EXPORT PairPotentialExpandedGaussian : public hpmc::PairPotential
     {
     public:
     PairPotentialExpandedGaussian(std::shared_ptr<SystemDefinition> sysdef);
@@ -29,6 +29,11 @@ class PairPotentialExpandedGaussian : public hpmc::PairPotential
                             const quat<LongReal>& q_j,
                             const LongReal charge_j) const;
 
+    virtual LongReal energyBatch(const unsigned int type_i,
+                                 const quat<LongReal>& q_i,
+                                 const LongReal charge_i,
+                                 const PairEnergyBatch& batch) const;
+
     /// Compute the non-additive cuttoff radius
     virtual LongReal computeRCutNonAdditive(unsigned int type_i, unsigned int type_j) const
         {
@@ -97,6 +102,7 @@ class PairPotentialExpandedGaussian : public hpmc::PairPotential
             delta = 0;
             r_cut_squared = 0;
             r_on_squared = 0;
+            energy_r_cut = 0;
             }
 
         ParamType(pybind11::dict v)
@@ -110,6 +116,11 @@ class PairPotentialExpandedGaussian : public hpmc::PairPotential
             delta = v["delta"].cast<LongReal>();
             r_cut_squared = r_cut * r_cut;
             r_on_squared = r_on * r_on;
+
+            LongReal rcutmd_2 = (r_cut - delta) * (r_cut - delta);
+            LongReal rcutmd_over_sigma_2 = rcutmd_2 / sigma_2;
+            energy_r_cut
+                = epsilon * fast::exp(-LongReal(1.0) / LongReal(2.0) * rcutmd_over_sigma_2);
             }
 
         pybind11::dict asDict()
@@ -130,11 +141,48 @@ class PairPotentialExpandedGaussian : public hpmc::PairPotential
         LongReal delta;
         LongReal r_cut_squared;
         LongReal r_on_squared;
+
+        /// Unshifted energy at r_cut.
+        LongReal energy_r_cut;
         };
 
     std::vector<ParamType> m_params;
 
     EnergyShiftMode m_mode = no_shift;
+
+    /// Evaluate the energy of one pair with a compile time shift mode.
+    template<EnergyShiftMode mode>
+    static inline LongReal evaluate(const LongReal r_squared, const ParamType& param)
+        {
+        LongReal r = fast::sqrt(r_squared);
+        LongReal rmd_2 = (r - param.delta) * (r - param.delta);
+        LongReal rmd_over_sigma_2 = rmd_2 / param.sigma_2;
+        LongReal exp_val = fast::exp(-LongReal(1.0) / LongReal(2.0) * rmd_over_sigma_2);
+        LongReal energy = param.epsilon * exp_val;
+
+        if (mode == shift || (mode == xplor && param.r_on_squared >= param.r_cut_squared))
+            {
+            energy -= param.energy_r_cut;
+            }
+
+        if constexpr (mode == xplor)
+            {
+            LongReal a = param.r_cut_squared - param.r_on_squared;
+            LongReal denominator = a * a * a;
+
+            LongReal b = param.r_cut_squared - r_squared;
+            LongReal numerator = b * b
+                                 * (param.r_cut_squared + LongReal(2.0) * r_squared
+                                    - LongReal(3.0) * param.r_on_squared);
+            energy = r_squared > param.r_on_squared ? energy * numerator / denominator : energy;
+            }
+
+        return energy;
+        }
+
+    /// Sum the energies of a batch with a compile time shift mode.
+    template<EnergyShiftMode mode>
+    LongReal energyBatchMode(const unsigned int type_i, const PairEnergyBatch& batch) const;
     };
 
     } // end namespace hpmc
@@ -22,44 +22,62 @@ LongReal PairPotentialLJGauss::energy(const LongReal r_squared,
                                       const quat<LongReal>& q_j,
                                       const LongReal charge_j) const
     {
-    unsigned int param_index = m_type_param_index(type_i, type_j);
-    const auto& param = m_params[param_index];
-
-    LongReal r = fast::sqrt(r_squared);
-    LongReal rdiff = r - param.r0;
-    LongReal rdiff_sigma_2 = rdiff / param.sigma_2;
-    LongReal exp_val = fast::exp(-LongReal(0.5) * rdiff_sigma_2 * rdiff);
-    LongReal r2_inverse = LongReal(1.0) / r_squared;
-    LongReal r6_inverse = r2_inverse * r2_inverse * r2_inverse;
-
-    LongReal energy = r6_inverse * (r6_inverse - LongReal(2.0)) - exp_val * param.epsilon;
+    const auto& param = m_params[m_type_param_index(type_i, type_j)];
 
-    if (m_mode == shift || (m_mode == xplor && param.r_on_squared >= param.r_cut_squared))
+    if (m_mode == shift)
         {
-        LongReal r_cut_2_inverse = LongReal(1.0) / param.r_cut_squared;
-        LongReal r_cut_6_inverse = r_cut_2_inverse * r_cut_2_inverse * r_cut_2_inverse;
-        LongReal r_cut_minus_r0 = fast::sqrt(param.r_cut_squared) - param.r0;
-
-        energy -= r_cut_6_inverse * (r_cut_6_inverse - LongReal(2.0))
-                  - (param.epsilon
-                     * fast::exp(-LongReal(0.5) * r_cut_minus_r0 * r_cut_minus_r0 / param.sigma_2));
+        return evaluate<shift>(r_squared, param);
         }
-
-    if (m_mode == xplor && r_squared > param.r_on_squared)
+    else if (m_mode == xplor)
         {
-        LongReal a = param.r_cut_squared - param.r_on_squared;
-        LongReal denominator = a * a * a;
+        return evaluate<xplor>(r_squared, param);
+        }
+    else
+        {
+        return evaluate<no_shift>(r_squared, param);
+        }
+    }
+
+template<PairPotentialLJGauss::EnergyShiftMode mode>
+LongReal PairPotentialLJGauss::energyBatchMode(const unsigned int type_i,
+                                               const PairEnergyBatch& batch) const
+    {
+    const size_t n = batch.size();
+    const LongReal* r_squared = batch.r_squared.data();
+    const unsigned int* type_j = batch.type_j.data();
 
-        LongReal b = param.r_cut_squared - r_squared;
-        LongReal numerator = b * b
-                             * (param.r_cut_squared + LongReal(2.0) * r_squared
-                                - LongReal(3.0) * param.r_on_squared);
-        energy *= numerator / denominator;
+    // Evaluate every pair and discard those beyond r_cut without branching so that the loop
+    // can be vectorized.
+    LongReal energy = 0;
+    for (size_t k = 0; k < n; k++)
+        {
+        const unsigned int param_index = m_type_param_index(type_i, type_j[k]);
+        const LongReal energy_k = evaluate<mode>(r_squared[k], m_params[param_index]);
+        energy += r_squared[k] < getRCutSquaredTotal(type_i, type_j[k]) ? energy_k : LongReal(0);
         }
 
     return energy;
     }
 
+LongReal PairPotentialLJGauss::energyBatch(const unsigned int type_i,
+                                           const quat<LongReal>& q_i,
+                                           const LongReal charge_i,
+                                           const PairEnergyBatch& batch) const
+    {
+    if (m_mode == shift)
+        {
+        return energyBatchMode<shift>(type_i, batch);
+        }
+    else if (m_mode == xplor)
+        {
+        return energyBatchMode<xplor>(type_i, batch);
+        }
+    else
+        {
+        return energyBatchMode<no_shift>(type_i, batch);
+        }
+    }
+
 void PairPotentialLJGauss::setParamsPython(pybind11::tuple typ, pybind11::dict params)
     {
     auto pdata = m_sysdef->getParticleData();
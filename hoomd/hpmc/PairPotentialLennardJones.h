@@ -14,7 +14,7 @@ namespace hpmc
 
 For use with HPMC simulations.
 */
-class PairPotentialLennardJones : public hpmc::PairPotential
+class PYBIND11_EXPORT PairPotentialLennardJones : public hpmc::PairPotential
     {
     public:
     PairPotentialLennardJones(std::shared_ptr<SystemDefinition> sysdef);
@@ -29,6 +29,11 @@ class PairPotentialLennardJones : public hpmc::PairPotential
                             const quat<LongReal>& q_j,
                             const LongReal charge_j) const;
 
+    virtual LongReal energyBatch(const unsigned int type_i,
+                                 const quat<LongReal>& q_i,
+                                 const LongReal charge_i,
+                                 const PairEnergyBatch& batch) const;
+
     /// Compute the non-additive cuttoff radius
     virtual LongReal computeRCutNonAdditive(unsigned int type_i, unsigned int type_j) const
         {
@@ -96,6 +101,7 @@ class PairPotentialLennardJones : public hpmc::PairPotential
             epsilon_x_4 = 0;
             r_cut_squared = 0;
             r_on_squared = 0;
+            energy_r_cut = 0;
             }
 
         ParamType(pybind11::dict v)
@@ -109,6 +115,12 @@ class PairPotentialLennardJones : public hpmc::PairPotential
             epsilon_x_4 = LongReal(4.0) * epsilon;
             r_cut_squared = r_cut * r_cut;
             r_on_squared = r_on * r_on;
+
+            LongReal lj2 = epsilon_x_4 * sigma_6;
+            LongReal lj1 = lj2 * sigma_6;
+            LongReal r_cut_2_inverse = LongReal(1.0) / r_cut_squared;
+            LongReal r_cut_6_inverse = r_cut_2_inverse * r_cut_2_inverse * r_cut_2_inverse;
+            energy_r_cut = r_cut_6_inverse * (lj1 * r_cut_6_inverse - lj2);
             }
 
         pybind11::dict asDict()
@@ -127,11 +139,50 @@ class PairPotentialLennardJones : public hpmc::PairPotential
         LongReal epsilon_x_4;
         LongReal r_cut_squared;
         LongReal r_on_squared;
+
+        /// Unshifted energy at r_cut.
+        LongReal energy_r_cut;
         };
 
     std::vector<ParamType> m_params;
 
     EnergyShiftMode m_mode = no_shift;
+
+    /// Evaluate the energy of one pair with a compile time shift mode.
+    template<EnergyShiftMode mode>
+    static inline LongReal evaluate(const LongReal r_squared, const ParamType& param)
+        {
+        LongReal lj2 = param.epsilon_x_4 * param.sigma_6;
+        LongReal lj1 = lj2 * param.sigma_6;
+
+        LongReal r_2_inverse = LongReal(1.0) / r_squared;
+        LongReal r_6_inverse = r_2_inverse * r_2_inverse * r_2_inverse;
+
+        LongReal energy = r_6_inverse * (lj1 * r_6_inverse - lj2);
+
+        if (mode == shift || (mode == xplor && param.r_on_squared >= param.r_cut_squared))
+            {
+            energy -= param.energy_r_cut;
+            }
+
+        if constexpr (mode == xplor)
+            {
+            LongReal a = param.r_cut_squared - param.r_on_squared;
+            LongReal denominator = a * a * a;
+
+            LongReal b = param.r_cut_squared - r_squared;
+            LongReal numerator = b * b
+                                 * (param.r_cut_squared + LongReal(2.0) * r_squared
+                                    - LongReal(3.0) * param.r_on_squared);
+            energy = r_squared > param.r_on_squared ? energy * numerator / denominator : energy;
+            }
+
+        return energy;
+        }
+
+    /// Sum the energies of a batch with a compile time shift mode.
+    template<EnergyShiftMode mode>
+    LongReal energyBatchMode(const unsigned int type_i, const PairEnergyBatch& batch) const;
     };
 
     } // end namespace hpmc
@@ -22,43 +22,62 @@ LongReal PairPotentialOPP::energy(const LongReal r_squared,
                                   const quat<LongReal>& q_j,
                                   const LongReal charge_j) const
     {
-    unsigned int param_index = m_type_param_index(type_i, type_j);
-    const auto& param = m_params[param_index];
-
-    // Get quantities need for both energy calculation
-    LongReal r = fast::sqrt(r_squared);
-    LongReal eval_cos = fast::cos(param.k * r - param.phi);
-
-    // Compute energy
-    LongReal r_eta1_arg = param.C1 * fast::pow(r, -param.eta1);
-    LongReal r_to_eta2 = fast::pow(r, -param.eta2);
-    LongReal r_eta2_arg = param.C2 * r_to_eta2 * eval_cos;
-    LongReal energy = r_eta1_arg + r_eta2_arg;
+    const auto& param = m_params[m_type_param_index(type_i, type_j)];
 
-    if (m_mode == shift || (m_mode == xplor && param.r_on_squared >= param.r_cut_squared))
+    if (m_mode == shift)
         {
-        LongReal r_cut = fast::sqrt(param.r_cut_squared);
-        LongReal r_cut_eta1_arg = param.C1 * fast::pow(r_cut, -param.eta1);
-        LongReal r_cut_eta2_arg
-            = param.C2 * fast::pow(r_cut, -param.eta2) * fast::cos(param.k * r_cut - param.phi);
-        energy -= r_cut_eta1_arg + r_cut_eta2_arg;
+        return evaluate<shift>(r_squared, param);
         }
-
-    if (m_mode == xplor && r_squared > param.r_on_squared)
+    else if (m_mode == xplor)
+        {
+        return evaluate<xplor>(r_squared, param);
+        }
+    else
         {
-        LongReal a = param.r_cut_squared - param.r_on_squared;
-        LongReal denominator = a * a * a;
+        return evaluate<no_shift>(r_squared, param);
+        }
+    }
+
+template<PairPotentialOPP::EnergyShiftMode mode>
+LongReal PairPotentialOPP::energyBatchMode(const unsigned int type_i,
+                                           const PairEnergyBatch& batch) const
+    {
+    const size_t n = batch.size();
+    const LongReal* r_squared = batch.r_squared.data();
+    const unsigned int* type_j = batch.type_j.data();
 
-        LongReal b = param.r_cut_squared - r_squared;
-        LongReal numerator = b * b
-                             * (param.r_cut_squared + LongReal(2.0) * r_squared
-                                - LongReal(3.0) * param.r_on_squared);
-        energy *= numerator / denominator;
+    // Evaluate every pair and discard those beyond r_cut without branching so that the loop
+    // can be vectorized.
+    LongReal energy = 0;
+    for (size_t k = 0; k < n; k++)
+        {
+        const unsigned int param_index = m_type_param_index(type_i, type_j[k]);
+        const LongReal energy_k = evaluate<mode>(r_squared[k], m_params[param_index]);
+        energy += r_squared[k] < getRCutSquaredTotal(type_i, type_j[k]) ? energy_k : LongReal(0);
         }
 
     return energy;
     }
 
+LongReal PairPotentialOPP::energyBatch(const unsigned int type_i,
+                                       const quat<LongReal>& q_i,
+                                       const LongReal charge_i,
+                                       const PairEnergyBatch& batch) const
+    {
+    if (m_mode == shift)
+        {
+        return energyBatchMode<shift>(type_i, batch);
+        }
+    else if (m_mode == xplor)
+        {
+        return energyBatchMode<xplor>(type_i, batch);
+        }
+    else
+        {
+        return energyBatchMode<no_shift>(type_i, batch);
+        }
+    }
+
 void PairPotentialOPP::setParamsPython(pybind11::tuple typ, pybind11::dict params)
     {
     auto pdata = m_sysdef->getParticleData();
@@ -14,7 +14,7 @@ namespace hpmc
 
 For use with HPMC simulations.
 */
-class PairPotentialOPP : public hpmc::PairPotential
+class PYBIND11_EXPORT PairPotentialOPP : public hpmc::PairPotential
     {
     public:
     PairPotentialOPP(std::shared_ptr<SystemDefinition> sysdef);
@@ -29,6 +29,11 @@ class PairPotentialOPP : public hpmc::PairPotential
                             const quat<LongReal>& q_j,
                             const LongReal charge_j) const;
 
+    virtual LongReal energyBatch(const unsigned int type_i,
+                                 const quat<LongReal>& q_i,
+                                 const LongReal charge_i,
+                                 const PairEnergyBatch& batch) const;
+
     /// Compute the non-additive cuttoff radius
     virtual LongReal computeRCutNonAdditive(unsigned int type_i, unsigned int type_j) const
         {
@@ -98,6 +103,7 @@ class PairPotentialOPP : public hpmc::PairPotential
             eta2 = 0;
             k = 0;
             phi = 0;
+            energy_r_cut = 0;
             }
 
         ParamType(pybind11::dict v)
@@ -113,6 +119,9 @@ class PairPotentialOPP : public hpmc::PairPotential
             phi = v["phi"].cast<LongReal>();
             r_cut_squared = r_cut * r_cut;
             r_on_squared = r_on * r_on;
+
+            energy_r_cut = C1 * fast::pow(r_cut, -eta1)
+                           + C2 * fast::pow(r_cut, -eta2) * fast::cos(k * r_cut - phi);
             }
 
         pybind11::dict asDict()
@@ -139,11 +148,52 @@ class PairPotentialOPP : public hpmc::PairPotential
         LongReal phi;
         LongReal r_cut_squared;
         LongReal r_on_squared;
+
+        /// Unshifted energy at r_cut.
+        LongReal energy_r_cut;
         };
 
     std::vector<ParamType> m_params;
 
     EnergyShiftMode m_mode = no_shift;
+
+    /// Evaluate the energy of one pair with a compile time shift mode.
+    template<EnergyShiftMode mode>
+    static inline LongReal evaluate(const LongReal r_squared, const ParamType& param)
+        {
+        // Get quantities need for both energy calculation
+        LongReal r = fast::sqrt(r_squared);
+        LongReal eval_cos = fast::cos(param.k * r - param.phi);
+
+        // Compute energy
+        LongReal r_eta1_arg = param.C1 * fast::pow(r, -param.eta1);
+        LongReal r_to_eta2 = fast::pow(r, -param.eta2);
+        LongReal r_eta2_arg = param.C2 * r_to_eta2 * eval_cos;
+        LongReal energy = r_eta1_arg + r_eta2_arg;
+
+        if (mode == shift || (mode == xplor && param.r_on_squared >= param.r_cut_squared))
+            {
+            energy -= param.energy_r_cut;
+            }
+
+        if constexpr (mode == xplor)
+            {
+            LongReal a = param.r_cut_squared - param.r_on_squared;
+            LongReal denominator = a * a * a;
+
+            LongReal b = param.r_cut_squared - r_squared;
+            LongReal numerator = b * b
+                                 * (param.r_cut_squared + LongReal(2.0) * r_squared
+                                    - LongReal(3.0) * param.r_on_squared);
+            energy = r_squared > param.r_on_squared ? energy * numerator / denominator : energy;
+            }
+
+        return energy;
+        }
+
+    /// Sum the energies of a batch with a compile time shift mode.
+    template<EnergyShiftMode mode>
+    LongReal energyBatchMode(const unsigned int type_i, const PairEnergyBatch& batch) const;
     };
 
     } // end namespace hpmc
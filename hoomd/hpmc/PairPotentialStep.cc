@@ -36,48 +36,28 @@ LongReal PairPotentialStep::energy(const LongReal r_squared,
                                    const quat<LongReal>& q_j,
                                    const LongReal charge_j) const
     {
-    unsigned int param_index = m_type_param_index(type_i, type_j);
-    const auto& param = m_params[param_index];
-
-    size_t N = param.m_epsilon.size();
-
-    if (N == 0)
-        {
-        return 0;
-        }
-
-    if (r_squared < param.m_r_squared[0])
-        {
-        return param.m_epsilon[0];
-        }
+    return evaluate(r_squared, m_params[m_type_param_index(type_i, type_j)]);
+    }
 
-    // Perform a binary search based on r_squared to find the relevant potential value.
-    ssize_t L = 0;
-    ssize_t R = N;
+LongReal PairPotentialStep::energyBatch(const unsigned int type_i,
+                                        const quat<LongReal>& q_i,
+                                        const LongReal charge_i,
+                                        const PairEnergyBatch& batch) const
+    {
+    const size_t n = batch.size();
+    const LongReal* r_squared = batch.r_squared.data();
+    const unsigned int* type_j = batch.type_j.data();
 
-    while (L < R)
+    LongReal energy = 0;
+    for (size_t k = 0; k < n; k++)
         {
-        size_t m = (L + R) / 2;
-        LongReal r_squared_m = param.m_r_squared[m];
-
-        if (r_squared_m <= r_squared)
+        if (r_squared[k] < getRCutSquaredTotal(type_i, type_j[k]))
             {
-            L = m + 1;
-            }
-        else
-            {
-            R = m;
+            energy += evaluate(r_squared[k], m_params[m_type_param_index(type_i, type_j[k])]);
             }
         }
 
-    if (size_t(L) < N)
-        {
-        return param.m_epsilon[L];
-        }
-    else
-        {
-        return 0;
-        }
+    return energy;
     }
 
 void PairPotentialStep::setParamsPython(pybind11::tuple typ, pybind11::object params)
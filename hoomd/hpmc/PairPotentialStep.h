@@ -14,7 +14,7 @@ namespace hpmc
 
 For use with HPMC simulations.
 */
-class PairPotentialStep : public hpmc::PairPotential
+class PYBIND11_EXPORT PairPotentialStep : public hpmc::PairPotential
     {
     public:
     PairPotentialStep(std::shared_ptr<SystemDefinition> sysdef);
@@ -29,6 +29,11 @@ class PairPotentialStep : public hpmc::PairPotential
                             const quat<LongReal>& q_j,
                             const LongReal charge_j) const;
 
+    virtual LongReal energyBatch(const unsigned int type_i,
+                                 const quat<LongReal>& q_i,
+                                 const LongReal charge_i,
+                                 const PairEnergyBatch& batch) const;
+
     /// Compute the non-additive cuttoff radius
     virtual LongReal computeRCutNonAdditive(unsigned int type_i, unsigned int type_j) const;
 
@@ -56,6 +61,50 @@ class PairPotentialStep : public hpmc::PairPotential
 
     /// Parameters per type pair.
     std::vector<ParamType> m_params;
+
+    /// Evaluate the energy of one pair.
+    static inline LongReal evaluate(const LongReal r_squared, const ParamType& param)
+        {
+        size_t N = param.m_epsilon.size();
+
+        if (N == 0)
+            {
+            return 0;
+            }
+
+        if (r_squared < param.m_r_squared[0])
+            {
+            return param.m_epsilon[0];
+            }
+
+        // Perform a binary search based on r_squared to find the relevant potential value.
+        ssize_t L = 0;
+        ssize_t R = N;
+
+        while (L < R)
+            {
+            size_t m = (L + R) / 2;
+            LongReal r_squared_m = param.m_r_squared[m];
+
+            if (r_squared_m <= r_squared)
+                {
+                L = m + 1;
+                }
+            else
+                {
+                R = m;
+                }
+            }
+
+        if (size_t(L) < N)
+            {
+            return param.m_epsilon[L];
+            }
+        else
+            {
+            return 0;
+            }
+        }
     };
 
     } // end namespace hpmc
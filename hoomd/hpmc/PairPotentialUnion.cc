@@ -230,6 +230,24 @@ void PairPotentialUnion::buildOBBTree(unsigned int type_id)
         }
     }
 
+/// Per-thread storage reused by the constituent batches.
+static thread_local PairEnergyBatch constituent_batch_storage;
+
+/*! The batch takes over the storage instead of referencing it so that a constituent potential
+    that is itself a union gets its own (empty) batch.
+*/
+PairEnergyBatch PairPotentialUnion::acquireBatch()
+    {
+    PairEnergyBatch batch;
+    std::swap(batch, constituent_batch_storage);
+    return batch;
+    }
+
+void PairPotentialUnion::releaseBatch(PairEnergyBatch& batch)
+    {
+    std::swap(batch, constituent_batch_storage);
+    }
+
 LongReal PairPotentialUnion::compute_leaf_leaf_energy(vec3<LongReal> dr,
                                                       unsigned int type_a,
                                                       unsigned int type_b,
@@ -245,6 +263,8 @@ LongReal PairPotentialUnion::compute_leaf_leaf_energy(vec3<LongReal> dr,
     unsigned int na = m_tree[type_a].getNumParticles(cur_node_a);
     unsigned int nb = m_tree[type_b].getNumParticles(cur_node_b);
 
+    PairEnergyBatch batch = acquireBatch();
+
     for (unsigned int i = 0; i < na; i++)
         {
         unsigned int ileaf = m_tree[type_a].getParticleByNode(cur_node_a, i);
@@ -255,29 +275,26 @@ LongReal PairPotentialUnion::compute_leaf_leaf_energy(vec3<LongReal> dr,
         vec3<LongReal> pos_i(rotate(conj(orientation_b) * orientation_a, m_position[type_a][ileaf])
                              - r_ab);
 
-        // loop through leaf particles of cur_node_b
+        // collect the leaf particles of cur_node_b and evaluate them in one batch
+        batch.clear();
         for (unsigned int j = 0; j < nb; j++)
             {
             unsigned int jleaf = m_tree[type_b].getParticleByNode(cur_node_b, j);
-
-            unsigned int type_j = m_type[type_b][jleaf];
-            quat<LongReal> orientation_j = m_orientation[type_b][jleaf];
             vec3<LongReal> r_ij = m_position[type_b][jleaf] - pos_i;
-
-            LongReal rsq = dot(r_ij, r_ij);
-            if (rsq < m_constituent_potential->getRCutSquaredTotal(type_i, type_j))
-                {
-                energy += m_constituent_potential->energy(rsq,
-                                                          r_ij,
-                                                          type_i,
-                                                          orientation_i,
-                                                          m_charge[type_a][ileaf],
-                                                          type_j,
-                                                          orientation_j,
-                                                          m_charge[type_b][jleaf]);
-                }
+            batch.push_back(dot(r_ij, r_ij),
+                            r_ij,
+                            m_type[type_b][jleaf],
+                            m_orientation[type_b][jleaf],
+                            m_charge[type_b][jleaf]);
             }
+
+        energy += m_constituent_potential->energyBatch(type_i,
+                                                       orientation_i,
+                                                       m_charge[type_a][ileaf],
+                                                       batch);
         }
+
+    releaseBatch(batch);
     return energy;
     }
 
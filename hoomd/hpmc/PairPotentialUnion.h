@@ -16,7 +16,7 @@ namespace hpmc
     The extended sites act as a union of particles. The constituent potential is applied between
     all pairs of sites between two particles.
 */
-class PairPotentialUnion : public hpmc::PairPotential
+class PYBIND11_EXPORT PairPotentialUnion : public hpmc::PairPotential
     {
     public:
     PairPotentialUnion(std::shared_ptr<SystemDefinition> sysdef,
@@ -103,6 +103,12 @@ class PairPotentialUnion : public hpmc::PairPotential
     /// Builds OBB tree based on geometric properties of the constituent particles.
     void buildOBBTree(unsigned int type_id);
 
+    /// Take the per-thread constituent batch storage.
+    static PairEnergyBatch acquireBatch();
+
+    /// Return the constituent batch storage taken by acquireBatch.
+    static void releaseBatch(PairEnergyBatch& batch);
+
     /// Compute the energy of two overlapping leaf nodes.
     LongReal compute_leaf_leaf_energy(vec3<LongReal> dr,
                                       unsigned int type_a,
@@ -133,6 +139,8 @@ class PairPotentialUnion : public hpmc::PairPotential
 
         vec3<LongReal> r_ij_rotated = rotate(conj_q_j, r_ij);
 
+        PairEnergyBatch batch = acquireBatch();
+
         for (unsigned int i = 0; i < N_i; i++)
             {
             // Rotate and translate the constituents of i to j's body frame.
@@ -141,28 +149,25 @@ class PairPotentialUnion : public hpmc::PairPotential
             vec3<LongReal> constituent_position_i(rotate_i_to_j * m_position[type_i][i]
                                                   - r_ij_rotated);
 
-            // loop through leaf particles of cur_node_b
+            // collect all constituents of j and evaluate them in one batch
+            batch.clear();
             for (unsigned int j = 0; j < N_j; j++)
                 {
-                unsigned int constituent_type_j = m_type[type_j][j];
-                quat<LongReal> constituent_orientation_j = m_orientation[type_j][j];
                 vec3<LongReal> constituent_r_ij = m_position[type_j][j] - constituent_position_i;
-
-                LongReal rsq = dot(constituent_r_ij, constituent_r_ij);
-                if (rsq < m_constituent_potential->getRCutSquaredTotal(constituent_type_i,
-                                                                       constituent_type_j))
-                    {
-                    energy += m_constituent_potential->energy(rsq,
-                                                              constituent_r_ij,
-                                                              constituent_type_i,
-                                                              constituent_orientation_i,
-                                                              m_charge[type_i][i],
-                                                              constituent_type_j,
-                                                              constituent_orientation_j,
-                                                              m_charge[type_j][j]);
-                    }
+                batch.push_back(dot(constituent_r_ij, constituent_r_ij),
+                                constituent_r_ij,
+                                m_type[type_j][j],
+                                m_orientation[type_j][j],
+                                m_charge[type_j][j]);
                 }
+
+            energy += m_constituent_potential->energyBatch(constituent_type_i,
+                                                           constituent_orientation_i,
+                                                           m_charge[type_i][i],
+                                                           batch);
             }
+
+        releaseBatch(batch);
         return energy;
         }
 
@@ -12,25 +12,19 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
-#include <set>
 #include <list>
 
 #include "Moves.h"
 #include "HPMCCounters.h"
 #include "IntegratorHPMCMono.h"
 
-#ifdef ENABLE_TBB
-#include <tbb/concurrent_unordered_map.h>
-#include <tbb/concurrent_unordered_set.h>
-#include <tbb/concurrent_vector.h>
-#include <tbb/parallel_for.h>
-#include <tbb/task.h>
+#include <algorithm>
 #include <atomic>
+#include <memory>
 
-#if TBB_VERSION_MAJOR < 2021
-#define ENABLE_TBB_TASK
-#endif
-
+#ifdef ENABLE_TBB
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
 #endif
 
 namespace hoomd {
@@ -41,232 +35,78 @@ namespace hpmc
 namespace detail
 {
 
-#ifdef ENABLE_TBB_TASK
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
+//! Disjoint set forest over particle indices
+/*! unite() merges the sets of two particles and find() returns the root of the set of a particle.
+    Both are lock free and may be called concurrently by many threads. A root is always linked
+    below the smaller of the two roots, so the root of every set is its smallest particle index
+    independent of the order in which the edges are added. find() shortens the paths it walks by
+    path halving.
+
+    Every parent index is smaller than or equal to its child index, so the parent of any node only
+    ever decreases and find() terminates even while other threads modify the forest. Only the
+    parent indices are shared between threads, so relaxed memory ordering suffices. The parallel
+    loops that call unite() synchronize before the labels are read.
+*/
+class UnionFind
     {
     public:
-        //! Default constructor
-        my_atomic_flag()
-            {
-            f.clear();
-            }
-
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
+        //! Reset to n single particle sets
+        void reset(unsigned int n)
             {
-            f.clear();
-            }
+            if (n > m_capacity)
+                {
+                m_parent.reset(new std::atomic<unsigned int>[n]);
+                m_capacity = n;
+                }
 
-        //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
-            {
-            f.clear();
-            return *this;
+            for (unsigned int v = 0; v < n; ++v)
+                m_parent[v].store(v, std::memory_order_relaxed);
             }
 
-        //! Sets flag and returns old value
-        bool test_and_set()
+        //! Find the root of the set containing v
+        unsigned int find(unsigned int v)
             {
-            return f.test_and_set();
-            }
+            while (true)
+                {
+                unsigned int parent = m_parent[v].load(std::memory_order_relaxed);
+                unsigned int grandparent = m_parent[parent].load(std::memory_order_relaxed);
 
-    private:
-        std::atomic_flag f;
-    };
-#endif
+                if (parent == grandparent)
+                    return parent;
 
-// Graph class represents a undirected graph
-// using adjacency list representation
-class Graph
-    {
-    public:
-        Graph()
-            {
+                // path halving, fails harmlessly when another thread already shortened the path
+                m_parent[v].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+                v = grandparent;
+                }
             }
 
-        inline Graph(unsigned int V);   // Constructor
-
-        inline void resize(unsigned int V);
+        //! Merge the sets containing v and w
+        void unite(unsigned int v, unsigned int w)
+            {
+            while (true)
+                {
+                v = find(v);
+                w = find(w);
 
-        inline void addEdge(unsigned int v, unsigned int w);
+                if (v == w)
+                    return;
 
-        #ifdef ENABLE_TBB_TASK
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
-        inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
+                // link the larger root below the smaller one
+                if (v < w)
+                    std::swap(v, w);
 
-        #ifdef ENABLE_TBB_TASK
-        void setTaskArena(std::shared_ptr<tbb::task_arena> task_arena)
-            {
-            m_task_arena = task_arena;
+                // retry when another thread linked v in the meantime
+                unsigned int expected = v;
+                if (m_parent[v].compare_exchange_strong(expected, w, std::memory_order_relaxed))
+                    return;
+                }
             }
-        #endif
 
     private:
-        #ifndef ENABLE_TBB_TASK
-        std::multimap<unsigned int,unsigned int> adj;
-        #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
-        #endif
-
-        #ifndef ENABLE_TBB_TASK
-        std::vector<unsigned int> visited;
-        #else
-        std::vector<my_atomic_flag> visited;
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        /// The TBB task arena
-        std::shared_ptr<tbb::task_arena> m_task_arena;
-        #endif
-
-        #ifndef ENABLE_TBB_TASK
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
-
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
-
-                        recycle_as_safe_continuation();
-                        }
-
-                    return NULL;
-                    }
-
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB_TASK
-
+        std::unique_ptr<std::atomic<unsigned int>[]> m_parent; //!< Parent of each particle
+        unsigned int m_capacity = 0;                            //!< Allocated number of particles
     };
 
-// Gather connected components in an undirected graph
-#ifdef ENABLE_TBB_TASK
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
-void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
-    {
-    #ifdef ENABLE_TBB_TASK
-    this->m_task_arena->execute([&]{
-    for (unsigned int v = 0; v < visited.size(); ++v)
-        {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
-        }
-    }); // end task arena execute()
-    #else
-    std::fill(visited.begin(), visited.end(), 0);
-
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
-        {
-        if (visited[v] == false)
-            {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
-            }
-        }
-    #endif
-    }
-
-#ifndef ENABLE_TBB_TASK
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
-    {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
-        {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
-        }
-    }
-#endif
-Graph::Graph(unsigned int V)
-    {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
-    }
-
-void Graph::resize(unsigned int V)
-    {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.clear();
-    visited.resize(V);
-    #endif
-
-    adj.clear();
-    }
-
-// method to add a directed edge
-void Graph::addEdge(unsigned int v, unsigned int w)
-    {
-    adj.insert(std::make_pair(v,w));
-    }
 } // end namespace detail
 
 /*! A generic cluster move for attractive interactions.
@@ -359,19 +199,29 @@ class UpdaterClusters : public Updater
             }
 
     protected:
+        //! Pair interaction energy of a particle with one partner in one image
+        struct PairEnergyDelta
+            {
+            unsigned int j;       //!< Index of the partner particle
+            LongReal energy_old;  //!< Energy in the old configuration
+            LongReal energy_new;  //!< Energy of the transformed particle with the old configuration
+            };
+
         std::shared_ptr< IntegratorHPMCMono<Shape> > m_mc; //!< HPMC integrator
         Scalar m_move_ratio;                        //!< Pivot/Reflection move ratio
         Scalar m_flip_probability;                  //!< Cluster flip probability
 
         unsigned int m_instance=0;                  //!< Unique ID for RNG seeding
 
-        #ifdef ENABLE_TBB_TASK
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
-        std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
+        detail::UnionFind m_union_find;             //!< Clusters of interacting particles
+        std::vector<unsigned int> m_cluster_label;  //!< Cluster of each particle (smallest index in it)
+        std::vector<unsigned int> m_cluster_flip;   //!< Flip decision of each cluster, stored at its label
 
-        detail::Graph m_G; //!< The graph
+        std::vector<PairEnergyDelta> m_pair_energy;   //!< Pair energies of one particle (serial)
+        #ifdef ENABLE_TBB
+        //! Pair energies of one particle (per thread)
+        tbb::enumerable_thread_specific<std::vector<PairEnergyDelta> > m_pair_energy_tls;
+        #endif
 
         hoomd::detail::AABBTree m_aabb_tree_old;              //!< Locality lookup for old configuration
 
@@ -379,16 +229,6 @@ class UpdaterClusters : public Updater
         GlobalVector<Scalar4> m_orientation_backup;    //!< Old local orientations
         GlobalVector<int3> m_image_backup;             //!< Old local images
 
-        #ifndef ENABLE_TBB_TASK
-        std::set<std::pair<unsigned int, unsigned int> > m_overlap;   //!< A local vector of particle pairs due to overlap
-        std::map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_old_old;    //!< Energy of interaction old-old
-        std::map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_new_old;    //!< Energy of interaction old-old
-        #else
-        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > m_overlap;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_old_old;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_new_old;
-        #endif
-
         hpmc_clusters_counters_t m_count_total;                 //!< Total count since initialization
         hpmc_clusters_counters_t m_count_run_start;             //!< Count saved at run() start
         hpmc_clusters_counters_t m_count_step_start;            //!< Count saved at the start of the last step
@@ -407,7 +247,7 @@ class UpdaterClusters : public Updater
         */
         virtual void findInteractions(uint64_t timestep, const quat<Scalar> q, const vec3<Scalar> pivot, bool line);
 
-        //! Determine connected components of the interaction graph
+        //! Label each particle with its cluster
         virtual void connectedComponents();
 
         // Transform particles using an self-inverse, isometric operation
@@ -426,10 +266,6 @@ UpdaterClusters<Shape>::UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef
     {
     m_exec_conf->msg->notice(5) << "Constructing UpdaterClusters" << std::endl;
 
-    #ifdef ENABLE_TBB_TASK
-    m_G.setTaskArena(sysdef->getParticleData()->getExecConf()->getTaskArena());
-    #endif
-
     // initialize stats
     resetStats();
 
@@ -494,7 +330,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
         }
     img_i = box.getImage(pos_i_transf);
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for(tbb::blocked_range<unsigned int>(0, this->m_pdata->getNTypes()),
         [=, &shape_i](const tbb::blocked_range<unsigned int>& x) {
@@ -507,7 +343,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
             {
             continue;
             }
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         tbb::parallel_for(tbb::blocked_range<unsigned int>(type_a, this->m_pdata->getNTypes()),
             [=, &shape_i](const tbb::blocked_range<unsigned int>& w) {
         for (unsigned int type_b = w.begin(); type_b != w.end(); ++type_b)
@@ -655,7 +491,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                 }
 
             // for every depletant
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
             tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
                 [=, &shape_i,
                     &pos_j, &orientation_j, &type_j, &V_all,
@@ -1043,23 +879,20 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                         if ((overlap_i_a && !overlap_transf_a && overlap_j_b) || (overlap_i_b && !overlap_transf_b & overlap_j_a))
                             {
                             // add bond
-                            this->m_overlap.insert(std::make_pair(i,idx_j[m]));
-
-                            // since i<=j by construction, make matrix symmetric explicitly
-                            this->m_overlap.insert(std::make_pair(idx_j[m],i));
+                            this->m_union_find.unite(i, idx_j[m]);
                             }
                         }
                     } // end loop over intersections
                 } // end loop over depletants
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
                 });
             #endif
             } // end loop over type_b
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             });
         #endif
         } // end loop over type_a
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1109,8 +942,27 @@ void UpdaterClusters<Shape>::transform(const quat<Scalar>& q, const vec3<Scalar>
 template< class Shape >
 void UpdaterClusters<Shape>::flip(uint64_t timestep)
     {
-    // move every cluster independently
-    m_count_total.n_clusters += m_clusters.size();
+    unsigned int nptl = this->m_pdata->getN();
+    uint16_t seed = this->m_sysdef->getSeed();
+
+    // decide the fate of every cluster at its label
+    m_cluster_flip.resize(nptl);
+    for (unsigned int i = 0; i < nptl; ++i)
+        {
+        if (m_cluster_label[i] != i)
+            continue;
+
+        m_count_total.n_clusters++;
+
+        // seed by id of first particle in cluster to make independent of cluster labeling
+        hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::UpdaterClusters2, timestep, seed),
+                                     hoomd::Counter(i));
+
+        m_cluster_flip[i] = hoomd::detail::generate_canonical<LongReal>(rng_i) <= m_flip_probability;
+        }
+
+    // every particle belongs to exactly one cluster
+    m_count_total.n_particles_in_clusters += nptl;
 
         {
         ArrayHandle<Scalar4> h_pos(this->m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -1121,32 +973,16 @@ void UpdaterClusters<Shape>::flip(uint64_t timestep)
         ArrayHandle<Scalar4> h_orientation_backup(m_orientation_backup, access_location::host, access_mode::read);
         ArrayHandle<int3> h_image_backup(m_image_backup, access_location::host, access_mode::read);
 
-        uint16_t seed = this->m_sysdef->getSeed();
-
-        for (unsigned int icluster = 0; icluster < m_clusters.size(); icluster++)
+        for (unsigned int i = 0; i < nptl; ++i)
             {
-            m_count_total.n_particles_in_clusters += m_clusters[icluster].size();
-
-            // seed by id of first particle in cluster to make independent of cluster labeling
-            hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::UpdaterClusters2, timestep, seed),
-                                         hoomd::Counter(m_clusters[icluster][0]));
-
-            bool flip = hoomd::detail::generate_canonical<LongReal>(rng_i) <= m_flip_probability;
-
-            if (!flip)
+            if (!m_cluster_flip[m_cluster_label[i]])
                 {
-                // revert cluster
-                for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
-                    {
-                    // particle index
-                    unsigned int i = *it;
-
-                    h_pos.data[i] = h_pos_backup.data[i];
-                    h_orientation.data[i] = h_orientation_backup.data[i];
-                    h_image.data[i] = h_image_backup.data[i];
-                    }
+                // revert the particles of clusters that are not flipped
+                h_pos.data[i] = h_pos_backup.data[i];
+                h_orientation.data[i] = h_orientation_backup.data[i];
+                h_image.data[i] = h_image_backup.data[i];
                 }
-            } // end loop over clusters
+            }
         }
     }
 
@@ -1165,20 +1001,18 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     Index2D overlap_idx = m_mc->getOverlapIndexer();
     ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
 
-    // clear the local bond and rejection lists
-    m_overlap.clear();
+    // every particle starts in its own cluster
+    unsigned int nptl = m_pdata->getN();
+    m_union_find.reset(nptl);
 
+    const bool has_pair_interactions = m_mc->hasPairInteractions();
     Scalar r_cut_patch(0.0);
-    if (m_mc->hasPairInteractions())
+    if (has_pair_interactions)
         {
-        m_energy_old_old.clear();
-        m_energy_new_old.clear();
         r_cut_patch = m_mc->getMaxPairEnergyRCutNonAdditive();
         }
 
-    // cluster according to overlap of excluded volume shells
-    // loop over local particles
-    unsigned int nptl = m_pdata->getN();
+    const uint16_t seed = m_sysdef->getSeed();
 
     // access particle data
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -1189,116 +1023,8 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     ArrayHandle<Scalar4> h_postype_backup(m_postype_backup, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation_backup(m_orientation_backup, access_location::host, access_mode::read);
 
-    if (m_mc->hasPairInteractions())
-        {
-        // test old configuration against itself
-        #ifdef ENABLE_TBB_TASK
-        this->m_exec_conf->getTaskArena()->execute([&]{
-        tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i)
-        #else
-        for (unsigned int i = 0; i < this->m_pdata->getN(); ++i)
-        #endif
-            {
-            unsigned int typ_i = __scalar_as_int(h_postype_backup.data[i].w);
-
-            vec3<Scalar> pos_i(h_postype_backup.data[i]);
-            quat<Scalar> orientation_i(h_orientation_backup.data[i]);
-
-            Scalar d_i(h_diameter.data[i]);
-            Scalar charge_i(h_charge.data[i]);
-
-            // subtract minimum AABB extent from search radius
-            Scalar extent_i = 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_i);
-            Scalar R_query = std::max(0.0,r_cut_patch+extent_i-min_core_diameter/(ShortReal)2.0);
-            hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0), R_query);
-
-            const unsigned int n_images = (unsigned int) image_list.size();
-
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
-
-                hoomd::detail::AABB aabb_i_image = aabb_local;
-                aabb_i_image.translate(pos_i_image);
-
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
-                    {
-                    if (aabb_i_image.overlaps(m_aabb_tree_old.getNodeAABB(cur_node_idx)))
-                        {
-                        if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
-
-                                if (i == j && cur_image == 0) continue;
-
-                                // load the position and orientation of the j particle
-                                vec3<Scalar> pos_j = vec3<Scalar>(h_postype_backup.data[j]);
-                                unsigned int typ_j = __scalar_as_int(h_postype_backup.data[j].w);
-
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = pos_j - pos_i_image;
-                                Scalar rsq_ij = dot(r_ij, r_ij);
-
-                                Scalar rcut_ij = r_cut_patch + extent_i + 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_j);
-
-                                if (rsq_ij <= rcut_ij*rcut_ij)
-                                    {
-                                    // the particle pair
-                                    auto p = std::make_pair(i,j);
-
-                                    // if particle interacts in different image already, add to that energy
-                                    LongReal U = 0.0;
-                                        {
-                                        auto it_energy = m_energy_old_old.find(p);
-                                        if (it_energy != m_energy_old_old.end())
-                                            U = it_energy->second;
-                                        }
-
-                                    U += m_mc->computeOnePairEnergy(rsq_ij,
-                                                        r_ij, typ_i,
-                                                        orientation_i,
-                                                        d_i,
-                                                        charge_i,
-                                                        typ_j,
-                                                        quat<LongReal>(h_orientation_backup.data[j]),
-                                                        h_diameter.data[j],
-                                                        h_charge.data[j]);
-
-                                    // update map
-                                    m_energy_old_old[p] = U;
-                                    } // end if overlap
-
-                                } // end loop over AABB tree leaf
-                            } // end is leaf
-                        } // end if overlap
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
-                        }
-
-                    } // end loop over nodes
-
-                } // end loop over images
-
-            } // end loop over old configuration
-        #ifdef ENABLE_TBB_TASK
-            );
-        }); // end task arena execute()
-        #endif
-        }
-
-    // loop over new configuration
-    #ifdef ENABLE_TBB_TASK
-    this->m_exec_conf->getTaskArena()->execute([&]{
-    tbb::parallel_for((unsigned int)0,nptl, [&](unsigned int i)
-    #else
-    for (unsigned int i = 0; i < nptl; ++i)
-    #endif
+    // cluster according to overlap of excluded volume shells and pair interaction bonds
+    auto find_particle_interactions = [&](unsigned int i, std::vector<PairEnergyDelta>& pair_energy)
         {
         unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
 
@@ -1356,7 +1082,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                                     && test_overlap(r_ij, shape_i, shape_j, err))
                                     {
                                     // add connection
-                                    m_overlap.insert(std::make_pair(i,j));
+                                    m_union_find.unite(i, j);
                                     } // end if overlap
                                 }
 
@@ -1372,14 +1098,87 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over nodes
             } // end loop over images
 
-        if (m_mc->hasPairInteractions())
+        if (!has_pair_interactions)
+            return;
+
+        pair_energy.clear();
+
+        // subtract minimum AABB extent from search radius
+        Scalar extent_i = 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_i);
+
+        // test old configuration against itself
+            {
+            vec3<Scalar> pos_i(h_postype_backup.data[i]);
+            quat<Scalar> orientation_i(h_orientation_backup.data[i]);
+
+            Scalar R_query = std::max(0.0,r_cut_patch+extent_i-min_core_diameter/(ShortReal)2.0);
+            hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0), R_query);
+
+            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                {
+                vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
+
+                hoomd::detail::AABB aabb_i_image = aabb_local;
+                aabb_i_image.translate(pos_i_image);
+
+                // stackless search
+                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
+                    {
+                    if (aabb_i_image.overlaps(m_aabb_tree_old.getNodeAABB(cur_node_idx)))
+                        {
+                        if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
+                            {
+                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
+                                {
+                                // read in its position and orientation
+                                unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
+
+                                if (i == j && cur_image == 0) continue;
+
+                                // load the position and orientation of the j particle
+                                vec3<Scalar> pos_j = vec3<Scalar>(h_postype_backup.data[j]);
+                                unsigned int typ_j = __scalar_as_int(h_postype_backup.data[j].w);
+
+                                // put particles in coordinate system of particle i
+                                vec3<Scalar> r_ij = pos_j - pos_i_image;
+                                Scalar rsq_ij = dot(r_ij, r_ij);
+
+                                Scalar rcut_ij = r_cut_patch + extent_i + 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_j);
+
+                                if (rsq_ij <= rcut_ij*rcut_ij)
+                                    {
+                                    LongReal U = m_mc->computeOnePairEnergy(rsq_ij,
+                                                        r_ij, typ_i,
+                                                        orientation_i,
+                                                        h_diameter.data[i],
+                                                        h_charge.data[i],
+                                                        typ_j,
+                                                        quat<LongReal>(h_orientation_backup.data[j]),
+                                                        h_diameter.data[j],
+                                                        h_charge.data[j]);
+
+                                    pair_energy.push_back(PairEnergyDelta{j, U, 0.0});
+                                    } // end if overlap
+
+                                } // end loop over AABB tree leaf
+                            } // end is leaf
+                        } // end if overlap
+                    else
+                        {
+                        // skip ahead
+                        cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
+                        }
+
+                    } // end loop over nodes
+
+                } // end loop over images
+            }
+
+        // compute V(r'-r)
             {
-            // subtract minimum AABB extent from search radius
-            Scalar extent_i = 0.5*m_mc->getMaxPairInteractionAdditiveRCut(typ_i);
             Scalar R_query = std::max(0.0,r_cut_patch+extent_i-min_core_diameter/(LongReal)2.0);
             hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0), R_query);
 
-            // compute V(r'-r)
             for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                 {
                 vec3<Scalar> pos_i_image = pos_i_new + image_list[cur_image];
@@ -1414,17 +1213,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
 
                                 if (rsq_ij <= rcut_ij*rcut_ij)
                                     {
-                                    auto p = std::make_pair(i, j);
-
-                                    // if particle interacts in different image already, add to that energy
-                                    LongReal U = 0.0;
-                                        {
-                                        auto it_energy = m_energy_new_old.find(p);
-                                        if (it_energy != m_energy_new_old.end())
-                                            U = it_energy->second;
-                                        }
-
-                                    U += m_mc->computeOnePairEnergy(rsq_ij,
+                                    LongReal U = m_mc->computeOnePairEnergy(rsq_ij,
                                                         r_ij,
                                                         typ_i,
                                                         shape_i.orientation,
@@ -1435,8 +1224,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                                                         h_diameter.data[j],
                                                         h_charge.data[j]);
 
-                                    // update map
-                                    m_energy_new_old[p] = U;
+                                    pair_energy.push_back(PairEnergyDelta{j, 0.0, U});
                                     }
                                 } // end loop over AABB tree leaf
                             } // end is leaf
@@ -1450,12 +1238,60 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                     } // end loop over nodes
 
                 } // end loop over images
-            } // end if patch
-        } // end loop over local particles
-    #ifdef ENABLE_TBB_TASK
-        );
-    }); // end task arena execute()
+            }
+
+        // sum up the interaction energies with each partner over all images, keeping the
+        // order of the terms so that the sums do not depend on the threading
+        std::stable_sort(pair_energy.begin(), pair_energy.end(),
+            [](const PairEnergyDelta& a, const PairEnergyDelta& b)
+                { return a.j < b.j; });
+
+        for (size_t k = 0; k < pair_energy.size(); )
+            {
+            unsigned int j = pair_energy[k].j;
+
+            LongReal U_old = 0.0;
+            LongReal U_new = 0.0;
+            for (; k < pair_energy.size() && pair_energy[k].j == j; ++k)
+                {
+                U_old += pair_energy[k].energy_old;
+                U_new += pair_energy[k].energy_new;
+                }
+
+            LongReal delU = U_new - U_old;
+
+            // create a RNG specific to this particle pair
+            hoomd::RandomGenerator rng_ij(hoomd::Seed(hoomd::RNGIdentifier::UpdaterClustersPairwise, timestep, seed),
+                                          hoomd::Counter(std::min(i,j), std::max(i,j)));
+
+            LongReal pij = 1.0f-exp(-delU);
+            if (hoomd::detail::generate_canonical<LongReal>(rng_ij) <= pij) // GCA
+                {
+                // add bond
+                m_union_find.unite(i, j);
+                }
+            }
+        };
+
+    // loop over new configuration
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        this->m_exec_conf->getTaskArena()->execute([&]{
+        tbb::parallel_for((unsigned int)0,nptl, [&](unsigned int i)
+            {
+            find_particle_interactions(i, m_pair_energy_tls.local());
+            });
+        }); // end task arena execute()
+        }
+    else
     #endif
+        {
+        for (unsigned int i = 0; i < nptl; ++i)
+            {
+            find_particle_interactions(i, m_pair_energy);
+            }
+        }
 
     /*
      * Depletants
@@ -1476,7 +1312,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
         return;
 
     // test old configuration against itself
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i) {
     #else
@@ -1494,7 +1330,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
             h_overlaps.data, h_fugacity.data,
             timestep, q, pivot, line);
         }
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1532,9 +1368,28 @@ void UpdaterClusters<Shape>::backupState()
 template<class Shape>
 void UpdaterClusters<Shape>::connectedComponents()
     {
-    // compute connected components
-    m_clusters.clear();
-    m_G.connectedComponents(m_clusters);
+    // label every particle with the root of its set
+    unsigned int nptl = m_pdata->getN();
+    m_cluster_label.resize(nptl);
+
+    #ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        this->m_exec_conf->getTaskArena()->execute([&]{
+        tbb::parallel_for((unsigned int)0,nptl, [&](unsigned int i)
+            {
+            m_cluster_label[i] = m_union_find.find(i);
+            });
+        }); // end task arena execute()
+        }
+    else
+    #endif
+        {
+        for (unsigned int i = 0; i < nptl; ++i)
+            {
+            m_cluster_label[i] = m_union_find.find(i);
+            }
+        }
     }
 
 /*! Perform a cluster move
@@ -1623,108 +1478,9 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
     // signal that AABB tree is invalid
     m_mc->invalidateAABBTree();
 
-    // determine which particles interact
+    // determine which particles interact and join them into clusters
     findInteractions(timestep, q, pivot, line);
 
-    // resize the number of graph nodes in place
-    m_G.resize(this->m_pdata->getN());
-
-    #ifdef ENABLE_TBB_TASK
-    this->m_exec_conf->getTaskArena()->execute([&]{
-    tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
-    #else
-    auto &r = m_overlap;
-    #endif
-        {
-        for (auto it = r.begin(); it != r.end(); ++it)
-            {
-            unsigned int i = it->first;
-            unsigned int j = it->second;
-
-            // we're adding a directed edge, but the actual graph will be undirected
-            // if the symmetry operation is self-inverse
-            m_G.addEdge(i,j);
-            }
-        }
-    #ifdef ENABLE_TBB_TASK
-        );
-    }); // end task arena execute()
-    #endif
-
-    if (m_mc->hasPairInteractions())
-        {
-        // sum up interaction energies
-        #ifdef ENABLE_TBB_TASK
-        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, LongReal> delta_U;
-        #else
-        std::map< std::pair<unsigned int, unsigned int>, LongReal> delta_U;
-        #endif
-
-        for (auto it = m_energy_old_old.begin(); it != m_energy_old_old.end(); ++it)
-            {
-            LongReal delU = -it->second;
-            unsigned int i = it->first.first;
-            unsigned int j = it->first.second;
-
-            auto p = std::make_pair(i,j);
-
-            // add to energy
-            auto itj = delta_U.find(p);
-            if (itj != delta_U.end())
-                delU += itj->second;
-
-            // update map with new interaction energy
-            delta_U[p] = delU;
-            }
-
-        for (auto it = m_energy_new_old.begin(); it != m_energy_new_old.end(); ++it)
-            {
-            LongReal delU = it->second;
-            unsigned int i = it->first.first;
-            unsigned int j = it->first.second;
-
-            auto p = std::make_pair(i,j);
-
-            // add to energy
-            auto itj = delta_U.find(p);
-            if (itj != delta_U.end())
-                delU += itj->second;
-
-            // update map with new interaction energy
-            delta_U[p] = delU;
-            }
-
-        #ifdef ENABLE_TBB_TASK
-        this->m_exec_conf->getTaskArena()->execute([&]{
-        tbb::parallel_for(delta_U.range(), [&] (decltype(delta_U.range()) r)
-        #else
-        auto &r = delta_U;
-        #endif
-            {
-            for (auto it = r.begin(); it != r.end(); ++it)
-                {
-                LongReal delU = it->second;
-                unsigned int i = it->first.first;
-                unsigned int j = it->first.second;
-
-                // create a RNG specific to this particle pair
-                hoomd::RandomGenerator rng_ij(hoomd::Seed(hoomd::RNGIdentifier::UpdaterClustersPairwise, timestep, seed),
-                                              hoomd::Counter(std::min(i,j), std::max(i,j)));
-
-                LongReal pij = 1.0f-exp(-delU);
-                if (hoomd::detail::generate_canonical<LongReal>(rng_ij) <= pij) // GCA
-                    {
-                    // add bond
-                    m_G.addEdge(i,j);
-                    }
-                }
-            }
-        #ifdef ENABLE_TBB_TASK
-            );
-        }); // end task arena execute()
-        #endif
-        } // end if (m_mc->hasPairInteractions)
-
     // compute connected components
     connectedComponents();
 
@@ -104,6 +104,12 @@ moves per particle when using the parallel code paths. Monitor the number of
 trial moves performed with `HPMCIntegrator.translate_moves` and
 `HPMCIntegrator.rotate_moves`.
 
+Set `HPMCIntegrator.checkerboard` to `True` to perform trial moves in parallel
+on multiple CPU threads. The box is divided into cells that are visited in
+alternating sets, and each particle receives ``nselect`` trial moves per
+timestep. The trial moves in each cell are drawn from a random number stream
+for that cell, so the trajectory does not depend on the number of threads.
+
 .. rubric:: Random numbers
 
 `HPMCIntegrator` uses a pseudorandom number stream to generate the trial moves.
@@ -315,12 +321,24 @@ class HPMCIntegrator(Integrator):
 
     .. rubric:: Threading
 
-    HPMC integrators use threaded execution on multiple CPU cores only when
+    HPMC integrators use threaded execution on multiple CPU cores when
     placing implicit depletants (``depletant_fugacity != 0``).
 
     .. deprecated:: 4.4.0
 
-        ``num_cpu_threads >= 1`` is deprecated. Set ``num_cpu_threads = 1``.
+        ``num_cpu_threads >= 1`` with implicit depletants is deprecated. Set
+        ``num_cpu_threads = 1``.
+
+    .. rubric:: Checkerboard sweeps
+
+    Set `checkerboard` to `True` to attempt trial moves on multiple CPU cores.
+    The CPU implementation divides the box into cells at least as wide as the
+    largest interaction range and attempts trial moves concurrently in one set
+    of non-adjacent cells at a time. Trial moves that would leave a cell are
+    rejected. The checkerboard sweep is not available with implicit
+    depletants, legacy external fields, or MPI domain decomposition. In these
+    cases, and when the box is narrower than two cells, `HPMCIntegrator` issues
+    a warning and performs the serial sweep. This code path is not deprecated.
 
     .. rubric:: Mixed precision
 
@@ -334,6 +352,11 @@ class HPMCIntegrator(Integrator):
             Maximum size of rotation trial moves
             :math:`[\\mathrm{dimensionless}]`.
 
+        checkerboard (bool): Set to `True` to perform trial moves in parallel
+            on the CPU with a checkerboard decomposition of the box
+            (**default:** `False`). GPU devices always use a checkerboard
+            decomposition and ignore this setting.
+
         d (`TypeParameter` [``particle type``, `float`]):
             Maximum size of displacement trial moves
             :math:`[\\mathrm{length}]`.
@@ -379,7 +402,8 @@ class HPMCIntegrator(Integrator):
         # Set base parameter dict for hpmc integrators
         param_dict = ParameterDict(
             translation_move_probability=float(translation_move_probability),
-            nselect=int(nselect))
+            nselect=int(nselect),
+            checkerboard=bool(False))
         self._param_dict.update(param_dict)
         self._pair_potential = None
         self._external_potential = None
@@ -151,6 +151,32 @@ def test_moves(simulation_factory, lattice_snapshot_factory, test_moves_args):
         assert accepted_rejected_rot > 0
 
 
+@pytest.mark.parametrize("n_dimensions", [2, 3])
+def test_checkerboard_moves(device, simulation_factory,
+                            lattice_snapshot_factory, n_dimensions):
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.2, nselect=2)
+    mc.shape['A'] = dict(diameter=1)
+    mc.checkerboard = True
+    assert mc.checkerboard
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(dimensions=n_dimensions, a=1.2, n=8))
+    sim.operations.add(mc)
+    sim.run(0)
+    assert mc.checkerboard
+
+    sim.run(10)
+    assert mc.overlaps == 0
+
+    # every particle receives nselect trial moves per step in the checkerboard
+    # sweep on the CPU
+    if (isinstance(device, hoomd.device.CPU)
+            and device.communicator.num_ranks == 1):
+        n_moves = sum(mc.translate_moves)
+        assert n_moves == 10 * 2 * sim.state.N_particles
+        assert mc.translate_moves[0] > 0
+
+
 def test_kernel_parameters(simulation_factory, lattice_snapshot_factory,
                            test_moves_args):
     integrator = test_moves_args[0]
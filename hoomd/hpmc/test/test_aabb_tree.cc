@@ -105,3 +105,94 @@ UP_TEST(bigger)
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST(refit_traverse)
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(7, 8, 9));
+
+    std::vector<vec3<Scalar>> points(N);
+    std::vector<AABB> aabbs(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                    * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    // buildTree reorders the AABBs it is given, so build from a copy
+    std::vector<AABB> build_aabbs(aabbs);
+    AABBTree tree;
+    tree.buildTree(build_aabbs.data(), N);
+
+    // traverse() must find the same particles as a brute force search
+    auto check_traverse = [&]()
+    {
+        for (unsigned int i = 0; i < N; i++)
+            {
+            AABB query(points[i], Scalar(2.0));
+            std::vector<unsigned int> hits;
+            tree.traverse(query,
+                          [&](unsigned int node)
+                          {
+                              for (unsigned int p = 0; p < tree.getNodeNumParticles(node); p++)
+                                  {
+                                  unsigned int j = tree.getNodeParticle(node, p);
+                                  if (query.overlaps(aabbs[j]))
+                                      hits.push_back(j);
+                                  }
+                              return false;
+                          });
+
+            unsigned int n_expected = 0;
+            for (unsigned int j = 0; j < N; j++)
+                {
+                if (query.overlaps(aabbs[j]))
+                    {
+                    n_expected++;
+                    UP_ASSERT(in(j, hits));
+                    }
+                }
+            UP_ASSERT_EQUAL(hits.size(), n_expected);
+            }
+    };
+
+    check_traverse();
+
+    // small displacements keep the tree quality, so refit succeeds
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5))
+                     * Scalar(0.5);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    UP_ASSERT(tree.refit(aabbs.data(), N, Scalar(1.5)));
+    check_traverse();
+
+    // moves made with update() are also seen by traverse()
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i].x += Scalar(0.5);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        tree.update(i, aabbs[i]);
+        }
+    check_traverse();
+
+    // a completely new configuration degrades the tree, so refit asks for a rebuild
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                    * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+    UP_ASSERT(!tree.refit(aabbs.data(), N, Scalar(1.5)));
+
+    // refit requires the same number of particles
+    UP_ASSERT(!tree.refit(aabbs.data(), N - 1, Scalar(1.5)));
+    }
@@ -0,0 +1,388 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/PairPotentialExpandedGaussian.h"
+#include "hoomd/hpmc/PairPotentialLJGauss.h"
+#include "hoomd/hpmc/PairPotentialLennardJones.h"
+#include "hoomd/hpmc/PairPotentialOPP.h"
+#include "hoomd/hpmc/PairPotentialStep.h"
+#include "hoomd/hpmc/PairPotentialUnion.h"
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include <pybind11/embed.h>
+#include <pybind11/pybind11.h>
+
+using namespace hoomd;
+using namespace hoomd::hpmc;
+
+/*! \file test_pair_potential_batch.cc
+    \brief Checks PairPotential::energyBatch against the sum of per pair energy() calls
+    \ingroup unit_tests
+*/
+
+//! Relative tolerance: both paths evaluate the same expressions in LongReal
+const LongReal tol_batch = LongReal(1e-10);
+
+//! The potentials take their parameters as Python dicts
+void start_python()
+    {
+    static pybind11::scoped_interpreter guard;
+    }
+
+//! Build a two type system to hold the potential parameters
+std::shared_ptr<SystemDefinition> make_sysdef()
+    {
+    start_python();
+    return std::make_shared<SystemDefinition>(1,
+                                              BoxDim(20),
+                                              2,
+                                              0,
+                                              0,
+                                              0,
+                                              0,
+                                              std::make_shared<ExecutionConfiguration>(
+                                                  ExecutionConfiguration::CPU));
+    }
+
+//! Random orientation
+quat<LongReal> random_orientation(std::mt19937& rng)
+    {
+    std::normal_distribution<LongReal> normal;
+    quat<LongReal> q(normal(rng), vec3<LongReal>(normal(rng), normal(rng), normal(rng)));
+    return q * fast::rsqrt(norm2(q));
+    }
+
+//! Random j particles of both types at distances in [r_min, r_max)
+PairEnergyBatch make_batch(unsigned int n, LongReal r_min, LongReal r_max, unsigned int seed)
+    {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<LongReal> distance(r_min, r_max);
+    std::normal_distribution<LongReal> normal;
+    std::uniform_int_distribution<unsigned int> type(0, 1);
+
+    PairEnergyBatch batch;
+    for (unsigned int k = 0; k < n; k++)
+        {
+        vec3<LongReal> direction(normal(rng), normal(rng), normal(rng));
+        vec3<LongReal> r_ij = direction * (distance(rng) * fast::rsqrt(dot(direction, direction)));
+        batch.push_back(dot(r_ij, r_ij),
+                        r_ij,
+                        type(rng),
+                        random_orientation(rng),
+                        LongReal(0.5) * normal(rng));
+        }
+    return batch;
+    }
+
+//! Sum energy() over the pairs of the batch within the cutoff
+LongReal sum_pair_energies(const PairPotential& potential,
+                           unsigned int type_i,
+                           const quat<LongReal>& q_i,
+                           LongReal charge_i,
+                           const PairEnergyBatch& batch)
+    {
+    LongReal energy = 0;
+    for (size_t k = 0; k < batch.size(); k++)
+        {
+        if (batch.r_squared[k] < potential.getRCutSquaredTotal(type_i, batch.type_j[k]))
+            {
+            energy += potential.energy(batch.r_squared[k],
+                                       vec3<LongReal>(batch.r_x[k], batch.r_y[k], batch.r_z[k]),
+                                       type_i,
+                                       q_i,
+                                       charge_i,
+                                       batch.type_j[k],
+                                       batch.q_j[k],
+                                       batch.charge_j[k]);
+            }
+        }
+    return energy;
+    }
+
+//! Compare energyBatch with the sum of energy() for both types of particle i
+/*! The batch reaches beyond the largest cutoff, so the cutoff check of energyBatch is exercised.
+ */
+void check_batch(const PairPotential& potential, LongReal r_min, LongReal r_max)
+    {
+    PairEnergyBatch batch = make_batch(200, r_min, r_max, 12345);
+    std::mt19937 rng(54321);
+    for (unsigned int type_i = 0; type_i < 2; type_i++)
+        {
+        quat<LongReal> q_i = random_orientation(rng);
+        LongReal charge_i = LongReal(-0.25);
+
+        LongReal expected = sum_pair_energies(potential, type_i, q_i, charge_i, batch);
+        LongReal energy = potential.energyBatch(type_i, q_i, charge_i, batch);
+        UP_ASSERT(expected != 0);
+        MY_CHECK_CLOSE(energy, expected, tol_batch);
+        }
+
+    // an empty batch has no energy
+    PairEnergyBatch empty;
+    UP_ASSERT_EQUAL(potential.energyBatch(0, quat<LongReal>(), 0, empty), LongReal(0));
+    }
+
+//! Check that shifted and xplor energies go to 0 at the cutoff
+void check_energy_at_r_cut(const PairPotential& potential, LongReal r_cut)
+    {
+    LongReal r = r_cut * (LongReal(1.0) - LongReal(1e-9));
+    vec3<LongReal> r_ij(r, 0, 0);
+    MY_CHECK_SMALL(potential.energy(r * r, r_ij, 0, quat<LongReal>(), 0, 0, quat<LongReal>(), 0),
+                   1e-6);
+    }
+
+//! Set the parameters of all type pairs, scaling epsilon by pair to check the type indexing
+template<class Potential>
+void set_params(Potential& potential, pybind11::dict params, const std::string& scaled)
+    {
+    const LongReal value = params[scaled.c_str()].cast<LongReal>();
+    potential.setParamsPython(pybind11::make_tuple("A", "A"), params);
+    params[scaled.c_str()] = value * LongReal(1.5);
+    potential.setParamsPython(pybind11::make_tuple("A", "B"), params);
+    params[scaled.c_str()] = value * LongReal(0.5);
+    potential.setParamsPython(pybind11::make_tuple("B", "B"), params);
+    }
+
+//! Check a potential in all shift modes
+template<class Potential>
+void check_modes(Potential& potential, LongReal r_cut, LongReal r_min)
+    {
+    for (const std::string mode : {"none", "shift", "xplor"})
+        {
+        potential.setMode(mode);
+        check_batch(potential, r_min, LongReal(1.2) * r_cut);
+        if (mode != "none")
+            {
+            check_energy_at_r_cut(potential, r_cut);
+            }
+        }
+    }
+
+UP_TEST(lennard_jones_batch)
+    {
+    auto sysdef = make_sysdef();
+    PairPotentialLennardJones potential(sysdef);
+
+    pybind11::dict params;
+    params["epsilon"] = 1.0;
+    params["sigma"] = 1.0;
+    params["r_cut"] = 2.5;
+    params["r_on"] = 2.0;
+    set_params(potential, params, "epsilon");
+    check_modes(potential, 2.5, 0.9);
+    }
+
+UP_TEST(opp_batch)
+    {
+    auto sysdef = make_sysdef();
+    PairPotentialOPP potential(sysdef);
+
+    pybind11::dict params;
+    params["C1"] = 1.0;
+    params["C2"] = 1.0;
+    params["eta1"] = 15.0;
+    params["eta2"] = 3.0;
+    params["k"] = 5.0;
+    params["phi"] = 0.5;
+    params["r_cut"] = 2.5;
+    params["r_on"] = 2.0;
+    set_params(potential, params, "C2");
+    check_modes(potential, 2.5, 0.9);
+    }
+
+UP_TEST(expanded_gaussian_batch)
+    {
+    auto sysdef = make_sysdef();
+    PairPotentialExpandedGaussian potential(sysdef);
+
+    pybind11::dict params;
+    params["epsilon"] = 1.0;
+    params["sigma"] = 0.5;
+    params["delta"] = 0.5;
+    params["r_cut"] = 2.5;
+    params["r_on"] = 2.0;
+    set_params(potential, params, "epsilon");
+    check_modes(potential, 2.5, 0.5);
+    }
+
+UP_TEST(lj_gauss_batch)
+    {
+    auto sysdef = make_sysdef();
+    PairPotentialLJGauss potential(sysdef);
+
+    pybind11::dict params;
+    params["epsilon"] = 1.0;
+    params["sigma"] = 0.3;
+    params["r0"] = 1.5;
+    params["r_cut"] = 2.5;
+    params["r_on"] = 2.0;
+    set_params(potential, params, "epsilon");
+    check_modes(potential, 2.5, 0.9);
+    }
+
+UP_TEST(step_batch)
+    {
+    auto sysdef = make_sysdef();
+    PairPotentialStep potential(sysdef);
+
+    pybind11::dict params_AA;
+    pybind11::list epsilon_AA, r_AA;
+    for (double value : {1.0, -2.0, 0.5})
+        epsilon_AA.append(value);
+    for (double value : {1.0, 1.5, 2.0})
+        r_AA.append(value);
+    params_AA["epsilon"] = epsilon_AA;
+    params_AA["r"] = r_AA;
+    potential.setParamsPython(pybind11::make_tuple("A", "A"), params_AA);
+
+    pybind11::dict params_AB;
+    pybind11::list epsilon_AB, r_AB;
+    epsilon_AB.append(-1.0);
+    r_AB.append(1.25);
+    params_AB["epsilon"] = epsilon_AB;
+    params_AB["r"] = r_AB;
+    potential.setParamsPython(pybind11::make_tuple("A", "B"), params_AB);
+
+    // B-B pairs do not interact
+    potential.setParamsPython(pybind11::make_tuple("B", "B"), pybind11::none());
+
+    check_batch(potential, 0.5, 2.5);
+    }
+
+//! Sum the constituent energy() over all pairs of constituents of two union particles
+LongReal sum_constituent_energies(const PairPotential& constituent,
+                                  const std::vector<vec3<LongReal>>& position,
+                                  const std::vector<quat<LongReal>>& orientation,
+                                  const std::vector<unsigned int>& type,
+                                  const std::vector<LongReal>& charge,
+                                  const vec3<LongReal>& r_ij,
+                                  const quat<LongReal>& q_i,
+                                  const quat<LongReal>& q_j)
+    {
+    LongReal energy = 0;
+    for (size_t a = 0; a < position.size(); a++)
+        {
+        for (size_t b = 0; b < position.size(); b++)
+            {
+            vec3<LongReal> r_ab = r_ij + rotate(q_j, position[b]) - rotate(q_i, position[a]);
+            LongReal r_squared = dot(r_ab, r_ab);
+            if (r_squared < constituent.getRCutSquaredTotal(type[a], type[b]))
+                {
+                energy += constituent.energy(r_squared,
+                                             r_ab,
+                                             type[a],
+                                             q_i * orientation[a],
+                                             charge[a],
+                                             type[b],
+                                             q_j * orientation[b],
+                                             charge[b]);
+                }
+            }
+        }
+    return energy;
+    }
+
+//! Union of LJ sites: brute force sums for energy() and the sum of energy() for energyBatch
+void union_batch_test(unsigned int leaf_capacity)
+    {
+    auto sysdef = make_sysdef();
+    auto constituent = std::make_shared<PairPotentialLennardJones>(sysdef);
+    pybind11::dict params;
+    params["epsilon"] = 1.0;
+    params["sigma"] = 0.5;
+    params["r_cut"] = 1.5;
+    params["r_on"] = 1.0;
+    set_params(*constituent, params, "epsilon");
+    constituent->setMode("shift");
+
+    PairPotentialUnion potential(sysdef, constituent);
+
+    // both types are unions of the same randomly placed sites
+    std::mt19937 rng(2024);
+    std::uniform_real_distribution<LongReal> coordinate(-1.0, 1.0);
+    std::vector<vec3<LongReal>> position;
+    std::vector<quat<LongReal>> orientation;
+    std::vector<unsigned int> type;
+    std::vector<LongReal> charge;
+    pybind11::list positions, orientations, types, charges;
+    for (unsigned int a = 0; a < 12; a++)
+        {
+        position.push_back(vec3<LongReal>(coordinate(rng), coordinate(rng), coordinate(rng)));
+        orientation.push_back(random_orientation(rng));
+        type.push_back(a % 2);
+        charge.push_back(LongReal(0.0));
+        positions.append(pybind11::make_tuple(position[a].x, position[a].y, position[a].z));
+        orientations.append(pybind11::make_tuple(orientation[a].s,
+                                                 orientation[a].v.x,
+                                                 orientation[a].v.y,
+                                                 orientation[a].v.z));
+        types.append(a % 2 ? "B" : "A");
+        charges.append(charge[a]);
+        }
+    pybind11::dict body;
+    body["positions"] = positions;
+    body["orientations"] = orientations;
+    body["types"] = types;
+    body["charges"] = charges;
+    potential.setBody("A", body);
+    potential.setBody("B", body);
+    potential.setLeafCapacity(leaf_capacity);
+
+    // union particles overlapping to just beyond the reach of the sites
+    PairEnergyBatch batch = make_batch(20, 1.0, 4.5, 777);
+    quat<LongReal> q_i = random_orientation(rng);
+    LongReal total = 0;
+    for (size_t k = 0; k < batch.size(); k++)
+        {
+        vec3<LongReal> r_ij(batch.r_x[k], batch.r_y[k], batch.r_z[k]);
+        LongReal expected = sum_constituent_energies(*constituent,
+                                                     position,
+                                                     orientation,
+                                                     type,
+                                                     charge,
+                                                     r_ij,
+                                                     q_i,
+                                                     batch.q_j[k]);
+        LongReal energy = potential.energy(batch.r_squared[k],
+                                           r_ij,
+                                           0,
+                                           q_i,
+                                           0,
+                                           batch.type_j[k],
+                                           batch.q_j[k],
+                                           0);
+        if (expected == 0)
+            {
+            UP_ASSERT_EQUAL(energy, LongReal(0));
+            }
+        else
+            {
+            MY_CHECK_CLOSE(energy, expected, tol_batch);
+            }
+
+        if (batch.r_squared[k] < potential.getRCutSquaredTotal(0, batch.type_j[k]))
+            total += expected;
+        }
+
+    UP_ASSERT(total != 0);
+    MY_CHECK_CLOSE(potential.energyBatch(0, q_i, 0, batch), total, tol_batch);
+    }
+
+UP_TEST(union_batch_all)
+    {
+    union_batch_test(0);
+    }
+
+UP_TEST(union_batch_obb)
+    {
+    union_batch_test(4);
+    }
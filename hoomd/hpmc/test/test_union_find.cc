@@ -0,0 +1,101 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/UpdaterClusters.h"
+
+#include <utility>
+#include <vector>
+
+#include "hoomd/RandomNumbers.h"
+
+using namespace hoomd;
+using namespace hoomd::hpmc::detail;
+
+UP_TEST(chain)
+    {
+    UnionFind union_find;
+    union_find.reset(10);
+
+    // every particle is its own cluster
+    for (unsigned int i = 0; i < 10; i++)
+        {
+        UP_ASSERT_EQUAL(union_find.find(i), i);
+        }
+
+    // join a chain from the end so that the roots need to be relinked
+    for (unsigned int i = 9; i > 5; i--)
+        {
+        union_find.unite(i, i - 1);
+        }
+    union_find.unite(0, 2);
+
+    for (unsigned int i = 5; i < 10; i++)
+        {
+        UP_ASSERT_EQUAL(union_find.find(i), 5);
+        }
+    UP_ASSERT_EQUAL(union_find.find(0), 0);
+    UP_ASSERT_EQUAL(union_find.find(2), 0);
+    UP_ASSERT_EQUAL(union_find.find(1), 1);
+
+    // reset separates all particles again
+    union_find.reset(4);
+    for (unsigned int i = 0; i < 4; i++)
+        {
+        UP_ASSERT_EQUAL(union_find.find(i), i);
+        }
+    }
+
+UP_TEST(random_graph)
+    {
+    const unsigned int n = 1000;
+    const unsigned int n_edges = 800;
+
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(3));
+    std::vector<std::pair<unsigned int, unsigned int>> edges;
+    for (unsigned int k = 0; k < n_edges; k++)
+        {
+        unsigned int i = hoomd::UniformIntDistribution(n - 1)(rng);
+        unsigned int j = hoomd::UniformIntDistribution(n - 1)(rng);
+        edges.push_back(std::make_pair(i, j));
+        }
+
+    UnionFind union_find;
+    union_find.reset(n);
+    for (const auto& edge : edges)
+        {
+        union_find.unite(edge.first, edge.second);
+        }
+
+    // reference labels: propagate the smallest index along the edges until nothing changes
+    std::vector<unsigned int> label(n);
+    for (unsigned int i = 0; i < n; i++)
+        {
+        label[i] = i;
+        }
+
+    bool changed = true;
+    while (changed)
+        {
+        changed = false;
+        for (const auto& edge : edges)
+            {
+            unsigned int min_label = std::min(label[edge.first], label[edge.second]);
+            if (label[edge.first] != min_label || label[edge.second] != min_label)
+                {
+                label[edge.first] = min_label;
+                label[edge.second] = min_label;
+                changed = true;
+                }
+            }
+        }
+
+    // the root of each cluster is its smallest particle index
+    for (unsigned int i = 0; i < n; i++)
+        {
+        UP_ASSERT_EQUAL(union_find.find(i), label[i]);
+        }
+    }
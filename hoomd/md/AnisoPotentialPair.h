@@ -14,6 +14,7 @@
 #endif
 
 #include "NeighborList.h"
+#include "PairKernelDispatch.h"
 #include "hoomd/ForceCompute.h"
 
 #include "hoomd/ManagedArray.h"
@@ -236,6 +237,21 @@ template<class aniso_evaluator> class AnisoPotentialPair : public ForceCompute
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Pair force kernel specialized on the shift mode, virial, and neighbor list storage
+    template<unsigned int shift_mode, bool compute_virial, bool third_law>
+    void computeForcesKernel(const unsigned int* n_neigh,
+                             const unsigned int* nlist,
+                             const size_t* head_list,
+                             const Scalar4* pos,
+                             const Scalar* charge,
+                             const Scalar4* orientation,
+                             const unsigned int* tag,
+                             const Scalar* rcutsq_table,
+                             const BoxDim& box,
+                             Scalar4* force,
+                             Scalar4* torque,
+                             Scalar* virial);
     };
 
 /*! \param sysdef System to compute forces on
@@ -504,166 +520,218 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
 
     const BoxDim box = m_pdata->getBox();
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        {
-        // need to start from a zero force, energy and virial
-        memset(&h_force.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
-        memset(&h_torque.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
-        memset(&h_virial.data[0], 0, sizeof(Scalar) * m_virial.getNumElements());
 
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
+    // need to start from a zero force, energy and virial
+    memset(&h_force.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
+    memset(&h_torque.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
+    memset(&h_virial.data[0], 0, sizeof(Scalar) * m_virial.getNumElements());
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
-            {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            Scalar4 quat_i = h_orientation.data[i];
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
+    // select the kernel once so that the inner loop has no mode branches
+    detail::dispatchPairKernel<2>(
+        m_shift_mode,
+        compute_virial,
+        third_law,
+        [&](auto shift_mode_c, auto compute_virial_c, auto third_law_c)
+        {
+            this->template computeForcesKernel<decltype(shift_mode_c)::value,
+                                               decltype(compute_virial_c)::value,
+                                               decltype(third_law_c)::value>(h_n_neigh.data,
+                                                                             h_nlist.data,
+                                                                             h_head_list.data,
+                                                                             h_pos.data,
+                                                                             h_charge.data,
+                                                                             h_orientation.data,
+                                                                             h_tag.data,
+                                                                             h_rcutsq.data,
+                                                                             box,
+                                                                             h_force.data,
+                                                                             h_torque.data,
+                                                                             h_virial.data);
+        });
+    }
 
-            // access charge (if needed)
-            Scalar qi = Scalar(0.0);
-            if (aniso_evaluator::needsCharge())
-                qi = h_charge.data[i];
-
-            // initialize current particle force, torque, potential energy, and virial to 0
-            Scalar fxi = Scalar(0.0);
-            Scalar fyi = Scalar(0.0);
-            Scalar fzi = Scalar(0.0);
-            Scalar txi = Scalar(0.0);
-            Scalar tyi = Scalar(0.0);
-            Scalar tzi = Scalar(0.0);
-            Scalar pei = Scalar(0.0);
-            Scalar virialxxi = 0.0;
-            Scalar virialxyi = 0.0;
-            Scalar virialxzi = 0.0;
-            Scalar virialyyi = 0.0;
-            Scalar virialyzi = 0.0;
-            Scalar virialzzi = 0.0;
-
-            // loop over all of the neighbors of this particle
-            const size_t myHead = h_head_list.data[i];
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            for (unsigned int k = 0; k < size; k++)
-                {
-                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-                unsigned int j = h_nlist.data[myHead + k];
-                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+/*! \tparam shift_mode Energy shift mode (an energyShiftMode value)
+    \tparam compute_virial Set to true to accumulate the virial
+    \tparam third_law Set to true when the neighbor list is half
+
+    \param n_neigh Number of neighbors of each particle
+    \param nlist Neighbor list
+    \param head_list Offset of each particle's neighbors in \a nlist
+    \param pos Particle positions and types
+    \param charge Particle charges
+    \param orientation Particle orientations
+    \param tag Particle tags
+    \param rcutsq_table r_cut squared per type pair
+    \param box Local simulation box
+    \param force Output force array (accumulated into)
+    \param torque Output torque array (accumulated into)
+    \param virial Output virial array (accumulated into)
+*/
+template<class aniso_evaluator>
+template<unsigned int shift_mode, bool compute_virial, bool third_law>
+void AnisoPotentialPair<aniso_evaluator>::computeForcesKernel(const unsigned int* n_neigh,
+                                                              const unsigned int* nlist,
+                                                              const size_t* head_list,
+                                                              const Scalar4* pos,
+                                                              const Scalar* charge,
+                                                              const Scalar4* orientation,
+                                                              const unsigned int* tag,
+                                                              const Scalar* rcutsq_table,
+                                                              const BoxDim& box,
+                                                              Scalar4* force,
+                                                              Scalar4* torque,
+                                                              Scalar* virial)
+    {
+    // design specifies that energies are shifted if shift mode is set to shift
+    const bool energy_shift = shift_mode == shift;
 
-                // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-                Scalar3 dx = pi - pj;
-                Scalar4 quat_j = h_orientation.data[j];
+    // for each particle
+    for (int i = 0; i < (int)m_pdata->getN(); i++)
+        {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 pi = make_scalar3(pos[i].x, pos[i].y, pos[i].z);
+        unsigned int typei = __scalar_as_int(pos[i].w);
+        Scalar4 quat_i = orientation[i];
+
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
+
+        // access charge (if needed)
+        Scalar qi = Scalar(0.0);
+        if (aniso_evaluator::needsCharge())
+            qi = charge[i];
+
+        // initialize current particle force, torque, potential energy, and virial to 0
+        Scalar fxi = Scalar(0.0);
+        Scalar fyi = Scalar(0.0);
+        Scalar fzi = Scalar(0.0);
+        Scalar txi = Scalar(0.0);
+        Scalar tyi = Scalar(0.0);
+        Scalar tzi = Scalar(0.0);
+        Scalar pei = Scalar(0.0);
+        Scalar virialxxi = 0.0;
+        Scalar virialxyi = 0.0;
+        Scalar virialxzi = 0.0;
+        Scalar virialyyi = 0.0;
+        Scalar virialyzi = 0.0;
+        Scalar virialzzi = 0.0;
+
+        // loop over all of the neighbors of this particle
+        const size_t myHead = head_list[i];
+        const unsigned int size = (unsigned int)n_neigh[i];
+        for (unsigned int k = 0; k < size; k++)
+            {
+            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+            unsigned int j = nlist[myHead + k];
+            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-                assert(typej < m_pdata->getNTypes());
+            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+            Scalar3 pj = make_scalar3(pos[j].x, pos[j].y, pos[j].z);
+            Scalar3 dx = pi - pj;
+            Scalar4 quat_j = orientation[j];
 
-                // access charge (if needed)
-                Scalar qj = Scalar(0.0);
-                if (aniso_evaluator::needsCharge())
-                    qj = h_charge.data[j];
+            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+            unsigned int typej = __scalar_as_int(pos[j].w);
+            assert(typej < m_pdata->getNTypes());
 
-                // apply periodic boundary conditions
-                dx = box.minImage(dx);
+            // access charge (if needed)
+            Scalar qj = Scalar(0.0);
+            if (aniso_evaluator::needsCharge())
+                qj = charge[j];
 
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                const param_type& param = m_params[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+            // apply periodic boundary conditions
+            dx = box.minImage(dx);
 
-                // design specifies that energies are shifted if
-                // shift mode is set to shift
-                bool energy_shift = false;
-                if (m_shift_mode == shift)
-                    energy_shift = true;
+            // get parameters for this type pair
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            const param_type& param = m_params[typpair_idx];
+            Scalar rcutsq = rcutsq_table[typpair_idx];
 
-                // compute the force and potential energy
-                Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
-                Scalar3 torque_i = make_scalar3(0.0, 0.0, 0.0);
-                Scalar3 torque_j = make_scalar3(0.0, 0.0, 0.0);
+            // compute the force and potential energy
+            Scalar3 f = make_scalar3(0.0, 0.0, 0.0);
+            Scalar3 torque_i = make_scalar3(0.0, 0.0, 0.0);
+            Scalar3 torque_j = make_scalar3(0.0, 0.0, 0.0);
 
-                Scalar pair_eng = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
 
-                aniso_evaluator eval(dx, quat_i, quat_j, rcutsq, param);
+            aniso_evaluator eval(dx, quat_i, quat_j, rcutsq, param);
 
-                if (aniso_evaluator::needsCharge())
-                    eval.setCharge(qi, qj);
-                if (aniso_evaluator::needsShape())
-                    eval.setShape(&m_shape_params[typei], &m_shape_params[typej]);
-                if (aniso_evaluator::needsTags())
-                    eval.setTags(h_tag.data[i], h_tag.data[j]);
+            if (aniso_evaluator::needsCharge())
+                eval.setCharge(qi, qj);
+            if (aniso_evaluator::needsShape())
+                eval.setShape(&m_shape_params[typei], &m_shape_params[typej]);
+            if (aniso_evaluator::needsTags())
+                eval.setTags(tag[i], tag[j]);
 
-                bool evaluated = eval.evaluate(force, pair_eng, energy_shift, torque_i, torque_j);
+            bool evaluated = eval.evaluate(f, pair_eng, energy_shift, torque_i, torque_j);
 
-                if (evaluated)
+            if (evaluated)
+                {
+                Scalar3 force2 = Scalar(0.5) * f;
+
+                // add the force, potential energy and virial to the particle i
+                // (FLOPS: 8)
+                fxi += f.x;
+                fyi += f.y;
+                fzi += f.z;
+                txi += torque_i.x;
+                tyi += torque_i.y;
+                tzi += torque_i.z;
+                pei += pair_eng * Scalar(0.5);
+
+                if constexpr (compute_virial)
                     {
-                    Scalar3 force2 = Scalar(0.5) * force;
-
-                    // add the force, potential energy and virial to the particle i
-                    // (FLOPS: 8)
-                    fxi += force.x;
-                    fyi += force.y;
-                    fzi += force.z;
-                    txi += torque_i.x;
-                    tyi += torque_i.y;
-                    tzi += torque_i.z;
-                    pei += pair_eng * Scalar(0.5);
-
-                    if (compute_virial)
-                        {
-                        virialxxi += dx.x * force2.x;
-                        virialxyi += dx.y * force2.x;
-                        virialxzi += dx.z * force2.x;
-                        virialyyi += dx.y * force2.y;
-                        virialyzi += dx.z * force2.y;
-                        virialzzi += dx.z * force2.z;
-                        }
+                    virialxxi += dx.x * force2.x;
+                    virialxyi += dx.y * force2.x;
+                    virialxzi += dx.z * force2.x;
+                    virialyyi += dx.y * force2.y;
+                    virialyzi += dx.z * force2.y;
+                    virialzzi += dx.z * force2.z;
+                    }
 
-                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                    // scalars / FLOPS: 8)
-                    if (third_law)
+                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
+                // scalars / FLOPS: 8)
+                if constexpr (third_law)
+                    {
+                    force[j].x -= f.x;
+                    force[j].y -= f.y;
+                    force[j].z -= f.z;
+                    torque[j].x += torque_j.x;
+                    torque[j].y += torque_j.y;
+                    torque[j].z += torque_j.z;
+                    force[j].w += pair_eng * Scalar(0.5);
+                    if constexpr (compute_virial)
                         {
-                        h_force.data[j].x -= force.x;
-                        h_force.data[j].y -= force.y;
-                        h_force.data[j].z -= force.z;
-                        h_torque.data[j].x += torque_j.x;
-                        h_torque.data[j].y += torque_j.y;
-                        h_torque.data[j].z += torque_j.z;
-                        h_force.data[j].w += pair_eng * Scalar(0.5);
-                        if (compute_virial)
-                            {
-                            h_virial.data[0 * m_virial_pitch + j] += dx.x * force2.x;
-                            h_virial.data[1 * m_virial_pitch + j] += dx.y * force2.x;
-                            h_virial.data[2 * m_virial_pitch + j] += dx.z * force2.x;
-                            h_virial.data[3 * m_virial_pitch + j] += dx.y * force2.y;
-                            h_virial.data[4 * m_virial_pitch + j] += dx.z * force2.y;
-                            h_virial.data[5 * m_virial_pitch + j] += dx.z * force2.z;
-                            }
+                        virial[0 * m_virial_pitch + j] += dx.x * force2.x;
+                        virial[1 * m_virial_pitch + j] += dx.y * force2.x;
+                        virial[2 * m_virial_pitch + j] += dx.z * force2.x;
+                        virial[3 * m_virial_pitch + j] += dx.y * force2.y;
+                        virial[4 * m_virial_pitch + j] += dx.z * force2.y;
+                        virial[5 * m_virial_pitch + j] += dx.z * force2.z;
                         }
                     }
                 }
+            }
 
-            // finally, increment the force, potential energy and virial for particle i
-            h_force.data[i].x += fxi;
-            h_force.data[i].y += fyi;
-            h_force.data[i].z += fzi;
-            h_torque.data[i].x += txi;
-            h_torque.data[i].y += tyi;
-            h_torque.data[i].z += tzi;
-            h_force.data[i].w += pei;
-            if (compute_virial)
-                {
-                h_virial.data[0 * m_virial_pitch + i] += virialxxi;
-                h_virial.data[1 * m_virial_pitch + i] += virialxyi;
-                h_virial.data[2 * m_virial_pitch + i] += virialxzi;
-                h_virial.data[3 * m_virial_pitch + i] += virialyyi;
-                h_virial.data[4 * m_virial_pitch + i] += virialyzi;
-                h_virial.data[5 * m_virial_pitch + i] += virialzzi;
-                }
+        // finally, increment the force, potential energy and virial for particle i
+        force[i].x += fxi;
+        force[i].y += fyi;
+        force[i].z += fzi;
+        torque[i].x += txi;
+        torque[i].y += tyi;
+        torque[i].z += tzi;
+        force[i].w += pei;
+        if constexpr (compute_virial)
+            {
+            virial[0 * m_virial_pitch + i] += virialxxi;
+            virial[1 * m_virial_pitch + i] += virialxyi;
+            virial[2 * m_virial_pitch + i] += virialxzi;
+            virial[3 * m_virial_pitch + i] += virialyyi;
+            virial[4 * m_virial_pitch + i] += virialyzi;
+            virial[5 * m_virial_pitch + i] += virialzzi;
             }
         }
     }
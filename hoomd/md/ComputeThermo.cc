@@ -13,6 +13,7 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -47,15 +48,23 @@ ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
 #endif
 
     m_computed_flags.reset();
+    m_kinetic_sums = nullptr;
 
 #ifdef ENABLE_MPI
     m_properties_reduced = true;
+    m_reduce_request = MPI_REQUEST_NULL;
 #endif
     }
 
 ComputeThermo::~ComputeThermo()
     {
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermo" << endl;
+
+#ifdef ENABLE_MPI
+    // the pending reduction writes into m_reduce_buffer
+    if (m_reduce_request != MPI_REQUEST_NULL)
+        MPI_Wait(&m_reduce_request, MPI_STATUS_IGNORE);
+#endif
     }
 
 /*! Calls computeProperties if the properties need updating
@@ -71,6 +80,16 @@ void ComputeThermo::compute(uint64_t timestep)
         }
     }
 
+/*! \param timestep Current time step of the simulation
+    \param kinetic Local kinetic sums over the group members
+*/
+void ComputeThermo::computeWithKineticSums(uint64_t timestep, const KineticSums& kinetic)
+    {
+    m_kinetic_sums = &kinetic;
+    compute(timestep);
+    m_kinetic_sums = nullptr;
+    }
+
 /*! Computes all thermodynamic properties of the system in one fell swoop.
  */
 void ComputeThermo::computeProperties()
@@ -84,163 +103,117 @@ void ComputeThermo::computeProperties()
     assert(m_pdata);
 
     // access the particle data
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
                                      access_location::host,
                                      access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
 
     // access the net force, pe, and virial
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
     const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
-
-    // total kinetic energy
-    double ke_trans_total = 0.0;
+    size_t virial_pitch = net_virial.getPitch();
 
     PDataFlags flags = m_pdata->getFlags();
+    const bool sum_kinetic = !m_kinetic_sums;
+    const bool sum_rotational = flags[pdata_flag::rotational_kinetic_energy];
+    const bool sum_virial = flags[pdata_flag::pressure_tensor];
 
-    double pressure_kinetic_xx = 0.0;
-    double pressure_kinetic_xy = 0.0;
-    double pressure_kinetic_xz = 0.0;
-    double pressure_kinetic_yy = 0.0;
-    double pressure_kinetic_yz = 0.0;
-    double pressure_kinetic_zz = 0.0;
+    KineticSums kinetic;
+    double ke_rot_total = 0.0;
+    double pe_total = 0.0;
+    double virial_xx = m_pdata->getExternalVirial(0);
+    double virial_xy = m_pdata->getExternalVirial(1);
+    double virial_xz = m_pdata->getExternalVirial(2);
+    double virial_yy = m_pdata->getExternalVirial(3);
+    double virial_yz = m_pdata->getExternalVirial(4);
+    double virial_zz = m_pdata->getExternalVirial(5);
 
-    if (flags[pdata_flag::pressure_tensor])
+    // accumulate every per-particle quantity in a single pass over the group
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
-        // Calculate kinetic part of pressure tensor
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        unsigned int j = h_index_array.data[group_idx];
+
+        // ignore rigid body constituent particles in the sum
+        if (h_body.data[j] < MIN_FLOPPY && h_body.data[j] != h_tag.data[j])
+            continue;
+
+        if (sum_kinetic)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                double mass = h_vel.data[j].w;
-                pressure_kinetic_xx += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].x);
-                pressure_kinetic_xy += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].y);
-                pressure_kinetic_xz += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].z);
-                pressure_kinetic_yy += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].y);
-                pressure_kinetic_yz += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].z);
-                pressure_kinetic_zz += mass * ((double)h_vel.data[j].z * (double)h_vel.data[j].z);
-                }
+            double mass = h_vel.data[j].w;
+            double vx = h_vel.data[j].x;
+            double vy = h_vel.data[j].y;
+            double vz = h_vel.data[j].z;
+            kinetic.xx += mass * (vx * vx);
+            kinetic.xy += mass * (vx * vy);
+            kinetic.xz += mass * (vx * vz);
+            kinetic.yy += mass * (vy * vy);
+            kinetic.yz += mass * (vy * vz);
+            kinetic.zz += mass * (vz * vz);
             }
-        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
-        ke_trans_total
-            = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
-        }
-    else
-        {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+
+        if (sum_rotational)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+            Scalar3 I = h_inertia.data[j];
+            quat<Scalar> q(h_orientation.data[j]);
+            quat<Scalar> p(h_angmom.data[j]);
+            quat<Scalar> s(Scalar(0.5) * conj(q) * p);
+
+            // only if the moment of inertia along one principal axis is non-zero, that axis
+            // carries angular momentum
+            if (I.x > 0)
                 {
-                ke_trans_total += (double)h_vel.data[j].w
-                                  * ((double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                     + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                     + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
+                ke_rot_total += s.v.x * s.v.x / I.x;
                 }
-            }
-
-        ke_trans_total *= Scalar(0.5);
-        }
-
-    // total rotational kinetic energy
-    double ke_rot_total = 0.0;
-
-    if (flags[pdata_flag::rotational_kinetic_energy])
-        {
-        // Calculate rotational part of kinetic energy
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::host,
-                                       access_mode::read);
-
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+            if (I.y > 0)
+                {
+                ke_rot_total += s.v.y * s.v.y / I.y;
+                }
+            if (I.z > 0)
                 {
-                Scalar3 I = h_inertia.data[j];
-                quat<Scalar> q(h_orientation.data[j]);
-                quat<Scalar> p(h_angmom.data[j]);
-                quat<Scalar> s(Scalar(0.5) * conj(q) * p);
-
-                // only if the moment of inertia along one principal axis is non-zero, that axis
-                // carries angular momentum
-                if (I.x > 0)
-                    {
-                    ke_rot_total += s.v.x * s.v.x / I.x;
-                    }
-                if (I.y > 0)
-                    {
-                    ke_rot_total += s.v.y * s.v.y / I.y;
-                    }
-                if (I.z > 0)
-                    {
-                    ke_rot_total += s.v.z * s.v.z / I.z;
-                    }
+                ke_rot_total += s.v.z * s.v.z / I.z;
                 }
             }
 
-        ke_rot_total /= Scalar(2.0);
-        }
-
-    // total potential energy
-    double pe_total = 0.0;
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int j = m_group->getMemberIndex(group_idx);
+        pe_total += (double)h_net_force.data[j].w;
 
-        // ignore rigid body constituent particles in the sum
-        if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+        if (sum_virial)
             {
-            pe_total += (double)h_net_force.data[j].w;
+            virial_xx += (double)h_net_virial.data[j + 0 * virial_pitch];
+            virial_xy += (double)h_net_virial.data[j + 1 * virial_pitch];
+            virial_xz += (double)h_net_virial.data[j + 2 * virial_pitch];
+            virial_yy += (double)h_net_virial.data[j + 3 * virial_pitch];
+            virial_yz += (double)h_net_virial.data[j + 4 * virial_pitch];
+            virial_zz += (double)h_net_virial.data[j + 5 * virial_pitch];
             }
         }
 
+    if (!sum_kinetic)
+        kinetic = *m_kinetic_sums;
+
+    // kinetic energy = 1/2 trace of kinetic part of pressure tensor
+    double ke_trans_total = Scalar(0.5) * (kinetic.xx + kinetic.yy + kinetic.zz);
+    ke_rot_total /= Scalar(2.0);
     pe_total += m_pdata->getExternalEnergy();
 
+    // isotropic virial = 1/3 trace of virial tensor
     double W = 0.0;
-    double virial_xx = m_pdata->getExternalVirial(0);
-    double virial_xy = m_pdata->getExternalVirial(1);
-    double virial_xz = m_pdata->getExternalVirial(2);
-    double virial_yy = m_pdata->getExternalVirial(3);
-    double virial_yz = m_pdata->getExternalVirial(4);
-    double virial_zz = m_pdata->getExternalVirial(5);
-
-    if (flags[pdata_flag::pressure_tensor])
-        {
-        // Calculate upper triangular virial tensor
-        size_t virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                virial_xx += (double)h_net_virial.data[j + 0 * virial_pitch];
-                virial_xy += (double)h_net_virial.data[j + 1 * virial_pitch];
-                virial_xz += (double)h_net_virial.data[j + 2 * virial_pitch];
-                virial_yy += (double)h_net_virial.data[j + 3 * virial_pitch];
-                virial_yz += (double)h_net_virial.data[j + 4 * virial_pitch];
-                virial_zz += (double)h_net_virial.data[j + 5 * virial_pitch];
-                }
-            }
-
-        // isotropic virial = 1/3 trace of virial tensor
+    if (sum_virial)
         W = Scalar(1. / 3.) * (virial_xx + virial_yy + virial_zz);
-        }
 
     // compute the pressure
     // volume/area & other 2D stuff needed
@@ -265,40 +238,89 @@ void ComputeThermo::computeProperties()
     Scalar pressure = (2.0 * ke_trans_total / Scalar(D) + W) / volume;
 
     // pressure tensor = (kinetic part + virial) / V
-    Scalar pressure_xx = (pressure_kinetic_xx + virial_xx) / volume;
-    Scalar pressure_xy = (pressure_kinetic_xy + virial_xy) / volume;
-    Scalar pressure_xz = (pressure_kinetic_xz + virial_xz) / volume;
-    Scalar pressure_yy = (pressure_kinetic_yy + virial_yy) / volume;
-    Scalar pressure_yz = (pressure_kinetic_yz + virial_yz) / volume;
-    Scalar pressure_zz = (pressure_kinetic_zz + virial_zz) / volume;
-
-    // fill out the GlobalArray
-    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
-    h_properties.data[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
-    h_properties.data[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
-    h_properties.data[thermo_index::potential_energy] = Scalar(pe_total);
-    h_properties.data[thermo_index::pressure] = pressure;
-    h_properties.data[thermo_index::pressure_xx] = pressure_xx;
-    h_properties.data[thermo_index::pressure_xy] = pressure_xy;
-    h_properties.data[thermo_index::pressure_xz] = pressure_xz;
-    h_properties.data[thermo_index::pressure_yy] = pressure_yy;
-    h_properties.data[thermo_index::pressure_yz] = pressure_yz;
-    h_properties.data[thermo_index::pressure_zz] = pressure_zz;
+    Scalar pressure_xx = (kinetic.xx + virial_xx) / volume;
+    Scalar pressure_xy = (kinetic.xy + virial_xy) / volume;
+    Scalar pressure_xz = (kinetic.xz + virial_xz) / volume;
+    Scalar pressure_yy = (kinetic.yy + virial_yy) / volume;
+    Scalar pressure_yz = (kinetic.yz + virial_yz) / volume;
+    Scalar pressure_zz = (kinetic.zz + virial_zz) / volume;
+
+        {
+        // fill out the GlobalArray
+        ArrayHandle<Scalar> h_properties(m_properties,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        h_properties.data[thermo_index::translational_kinetic_energy] = Scalar(ke_trans_total);
+        h_properties.data[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
+        h_properties.data[thermo_index::potential_energy] = Scalar(pe_total);
+        h_properties.data[thermo_index::pressure] = pressure;
+        h_properties.data[thermo_index::pressure_xx] = pressure_xx;
+        h_properties.data[thermo_index::pressure_xy] = pressure_xy;
+        h_properties.data[thermo_index::pressure_xz] = pressure_xz;
+        h_properties.data[thermo_index::pressure_yy] = pressure_yy;
+        h_properties.data[thermo_index::pressure_yz] = pressure_yz;
+        h_properties.data[thermo_index::pressure_zz] = pressure_zz;
+        }
 
 #ifdef ENABLE_MPI
-    // in MPI, reduce extensive quantities only when they're needed
+    // in MPI, start reducing the extensive quantities now and wait only when they're needed
     m_properties_reduced = !m_pdata->getDomainDecomposition();
+    if (!m_properties_reduced)
+        beginReduceProperties();
 #endif // ENABLE_MPI
     }
 
 #ifdef ENABLE_MPI
+/*! Posts a non-blocking sum of the local properties. reduceProperties() completes it. Without
+    MPI-3 non-blocking collectives, this does nothing and reduceProperties() reduces in place.
+*/
+void ComputeThermo::beginReduceProperties()
+    {
+#if MPI_VERSION >= 3
+    // a new computation supersedes a reduction that nobody waited on
+    if (m_reduce_request != MPI_REQUEST_NULL)
+        MPI_Wait(&m_reduce_request, MPI_STATUS_IGNORE);
+
+        {
+        ArrayHandle<Scalar> h_properties(m_properties,
+                                         access_location::host,
+                                         access_mode::read);
+        std::copy(h_properties.data,
+                  h_properties.data + thermo_index::num_quantities,
+                  m_reduce_buffer);
+        }
+
+    MPI_Iallreduce(MPI_IN_PLACE,
+                   m_reduce_buffer,
+                   thermo_index::num_quantities,
+                   MPI_HOOMD_SCALAR,
+                   MPI_SUM,
+                   m_exec_conf->getMPICommunicator(),
+                   &m_reduce_request);
+#endif
+    }
+
 void ComputeThermo::reduceProperties()
     {
     if (m_properties_reduced)
         return;
 
-    // reduce properties
     ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
+
+#if MPI_VERSION >= 3
+    if (m_reduce_request != MPI_REQUEST_NULL)
+        {
+        // complete the reduction posted by computeProperties()
+        MPI_Wait(&m_reduce_request, MPI_STATUS_IGNORE);
+        std::copy(m_reduce_buffer,
+                  m_reduce_buffer + thermo_index::num_quantities,
+                  h_properties.data);
+        m_properties_reduced = true;
+        return;
+        }
+#endif
+
+    // reduce properties
     MPI_Allreduce(MPI_IN_PLACE,
                   h_properties.data,
                   thermo_index::num_quantities,
@@ -6,6 +6,10 @@
 #include "hoomd/GlobalArray.h"
 #include "hoomd/ParticleGroup.h"
 
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
 #include <limits>
 #include <memory>
 
@@ -34,6 +38,17 @@ namespace md
    Certain properties, like ndof and num_particles are always known and there is no need for them to
    be accessible via the GlobalArray.
 
+    All per-particle sums are taken in a single pass over the group members. An integration method
+   that has just written the velocities may hand in the kinetic tensor it summed along the way with
+   computeWithKineticSums() so that the velocities are not read a second time.
+
+    With domain decomposition, computeProperties() posts a non-blocking reduction of the extensive
+   quantities as soon as the local sums are known. The first accessor that needs a reduced value
+   waits on it, so the communication overlaps with whatever the caller does in between. Callers
+   that read a value right after compute() gain nothing: TwoStepConstantPressure overlaps the
+   reduction only with the angular momentum update of anisotropic systems, and waits immediately
+   for isotropic ones.
+
     Computed quantities available in the GlobalArray:
      - temperature of the group from translational degrees of freedom
      - temperature of the group from rotational degrees of freedom
@@ -62,9 +77,36 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     //! Destructor
     virtual ~ComputeThermo();
 
+    //! Per-rank kinetic part of the pressure tensor, sum of m v_a v_b over the group
+    struct KineticSums
+        {
+        double xx = 0.0; //!< xx component
+        double xy = 0.0; //!< xy component
+        double xz = 0.0; //!< xz component
+        double yy = 0.0; //!< yy component
+        double yz = 0.0; //!< yz component
+        double zz = 0.0; //!< zz component
+        };
+
     //! Compute the temperature
     virtual void compute(uint64_t timestep);
 
+    //! Compute the properties using a kinetic tensor already summed by the caller
+    /*! \param timestep Current time step of the simulation
+        \param kinetic Local kinetic sums over exactly the members of this compute's group,
+               excluding rigid body constituents, taken from the current velocities
+
+        Implementations that compute on the GPU ignore \a kinetic and sum the velocities
+        themselves.
+    */
+    void computeWithKineticSums(uint64_t timestep, const KineticSums& kinetic);
+
+    //! Get the group the properties are computed over
+    std::shared_ptr<ParticleGroup> getGroup()
+        {
+        return m_group;
+        }
+
     //! Returns the overall temperature last computed by compute()
     /*! \returns Instantaneous overall temperature of the system
      */
@@ -336,12 +378,21 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     /// Store the particle data flags used during the last computation
     PDataFlags m_computed_flags;
 
+    /// Kinetic sums supplied by computeWithKineticSums(), valid only during that call
+    const KineticSums* m_kinetic_sums;
+
     //! Does the actual computation
     virtual void computeProperties();
 
 #ifdef ENABLE_MPI
     bool m_properties_reduced; //!< True if properties have been reduced across MPI
 
+    MPI_Request m_reduce_request; //!< Pending reduction of m_reduce_buffer
+    Scalar m_reduce_buffer[thermo_index::num_quantities]; //!< Properties being reduced
+
+    //! Start reducing the local properties over MPI without waiting for the result
+    void beginReduceProperties();
+
     //! Reduce properties over MPI
     virtual void reduceProperties();
 #endif
@@ -5,6 +5,7 @@
 #define __PAIR_EVALUATOR_GAUSS_H__
 
 #ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
 #include <string>
 #endif
 
@@ -103,7 +104,7 @@ class EvaluatorPairGauss
         }
 
     //! Gauss doesn't use charge
-    DEVICE static bool needsCharge()
+    DEVICE static constexpr bool needsCharge()
         {
         return false;
         }
@@ -154,6 +155,46 @@ class EvaluatorPairGauss
         return 0;
         }
 
+#ifndef __HIPCC__
+    /*! Evaluate the force and energy of a batch of pairs.
+        See PairEvaluatorBatch.h for the definition of the arguments.
+    */
+    static void evalForceAndEnergyN(unsigned int n,
+                                    const Scalar* rsq,
+                                    const Scalar* rcutsq,
+                                    const param_type* const* params,
+                                    const bool* energy_shift,
+                                    Scalar* force_divr,
+                                    Scalar* pair_eng,
+                                    bool* evaluated)
+        {
+        constexpr unsigned int W = detail::pair_batch_width;
+        Scalar epsilon[W];
+        Scalar sigma_sq[W];
+        Scalar shift[W];
+        for (unsigned int l = 0; l < W; l++)
+            {
+            epsilon[l] = params[l]->epsilon;
+            sigma_sq[l] = params[l]->sigma * params[l]->sigma;
+            shift[l] = energy_shift[l] ? Scalar(1.0) : Scalar(0.0);
+            }
+
+        for (unsigned int l = 0; l < W; l++)
+            {
+            Scalar exp_val = fast::exp(-Scalar(1.0) / Scalar(2.0) * rsq[l] / sigma_sq[l]);
+            Scalar exp_cut = fast::exp(-Scalar(1.0) / Scalar(2.0) * rcutsq[l] / sigma_sq[l]);
+
+            Scalar f = epsilon[l] / sigma_sq[l] * exp_val;
+            Scalar e = epsilon[l] * exp_val - shift[l] * epsilon[l] * exp_cut;
+
+            bool inside = rsq[l] < rcutsq[l];
+            force_divr[l] = inside ? f : Scalar(0.0);
+            pair_eng[l] = inside ? e : Scalar(0.0);
+            evaluated[l] = inside;
+            }
+        }
+#endif
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
@@ -5,6 +5,7 @@
 #define __PAIR_EVALUATOR_LJ_H__
 
 #ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
 #include <string>
 #endif
 
@@ -175,7 +176,7 @@ class EvaluatorPairLJ
         }
 
     //! LJ doesn't use charge
-    DEVICE static bool needsCharge()
+    DEVICE static constexpr bool needsCharge()
         {
         return false;
         }
@@ -256,6 +257,49 @@ class EvaluatorPairLJ
         return lj1 / Scalar(9.0) * rcut9inv - lj2 / Scalar(3.0) * rcut3inv;
         }
 
+#ifndef __HIPCC__
+    /*! Evaluate the force and energy of a batch of pairs.
+        See PairEvaluatorBatch.h for the definition of the arguments.
+    */
+    static void evalForceAndEnergyN(unsigned int n,
+                                    const Scalar* rsq,
+                                    const Scalar* rcutsq,
+                                    const param_type* const* params,
+                                    const bool* energy_shift,
+                                    Scalar* force_divr,
+                                    Scalar* pair_eng,
+                                    bool* evaluated)
+        {
+        constexpr unsigned int W = detail::pair_batch_width;
+        Scalar lj1[W];
+        Scalar lj2[W];
+        Scalar shift[W];
+        for (unsigned int l = 0; l < W; l++)
+            {
+            lj1[l] = params[l]->epsilon_x_4 * params[l]->sigma_6 * params[l]->sigma_6;
+            lj2[l] = params[l]->epsilon_x_4 * params[l]->sigma_6;
+            shift[l] = energy_shift[l] ? Scalar(1.0) : Scalar(0.0);
+            }
+
+        for (unsigned int l = 0; l < W; l++)
+            {
+            Scalar r2inv = Scalar(1.0) / rsq[l];
+            Scalar r6inv = r2inv * r2inv * r2inv;
+            Scalar rcut2inv = Scalar(1.0) / rcutsq[l];
+            Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+
+            Scalar f = r2inv * r6inv * (Scalar(12.0) * lj1[l] * r6inv - Scalar(6.0) * lj2[l]);
+            Scalar e = r6inv * (lj1[l] * r6inv - lj2[l])
+                       - shift[l] * rcut6inv * (lj1[l] * rcut6inv - lj2[l]);
+
+            bool inside = rsq[l] < rcutsq[l] && lj1[l] != Scalar(0.0);
+            force_divr[l] = inside ? f : Scalar(0.0);
+            pair_eng[l] = inside ? e : Scalar(0.0);
+            evaluated[l] = inside;
+            }
+        }
+#endif
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
@@ -14,6 +14,7 @@
 #endif
 
 #ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #endif
@@ -129,7 +130,7 @@ class EvaluatorPairTable
         }
 
     //! Table doesn't use charge
-    DEVICE static bool needsCharge()
+    DEVICE static constexpr bool needsCharge()
         {
         return false;
         }
@@ -203,6 +204,67 @@ class EvaluatorPairTable
         return 0;
         }
 
+#ifndef __HIPCC__
+    /*! Evaluate the force and energy of a batch of pairs.
+        See PairEvaluatorBatch.h for the definition of the arguments. Table potentials do not
+        support energy shifting, so \a energy_shift is ignored.
+    */
+    static void evalForceAndEnergyN(unsigned int n,
+                                    const Scalar* rsq,
+                                    const Scalar* rcutsq,
+                                    const param_type* const* params,
+                                    const bool* energy_shift,
+                                    Scalar* force_divr,
+                                    Scalar* pair_eng,
+                                    bool* evaluated)
+        {
+        constexpr unsigned int W = detail::pair_batch_width;
+        Scalar r[W];
+        Scalar value_f[W];
+        bool inside[W];
+        for (unsigned int l = 0; l < W; l++)
+            {
+            const param_type& param = *params[l];
+            const Scalar width = static_cast<Scalar>(param.V_table.size());
+            const Scalar rcut = fast::sqrt(rcutsq[l]);
+            const Scalar delta_r = (rcut - param.rmin) / width;
+            r[l] = fast::sqrt(rsq[l]);
+            inside[l] = rsq[l] < rcutsq[l] && r[l] >= param.rmin;
+            // outside lanes look up the start of the table so that the gather stays in bounds
+            value_f[l] = inside[l] ? (r[l] - param.rmin) / delta_r : Scalar(0.0);
+            }
+
+        // gather the bracketing table entries
+        Scalar V0[W];
+        Scalar V1[W];
+        Scalar F0[W];
+        Scalar F1[W];
+        Scalar frac[W];
+        for (unsigned int l = 0; l < W; l++)
+            {
+            const param_type& param = *params[l];
+            const unsigned int width = param.V_table.size();
+            const unsigned int value_i = static_cast<unsigned int>(slow::floor(value_f[l]));
+            frac[l] = value_f[l] - Scalar(value_i);
+            V0[l] = value_i < width ? param.V_table[value_i] : Scalar(0.0);
+            F0[l] = value_i < width ? param.F_table[value_i] : Scalar(0.0);
+            V1[l] = value_i + 1 < width ? param.V_table[value_i + 1] : Scalar(0.0);
+            F1[l] = value_i + 1 < width ? param.F_table[value_i + 1] : Scalar(0.0);
+            }
+
+        // interpolate
+        for (unsigned int l = 0; l < W; l++)
+            {
+            const Scalar V = V0[l] + frac[l] * (V1[l] - V0[l]);
+            const Scalar F = F0[l] + frac[l] * (F1[l] - F0[l]);
+
+            force_divr[l] = (inside[l] && rsq[l] > Scalar(0.0)) ? F / r[l] : Scalar(0.0);
+            pair_eng[l] = inside[l] ? V : Scalar(0.0);
+            evaluated[l] = inside[l];
+            }
+        }
+#endif
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
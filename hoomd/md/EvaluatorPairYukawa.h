@@ -5,6 +5,7 @@
 #define __PAIR_EVALUATOR_YUKAWA_H__
 
 #ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
 #include <string>
 #endif
 
@@ -106,7 +107,7 @@ class EvaluatorPairYukawa
         }
 
     //! Yukawa doesn't use charge
-    DEVICE static bool needsCharge()
+    DEVICE static constexpr bool needsCharge()
         {
         return false;
         }
@@ -161,6 +162,52 @@ class EvaluatorPairYukawa
         return 0;
         }
 
+#ifndef __HIPCC__
+    /*! Evaluate the force and energy of a batch of pairs.
+        See PairEvaluatorBatch.h for the definition of the arguments.
+    */
+    static void evalForceAndEnergyN(unsigned int n,
+                                    const Scalar* rsq,
+                                    const Scalar* rcutsq,
+                                    const param_type* const* params,
+                                    const bool* energy_shift,
+                                    Scalar* force_divr,
+                                    Scalar* pair_eng,
+                                    bool* evaluated)
+        {
+        constexpr unsigned int W = detail::pair_batch_width;
+        Scalar epsilon[W];
+        Scalar kappa[W];
+        Scalar shift[W];
+        for (unsigned int l = 0; l < W; l++)
+            {
+            epsilon[l] = params[l]->epsilon;
+            kappa[l] = params[l]->kappa;
+            shift[l] = energy_shift[l] ? Scalar(1.0) : Scalar(0.0);
+            }
+
+        for (unsigned int l = 0; l < W; l++)
+            {
+            Scalar rinv = fast::rsqrt(rsq[l]);
+            Scalar r = Scalar(1.0) / rinv;
+            Scalar r2inv = Scalar(1.0) / rsq[l];
+            Scalar exp_val = fast::exp(-kappa[l] * r);
+
+            Scalar rcutinv = fast::rsqrt(rcutsq[l]);
+            Scalar rcut = Scalar(1.0) / rcutinv;
+            Scalar exp_cut = fast::exp(-kappa[l] * rcut);
+
+            Scalar f = epsilon[l] * exp_val * r2inv * (rinv + kappa[l]);
+            Scalar e = epsilon[l] * exp_val * rinv - shift[l] * epsilon[l] * exp_cut * rcutinv;
+
+            bool inside = rsq[l] < rcutsq[l] && epsilon[l] != Scalar(0.0);
+            force_divr[l] = inside ? f : Scalar(0.0);
+            pair_eng[l] = inside ? e : Scalar(0.0);
+            evaluated[l] = inside;
+            }
+        }
+#endif
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
@@ -3,7 +3,14 @@
 
 #include "ForceDistanceConstraint.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace Eigen;
 
 /*! \file ForceDistanceConstraint.cc
@@ -20,7 +27,8 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
     : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()), m_cmatrix(m_exec_conf),
       m_cvec(m_exec_conf), m_lagrange(m_exec_conf), m_rel_tol(1e-3),
       m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_sparse_idxlookup(m_exec_conf),
-      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
+      m_iterative(false), m_solver_tol(1e-10), m_constraint_reorder(true),
+      m_constraints_added_removed(true), m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -70,6 +78,46 @@ ForceDistanceConstraint::~ForceDistanceConstraint()
 #endif
     }
 
+/*! \param solver Name of the solver: "direct" for sparse LU or "iterative" for BiCGSTAB
+ */
+void ForceDistanceConstraint::setSolver(const std::string& solver)
+    {
+    if (solver == "direct")
+        m_iterative = false;
+    else if (solver == "iterative")
+        m_iterative = true;
+    else
+        throw std::invalid_argument("Unknown constraint solver: " + solver);
+
+    // analyze the pattern again for the newly selected solver
+    m_condition.resetFlags(1);
+    }
+
+template<class Kernel>
+void ForceDistanceConstraint::forEachConstraint(unsigned int n, const Kernel& kernel)
+    {
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1 && n > 0)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          kernel(i);
+                                  });
+            });
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < n; ++i)
+            kernel(i);
+        }
+    }
+
 Scalar ForceDistanceConstraint::getNDOFRemoved(std::shared_ptr<ParticleGroup> query)
     {
     // the distance constraint removes half a degree of freedom for each particle that is part
@@ -118,7 +166,6 @@ void ForceDistanceConstraint::computeForces(uint64_t timestep)
 
     // reallocate through amortized resizin
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint * n_constraint);
     m_cvec.resize(n_constraint);
 
     // populate the terms in the matrix vector equation
@@ -134,29 +181,87 @@ void ForceDistanceConstraint::computeForces(uint64_t timestep)
     computeConstraintForces(timestep);
     }
 
-void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
+/*! \param max_local Number of local and ghost particles
+
+    Two constraints are coupled when they share a particle. Row n of the constraint matrix holds an
+    entry for every constraint coupled to n (including n itself), and m_coupled_entry stores the
+    position of each entry in the compressed column-major storage of m_sparse.
+*/
+void ForceDistanceConstraint::buildSparsityPattern(unsigned int max_local)
     {
-    // fill the matrix in column-major order
-    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+    unsigned int n_constraint = (unsigned int)m_constraint_idx.size();
 
-    if (m_constraint_reorder)
+    // list the constraints of each particle
+    std::vector<unsigned int> particle_offset(max_local + 1, 0);
+    for (unsigned int n = 0; n < n_constraint; ++n)
         {
-        // reset flag
-        m_constraint_reorder = false;
+        particle_offset[m_constraint_idx[n].x + 1]++;
+        particle_offset[m_constraint_idx[n].y + 1]++;
+        }
+    for (unsigned int i = 0; i < max_local; ++i)
+        particle_offset[i + 1] += particle_offset[i];
+
+    std::vector<unsigned int> particle_constraint(2 * n_constraint);
+        {
+        std::vector<unsigned int> fill(particle_offset.begin(), particle_offset.end() - 1);
+        for (unsigned int n = 0; n < n_constraint; ++n)
+            {
+            particle_constraint[fill[m_constraint_idx[n].x]++] = n;
+            particle_constraint[fill[m_constraint_idx[n].y]++] = n;
+            }
+        }
 
-        // resize lookup matrix
-        m_sparse_idxlookup.resize(n_constraint * n_constraint);
+    // couple each constraint to the constraints of its two particles
+    m_constraint_offset.resize(n_constraint + 1);
+    m_coupled_constraint.clear();
+    m_constraint_offset[0] = 0;
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        unsigned int row_begin = (unsigned int)m_coupled_constraint.size();
+        for (unsigned int idx : {m_constraint_idx[n].x, m_constraint_idx[n].y})
+            {
+            m_coupled_constraint.insert(m_coupled_constraint.end(),
+                                        particle_constraint.begin() + particle_offset[idx],
+                                        particle_constraint.begin() + particle_offset[idx + 1]);
+            }
+        std::sort(m_coupled_constraint.begin() + row_begin, m_coupled_constraint.end());
+        m_coupled_constraint.erase(
+            std::unique(m_coupled_constraint.begin() + row_begin, m_coupled_constraint.end()),
+            m_coupled_constraint.end());
+        m_constraint_offset[n + 1] = (unsigned int)m_coupled_constraint.size();
+        }
+
+    // store every coupling explicitly, the values are filled in each step
+    std::vector<Triplet<double>> triplets;
+    triplets.reserve(m_coupled_constraint.size());
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        for (unsigned int j = m_constraint_offset[n]; j < m_constraint_offset[n + 1]; ++j)
+            triplets.push_back(Triplet<double>(n, m_coupled_constraint[j], 0.0));
+        }
 
-        ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup,
-                                            access_location::host,
-                                            access_mode::overwrite);
+    m_sparse.resize(n_constraint, n_constraint);
+    m_sparse.setFromTriplets(triplets.begin(), triplets.end());
+    m_sparse.makeCompressed();
 
-        // reset lookup matrix values to -1
-        for (unsigned int i = 0; i < n_constraint * n_constraint; ++i)
+    // locate each coupling in the compressed storage (row indices are sorted within a column)
+    const int* outer = m_sparse.outerIndexPtr();
+    const int* inner = m_sparse.innerIndexPtr();
+    m_coupled_entry.resize(m_coupled_constraint.size());
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        {
+        for (unsigned int j = m_constraint_offset[n]; j < m_constraint_offset[n + 1]; ++j)
             {
-            h_sparse_idxlookup.data[i] = -1;
+            unsigned int m = m_coupled_constraint[j];
+            const int* entry = std::lower_bound(inner + outer[m], inner + outer[m + 1], int(n));
+            m_coupled_entry[j] = int(entry - inner);
             }
         }
+    }
+
+void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
+    {
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
     // access particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -166,25 +271,20 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
                                     access_location::host,
                                     access_mode::read);
 
-    // access matrix elements
-    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::overwrite);
+    // access the right hand side
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
 
-    // clear matrix
-    memset(h_cmatrix.data, 0, sizeof(double) * m_cmatrix.size());
-
     const BoxDim& box = m_pdata->getBox();
 
+    // transform the constraint members into indices into the particle data arrays
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    m_constraint_idx.resize(n_constraint);
     for (unsigned int n = 0; n < n_constraint; ++n)
         {
-        // lookup the tag of each of the particles participating in the constraint
         const ConstraintData::members_t constraint = m_cdata->getMembersByIndex(n);
         assert(constraint.tag[0] <= m_pdata->getMaximumTag());
         assert(constraint.tag[1] <= m_pdata->getMaximumTag());
 
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
         unsigned int idx_a = h_rtag.data[constraint.tag[0]];
         unsigned int idx_b = h_rtag.data[constraint.tag[1]];
 
@@ -197,103 +297,95 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
             throw std::runtime_error("Error in constraint calculation");
             }
 
-        vec3<Scalar> ra(h_pos.data[idx_a]);
-        vec3<Scalar> rb(h_pos.data[idx_b]);
-        vec3<Scalar> rn(ra - rb);
-
-        // apply minimum image
-        rn = box.minImage(rn);
+        m_constraint_idx[n] = make_uint2(idx_a, idx_b);
+        }
 
-        vec3<Scalar> va(h_vel.data[idx_a]);
-        Scalar ma(h_vel.data[idx_a].w);
-        vec3<Scalar> vb(h_vel.data[idx_b]);
-        Scalar mb(h_vel.data[idx_b].w);
+    // the sparsity pattern only changes when the constraints change
+    if (m_constraint_reorder || m_constraint_offset.size() != n_constraint + 1)
+        {
+        // reset flag
+        m_constraint_reorder = false;
 
-        vec3<Scalar> rndot(va - vb);
-        vec3<Scalar> qn(rn + rndot * m_deltaT);
+        buildSparsityPattern(max_local);
+        m_condition.resetFlags(1);
+        }
 
-        // fill matrix row
-        for (unsigned int m = 0; m < n_constraint; ++m)
-            {
-            // lookup the tag of each of the particles participating in the constraint
-            const ConstraintData::members_t constraint_m = m_cdata->getMembersByIndex(m);
-            assert(constraint_m.tag[0] <= m_pdata->getMaximumTag());
-            assert(constraint_m.tag[1] <= m_pdata->getMaximumTag());
-
-            // transform a and b into indices into the particle data arrays
-            // (MEM TRANSFER: 4 integers)
-            unsigned int idx_m_a = h_rtag.data[constraint_m.tag[0]];
-            unsigned int idx_m_b = h_rtag.data[constraint_m.tag[1]];
-            assert(idx_m_a <= m_pdata->getN() + m_pdata->getNGhosts());
-            assert(idx_m_b <= m_pdata->getN() + m_pdata->getNGhosts());
-
-            if (idx_m_a >= max_local || idx_m_b >= max_local)
-                {
-                this->m_exec_conf->msg->error()
-                    << "constrain.distance(): constraint " << constraint_m.tag[0] << " "
-                    << constraint_m.tag[1] << " incomplete." << std::endl
-                    << std::endl;
-                throw std::runtime_error("Error in constraint calculation");
-                }
+    // apply minimum image to the separation of each constraint
+    m_constraint_rn.resize(n_constraint);
+    forEachConstraint(n_constraint,
+                      [&](unsigned int n)
+                      {
+                          vec3<Scalar> ra(h_pos.data[m_constraint_idx[n].x]);
+                          vec3<Scalar> rb(h_pos.data[m_constraint_idx[n].y]);
+                          m_constraint_rn[n] = box.minImage(ra - rb);
+                      });
+
+    // fill the matrix rows, each row only writes its own entries
+    double* sparse_val = m_sparse.valuePtr();
+    std::atomic<unsigned int> constraint_violated(0);
+    forEachConstraint(
+        n_constraint,
+        [&](unsigned int n)
+        {
+            unsigned int idx_a = m_constraint_idx[n].x;
+            unsigned int idx_b = m_constraint_idx[n].y;
+            vec3<Scalar> rn = m_constraint_rn[n];
 
-            vec3<Scalar> rm_a(h_pos.data[idx_m_a]);
-            vec3<Scalar> rm_b(h_pos.data[idx_m_b]);
-            vec3<Scalar> rm(rm_a - rm_b);
+            vec3<Scalar> va(h_vel.data[idx_a]);
+            Scalar ma(h_vel.data[idx_a].w);
+            vec3<Scalar> vb(h_vel.data[idx_b]);
+            Scalar mb(h_vel.data[idx_b].w);
 
-            // apply minimum image
-            rm = box.minImage(rm);
+            vec3<Scalar> rndot(va - vb);
+            vec3<Scalar> qn(rn + rndot * m_deltaT);
 
-            double delta(0.0);
-            if (idx_m_a == idx_a)
-                {
-                delta += double(4.0) * dot(qn, rm) / ma;
-                }
-            if (idx_m_b == idx_a)
-                {
-                delta -= double(4.0) * dot(qn, rm) / ma;
-                }
-            if (idx_m_a == idx_b)
+            for (unsigned int j = m_constraint_offset[n]; j < m_constraint_offset[n + 1]; ++j)
                 {
-                delta -= double(4.0) * dot(qn, rm) / mb;
-                }
-            if (idx_m_b == idx_b)
-                {
-                delta += double(4.0) * dot(qn, rm) / mb;
-                }
+                unsigned int m = m_coupled_constraint[j];
+                unsigned int idx_m_a = m_constraint_idx[m].x;
+                unsigned int idx_m_b = m_constraint_idx[m].y;
+                vec3<Scalar> rm = m_constraint_rn[m];
 
-            h_cmatrix.data[m * n_constraint + n] += delta;
-
-            // update sparse matrix
-            int k = m_sparse_idxlookup[m * n_constraint + n];
+                double delta(0.0);
+                if (idx_m_a == idx_a)
+                    {
+                    delta += double(4.0) * dot(qn, rm) / ma;
+                    }
+                if (idx_m_b == idx_a)
+                    {
+                    delta -= double(4.0) * dot(qn, rm) / ma;
+                    }
+                if (idx_m_a == idx_b)
+                    {
+                    delta -= double(4.0) * dot(qn, rm) / mb;
+                    }
+                if (idx_m_b == idx_b)
+                    {
+                    delta += double(4.0) * dot(qn, rm) / mb;
+                    }
 
-            if ((k == -1 && delta != double(0.0)) || (k != -1 && delta == double(0.0)))
-                {
-                m_condition.resetFlags(1);
+                sparse_val[m_coupled_entry[j]] = delta;
                 }
 
-            if (k != -1)
+            // get constraint distance
+            Scalar d = m_cdata->getValueByIndex(n);
+
+            // check distance violation
+            if (fast::sqrt(dot(rn, rn)) - d >= m_rel_tol * d || std::isnan(dot(rn, rn)))
                 {
-                // update sparse matrix value directly
-                m_sparse.valuePtr()[k] = delta;
+                constraint_violated = n + 1;
                 }
-            }
 
-        // get constraint distance
-        Scalar d = m_cdata->getValueByIndex(n);
+            // fill vector component
+            h_cvec.data[n] = (dot(qn, qn) - d * d) / m_deltaT / m_deltaT;
+            h_cvec.data[n] += double(2.0)
+                              * dot(qn,
+                                    vec3<Scalar>(h_netforce.data[idx_a]) / ma
+                                        - vec3<Scalar>(h_netforce.data[idx_b]) / mb);
+        });
 
-        // check distance violation
-        if (fast::sqrt(dot(rn, rn)) - d >= m_rel_tol * d || std::isnan(dot(rn, rn)))
-            {
-            m_constraint_violated.resetFlags(n + 1);
-            }
-
-        // fill vector component
-        h_cvec.data[n] = (dot(qn, qn) - d * d) / m_deltaT / m_deltaT;
-        h_cvec.data[n] += double(2.0)
-                          * dot(qn,
-                                vec3<Scalar>(h_netforce.data[idx_a]) / ma
-                                    - vec3<Scalar>(h_netforce.data[idx_b]) / mb);
-        }
+    if (constraint_violated)
+        m_constraint_violated.resetFlags(constraint_violated);
     }
 
 void ForceDistanceConstraint::checkConstraints(uint64_t timestep)
@@ -331,12 +423,6 @@ void ForceDistanceConstraint::checkConstraints(uint64_t timestep)
 
 void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
     {
-    // use Eigen dense matrix algebra (slow for large matrices)
-    typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
-    typedef Matrix<double, Dynamic, 1> vec_t;
-    typedef Map<matrix_t> matrix_map_t;
-    typedef Map<vec_t> vec_map_t;
-
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
     // skip if zero constraints
@@ -346,72 +432,85 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
     // reallocate array of constraint forces
     m_lagrange.resize(n_constraint);
 
-    unsigned int sparsity_pattern_changed = m_condition.readFlags();
-
+    bool sparsity_pattern_changed = m_condition.readFlags();
     if (sparsity_pattern_changed)
         {
-        m_exec_conf->msg->notice(6)
-            << "ForceDistanceConstraint: sparsity pattern changed. Solving on CPU" << std::endl;
+        m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: sparsity pattern changed"
+                                    << std::endl;
 
         // reset flags
         m_condition.resetFlags(0);
+        }
 
-        // access matrix
-        ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::read);
+    solveSparseSystem(sparsity_pattern_changed);
+    }
 
-        // wrap array
-        matrix_map_t map_matrix(h_cmatrix.data, n_constraint, n_constraint);
+/*! Used by the GPU implementation, which fills the dense matrix m_cmatrix.
+ */
+void ForceDistanceConstraint::convertDenseMatrix()
+    {
+    // use Eigen dense matrix algebra (slow for large matrices)
+    typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
+    typedef Map<matrix_t> matrix_map_t;
 
-        // sparsity pattern changed
-        m_sparse = map_matrix.sparseView();
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
-            {
-            ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup,
-                                                access_location::host,
-                                                access_mode::overwrite);
+    // access matrix
+    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::read);
 
-            // reset lookup matrix values to -1
-            for (unsigned int i = 0; i < n_constraint * n_constraint; ++i)
-                {
-                h_sparse_idxlookup.data[i] = -1;
-                }
+    // wrap array
+    matrix_map_t map_matrix(h_cmatrix.data, n_constraint, n_constraint);
 
-            // construct lookup table
-            int* inner_non_zeros = m_sparse.innerNonZeroPtr();
-            int* outer = m_sparse.outerIndexPtr();
-            int* inner = m_sparse.innerIndexPtr();
-            for (int i = 0; i < m_sparse.outerSize(); ++i)
-                {
-                int id = outer[i];
-                int end;
+    // sparsity pattern changed
+    m_sparse = map_matrix.sparseView();
 
-                if (m_sparse.isCompressed())
-                    end = outer[i + 1];
-                else
-                    end = id + inner_non_zeros[i];
+    ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup,
+                                        access_location::host,
+                                        access_mode::overwrite);
 
-                for (; id < end; ++id)
-                    {
-                    unsigned int col = i;
-                    unsigned int row = inner[id];
+    // reset lookup matrix values to -1
+    for (unsigned int i = 0; i < n_constraint * n_constraint; ++i)
+        {
+        h_sparse_idxlookup.data[i] = -1;
+        }
 
-                    // set pointer to index in sparse_val
-                    h_sparse_idxlookup.data[col * n_constraint + row] = id;
-                    }
-                }
-            }
+    // construct lookup table
+    int* inner_non_zeros = m_sparse.innerNonZeroPtr();
+    int* outer = m_sparse.outerIndexPtr();
+    int* inner = m_sparse.innerIndexPtr();
+    for (int i = 0; i < m_sparse.outerSize(); ++i)
+        {
+        int id = outer[i];
+        int end;
 
-        // Compute the ordering permutation vector from the structural pattern of A
-        m_sparse_solver.analyzePattern(m_sparse);
-        }
+        if (m_sparse.isCompressed())
+            end = outer[i + 1];
+        else
+            end = id + inner_non_zeros[i];
 
-    // Compute the numerical factorization
-    m_sparse_solver.factorize(m_sparse);
+        for (; id < end; ++id)
+            {
+            unsigned int col = i;
+            unsigned int row = inner[id];
 
-    if (m_sparse_solver.info())
-        {
-        throw std::runtime_error("Could not solve linear system of constraint equations.");
+            // set pointer to index in sparse_val
+            h_sparse_idxlookup.data[col * n_constraint + row] = id;
+            }
         }
+    }
+
+/*! \param pattern_changed True when the sparsity pattern or the order of the constraints changed
+
+    The direct solver reuses the fill-reducing ordering of the sparse LU decomposition until the
+    pattern changes. The iterative solver starts from the Lagrange multipliers of the previous
+    step, matched by constraint tag when the constraints have been reordered.
+*/
+void ForceDistanceConstraint::solveSparseSystem(bool pattern_changed)
+    {
+    typedef Matrix<double, Dynamic, 1> vec_t;
+    typedef Map<vec_t> vec_map_t;
+
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
     // access RHS and solution vector
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
@@ -419,8 +518,72 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
     vec_map_t map_vec(h_cvec.data, n_constraint, 1);
     vec_map_t map_lagrange(h_lagrange.data, n_constraint, 1);
 
-    // Use the factors to solve the linear system
-    map_lagrange = m_sparse_solver.solve(map_vec);
+    if (!m_iterative)
+        {
+        if (pattern_changed)
+            {
+            // Compute the ordering permutation vector from the structural pattern of A
+            m_sparse_solver.analyzePattern(m_sparse);
+            }
+
+        // Compute the numerical factorization
+        m_sparse_solver.factorize(m_sparse);
+
+        if (m_sparse_solver.info())
+            {
+            throw std::runtime_error("Could not solve linear system of constraint equations.");
+            }
+
+        // Use the factors to solve the linear system
+        map_lagrange = m_sparse_solver.solve(map_vec);
+        m_previous_lagrange.clear();
+        return;
+        }
+
+    ArrayHandle<unsigned int> h_group_tag(m_cdata->getTags(),
+                                          access_location::host,
+                                          access_mode::read);
+
+    // warm start from the previous solution
+    vec_t guess = vec_t::Zero(n_constraint);
+    if (!pattern_changed && m_previous_lagrange.size() == n_constraint)
+        {
+        for (unsigned int n = 0; n < n_constraint; ++n)
+            guess[n] = m_previous_lagrange[n].second;
+        }
+    else if (!m_previous_lagrange.empty())
+        {
+        // the constraints may have been reordered, match the old solution by tag
+        std::sort(m_previous_lagrange.begin(), m_previous_lagrange.end());
+
+        for (unsigned int n = 0; n < n_constraint; ++n)
+            {
+            unsigned int tag = h_group_tag.data[n];
+            auto it = std::lower_bound(m_previous_lagrange.begin(),
+                                       m_previous_lagrange.end(),
+                                       tag,
+                                       [](const std::pair<unsigned int, double>& p, unsigned int t)
+                                       { return p.first < t; });
+            if (it != m_previous_lagrange.end() && it->first == tag)
+                guess[n] = it->second;
+            }
+        }
+
+    m_iterative_solver.setTolerance(m_solver_tol);
+    m_iterative_solver.compute(m_sparse);
+    vec_t solution = m_iterative_solver.solveWithGuess(map_vec, guess);
+
+    if (m_iterative_solver.info() != Success)
+        {
+        throw std::runtime_error("Iterative constraint solver did not converge.");
+        }
+
+    map_lagrange = solution;
+
+    // remember which constraint each multiplier belongs to
+    m_previous_lagrange.resize(n_constraint);
+    for (unsigned int n = 0; n < n_constraint; ++n)
+        m_previous_lagrange[n] = std::make_pair(h_group_tag.data[n], solution[n]);
     }
 
 void ForceDistanceConstraint::computeConstraintForces(uint64_t timestep)
@@ -658,7 +821,13 @@ void export_ForceDistanceConstraint(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def_property("tolerance",
                       &ForceDistanceConstraint::getRelativeTolerance,
-                      &ForceDistanceConstraint::setRelativeTolerance);
+                      &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("solver",
+                      &ForceDistanceConstraint::getSolver,
+                      &ForceDistanceConstraint::setSolver)
+        .def_property("solver_tolerance",
+                      &ForceDistanceConstraint::getSolverTolerance,
+                      &ForceDistanceConstraint::setSolverTolerance);
     }
 
     } // end namespace detail
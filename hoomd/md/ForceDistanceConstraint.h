@@ -20,8 +20,12 @@
 #include "hoomd/GPUVector.h"
 
 #include <Eigen/Dense>
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseLU>
 
+#include <string>
+#include <vector>
+
 namespace hoomd
     {
 namespace md
@@ -33,6 +37,14 @@ namespace md
    M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics
    Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    The constraint matrix couples two constraints only when they share a particle. On the CPU, the
+    matrix is assembled directly in sparse form from the constraint topology: the sparsity pattern
+    and the position of every entry in the sparse storage are rebuilt only when the constraints
+    are reordered, and the entries are filled in parallel over constraints. The linear system is
+    solved either with a sparse LU decomposition that keeps its fill-reducing ordering until the
+    pattern changes, or with a BiCGSTAB iteration warm started from the previous Lagrange
+    multipliers.
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -63,6 +75,27 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         return m_rel_tol;
         }
 
+    /// Set the linear solver ("direct" or "iterative")
+    void setSolver(const std::string& solver);
+
+    /// Get the linear solver
+    std::string getSolver()
+        {
+        return m_iterative ? "iterative" : "direct";
+        }
+
+    /// Set the relative residual tolerance of the iterative solver
+    void setSolverTolerance(Scalar solver_tol)
+        {
+        m_solver_tol = solver_tol;
+        }
+
+    /// Get the relative residual tolerance of the iterative solver
+    Scalar getSolverTolerance()
+        {
+        return m_solver_tol;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -74,7 +107,7 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     protected:
     std::shared_ptr<ConstraintData> m_cdata; //! The constraint data
 
-    GPUVector<double> m_cmatrix;  //!< The matrix for the constraint force equation (column-major)
+    GPUVector<double> m_cmatrix;  //!< Dense constraint matrix on the GPU (column-major)
     GPUVector<double> m_cvec;     //!< The vector on the RHS of the constraint equation
     GPUVector<double> m_lagrange; //!< The solution for the lagrange multipliers
 
@@ -90,6 +123,23 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     GPUVector<int>
         m_sparse_idxlookup; //!< Reverse lookup from column-major to sparse matrix element
 
+    /// The iterative solver with a Jacobi preconditioner
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double, Eigen::ColMajor>,
+                    Eigen::DiagonalPreconditioner<double>>
+        m_iterative_solver;
+
+    bool m_iterative;    //!< True when solving with the iterative solver
+    Scalar m_solver_tol; //!< Relative residual tolerance of the iterative solver
+
+    std::vector<uint2> m_constraint_idx;            //!< Particle indices of each constraint
+    std::vector<vec3<Scalar>> m_constraint_rn;      //!< Separation vector of each constraint
+    std::vector<unsigned int> m_constraint_offset;  //!< First coupled constraint of each row
+    std::vector<unsigned int> m_coupled_constraint; //!< Constraints coupled to each row
+    std::vector<int> m_coupled_entry;               //!< Index of each coupling in m_sparse
+
+    /// Tag and Lagrange multiplier of each constraint in the last iterative solution
+    std::vector<std::pair<unsigned int, double>> m_previous_lagrange;
+
     bool m_constraint_reorder;        //!< True if groups have changed
     bool m_constraints_added_removed; //!< True if global constraint topology has changed
 
@@ -107,6 +157,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     //! Solve the constraint matrix equation
     virtual void solveConstraints(uint64_t timestep);
 
+    //! Build the sparse constraint matrix from the dense matrix m_cmatrix
+    void convertDenseMatrix();
+
+    //! Solve the sparse matrix equation for the Lagrange multipliers
+    void solveSparseSystem(bool pattern_changed);
+
     //! Solve the linear matrix-vector equation
     virtual void computeConstraintForces(uint64_t timestep);
 
@@ -133,6 +189,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     std::shared_ptr<Communicator> m_comm;
 #endif
 
+    //! Build the sparsity pattern of the constraint matrix from the constraint topology
+    void buildSparsityPattern(unsigned int max_local);
+
+    //! Call kernel(i) for every i in [0, n), in parallel when threads are available
+    template<class Kernel> void forEachConstraint(unsigned int n, const Kernel& kernel);
+
     //! Helper function to perform a depth-first search
     Scalar dfs(unsigned int iconstraint,
                unsigned int molecule,
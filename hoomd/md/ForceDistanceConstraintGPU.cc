@@ -96,6 +96,9 @@ void ForceDistanceConstraintGPU::fillMatrixVector(uint64_t timestep)
     // fill the matrix in row-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
+    // reallocate the dense matrix through amortized resizing
+    m_cmatrix.resize(n_constraint * n_constraint);
+
     if (m_constraint_reorder)
         {
         // reset flag
@@ -203,6 +206,15 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
     unsigned int sparsity_pattern_changed = m_condition.readFlags();
 
 #ifndef CUSOLVER_AVAILABLE
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+    // skip if zero constraints
+    if (n_constraint == 0)
+        return;
+
+    // reallocate array of constraint forces
+    m_lagrange.resize(n_constraint);
+
     if (!sparsity_pattern_changed)
         {
         // copy new sparse values to host sparse matrix
@@ -212,9 +224,17 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
                   sizeof(double) * m_sparse.data().size(),
                   hipMemcpyDeviceToHost);
         }
+    else
+        {
+        // reset flags
+        m_condition.resetFlags(0);
+
+        // build the sparse matrix from the dense matrix
+        convertDenseMatrix();
+        }
 
     // solve on CPU
-    ForceDistanceConstraint::solveConstraints(timestep);
+    solveSparseSystem(sparsity_pattern_changed);
 
     // a sparse matrix should have been constructed, resize values array
     m_sparse_val.resize(m_sparse.data().size());
@@ -85,6 +85,12 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
 #ifdef ENABLE_MPI
     /// helper function to determine the ghost communication flags
     virtual CommFlags determineFlags(uint64_t timestep);
+
+    /// Rigid body constituents are placed after the ghost update, so they cannot be overlapped
+    virtual bool canOverlapGhostUpdate()
+        {
+        return !m_rigid_bodies;
+        }
 #endif
 
     /// Check if any forces introduce anisotropic degrees of freedom
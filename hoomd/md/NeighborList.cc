@@ -11,6 +11,11 @@
 #include <iostream>
 #include <stdexcept>
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_scan.h>
+#endif
+
 using namespace std;
 
 /*! \file NeighborList.cc
@@ -265,6 +270,20 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
         m_last_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
 #endif
 
+#ifdef ENABLE_TBB
+    // the threaded CPU builds tune their grain size, the tuner is optional because it only
+    // activates when more than one thread is in use
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_tuner_tasks.reset(new Autotuner<1>({AutotunerBase::getTasksPerThreadRange()},
+                                             m_exec_conf,
+                                             "nlist_tasks_per_thread",
+                                             5,
+                                             true));
+        m_autotuners.push_back(m_tuner_tasks);
+        }
+#endif
+
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
@@ -431,7 +450,63 @@ void NeighborList::compute(uint64_t timestep)
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_n_builds++;
+        m_ranges_valid = false;
+        }
+    }
+
+/*! \param timestep Current time step
+    \returns true when a call to compute() at \a timestep will not rebuild the list
+
+    The rebuild check is performed (and cached) at \a timestep, so in MPI simulations this must be
+    called on all ranks.
+*/
+bool NeighborList::isUpToDate(uint64_t timestep)
+    {
+    // always evaluate the check so that the collective distance check is made on every rank
+    bool needs_update = needsUpdating(timestep);
+
+    return !needs_update && m_has_been_updated_once && !m_force_update && !m_rcut_changed
+           && !m_n_particles_changed && !m_topology_changed;
+    }
+
+/*! A particle is on the boundary when any of its neighbors is a ghost particle. Forces on interior
+    particles can be computed before the ghost positions are current.
+*/
+void NeighborList::updateRanges()
+    {
+    updateParticleNlist();
+
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+
+    m_interior_ranges.clear();
+    m_boundary_ranges.clear();
+
+    const unsigned int N = m_pdata->getN();
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const size_t head = h_head_list.data[i];
+        bool boundary = false;
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            if (h_nlist.data[head + k] >= N)
+                {
+                boundary = true;
+                break;
+                }
+            }
+
+        // extend the last range of the same kind when it ends at i
+        auto& ranges = boundary ? m_boundary_ranges : m_interior_ranges;
+        if (!ranges.empty() && ranges.back().second == i)
+            ranges.back().second = i + 1;
+        else
+            ranges.emplace_back(i, i + 1);
         }
+
+    m_ranges_valid = true;
     }
 
 /*! \param r_buff New buffer radius to set
@@ -1241,31 +1316,54 @@ bool NeighborList::distanceCheck(uint64_t timestep)
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+    // returns true if any particle in [first, last) has moved far enough to require a rebuild
+    auto check_range = [&](unsigned int first, unsigned int last)
+    {
+        for (unsigned int i = first; i < last; i++)
+            {
+            const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
 
-        // minimum distance within which all particles should be included
-        Scalar old_rmin = h_rcut_max.data[type_i];
+            // minimum distance within which all particles should be included
+            Scalar old_rmin = h_rcut_max.data[type_i];
 
-        // maximum value we have checked for neighbors, defined by the buffer layer
-        Scalar rmax = old_rmin + m_r_buff;
+            // maximum value we have checked for neighbors, defined by the buffer layer
+            Scalar rmax = old_rmin + m_r_buff;
 
-        // max displacement for each particle (after subtraction of homogeneous dilations)
-        const Scalar delta_max = (rmax * lambda_min - old_rmin) / Scalar(2.0);
-        Scalar maxsq = (delta_max > 0) ? delta_max * delta_max : 0;
+            // max displacement for each particle (after subtraction of homogeneous dilations)
+            const Scalar delta_max = (rmax * lambda_min - old_rmin) / Scalar(2.0);
+            Scalar maxsq = (delta_max > 0) ? delta_max * delta_max : 0;
 
-        Scalar3 dx = make_scalar3(h_pos.data[i].x - lambda.x * h_last_pos.data[i].x,
-                                  h_pos.data[i].y - lambda.y * h_last_pos.data[i].y,
-                                  h_pos.data[i].z - lambda.z * h_last_pos.data[i].z);
+            Scalar3 dx = make_scalar3(h_pos.data[i].x - lambda.x * h_last_pos.data[i].x,
+                                      h_pos.data[i].y - lambda.y * h_last_pos.data[i].y,
+                                      h_pos.data[i].z - lambda.z * h_last_pos.data[i].z);
 
-        dx = box.minImage(dx);
+            dx = box.minImage(dx);
 
-        if (dot(dx, dx) >= maxsq)
-            {
-            result = true;
-            break;
+            if (dot(dx, dx) >= maxsq)
+                return true;
             }
+        return false;
+    };
+
+    const unsigned int N = m_pdata->getN();
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                result = tbb::parallel_reduce(
+                    tbb::blocked_range<unsigned int>(0, N),
+                    false,
+                    [&](const tbb::blocked_range<unsigned int>& r, bool found) -> bool
+                    { return found || check_range(r.begin(), r.end()); },
+                    [](bool a, bool b) -> bool { return a || b; });
+            });
+        }
+    else
+#endif
+        {
+        result = check_range(0, N);
         }
 
 #ifdef ENABLE_MPI
@@ -1463,8 +1561,8 @@ void NeighborList::updateExListIdx()
                                             access_mode::overwrite);
 
     // translate the number and exclusions from one array to the other
-    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
-        {
+    auto translate_particle = [&](unsigned int idx)
+    {
         // get the tag for this index
         unsigned int tag = h_tag.data[idx];
 
@@ -1481,6 +1579,28 @@ void NeighborList::updateExListIdx()
             // store excluded particle idx
             h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex_idx;
             }
+    };
+
+    const unsigned int N = m_pdata->getN();
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+                                          translate_particle(idx);
+                                  });
+            });
+        }
+    else
+#endif
+        {
+        for (unsigned int idx = 0; idx < N; idx++)
+            translate_particle(idx);
         }
     }
 
@@ -1497,9 +1617,9 @@ void NeighborList::filterNlist()
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
 
-    // for each particle's neighbor list
-    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
-        {
+    // filter each particle's neighbor list in place
+    auto filter_particle = [&](unsigned int idx)
+    {
         size_t myHead = h_head_list.data[idx];
         unsigned int n_neigh = h_n_neigh.data[idx];
         unsigned int n_ex = h_n_ex_idx.data[idx];
@@ -1532,6 +1652,28 @@ void NeighborList::filterNlist()
 
         // update the number of neighbors
         h_n_neigh.data[idx] = new_n_neigh;
+    };
+
+    const unsigned int N = m_pdata->getN();
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+                                          filter_particle(idx);
+                                  });
+            });
+        }
+    else
+#endif
+        {
+        for (unsigned int idx = 0; idx < N; idx++)
+            filter_particle(idx);
         }
     }
 
@@ -1551,13 +1693,45 @@ void NeighborList::buildHeadList()
                                    access_mode::read);
         ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
 
-        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+        const unsigned int N = m_pdata->getN();
+#ifdef ENABLE_TBB
+        if (m_exec_conf->getNumThreads() > 1)
             {
-            h_head_list.data[i] = headAddress;
+            // exclusive prefix sum of the per particle capacities
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    headAddress = tbb::parallel_scan(
+                        tbb::blocked_range<unsigned int>(0, N),
+                        size_t(0),
+                        [&](const tbb::blocked_range<unsigned int>& r,
+                            size_t running_total,
+                            bool is_final_scan) -> size_t
+                        {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                if (is_final_scan)
+                                    h_head_list.data[i] = running_total;
+
+                                unsigned int myType = __scalar_as_int(h_pos.data[i].w);
+                                running_total += h_Nmax.data[myType];
+                                }
+                            return running_total;
+                        },
+                        [](size_t left, size_t right) -> size_t { return left + right; });
+                });
+            }
+        else
+#endif
+            {
+            for (unsigned int i = 0; i < N; ++i)
+                {
+                h_head_list.data[i] = headAddress;
 
-            // move the head address along
-            unsigned int myType = __scalar_as_int(h_pos.data[i].w);
-            headAddress += h_Nmax.data[myType];
+                // move the head address along
+                unsigned int myType = __scalar_as_int(h_pos.data[i].w);
+                headAddress += h_Nmax.data[myType];
+                }
             }
         }
 
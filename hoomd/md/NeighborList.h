@@ -10,10 +10,18 @@
 #include "hoomd/PythonLocalDataAccess.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file NeighborList.h
     \brief Declares the NeighborList class
 */
@@ -296,18 +304,21 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Get the number of neighbors array
     const GlobalArray<unsigned int>& getNNeighArray() const
         {
+        updateParticleNlist();
         return m_n_neigh;
         }
 
     //! Get the neighbor list
     const GlobalArray<unsigned int>& getNListArray() const
         {
+        updateParticleNlist();
         return m_nlist;
         }
 
     //! Get the head list
     const GlobalArray<size_t>& getHeadList() const
         {
+        updateParticleNlist();
         return m_head_list;
         }
 
@@ -430,6 +441,31 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_last_updated_tstep == timestep && m_has_been_updated_once;
         }
 
+    //! Return true if the current list can be used at this time step without a rebuild
+    bool isUpToDate(uint64_t timestep);
+
+    //! Get the number of times the list has been built
+    uint64_t getNumBuilds() const
+        {
+        return m_n_builds;
+        }
+
+    //! Get the ranges [first, last) of particles whose neighbors are all local particles
+    const std::vector<std::pair<unsigned int, unsigned int>>& getInteriorRanges()
+        {
+        if (!m_ranges_valid)
+            updateRanges();
+        return m_interior_ranges;
+        }
+
+    //! Get the ranges [first, last) of particles with at least one ghost neighbor
+    const std::vector<std::pair<unsigned int, unsigned int>>& getBoundaryRanges()
+        {
+        if (!m_ranges_valid)
+            updateRanges();
+        return m_boundary_ranges;
+        }
+
     Nano::Signal<void()>& getRCutChangeSignal()
         {
         return m_rcut_signal;
@@ -518,6 +554,11 @@ class PYBIND11_EXPORT NeighborList : public Compute
     std::shared_ptr<Communicator> m_comm;
 #endif
 
+#ifdef ENABLE_TBB
+    /// Autotuner for the number of tasks per thread in forEachLocalParticle (CPU only)
+    std::shared_ptr<Autotuner<1>> m_tuner_tasks;
+#endif
+
     //! Return true if we are supposed to do a distance check in this time step
     bool shouldCheckDistance(uint64_t timestep);
 
@@ -545,9 +586,25 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Build the head list to allocated memory
     virtual void buildHeadList();
 
+    //! Bring the per-particle neighbor list up to date before it is read
+    /*! Subclasses that store their neighbors in another form fill m_n_neigh, m_nlist, and
+        m_head_list on demand here. The getters are const, so this is too.
+    */
+    virtual void updateParticleNlist() const { }
+
     //! Amortized resizing of the neighborlist
     void resizeNlist(size_t size);
 
+    //! Run a per particle neighbor list build kernel over all local particles
+    template<class Kernel>
+    void forEachLocalParticle(unsigned int* conditions, const Kernel& kernel);
+
+    //! Check the status of the conditions
+    bool checkConditions();
+
+    //! Resets the condition status to all zeroes
+    virtual void resetConditions();
+
 #ifdef ENABLE_MPI
     CommFlags getRequestedCommFlags(uint64_t timestep)
         {
@@ -595,6 +652,19 @@ class PYBIND11_EXPORT NeighborList : public Compute
                                             //!< m_rebuild_check_delay steps after the last one
     std::vector<uint64_t> m_update_periods; //!< Steps between updates
     std::set<std::string> m_exclusions;     //!< Exclusions that have been set
+    uint64_t m_n_builds = 0;                //!< Number of times the list has been built
+
+    /// Ranges of particles whose neighbors are all local
+    std::vector<std::pair<unsigned int, unsigned int>> m_interior_ranges;
+
+    /// Ranges of particles with at least one ghost neighbor
+    std::vector<std::pair<unsigned int, unsigned int>> m_boundary_ranges;
+
+    /// True when the interior and boundary ranges match the current list
+    bool m_ranges_valid = false;
+
+    //! Classify the local particles into interior and boundary ranges
+    void updateRanges();
 
     //! Test if the list needs updating
     bool needsUpdating(uint64_t timestep);
@@ -602,12 +672,6 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Reallocate internal neighbor list data structures
     void reallocate();
 
-    //! Check the status of the conditions
-    bool checkConditions();
-
-    //! Resets the condition status to all zeroes
-    virtual void resetConditions();
-
     //! Grow the exclusions list memory capacity by one row
     void growExclusionList();
 
@@ -658,6 +722,58 @@ class PYBIND11_EXPORT NeighborList : public Compute
 #endif
     };
 
+/*! \param conditions Host pointer to m_conditions
+    \param kernel Callable kernel(i, conditions) that builds the neighbor list of local particle i
+           and raises conditions[type_i] when the particle overflows its allocation
+
+    Each particle writes only its own slice of the neighbor list, so particles are processed in
+    parallel when HOOMD is built with TBB and more than one thread is available. Overflow counts
+    are then collected in per-thread arrays and merged into \a conditions with max after the loop.
+    The grain size of the parallel loop is autotuned by m_tuner_tasks.
+*/
+template<class Kernel>
+void NeighborList::forEachLocalParticle(unsigned int* conditions, const Kernel& kernel)
+    {
+    const unsigned int N = m_pdata->getN();
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1 && N > 0)
+        {
+        const unsigned int n_types = m_pdata->getNTypes();
+        tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_conditions(
+            std::vector<unsigned int>(n_types, 0));
+
+        m_tuner_tasks->begin();
+        const unsigned int n_tasks = m_exec_conf->getNumThreads() * m_tuner_tasks->getParam()[0];
+        const unsigned int grain_size = std::max(N / n_tasks, 1u);
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N, grain_size),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      unsigned int* local_conditions
+                                          = thread_conditions.local().data();
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          kernel(i, local_conditions);
+                                  });
+            });
+        m_tuner_tasks->end();
+
+        for (const std::vector<unsigned int>& local_conditions : thread_conditions)
+            {
+            for (unsigned int type = 0; type < n_types; ++type)
+                conditions[type] = std::max(conditions[type], local_conditions[type]);
+            }
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < N; ++i)
+            kernel(i, conditions);
+        }
+    }
+
 /// Make the local particle data available to python via zero-copy access.
 template<class Output>
 class PYBIND11_EXPORT LocalNeighborListData : public LocalDataAccess<Output, NeighborList>
@@ -22,10 +22,26 @@ NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef,
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListBinned" << endl;
 
+    // read positions from a compressed structure of arrays cell list
     m_cl->setRadius(1);
-    m_cl->setComputeXYZF(true);
+    m_cl->setCompressed(true);
+    m_cl->setComputeXYZF(false);
+    m_cl->setComputeSoA(true);
+    m_cl->setComputeIdx(true);
     m_cl->setComputeTypeBody(false);
-    m_cl->setFlagIndex();
+
+    // The cell width changes the order of the neighbors, so the tuner is optional and the width
+    // stays at r_list until the user calls tune_kernel_parameters(). All ranks choose the same
+    // width.
+    m_tuner_cell_width.reset(new Autotuner<1>({{100, 125, 150, 200}},
+                                              m_exec_conf,
+                                              "nlist_binned_cell_width",
+                                              5,
+                                              true));
+#ifdef ENABLE_MPI
+    m_tuner_cell_width->setSync(bool(m_pdata->getDomainDecomposition()));
+#endif
+    m_autotuners.push_back(m_tuner_cell_width);
     }
 
 NeighborListBinned::~NeighborListBinned()
@@ -35,12 +51,29 @@ NeighborListBinned::~NeighborListBinned()
 
 void NeighborListBinned::buildNlist(uint64_t timestep)
     {
+    if (m_tune_cell_width)
+        {
+        m_tuner_cell_width->begin();
+        }
+    const unsigned int cell_width_percent = m_tuner_cell_width->getParam()[0];
+
     // update the cell list size if needed
-    if (m_update_cell_size)
+    if (m_update_cell_size || cell_width_percent != m_cell_width_percent)
         {
         Scalar rmax = getMaxRCut() + m_r_buff;
+        Scalar width = rmax * Scalar(cell_width_percent) / Scalar(100.0);
 
-        m_cl->setNominalWidth(rmax);
+        // the 27 cell stencil only finds every neighbor once with at least 3 cells along each
+        // dimension, so keep the minimum width in boxes that are too small for wider cells
+        const Scalar3 L = m_pdata->getBox().getNearestPlaneDistance();
+        if (L.x < Scalar(3.0) * width || L.y < Scalar(3.0) * width
+            || (m_sysdef->getNDimensions() == 3 && L.z < Scalar(3.0) * width))
+            {
+            width = rmax;
+            }
+
+        m_cl->setNominalWidth(width);
+        m_cell_width_percent = cell_width_percent;
         m_update_cell_size = false;
         }
 
@@ -62,12 +95,15 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
 
     // access the cell list data arrays
-    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
-                                          access_location::host,
-                                          access_mode::read);
-    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
-                                     access_location::host,
-                                     access_mode::read);
+    ArrayHandle<unsigned int> h_cell_start(m_cl->getCellStartArray(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> h_cell_idx(m_cl->getIndexArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<Scalar> h_cell_x(m_cl->getXArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_cell_y(m_cl->getYArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_cell_z(m_cl->getZArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(),
                                          access_location::host,
                                          access_mode::read);
@@ -83,17 +119,14 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
 
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
-    Index2D cli = m_cl->getCellListIndexer();
     Index2D cadji = m_cl->getCellAdjIndexer();
 
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
-    // for each local particle
-    unsigned int nparticles = m_pdata->getN();
-
-    for (int i = 0; i < (int)nparticles; i++)
-        {
+    // build the neighbor list of each local particle, in parallel when threads are available
+    auto build_particle = [&](int i, unsigned int* conditions)
+    {
         unsigned int cur_n_neigh = 0;
 
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -126,11 +159,11 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
             unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
 
             // check against all the particles in that neighboring bin to see if it is a neighbor
-            unsigned int size = h_cell_size.data[neigh_cell];
-            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            const unsigned int cell_last = h_cell_start.data[neigh_cell + 1];
+            for (unsigned int cur_slot = h_cell_start.data[neigh_cell]; cur_slot < cell_last;
+                 cur_slot++)
                 {
-                Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
-                unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
+                unsigned int cur_neigh = h_cell_idx.data[cur_slot];
 
                 // get the current neighbor type from the position data (will use TypeBody on the
                 // GPU)
@@ -147,7 +180,9 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
                 if (excluded)
                     continue;
 
-                Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                Scalar3 neigh_pos = make_scalar3(h_cell_x.data[cur_slot],
+                                                 h_cell_y.data[cur_slot],
+                                                 h_cell_z.data[cur_slot]);
                 Scalar3 dx = my_pos - neigh_pos;
                 dx = box.minImage(dx);
 
@@ -165,8 +200,7 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
                             h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
                         else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
+                            conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
 
                         cur_n_neigh++;
                         }
@@ -175,6 +209,12 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
             }
 
         h_n_neigh.data[i] = cur_n_neigh;
+    };
+
+    forEachLocalParticle(h_conditions.data, build_particle);
+    if (m_tune_cell_width)
+        {
+        m_tuner_cell_width->end();
         }
     }
 
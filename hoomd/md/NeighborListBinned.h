@@ -24,6 +24,10 @@ namespace md
 //! Efficient neighbor list build on the CPU
 /*! Implements the O(N) neighbor list build on the CPU using a cell list.
 
+    The nominal cell width is the largest r_list. After startAutotuning(), it is tuned as a
+    multiple of the largest r_list. Wider cells hold more particles that fail the distance check,
+    but reduce the number of cells to build and visit.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT NeighborListBinned : public NeighborList
@@ -54,6 +58,13 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
         return m_cl->getSortCellList();
         }
 
+    /// Start autotuning, including the cell width
+    virtual void startAutotuning()
+        {
+        m_tune_cell_width = true;
+        NeighborList::startAutotuning();
+        }
+
     /// Get the dimensions of the cell list
     const uint3& getDim() const
         {
@@ -72,6 +83,15 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
     /// Track when the cell size needs to be updated
     bool m_update_cell_size = true;
 
+    /// Autotuner for the cell width in percent of the largest r_list
+    std::shared_ptr<Autotuner<1>> m_tuner_cell_width;
+
+    /// Cell width percentage the cell list was last sized with
+    unsigned int m_cell_width_percent = 0;
+
+    /// True once the user requested tuning, the cell width is fixed until then
+    bool m_tune_cell_width = false;
+
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
     };
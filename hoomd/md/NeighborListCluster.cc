@@ -0,0 +1,483 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file NeighborListCluster.cc
+    \brief Defines NeighborListCluster
+*/
+
+#include "NeighborListCluster.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+NeighborListCluster::NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
+    : NeighborList(sysdef, r_buff), m_cl(std::make_shared<CellList>(sysdef))
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListCluster" << endl;
+
+    // read positions from a compressed structure of arrays cell list
+    m_cl->setRadius(1);
+    m_cl->setCompressed(true);
+    m_cl->setComputeXYZF(false);
+    m_cl->setComputeSoA(true);
+    m_cl->setComputeIdx(true);
+    m_cl->setComputeTypeBody(false);
+    }
+
+NeighborListCluster::~NeighborListCluster()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListCluster" << endl;
+    }
+
+/*! \param cluster_size Number of particles in each cluster, either 4 or 8
+ */
+void NeighborListCluster::setClusterSize(unsigned int cluster_size)
+    {
+    if (cluster_size != 4 && cluster_size != 8)
+        {
+        throw runtime_error("Cluster size must be 4 or 8.");
+        }
+
+    if (cluster_size != m_cluster_size)
+        {
+        m_cluster_size = cluster_size;
+        forceUpdate();
+        }
+    }
+
+/*! \param n Number of indices
+    \param kernel Callable kernel(i) that only writes data owned by index i
+*/
+template<class Kernel> void NeighborListCluster::forEachIndex(unsigned int n, const Kernel& kernel)
+    {
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1 && n > 0)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          kernel(i);
+                                  });
+            });
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < n; ++i)
+            kernel(i);
+        }
+    }
+
+void NeighborListCluster::buildNlist(uint64_t timestep)
+    {
+    // update the cell list size if needed
+    if (m_update_cell_size)
+        {
+        Scalar rmax = getMaxRCut() + m_r_buff;
+
+        m_cl->setNominalWidth(rmax);
+        m_update_cell_size = false;
+        }
+
+    m_cl->compute(timestep);
+
+    buildClusters();
+    buildClusterPairs();
+    m_particle_nlist_current = false;
+    }
+
+void NeighborListCluster::buildHeadList()
+    {
+    NeighborList::buildHeadList();
+    m_particle_nlist_current = false;
+    }
+
+void NeighborListCluster::updateParticleNlist() const
+    {
+    if (m_particle_nlist_current)
+        return;
+
+    // the per-particle list is a cache of the cluster pairs, so filling it from the const getters
+    // does not change the logical state of the neighbor list
+    const_cast<NeighborListCluster*>(this)->expandClusterPairs();
+    }
+
+/*! Particles are taken in cell list order, so the local particles of each cell (which have lower
+    indices than the ghosts) are grouped into the local clusters of that cell and the remaining
+    ghost particles into its ghost clusters.
+*/
+void NeighborListCluster::buildClusters()
+    {
+    const unsigned int N = m_pdata->getN();
+    const unsigned int M = m_cluster_size;
+    const unsigned int n_cells = m_cl->getCellIndexer().getNumElements();
+
+    // access the cell list data arrays
+    ArrayHandle<unsigned int> h_cell_start(m_cl->getCellStartArray(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> h_cell_idx(m_cl->getIndexArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<Scalar> h_cell_x(m_cl->getXArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_cell_y(m_cl->getYArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_cell_z(m_cl->getZArray(), access_location::host, access_mode::read);
+
+    // find the first ghost slot of a cell
+    auto first_ghost_slot = [&](unsigned int cell)
+    {
+        const unsigned int cell_last = h_cell_start.data[cell + 1];
+        unsigned int slot = h_cell_start.data[cell];
+        while (slot < cell_last && h_cell_idx.data[slot] < N)
+            slot++;
+        return slot;
+    };
+
+    // count the clusters in each cell
+    m_local_cluster_start.resize(n_cells + 1);
+    m_ghost_cluster_start.resize(n_cells + 1);
+    unsigned int n_local_clusters = 0;
+    unsigned int n_ghost_clusters = 0;
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        {
+        const unsigned int ghost_slot = first_ghost_slot(cell);
+        m_local_cluster_start[cell] = n_local_clusters;
+        m_ghost_cluster_start[cell] = n_ghost_clusters;
+        n_local_clusters += (ghost_slot - h_cell_start.data[cell] + M - 1) / M;
+        n_ghost_clusters += (h_cell_start.data[cell + 1] - ghost_slot + M - 1) / M;
+        }
+    m_local_cluster_start[n_cells] = n_local_clusters;
+    m_ghost_cluster_start[n_cells] = n_ghost_clusters;
+
+    // ghost clusters are numbered after all local clusters
+    for (unsigned int cell = 0; cell <= n_cells; cell++)
+        m_ghost_cluster_start[cell] += n_local_clusters;
+
+    m_n_local_clusters = n_local_clusters;
+    m_n_clusters = n_local_clusters + n_ghost_clusters;
+    m_cluster_particles.assign(size_t(m_n_clusters) * M, invalid_particle);
+    m_cluster_sphere.resize(m_n_clusters);
+    m_cluster_cell.resize(m_n_local_clusters);
+    m_particle_slot.assign(N, invalid_particle);
+
+    // fill the clusters starting at cluster c with the particles in slots [first, last)
+    auto fill_clusters
+        = [&](unsigned int cell, unsigned int first, unsigned int last, unsigned int c, bool local)
+    {
+        for (unsigned int slot = first; slot < last; slot += M, c++)
+            {
+            const unsigned int n = std::min(M, last - slot);
+            Scalar3 lo
+                = make_scalar3(h_cell_x.data[slot], h_cell_y.data[slot], h_cell_z.data[slot]);
+            Scalar3 hi = lo;
+            for (unsigned int a = 0; a < n; a++)
+                {
+                const unsigned int idx = h_cell_idx.data[slot + a];
+                m_cluster_particles[size_t(c) * M + a] = idx;
+                if (local)
+                    m_particle_slot[idx] = c * M + a;
+
+                lo.x = std::min(lo.x, h_cell_x.data[slot + a]);
+                lo.y = std::min(lo.y, h_cell_y.data[slot + a]);
+                lo.z = std::min(lo.z, h_cell_z.data[slot + a]);
+                hi.x = std::max(hi.x, h_cell_x.data[slot + a]);
+                hi.y = std::max(hi.y, h_cell_y.data[slot + a]);
+                hi.z = std::max(hi.z, h_cell_z.data[slot + a]);
+                }
+
+            // bounding sphere of the cluster's bounding box
+            const Scalar3 center = (lo + hi) * Scalar(0.5);
+            const Scalar3 half_extent = (hi - lo) * Scalar(0.5);
+            m_cluster_sphere[c] = make_scalar4(center.x,
+                                               center.y,
+                                               center.z,
+                                               sqrt(dot(half_extent, half_extent)));
+            if (local)
+                m_cluster_cell[c] = cell;
+            }
+    };
+
+    forEachIndex(n_cells,
+                 [&](unsigned int cell)
+                 {
+                     const unsigned int ghost_slot = first_ghost_slot(cell);
+                     fill_clusters(cell,
+                                   h_cell_start.data[cell],
+                                   ghost_slot,
+                                   m_local_cluster_start[cell],
+                                   true);
+                     fill_clusters(cell,
+                                   ghost_slot,
+                                   h_cell_start.data[cell + 1],
+                                   m_ghost_cluster_start[cell],
+                                   false);
+                 });
+    }
+
+/*! A j-cluster is a candidate for i-cluster ci when it is in a cell adjacent to ci's cell and the
+    distance between the bounding sphere centers is at most r_list plus both radii. Because the
+    minimum image of the center separation is never longer than that of any other image, this test
+    keeps every cluster that contains a particle within r_list of a particle in ci.
+*/
+void NeighborListCluster::buildClusterPairs()
+    {
+    const unsigned int M = m_cluster_size;
+    const Scalar r_list = getMaxRList();
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    Index2D cadji = m_cl->getCellAdjIndexer();
+
+    // allocate room for every cluster in the adjacent cells of each i-cluster
+    m_cluster_head_list.resize(m_n_local_clusters);
+    m_n_cluster_neigh.resize(m_n_local_clusters);
+    size_t n_slots = 0;
+    for (unsigned int ci = 0; ci < m_n_local_clusters; ci++)
+        {
+        m_cluster_head_list[ci] = n_slots;
+        for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+            {
+            unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, m_cluster_cell[ci])];
+            n_slots += m_local_cluster_start[neigh_cell + 1] - m_local_cluster_start[neigh_cell];
+            n_slots += m_ghost_cluster_start[neigh_cell + 1] - m_ghost_cluster_start[neigh_cell];
+            }
+        }
+    m_cluster_nlist.resize(n_slots);
+    m_cluster_masks.resize(n_slots);
+
+    // set the bits of the particle pairs of clusters ci and cj that may interact
+    auto interaction_mask = [&](unsigned int ci, unsigned int cj)
+    {
+        uint64_t mask = 0;
+        for (unsigned int a = 0; a < M; a++)
+            {
+            const unsigned int i = m_cluster_particles[size_t(ci) * M + a];
+            if (i == invalid_particle)
+                break;
+
+            const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int body_i = h_body.data[i];
+            const unsigned int n_ex = m_exclusions_set ? h_n_ex_idx.data[i] : 0;
+
+            for (unsigned int b = 0; b < M; b++)
+                {
+                const unsigned int j = m_cluster_particles[size_t(cj) * M + b];
+                if (j == invalid_particle)
+                    break;
+
+                // automatically exclude particles when:
+                // (1) they are the same particle, or
+                // (2) the r_cut(i,j) indicates to skip, or
+                // (3) they are in the same body
+                const unsigned int type_j = __scalar_as_int(h_pos.data[j].w);
+                bool excluded
+                    = ((i == j) || (h_r_cut.data[m_typpair_idx(type_i, type_j)] <= Scalar(0.0)));
+                if (m_filter_body && body_i != NO_BODY)
+                    excluded = excluded | (body_i == h_body.data[j]);
+
+                // (4) they are in the exclusion list
+                for (unsigned int k = 0; k < n_ex && !excluded; k++)
+                    excluded = h_ex_list_idx.data[m_ex_list_indexer(i, k)] == j;
+
+                if (!excluded)
+                    mask |= uint64_t(1) << (a * M + b);
+                }
+            }
+        return mask;
+    };
+
+    forEachIndex(
+        m_n_local_clusters,
+        [&](unsigned int ci)
+        {
+            const Scalar4 sphere_i = m_cluster_sphere[ci];
+            const Scalar3 center_i = make_scalar3(sphere_i.x, sphere_i.y, sphere_i.z);
+            const size_t head = m_cluster_head_list[ci];
+            unsigned int n_neigh = 0;
+
+            auto check_cluster = [&](unsigned int cj)
+            {
+                const Scalar4 sphere_j = m_cluster_sphere[cj];
+                Scalar3 dx = center_i - make_scalar3(sphere_j.x, sphere_j.y, sphere_j.z);
+                dx = box.minImage(dx);
+
+                const Scalar r_max = r_list + sphere_i.w + sphere_j.w;
+                if (dot(dx, dx) > r_max * r_max)
+                    return;
+
+                const uint64_t mask = interaction_mask(ci, cj);
+                if (mask != 0)
+                    {
+                    m_cluster_nlist[head + n_neigh] = cj;
+                    m_cluster_masks[head + n_neigh] = mask;
+                    n_neigh++;
+                    }
+            };
+
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                {
+                unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, m_cluster_cell[ci])];
+                for (unsigned int cj = m_local_cluster_start[neigh_cell];
+                     cj < m_local_cluster_start[neigh_cell + 1];
+                     cj++)
+                    check_cluster(cj);
+                for (unsigned int cj = m_ghost_cluster_start[neigh_cell];
+                     cj < m_ghost_cluster_start[neigh_cell + 1];
+                     cj++)
+                    check_cluster(cj);
+                }
+
+            m_n_cluster_neigh[ci] = n_neigh;
+        });
+    }
+
+/*! The list starts with the allocation from the last buildHeadList() and is regrown and refilled
+    until no particle overflows it.
+*/
+void NeighborListCluster::expandClusterPairs()
+    {
+    bool overflowed = false;
+    do
+        {
+        fillParticleNlist();
+
+        overflowed = checkConditions();
+        if (overflowed)
+            {
+            // call the base class directly, the list is current once the loop exits
+            NeighborList::buildHeadList();
+            resetConditions();
+            }
+        } while (overflowed);
+
+    m_particle_nlist_current = true;
+    }
+
+/*! Each local particle keeps the particles of its row in the interaction masks that are within
+    r_list of it. In half storage mode, only neighbors with a larger index are kept.
+*/
+void NeighborListCluster::fillParticleNlist()
+    {
+    const unsigned int M = m_cluster_size;
+    const uint64_t row_mask = (uint64_t(1) << M) - 1;
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
+
+    // access the neighbor list data
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_conditions(m_conditions,
+                                           access_location::host,
+                                           access_mode::readwrite);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+
+    auto expand_particle = [&](unsigned int i, unsigned int* conditions)
+    {
+        unsigned int cur_n_neigh = 0;
+
+        const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+
+        const unsigned int Nmax_i = h_Nmax.data[type_i];
+        const size_t head_idx_i = h_head_list.data[i];
+
+        // every local particle is in the cell list and therefore in a cluster
+        const unsigned int slot = m_particle_slot[i];
+        assert(slot != invalid_particle);
+        if (slot == invalid_particle)
+            {
+            h_n_neigh.data[i] = 0;
+            return;
+            }
+
+        const unsigned int ci = slot / M;
+        const unsigned int a = slot % M;
+        const size_t cluster_head = m_cluster_head_list[ci];
+
+        for (unsigned int k = 0; k < m_n_cluster_neigh[ci]; k++)
+            {
+            const unsigned int cj = m_cluster_nlist[cluster_head + k];
+            const uint64_t row = (m_cluster_masks[cluster_head + k] >> (a * M)) & row_mask;
+
+            for (unsigned int b = 0; b < M; b++)
+                {
+                if (!(row & (uint64_t(1) << b)))
+                    continue;
+
+                const unsigned int cur_neigh = m_cluster_particles[size_t(cj) * M + b];
+                const unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
+
+                Scalar3 neigh_pos = make_scalar3(h_pos.data[cur_neigh].x,
+                                                 h_pos.data[cur_neigh].y,
+                                                 h_pos.data[cur_neigh].z);
+                Scalar3 dx = my_pos - neigh_pos;
+                dx = box.minImage(dx);
+
+                Scalar dr_sq = dot(dx, dx);
+
+                Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i, cur_neigh_type)];
+                if (dr_sq <= r_listsq && (m_storage_mode == full || i < cur_neigh))
+                    {
+                    if (cur_n_neigh < Nmax_i)
+                        {
+                        h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                        }
+                    else
+                        conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
+
+                    cur_n_neigh++;
+                    }
+                }
+            }
+
+        h_n_neigh.data[i] = cur_n_neigh;
+    };
+
+    forEachLocalParticle(h_conditions.data, expand_particle);
+    }
+
+namespace detail
+    {
+void export_NeighborListCluster(pybind11::module& m)
+    {
+    pybind11::class_<NeighborListCluster, NeighborList, std::shared_ptr<NeighborListCluster>>(
+        m,
+        "NeighborListCluster")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
+        .def_property("cluster_size",
+                      &NeighborListCluster::getClusterSize,
+                      &NeighborListCluster::setClusterSize)
+        .def("getDim",
+             &NeighborListCluster::getDim,
+             pybind11::return_value_policy::reference_internal)
+        .def("getNLocalClusters", &NeighborListCluster::getNLocalClusters);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,184 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "NeighborList.h"
+#include "hoomd/CellList.h"
+
+#include <cstdint>
+#include <vector>
+
+/*! \file NeighborListCluster.h
+    \brief Declares the NeighborListCluster class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTCLUSTER_H__
+#define __NEIGHBORLISTCLUSTER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Cluster pair neighbor list build on the CPU
+/*! NeighborListCluster groups the particles in each cell of a compressed cell list into clusters
+    of getClusterSize() particles. Local particles form i-clusters that come first in the cluster
+    numbering, and ghost particles form j-only clusters that follow them. Unused slots in the last
+    cluster of a cell hold invalid_particle.
+
+    Each i-cluster stores the list of j-clusters whose bounding spheres are within r_list of its
+    own, in the same head list / count form the per-particle neighbor list uses. Every cluster pair
+    carries a bitmask with bit a * getClusterSize() + b set when particle a of the i-cluster may
+    interact with particle b of the j-cluster. Bits are cleared for padding slots, self pairs,
+    type pairs with r_cut <= 0, particles in the same body (when body filtering is enabled), and
+    excluded pairs taken from the exclusion list. The cluster pair list is always full: each pair
+    of local clusters appears in both orders, and half list consumers skip j-clusters with a lower
+    index and the lower triangle of the self cluster mask.
+
+    PotentialPair evaluates the i-cluster x j-cluster tiles directly and never reads the
+    per-particle neighbor list. That list is only expanded from the cluster pairs when another
+    consumer asks for it through getNListArray(), getNNeighArray(), or getHeadList(), so a
+    simulation whose only consumers walk the clusters never allocates or fills it.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT NeighborListCluster : public NeighborList
+    {
+    public:
+    //! Marks an unused slot in a cluster
+    static const unsigned int invalid_particle = 0xffffffff;
+
+    //! Largest supported cluster size (the pair masks hold max_cluster_size^2 bits)
+    static const unsigned int max_cluster_size = 8;
+
+    //! Constructs the compute
+    NeighborListCluster(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff);
+
+    //! Destructor
+    virtual ~NeighborListCluster();
+
+    /// Notify NeighborList that a r_cut matrix value has changed
+    virtual void notifyRCutMatrixChange()
+        {
+        m_update_cell_size = true;
+        NeighborList::notifyRCutMatrixChange();
+        }
+
+    /// Set the number of particles in each cluster (4 or 8)
+    void setClusterSize(unsigned int cluster_size);
+
+    /// Get the number of particles in each cluster
+    unsigned int getClusterSize() const
+        {
+        return m_cluster_size;
+        }
+
+    /// Get the dimensions of the cell list
+    const uint3& getDim() const
+        {
+        return m_cl->getDim();
+        }
+
+    /// Get the number of clusters made of local particles
+    unsigned int getNLocalClusters() const
+        {
+        return m_n_local_clusters;
+        }
+
+    /// Get the total number of clusters (local clusters followed by ghost clusters)
+    unsigned int getNClusters() const
+        {
+        return m_n_clusters;
+        }
+
+    /// Get the particle indices of each cluster (getClusterSize() entries per cluster)
+    const std::vector<unsigned int>& getClusterParticles() const
+        {
+        return m_cluster_particles;
+        }
+
+    /// Get the offset of each i-cluster's entries in the cluster pair list
+    const std::vector<size_t>& getClusterHeadList() const
+        {
+        return m_cluster_head_list;
+        }
+
+    /// Get the number of j-clusters of each i-cluster
+    const std::vector<unsigned int>& getNClusterNeigh() const
+        {
+        return m_n_cluster_neigh;
+        }
+
+    /// Get the j-cluster indices of the cluster pair list
+    const std::vector<unsigned int>& getClusterNList() const
+        {
+        return m_cluster_nlist;
+        }
+
+    /// Get the interaction mask of each cluster pair
+    const std::vector<uint64_t>& getClusterMasks() const
+        {
+        return m_cluster_masks;
+        }
+
+    protected:
+    std::shared_ptr<CellList> m_cl; //!< The cell list
+
+    /// Track when the cell size needs to be updated
+    bool m_update_cell_size = true;
+
+    unsigned int m_cluster_size = 4;     //!< Number of particles per cluster
+    unsigned int m_n_local_clusters = 0; //!< Number of clusters of local particles
+    unsigned int m_n_clusters = 0;       //!< Number of local and ghost clusters
+
+    std::vector<unsigned int> m_cluster_particles;   //!< Particle indices of each cluster slot
+    std::vector<Scalar4> m_cluster_sphere;           //!< Bounding sphere center and radius
+    std::vector<unsigned int> m_cluster_cell;        //!< Cell of each local cluster
+    std::vector<unsigned int> m_local_cluster_start; //!< First local cluster of each cell
+    std::vector<unsigned int> m_ghost_cluster_start; //!< First ghost cluster of each cell
+    std::vector<unsigned int> m_particle_slot;       //!< Cluster slot of each local particle
+
+    std::vector<size_t> m_cluster_head_list;     //!< Offset of each i-cluster's j-clusters
+    std::vector<unsigned int> m_n_cluster_neigh; //!< Number of j-clusters of each i-cluster
+    std::vector<unsigned int> m_cluster_nlist;   //!< j-cluster indices
+    std::vector<uint64_t> m_cluster_masks;       //!< Interaction mask of each cluster pair
+
+    /// True when the per-particle neighbor list matches the cluster pairs
+    bool m_particle_nlist_current = false;
+
+    //! Builds the neighbor list
+    virtual void buildNlist(uint64_t timestep);
+
+    //! Build the head list and mark the per-particle neighbor list out of date
+    virtual void buildHeadList();
+
+    //! Excluded pairs are already removed from the interaction masks
+    virtual void filterNlist() { }
+
+    //! Expand the cluster pairs into the per-particle neighbor list when it is out of date
+    virtual void updateParticleNlist() const;
+
+    //! Group the particles in each cell into clusters
+    void buildClusters();
+
+    //! Find the j-clusters of each i-cluster and their interaction masks
+    void buildClusterPairs();
+
+    //! Expand the cluster pairs into the per-particle neighbor list, growing it as needed
+    void expandClusterPairs();
+
+    //! Fill the per-particle neighbor list from the cluster pairs in one pass
+    void fillParticleNlist();
+
+    //! Call kernel(i) for every i in [0, n), in parallel when threads are available
+    template<class Kernel> void forEachIndex(unsigned int n, const Kernel& kernel);
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -32,9 +32,13 @@ NeighborListStencil::NeighborListStencil(std::shared_ptr<SystemDefinition> sysde
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListStencil" << endl;
 
+    // read positions from a compressed structure of arrays cell list
     m_cl->setRadius(1);
+    m_cl->setCompressed(true);
+    m_cl->setComputeXYZF(false);
+    m_cl->setComputeSoA(true);
+    m_cl->setComputeIdx(true);
     m_cl->setComputeTypeBody(true);
-    m_cl->setFlagIndex();
     m_cl->setComputeAdjList(false);
     }
 
@@ -124,12 +128,15 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
 
     // access the cell list data arrays
-    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
-                                          access_location::host,
-                                          access_mode::read);
-    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
-                                     access_location::host,
-                                     access_mode::read);
+    ArrayHandle<unsigned int> h_cell_start(m_cl->getCellStartArray(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> h_cell_idx(m_cl->getIndexArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<Scalar> h_cell_x(m_cl->getXArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_cell_y(m_cl->getYArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_cell_z(m_cl->getZArray(), access_location::host, access_mode::read);
     ArrayHandle<uint2> h_cell_type_body(m_cl->getTypeBodyArray(),
                                         access_location::host,
                                         access_mode::read);
@@ -150,13 +157,10 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
 
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
-    Index2D cli = m_cl->getCellListIndexer();
 
-    // for each local particle
-    unsigned int nparticles = m_pdata->getN();
-
-    for (int i = 0; i < (int)nparticles; i++)
-        {
+    // build the neighbor list of each local particle, in parallel when threads are available
+    auto build_particle = [&](int i, unsigned int* conditions)
+    {
         unsigned int cur_n_neigh = 0;
 
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -238,12 +242,12 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
             unsigned int neigh_cell = ci(sib, sjb, skb);
 
             // check against all the particles in that neighboring bin to see if it is a neighbor
-            unsigned int size = h_cell_size.data[neigh_cell];
-            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            const unsigned int cell_last = h_cell_start.data[neigh_cell + 1];
+            for (unsigned int cur_slot = h_cell_start.data[neigh_cell]; cur_slot < cell_last;
+                 cur_slot++)
                 {
-                // read in the particle type (diameter and body as well while we've got the Scalar4
-                // in)
-                const uint2& neigh_type_body = h_cell_type_body.data[cli(cur_offset, neigh_cell)];
+                // read in the particle type and body
+                const uint2& neigh_type_body = h_cell_type_body.data[cur_slot];
                 const unsigned int type_j = neigh_type_body.x;
                 const unsigned int body_j = neigh_type_body.y;
 
@@ -266,14 +270,15 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
                     continue;
 
                 // only load in the particle position and id if distance check is satisfied
-                const Scalar4& neigh_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
-                unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
+                unsigned int cur_neigh = h_cell_idx.data[cur_slot];
 
                 // a particle cannot neighbor itself
                 if (i == (int)cur_neigh)
                     continue;
 
-                Scalar3 neigh_pos = make_scalar3(neigh_xyzf.x, neigh_xyzf.y, neigh_xyzf.z);
+                Scalar3 neigh_pos = make_scalar3(h_cell_x.data[cur_slot],
+                                                 h_cell_y.data[cur_slot],
+                                                 h_cell_z.data[cur_slot]);
                 Scalar3 dx = my_pos - neigh_pos;
                 dx = box.minImage(dx);
 
@@ -289,8 +294,7 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
                             h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
                         else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
+                            conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
 
                         ++cur_n_neigh;
                         }
@@ -299,7 +303,9 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
             }
 
         h_n_neigh.data[i] = cur_n_neigh;
-        }
+    };
+
+    forEachLocalParticle(h_conditions.data, build_particle);
     }
 
 namespace detail
@@ -293,9 +293,9 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
-    // Loop over all particles
-    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
-        {
+    // traverse the trees for each local particle, in parallel when threads are available
+    auto traverse_particle = [&](unsigned int i, unsigned int* conditions)
+    {
         // read in the current position and orientation
         const Scalar4 postype_i = h_postype.data[i];
         const vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
@@ -370,8 +370,8 @@ void NeighborListTree::traverseTree()
                                             if (n_neigh_i < Nmax_i)
                                                 h_nlist.data[nlist_head_i + n_neigh_i] = j;
                                             else
-                                                h_conditions.data[type_i]
-                                                    = max(h_conditions.data[type_i], n_neigh_i + 1);
+                                                conditions[type_i]
+                                                    = max(conditions[type_i], n_neigh_i + 1);
 
                                             ++n_neigh_i;
                                             }
@@ -389,7 +389,9 @@ void NeighborListTree::traverseTree()
                 } // end loop over images
             } // end loop over pair types
         h_n_neigh.data[i] = n_neigh_i;
-        } // end loop over particles
+    };
+
+    forEachLocalParticle(h_conditions.data, traverse_particle);
     }
 
 namespace detail
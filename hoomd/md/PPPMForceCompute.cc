@@ -4,6 +4,10 @@
 #include "PPPMForceCompute.h"
 #include <map>
 
+#ifdef ENABLE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 namespace md
@@ -527,10 +531,14 @@ void PPPMForceCompute::initializeFFT()
 
     if (local_fft)
         {
+        // the charge density is real: with an even number of x points, pack pairs of x points
+        // into one complex value and run a transform of half the size
+        m_kiss_fft_r2c = (m_mesh_points.x % 2 == 0);
+
         int dims[3];
         dims[0] = m_mesh_points.z;
         dims[1] = m_mesh_points.y;
-        dims[2] = m_mesh_points.x;
+        dims[2] = m_kiss_fft_r2c ? m_mesh_points.x / 2 : m_mesh_points.x;
 
         if (m_kiss_fft)
             {
@@ -544,6 +552,21 @@ void PPPMForceCompute::initializeFFT()
         m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
         m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
 
+        if (m_kiss_fft_r2c)
+            {
+            unsigned int n_half = m_n_inner_cells / 2;
+            m_r2c_in.resize(n_half);
+            m_r2c_out.resize(n_half);
+
+            m_r2c_twiddle.resize(m_mesh_points.x);
+            for (unsigned int kx = 0; kx < m_mesh_points.x; ++kx)
+                {
+                double phase = -2.0 * M_PI * double(kx) / double(m_mesh_points.x);
+                m_r2c_twiddle[kx].r = float(cos(phase));
+                m_r2c_twiddle[kx].i = float(sin(phase));
+                }
+            }
+
         m_kiss_fft_initialized = true;
         }
 
@@ -577,6 +600,152 @@ void PPPMForceCompute::initializeFFT()
     m_inv_fourier_mesh_z.swap(inv_fourier_mesh_z);
     }
 
+/*! \param n Number of indices
+    \param kernel Callable kernel(i) that only writes data owned by index i
+*/
+template<class Kernel> void PPPMForceCompute::forEachIndex(unsigned int n, const Kernel& kernel)
+    {
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1 && n > 0)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          kernel(i);
+                                  });
+            });
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < n; ++i)
+            kernel(i);
+        }
+    }
+
+/*! \param in Local mesh of m_n_inner_cells values, only the real parts are read
+    \param out Full (Hermitian) spectrum of m_n_inner_cells values
+
+    With x packed as z[n] = in[2n] + i in[2n+1], the half size transform Z gives the transforms of
+    the even and odd samples as E = (Z[k] + Z*[-k]) / 2 and O = (Z[k] - Z*[-k]) / 2i, and the
+    spectrum of the real mesh is X[k] = E[k] + exp(-2 pi i k_x / N_x) O[k].
+*/
+void PPPMForceCompute::forwardFFTReal(const kiss_fft_cpx* in, kiss_fft_cpx* out)
+    {
+    const unsigned int nx = m_mesh_points.x;
+    const unsigned int ny = m_mesh_points.y;
+    const unsigned int nz = m_mesh_points.z;
+    const unsigned int n_half_x = nx / 2;
+    const unsigned int n_half = m_n_inner_cells / 2;
+
+    for (unsigned int n = 0; n < n_half; ++n)
+        {
+        m_r2c_in[n].r = in[2 * n].r;
+        m_r2c_in[n].i = in[2 * n + 1].r;
+        }
+
+    kiss_fftnd(m_kiss_fft, m_r2c_in.data(), m_r2c_out.data());
+
+    const kiss_fft_cpx* Z = m_r2c_out.data();
+    const kiss_fft_cpx* twiddle = m_r2c_twiddle.data();
+
+    // unpack one row of constant (k_y, k_z) at a time
+    forEachIndex(ny * nz,
+                 [&](unsigned int row)
+                 {
+                     unsigned int ky = row % ny;
+                     unsigned int kz = row / ny;
+                     unsigned int row_neg = (nz - kz) % nz * ny + (ny - ky) % ny;
+
+                     for (unsigned int kx = 0; kx < nx; ++kx)
+                         {
+                         unsigned int k = kx % n_half_x;
+                         kiss_fft_cpx z = Z[row * n_half_x + k];
+                         kiss_fft_cpx z_neg = Z[row_neg * n_half_x + (n_half_x - k) % n_half_x];
+
+                         Scalar even_r = Scalar(0.5) * (z.r + z_neg.r);
+                         Scalar even_i = Scalar(0.5) * (z.i - z_neg.i);
+                         Scalar odd_r = Scalar(0.5) * (z.i + z_neg.i);
+                         Scalar odd_i = Scalar(-0.5) * (z.r - z_neg.r);
+
+                         kiss_fft_cpx w = twiddle[kx];
+                         out[row * nx + kx].r = float(even_r + w.r * odd_r - w.i * odd_i);
+                         out[row * nx + kx].i = float(even_i + w.r * odd_i + w.i * odd_r);
+                         }
+                 });
+    }
+
+/*! \param in Full spectrum of m_n_inner_cells values
+    \param out Local mesh of m_n_inner_cells values, receives the real part of the inverse transform
+
+    Only the Hermitian part H[k] = (Y[k] + Y*[-k]) / 2 of the spectrum contributes to the real part
+    of the inverse transform. The even and odd samples of the result are the inverse transforms of
+    E[k] = H[k] + H[k + N_x/2] and O[k] = (H[k] - H[k + N_x/2]) exp(2 pi i k_x / N_x), which are
+    computed together as the half size inverse transform of E + i O.
+*/
+void PPPMForceCompute::inverseFFTReal(const kiss_fft_cpx* in, kiss_fft_cpx* out)
+    {
+    const unsigned int nx = m_mesh_points.x;
+    const unsigned int ny = m_mesh_points.y;
+    const unsigned int nz = m_mesh_points.z;
+    const unsigned int n_half_x = nx / 2;
+    const unsigned int n_half = m_n_inner_cells / 2;
+
+    kiss_fft_cpx* Z = m_r2c_in.data();
+    const kiss_fft_cpx* twiddle = m_r2c_twiddle.data();
+
+    forEachIndex(ny * nz,
+                 [&](unsigned int row)
+                 {
+                     unsigned int ky = row % ny;
+                     unsigned int kz = row / ny;
+                     unsigned int row_neg = (nz - kz) % nz * ny + (ny - ky) % ny;
+
+                     // Hermitian part of the spectrum at (k_x, k_y, k_z)
+                     auto hermitian = [&](unsigned int kx, Scalar& h_r, Scalar& h_i)
+                     {
+                         kiss_fft_cpx y = in[row * nx + kx];
+                         kiss_fft_cpx y_neg = in[row_neg * nx + (nx - kx) % nx];
+                         h_r = Scalar(0.5) * (y.r + y_neg.r);
+                         h_i = Scalar(0.5) * (y.i - y_neg.i);
+                     };
+
+                     for (unsigned int k = 0; k < n_half_x; ++k)
+                         {
+                         Scalar h0_r, h0_i, h1_r, h1_i;
+                         hermitian(k, h0_r, h0_i);
+                         hermitian(k + n_half_x, h1_r, h1_i);
+
+                         Scalar even_r = h0_r + h1_r;
+                         Scalar even_i = h0_i + h1_i;
+
+                         // multiply by the complex conjugate of the forward twiddle factor
+                         kiss_fft_cpx w = twiddle[k];
+                         Scalar diff_r = h0_r - h1_r;
+                         Scalar diff_i = h0_i - h1_i;
+                         Scalar odd_r = diff_r * w.r + diff_i * w.i;
+                         Scalar odd_i = diff_i * w.r - diff_r * w.i;
+
+                         Z[row * n_half_x + k].r = float(even_r - odd_i);
+                         Z[row * n_half_x + k].i = float(even_i + odd_r);
+                         }
+                 });
+
+    kiss_fftnd(m_kiss_ifft, m_r2c_in.data(), m_r2c_out.data());
+
+    for (unsigned int n = 0; n < n_half; ++n)
+        {
+        out[2 * n].r = m_r2c_out[n].r;
+        out[2 * n].i = 0.0f;
+        out[2 * n + 1].r = m_r2c_out[n].i;
+        out[2 * n + 1].i = 0.0f;
+        }
+    }
+
 //! CPU implementation of sinc(x)==sin(x)/x
 inline Scalar sinc(Scalar x)
     {
@@ -783,18 +952,23 @@ void PPPMForceCompute::assignParticles()
 
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
 
-    const BoxDim& box = m_pdata->getBox();
+    unsigned int group_size = m_group->getNumMembers();
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
 
-    // set mesh to zero
-    memset(h_mesh.data, 0, sizeof(kiss_fft_cpx) * m_mesh.getNumElements());
+    const BoxDim& box = m_pdata->getBox();
 
     Scalar V_cell = box.getVolume() / (Scalar)(m_mesh_points.x * m_mesh_points.y * m_mesh_points.z);
 
-    // loop over group
-    unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+    int nlower = -(m_order - 1) / 2;
+    int nupper = m_order / 2;
+
+    // find the mesh cell of a group member and its offset from the cell center, returns false
+    // when the particle is not spread
+    auto find_cell = [&](unsigned int group_idx, int3& cell, Scalar3& d)
+    {
+        unsigned int idx = h_index_array.data[group_idx];
 
         Scalar4 postype = h_postype.data[idx];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -802,11 +976,9 @@ void PPPMForceCompute::assignParticles()
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return false;
             }
 
-        Scalar qi = h_charge.data[idx];
-
         // compute coordinates in units of the mesh size
         Scalar3 f = box.makeFraction(pos);
         Scalar3 reduced_pos = make_scalar3(f.x * (Scalar)m_mesh_points.x,
@@ -851,15 +1023,29 @@ void PPPMForceCompute::assignParticles()
             || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return false;
             }
 
+        cell = make_int3(ix, iy, iz);
+        d = make_scalar3(dx, dy, dz);
+        return true;
+    };
+
+    // spread the charge of one group member, deposit(cell, charge) adds to the mesh
+    auto spread_particle = [&](unsigned int group_idx, auto&& deposit)
+    {
+        int3 cell;
+        Scalar3 d;
+        if (!find_cell(group_idx, cell, d))
+            return;
+
+        const int ix = cell.x, iy = cell.y, iz = cell.z;
+        const Scalar dx = d.x, dy = d.y, dz = d.z;
+        Scalar qi = h_charge.data[h_index_array.data[group_idx]];
+
         int mult_fact = 2 * m_order + 1;
         Scalar Wx, Wy, Wz;
 
-        int nlower = -(m_order - 1) / 2;
-        int nupper = m_order / 2;
-
         for (int i = nlower; i <= nupper; ++i)
             {
             Wx = Scalar(0.0);
@@ -919,11 +1105,79 @@ void PPPMForceCompute::assignParticles()
                     unsigned int neigh_idx
                         = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
 
-                    h_mesh.data[neigh_idx].r += float(qi * W / V_cell);
+                    deposit(neigh_idx, qi * W / V_cell);
                     }
                 }
             }
-        } // end loop over particles
+    };
+
+    // set mesh to zero
+    memset(h_mesh.data, 0, sizeof(kiss_fft_cpx) * m_mesh.getNumElements());
+
+#ifdef ENABLE_TBB
+    // The stencil of a particle covers m_order cells in z starting at its lowest cell. Stencils
+    // that start in z slabs of at least m_order cells, two slabs apart, never write to the same
+    // cell. So the particles of all even slabs are spread in parallel, then those of the odd
+    // slabs. Without ghost cells the mesh is periodic in z and the first and last slabs touch,
+    // which needs an even number of slabs.
+    unsigned int n_slabs = m_grid_dim.z / (unsigned int)m_order;
+    if (!m_n_ghost_cells.z)
+        n_slabs -= n_slabs % 2;
+
+    if (m_exec_conf->getNumThreads() > 1 && group_size > 0 && n_slabs >= 2)
+        {
+        const unsigned int slab_size = m_grid_dim.z / n_slabs;
+
+        // slab n_slabs holds the particles that are not spread
+        m_particle_slab.resize(group_size);
+        forEachIndex(group_size,
+                     [&](unsigned int group_idx)
+                     {
+                         int3 cell;
+                         Scalar3 d;
+                         unsigned int slab = n_slabs;
+                         if (find_cell(group_idx, cell, d))
+                             {
+                             int lo = cell.z + nlower;
+                             if (lo < 0)
+                                 lo = m_n_ghost_cells.z ? 0 : lo + (int)m_grid_dim.z;
+                             slab = std::min((unsigned int)lo / slab_size, n_slabs - 1);
+                             }
+                         m_particle_slab[group_idx] = slab;
+                     });
+
+        // sort the group members by slab, keeping the group order within a slab
+        m_slab_start.assign(n_slabs + 2, 0);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            m_slab_start[m_particle_slab[group_idx] + 1]++;
+        for (unsigned int slab = 0; slab <= n_slabs; slab++)
+            m_slab_start[slab + 1] += m_slab_start[slab];
+        m_slab_particles.resize(group_size);
+        m_slab_fill.assign(m_slab_start.begin(), m_slab_start.end() - 1);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            m_slab_particles[m_slab_fill[m_particle_slab[group_idx]]++] = group_idx;
+
+        for (unsigned int color = 0; color < 2; color++)
+            {
+            forEachIndex((n_slabs + 1 - color) / 2,
+                         [&](unsigned int i)
+                         {
+                             const unsigned int slab = 2 * i + color;
+                             for (unsigned int k = m_slab_start[slab]; k < m_slab_start[slab + 1];
+                                  k++)
+                                 spread_particle(m_slab_particles[k],
+                                                 [&](unsigned int cell, Scalar q)
+                                                 { h_mesh.data[cell].r += float(q); });
+                         });
+            }
+        }
+    else
+#endif
+        {
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            spread_particle(group_idx,
+                            [&](unsigned int cell, Scalar q) { h_mesh.data[cell].r += float(q); });
+        }
     }
 
 void PPPMForceCompute::updateMeshes()
@@ -936,7 +1190,10 @@ void PPPMForceCompute::updateMeshes()
                                                  access_location::host,
                                                  access_mode::overwrite);
 
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        if (m_kiss_fft_r2c)
+            forwardFFTReal(h_mesh.data, h_fourier_mesh.data);
+        else
+            kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
         }
 
 #ifdef ENABLE_MPI
@@ -980,8 +1237,8 @@ void PPPMForceCompute::updateMeshes()
         unsigned int NNN = m_global_dim.x * m_global_dim.y * m_global_dim.z;
 
         // multiply with influence function and I*k
-        for (unsigned int k = 0; k < m_n_inner_cells; ++k)
-            {
+        auto multiply_cell = [&](unsigned int k)
+        {
             kiss_fft_cpx f = h_fourier_mesh.data[k];
 
             Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
@@ -996,7 +1253,9 @@ void PPPMForceCompute::updateMeshes()
 
             h_fourier_mesh_G_z.data[k].r = float(f.i * kvec.z * scaled_inf_f);
             h_fourier_mesh_G_z.data[k].i = float(-f.r * kvec.z * scaled_inf_f);
-            }
+        };
+
+        forEachIndex(m_n_inner_cells, multiply_cell);
         }
 
     if (m_kiss_fft_initialized)
@@ -1020,9 +1279,18 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
                                                        access_location::host,
                                                        access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        if (m_kiss_fft_r2c)
+            {
+            inverseFFTReal(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
+            inverseFFTReal(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+            inverseFFTReal(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+            }
+        else
+            {
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+            }
         }
 
 #ifdef ENABLE_MPI
@@ -1108,11 +1376,15 @@ void PPPMForceCompute::interpolateForces()
 
     const BoxDim& box = m_pdata->getBox();
 
-    // loop over group
     unsigned int group_size = m_group->getNumMembers();
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-        {
-        unsigned int idx = m_group->getMemberIndex(group_idx);
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
+
+    // interpolate the force on one group member, which only writes its own force
+    auto interpolate_particle = [&](unsigned int group_idx)
+    {
+        unsigned int idx = h_index_array.data[group_idx];
         Scalar4 postype = h_postype.data[idx];
 
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -1120,7 +1392,7 @@ void PPPMForceCompute::interpolateForces()
         // ignore if NaN
         if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
             {
-            continue;
+            return;
             }
 
         Scalar qi = h_charge.data[idx];
@@ -1168,7 +1440,7 @@ void PPPMForceCompute::interpolateForces()
             || iz >= (int)m_grid_dim.z)
             {
             // ignore, error will be thrown elsewhere (in CellList)
-            continue;
+            return;
             }
 
         Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
@@ -1248,7 +1520,9 @@ void PPPMForceCompute::interpolateForces()
             }
 
         h_force.data[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
-        } // end of loop over particles
+    };
+
+    forEachIndex(group_size, interpolate_particle);
     }
 
 Scalar PPPMForceCompute::computePE()
@@ -17,6 +17,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
 
 namespace hoomd
     {
@@ -201,6 +202,19 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     kiss_fftnd_cfg m_kiss_fft = NULL;  //!< The FFT configuration
     kiss_fftnd_cfg m_kiss_ifft = NULL; //!< Inverse FFT configuration
 
+    //! True when the local FFT packs the real mesh into a half size complex transform
+    bool m_kiss_fft_r2c = false;
+    std::vector<kiss_fft_cpx> m_r2c_in;      //!< Packed real data of the half size transform
+    std::vector<kiss_fft_cpx> m_r2c_out;     //!< Spectrum of the half size transform
+    std::vector<kiss_fft_cpx> m_r2c_twiddle; //!< exp(-2 pi i k_x / N_x) for 0 <= k_x < N_x
+
+#ifdef ENABLE_TBB
+    std::vector<unsigned int> m_particle_slab;  //!< z slab of the mesh of each group member
+    std::vector<unsigned int> m_slab_start;     //!< First entry of each slab in m_slab_particles
+    std::vector<unsigned int> m_slab_fill;      //!< Next free entry of each slab while sorting
+    std::vector<unsigned int> m_slab_particles; //!< Group members sorted by slab
+#endif
+
 #ifdef ENABLE_MPI
     dfft_plan m_dfft_plan_forward; //!< Distributed FFT for forward transform
     dfft_plan m_dfft_plan_inverse; //!< Distributed FFT for inverse transform
@@ -232,6 +246,15 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     //! Compute virial on mesh
     void computeVirialMesh();
 
+    //! Forward transform of the real local mesh \a in into the full spectrum \a out
+    void forwardFFTReal(const kiss_fft_cpx* in, kiss_fft_cpx* out);
+
+    //! Inverse transform of the spectrum \a in into the real parts of \a out
+    void inverseFFTReal(const kiss_fft_cpx* in, kiss_fft_cpx* out);
+
+    //! Call kernel(i) for every i in [0, n), in parallel when threads are available
+    template<class Kernel> void forEachIndex(unsigned int n, const Kernel& kernel);
+
     //! Compute number of ghost cellso
     uint3 computeGhostCellNum();
 
@@ -0,0 +1,117 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_BATCH_H__
+#define __PAIR_EVALUATOR_BATCH_H__
+
+#include "hoomd/HOOMDMath.h"
+
+#include <type_traits>
+
+/*! \file PairEvaluatorBatch.h
+    \brief Defines helpers for evaluating several pairs at once with a pair evaluator
+    \details Pair evaluators may optionally implement the static method
+
+    \code
+    static void evalForceAndEnergyN(unsigned int n,
+                                    const Scalar* rsq,
+                                    const Scalar* rcutsq,
+                                    const param_type* const* params,
+                                    const bool* energy_shift,
+                                    Scalar* force_divr,
+                                    Scalar* pair_eng,
+                                    bool* evaluated);
+    \endcode
+
+    which evaluates \a n <= pair_batch_width pairs given in structure of arrays form. Lane \a l of
+    each output is set as if a scalar evaluator had been constructed with rsq[l], rcutsq[l], and
+    *params[l] and evalForceAndEnergy(force_divr[l], pair_eng[l], energy_shift[l]) had been
+    called. Implementations gather the per lane parameters into local arrays and then perform the
+    arithmetic in branch free loops over all pair_batch_width lanes. Lanes at or beyond \a n
+    contain padding values (rsq > rcutsq) that implementations may evaluate and must not report as
+    evaluated.
+
+    This is a scalar restructuring of the pair loop. The batched evaluators use no SIMD intrinsics
+    or pragmas, and their lane loops are vectorized only when the compiler chooses to at the
+    optimization level and target of the build.
+
+    PotentialPair uses the batched path for evaluators that provide evalForceAndEnergyN and the
+    scalar evaluator otherwise. The batched path passes no charges, so batched evaluators must
+    declare a constexpr needsCharge() that returns false. evalForceAndEnergyBatch() checks this at
+    compile time.
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Number of pairs evaluated together by batched pair evaluators
+const unsigned int pair_batch_width = 8;
+
+//! Detect whether an evaluator implements evalForceAndEnergyN
+template<class evaluator, class = void> struct has_batched_eval : std::false_type
+    {
+    };
+
+template<class evaluator>
+struct has_batched_eval<evaluator, std::void_t<decltype(&evaluator::evalForceAndEnergyN)>>
+    : std::true_type
+    {
+    };
+
+//! Evaluate a batch of pairs with the evaluator's batched method or the scalar fallback
+/*! \param n Number of valid lanes
+    \param rsq Squared pair distances
+    \param rcutsq Squared cutoff radii
+    \param params Pointers to the type pair parameters
+    \param energy_shift Per lane energy shift flags
+    \param force_divr Output force divided by r
+    \param pair_eng Output pair energy
+    \param evaluated Output flag set to true when the pair is inside the cutoff
+*/
+template<class evaluator>
+inline void evalForceAndEnergyBatch(unsigned int n,
+                                    const Scalar* rsq,
+                                    const Scalar* rcutsq,
+                                    const typename evaluator::param_type* const* params,
+                                    const bool* energy_shift,
+                                    Scalar* force_divr,
+                                    Scalar* pair_eng,
+                                    bool* evaluated)
+    {
+    static_assert(!evaluator::needsCharge(), "Batched pair evaluators cannot use charges.");
+
+    if constexpr (has_batched_eval<evaluator>::value)
+        {
+        evaluator::evalForceAndEnergyN(n,
+                                       rsq,
+                                       rcutsq,
+                                       params,
+                                       energy_shift,
+                                       force_divr,
+                                       pair_eng,
+                                       evaluated);
+        }
+    else
+        {
+        for (unsigned int l = 0; l < n; ++l)
+            {
+            force_divr[l] = Scalar(0.0);
+            pair_eng[l] = Scalar(0.0);
+            evaluator eval(rsq[l], rcutsq[l], *params[l]);
+            evaluated[l] = eval.evalForceAndEnergy(force_divr[l], pair_eng[l], energy_shift[l]);
+            }
+        }
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_EVALUATOR_BATCH_H__
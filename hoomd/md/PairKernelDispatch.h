@@ -0,0 +1,99 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_KERNEL_DISPATCH_H__
+#define __PAIR_KERNEL_DISPATCH_H__
+
+#include <stdexcept>
+#include <type_traits>
+
+/*! \file PairKernelDispatch.h
+    \brief Selects a compile time specialized pair force kernel from run time settings
+    \details The CPU pair force loops are templated on the energy shift mode, whether the virial
+    is computed, and whether the neighbor list is half (third law) or full. dispatchPairKernel
+    converts the run time values into std::integral_constant arguments once per call so that the
+    inner loop of the selected kernel contains no mode branches.
+
+    \code
+    dispatchPairKernel<3>(m_shift_mode,
+                          compute_virial,
+                          third_law,
+                          [&](auto shift_mode, auto compute_virial, auto third_law)
+                          {
+                              computeForcesKernel<decltype(shift_mode)::value,
+                                                  decltype(compute_virial)::value,
+                                                  decltype(third_law)::value>(...);
+                          });
+    \endcode
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Call \a kernel with the shift mode as a std::integral_constant
+template<unsigned int mode, unsigned int n_shift_modes, class Kernel>
+inline void dispatchShiftMode(unsigned int shift_mode, Kernel&& kernel)
+    {
+    if constexpr (mode < n_shift_modes)
+        {
+        if (shift_mode == mode)
+            {
+            kernel(std::integral_constant<unsigned int, mode>());
+            }
+        else
+            {
+            dispatchShiftMode<mode + 1, n_shift_modes>(shift_mode, kernel);
+            }
+        }
+    else
+        {
+        throw std::runtime_error("Invalid energy shift mode.");
+        }
+    }
+
+//! Call \a kernel with \a value as a std::bool_constant
+template<class Kernel> inline void dispatchBool(bool value, Kernel&& kernel)
+    {
+    if (value)
+        kernel(std::true_type());
+    else
+        kernel(std::false_type());
+    }
+
+//! Call a pair force kernel specialized on the shift mode, virial flag, and third law flag
+/*! \tparam n_shift_modes Number of energy shift modes the caller supports (modes are 0 based)
+    \param shift_mode Energy shift mode
+    \param compute_virial Set to true when the virial is needed
+    \param third_law Set to true when the neighbor list is half
+    \param kernel Generic callable taking three std::integral_constant arguments
+*/
+template<unsigned int n_shift_modes, class Kernel>
+inline void
+dispatchPairKernel(unsigned int shift_mode, bool compute_virial, bool third_law, Kernel&& kernel)
+    {
+    dispatchShiftMode<0, n_shift_modes>(
+        shift_mode,
+        [&](auto shift_mode_c)
+        {
+            dispatchBool(compute_virial,
+                         [&](auto compute_virial_c)
+                         {
+                             dispatchBool(third_law,
+                                          [&](auto third_law_c)
+                                          { kernel(shift_mode_c, compute_virial_c, third_law_c); });
+                         });
+        });
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_KERNEL_DISPATCH_H__
@@ -58,14 +58,59 @@ template<class evaluator, class Bonds> class PotentialBond : public ForceCompute
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! Compute the forces of the bonds between local particles
+    virtual void computeInterior(uint64_t timestep);
 #endif
 
+    /// Bond forces can be added directly into the net force arrays
+    virtual bool supportsNetForceAccumulation()
+        {
+        return true;
+        }
+
     protected:
     GPUArray<param_type> m_params;      //!< Bond parameters per type
     std::shared_ptr<Bonds> m_bond_data; //!< Bond data to use in computing bonds
 
+    //! Subsets of the bonds evaluated by computeForcesInto()
+    enum bond_subset
+        {
+        all_bonds,      //!< All bonds
+        interior_bonds, //!< Bonds whose members are all local particles
+        boundary_bonds  //!< Bonds with at least one ghost member
+        };
+
+#ifdef ENABLE_MPI
+    bool m_has_interior = false;      //!< True when m_force holds the interior bond forces
+    uint64_t m_interior_timestep = 0; //!< Time step of the last call to computeInterior()
+
+    //! Invalidate the interior forces when particle indices change
+    void slotGhostParticlesRemoved()
+        {
+        m_has_interior = false;
+        }
+#endif
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Add the bond forces directly into the net force arrays
+    virtual double accumulateForces(uint64_t timestep,
+                                    Scalar4* force,
+                                    Scalar* virial,
+                                    size_t virial_pitch,
+                                    Scalar4* torque)
+        {
+        return computeForcesInto(timestep, force, virial, virial_pitch);
+        }
+
+    //! Compute the bond forces and add them to the given force and virial arrays
+    double computeForcesInto(uint64_t timestep,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch,
+                             bond_subset subset = all_bonds);
     };
 
 template<class evaluator, class Bonds>
@@ -82,6 +127,12 @@ PotentialBond<evaluator, Bonds>::PotentialBond(std::shared_ptr<SystemDefinition>
     // allocate the parameters
     GPUArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+#ifdef ENABLE_MPI
+    m_pdata->getGhostParticlesRemovedSignal()
+        .connect<PotentialBond<evaluator, Bonds>,
+                 &PotentialBond<evaluator, Bonds>::slotGhostParticlesRemoved>(this);
+#endif
     }
 
 template<class evaluator, class Bonds>
@@ -99,12 +150,24 @@ PotentialBond<evaluator, Bonds>::PotentialBond(std::shared_ptr<SystemDefinition>
     // allocate the parameters
     GPUArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+#ifdef ENABLE_MPI
+    m_pdata->getGhostParticlesRemovedSignal()
+        .connect<PotentialBond<evaluator, Bonds>,
+                 &PotentialBond<evaluator, Bonds>::slotGhostParticlesRemoved>(this);
+#endif
     }
 
 template<class evaluator, class Bonds> PotentialBond<evaluator, Bonds>::~PotentialBond()
     {
     m_exec_conf->msg->notice(5) << "Destroying PotentialBond<" << evaluator::getName() << ">"
                                 << std::endl;
+
+#ifdef ENABLE_MPI
+    m_pdata->getGhostParticlesRemovedSignal()
+        .disconnect<PotentialBond<evaluator, Bonds>,
+                    &PotentialBond<evaluator, Bonds>::slotGhostParticlesRemoved>(this);
+#endif
     }
 
 /*! \param type Type of the bond to set parameters for
@@ -166,6 +229,44 @@ pybind11::dict PotentialBond<evaluator, Bonds>::getParams(std::string type)
 template<class evaluator, class Bonds>
 void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
     {
+#ifdef ENABLE_MPI
+    // only the bonds with ghost members remain after computeInterior()
+    bool has_interior = m_has_interior && m_interior_timestep == timestep;
+    m_has_interior = false;
+    if (has_interior)
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::readwrite);
+
+        computeForcesInto(timestep, h_force.data, h_virial.data, m_virial_pitch, boundary_bonds);
+        return;
+        }
+#endif
+
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+    // Zero data for force calculation
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+    computeForcesInto(timestep, h_force.data, h_virial.data, m_virial_pitch);
+    }
+
+/*! \param timestep Current time step
+    \param force Force array to add into
+    \param virial Virial array to add into
+    \param virial_pitch Pitch of \a virial
+    \param subset Subset of the bonds to evaluate
+    \returns The potential energy added to the local particles
+ */
+template<class evaluator, class Bonds>
+double PotentialBond<evaluator, Bonds>::computeForcesInto(uint64_t timestep,
+                                                          Scalar4* force,
+                                                          Scalar* virial,
+                                                          size_t virial_pitch,
+                                                          bond_subset subset)
+    {
     assert(m_pdata);
 
     // access the particle data arrays
@@ -173,22 +274,15 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::readwrite);
-
     // access the parameters
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
-    assert(h_force.data);
-    assert(h_virial.data);
+    assert(force);
+    assert(virial);
     assert(h_pos.data);
     assert(h_charge.data);
 
-    // Zero data for force calculation
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
-
     // we are using the minimum image of the global box here
     // to ensure that ghosts are always correctly wrapped (even if a bond exceeds half the domain
     // length)
@@ -209,6 +303,7 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
                                      access_mode::read);
 
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+    double energy = 0.0;
 
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
@@ -233,6 +328,13 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
             throw std::runtime_error(stream.str());
             }
 
+        if (subset != all_bonds)
+            {
+            bool interior = idx_a < m_pdata->getN() && idx_b < m_pdata->getN();
+            if (interior != (subset == interior_bonds))
+                continue;
+            }
+
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
         Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
@@ -284,24 +386,26 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
             // add the force to the particles (only for non-ghost particles)
             if (idx_b < m_pdata->getN())
                 {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                force[idx_b].x += force_divr * dx.x;
+                force[idx_b].y += force_divr * dx.y;
+                force[idx_b].z += force_divr * dx.z;
+                force[idx_b].w += bond_eng;
+                energy += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_b] += bond_virial[i];
+                        virial[i * virial_pitch + idx_b] += bond_virial[i];
                 }
 
             if (idx_a < m_pdata->getN())
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                force[idx_a].x -= force_divr * dx.x;
+                force[idx_a].y -= force_divr * dx.y;
+                force[idx_a].z -= force_divr * dx.z;
+                force[idx_a].w += bond_eng;
+                energy += bond_eng;
                 if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_a] += bond_virial[i];
+                        virial[i * virial_pitch + idx_a] += bond_virial[i];
                 }
             }
         else
@@ -312,6 +416,8 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
             throw std::runtime_error("Error in bond calculation");
             }
         }
+
+    return energy;
     }
 
 #ifdef ENABLE_MPI
@@ -331,6 +437,29 @@ CommFlags PotentialBond<evaluator, Bonds>::getRequestedCommFlags(uint64_t timest
 
     return flags;
     }
+
+/*! \param timestep Current time step
+
+    Bonds between local particles do not depend on the ghost positions, so their forces can be
+    computed while the ghost update is in flight. The next call to computeForces() at the same time
+    step adds the bonds with ghost members, unless particles have migrated in between.
+*/
+template<class evaluator, class Bonds>
+void PotentialBond<evaluator, Bonds>::computeInterior(uint64_t timestep)
+    {
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+        memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+        computeForcesInto(timestep, h_force.data, h_virial.data, m_virial_pitch, interior_bonds);
+        }
+
+    m_has_interior = true;
+    m_interior_timestep = timestep;
+    }
 #endif
 
 namespace detail
@@ -41,6 +41,12 @@ class PotentialBondGPU : public PotentialBond<evaluator, Bonds>
     //! Destructor
     virtual ~PotentialBondGPU() { }
 
+    //! The GPU forces are summed by Integrator::computeNetForceGPU()
+    virtual bool supportsNetForceAccumulation()
+        {
+        return false;
+        }
+
     protected:
     std::shared_ptr<Autotuner<1>> m_tuner; //!< Autotuner for block size
     GPUArray<unsigned int> m_flags;        //!< Flags set during the kernel execution
@@ -4,19 +4,27 @@
 #ifndef __POTENTIAL_PAIR_H__
 #define __POTENTIAL_PAIR_H__
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "NeighborList.h"
+#include "NeighborListCluster.h"
+#include "hoomd/BlockScatter.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/managed_allocator.h"
 #include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/PairEvaluatorBatch.h"
+#include "hoomd/md/PairKernelDispatch.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -26,6 +34,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
     \details The heart of the code that computes pair potentials is in this file.
@@ -185,6 +199,9 @@ template<class evaluator> class PotentialPair : public ForceCompute
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! Compute the forces on particles that have no ghost neighbors
+    virtual void computeInterior(uint64_t timestep);
 #endif
 
     //! Calculates the energy between two lists of particles.
@@ -222,6 +239,12 @@ template<class evaluator> class PotentialPair : public ForceCompute
     /// Check if autotuning is complete.
     virtual bool isAutotuningComplete();
 
+    /// Pair forces can be added directly into the net force arrays
+    virtual bool supportsNetForceAccumulation()
+        {
+        return true;
+        }
+
     protected:
     std::shared_ptr<NeighborList> m_nlist; //!< The neighborlist to use for the computation
     energyShiftMode m_shift_mode; //!< Store the mode with which to handle the energy shift at r_cut
@@ -245,11 +268,154 @@ template<class evaluator> class PotentialPair : public ForceCompute
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
+
+    /// True when m_force and m_virial hold the forces computed by computeInterior()
+    bool m_has_interior = false;
+
+    /// Time step of the last call to computeInterior()
+    uint64_t m_interior_timestep = 0;
+
+    /// Number of neighbor list builds at the last call to computeInterior()
+    uint64_t m_interior_nlist_builds = 0;
+#endif
+
+#ifdef ENABLE_TBB
+    /// Blocks of work items for threaded half neighbor list evaluation
+    hoomd::detail::BlockScatter m_scatter;
+
+    /// Per-block force accumulation buffers for threaded half neighbor list evaluation
+    std::vector<Scalar4> m_thread_force;
+
+    /// Per-block virial accumulation buffers for threaded half neighbor list evaluation
+    std::vector<Scalar> m_thread_virial;
+
+    /// Autotuner for the number of tasks per thread with a full neighbor list (CPU only)
+    std::shared_ptr<Autotuner<1>> m_tuner_tasks;
 #endif
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
+    //! Add the pair forces directly into the net force arrays
+    virtual double accumulateForces(uint64_t timestep,
+                                    Scalar4* force,
+                                    Scalar* virial,
+                                    size_t virial_pitch,
+                                    Scalar4* torque)
+        {
+        return computeForcesInto(timestep, force, virial, virial_pitch);
+        }
+
+    //! Compute the pair forces and add them to the given force and virial arrays
+    double computeForcesInto(
+        uint64_t timestep,
+        Scalar4* force,
+        Scalar* virial,
+        size_t virial_pitch,
+        const std::vector<std::pair<unsigned int, unsigned int>>* ranges = nullptr);
+
+    //! Compute the pair forces on a contiguous range of particles
+    void computeForcesRange(unsigned int first,
+                            unsigned int last,
+                            bool third_law,
+                            bool compute_virial,
+                            const unsigned int* n_neigh,
+                            const unsigned int* nlist,
+                            const size_t* head_list,
+                            const Scalar4* pos,
+                            const Scalar* charge,
+                            const Scalar* rcutsq_table,
+                            const Scalar* ronsq_table,
+                            const BoxDim& box,
+                            Scalar4* force,
+                            Scalar* virial,
+                            size_t virial_pitch,
+                            unsigned int offset,
+                            double& energy);
+
+    //! Pair force kernel specialized on the shift mode, virial, and neighbor list storage
+    template<unsigned int shift_mode, bool compute_virial, bool third_law>
+    void computeForcesKernel(unsigned int first,
+                             unsigned int last,
+                             const unsigned int* n_neigh,
+                             const unsigned int* nlist,
+                             const size_t* head_list,
+                             const Scalar4* pos,
+                             const Scalar* charge,
+                             const Scalar* rcutsq_table,
+                             const Scalar* ronsq_table,
+                             const BoxDim& box,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch,
+                             unsigned int offset,
+                             double& energy);
+
+    //! Compute the pair forces on a contiguous range of i-clusters of a cluster neighbor list
+    void computeForcesClusterRange(unsigned int first,
+                                   unsigned int last,
+                                   bool third_law,
+                                   bool compute_virial,
+                                   const NeighborListCluster& nlist,
+                                   const Scalar4* pos,
+                                   const Scalar* rcutsq_table,
+                                   const Scalar* ronsq_table,
+                                   const BoxDim& box,
+                                   Scalar4* force,
+                                   Scalar* virial,
+                                   size_t virial_pitch,
+                                   unsigned int offset,
+                                   double& energy);
+
+    //! Cluster pair force kernel specialized on the shift mode, virial, and neighbor list storage
+    template<unsigned int shift_mode, bool compute_virial, bool third_law>
+    void computeForcesClusterKernel(unsigned int first,
+                                    unsigned int last,
+                                    const NeighborListCluster& nlist,
+                                    const Scalar4* pos,
+                                    const Scalar* rcutsq_table,
+                                    const Scalar* ronsq_table,
+                                    const BoxDim& box,
+                                    Scalar4* force,
+                                    Scalar* virial,
+                                    size_t virial_pitch,
+                                    unsigned int offset,
+                                    double& energy);
+
+    //! Force, potential energy, and virial accumulated on one particle by the CPU kernels
+    struct PairAccumulator
+        {
+        Scalar3 f = make_scalar3(0, 0, 0);
+        Scalar pe = 0;
+        Scalar pe_j = 0; //!< Potential energy given to local j particles by the third law
+        Scalar virial[6] = {0, 0, 0, 0, 0, 0};
+        };
+
+    //! Apply XPLOR smoothing to an evaluated pair and accumulate it on particle i (and j)
+    template<unsigned int shift_mode, bool compute_virial, bool third_law>
+    void accumulatePair(PairAccumulator& acc_i,
+                        unsigned int j,
+                        const Scalar3& dx,
+                        Scalar rsq,
+                        Scalar rcutsq,
+                        Scalar ronsq,
+                        Scalar force_divr,
+                        Scalar pair_eng,
+                        unsigned int N,
+                        Scalar4* force,
+                        Scalar* virial,
+                        size_t virial_pitch,
+                        unsigned int offset);
+
+    //! Add the accumulated force, potential energy, and virial to particle i
+    template<bool compute_virial>
+    void addAccumulator(unsigned int i,
+                        const PairAccumulator& acc_i,
+                        Scalar4* force,
+                        Scalar* virial,
+                        size_t virial_pitch,
+                        unsigned int offset);
+
     //! Compute the long-range corrections to energy and pressure to account for truncating the pair
     //! potentials
     virtual void computeTailCorrection()
@@ -370,6 +536,19 @@ PotentialPair<evaluator>::PotentialPair(std::shared_ptr<SystemDefinition> sysdef
         = std::make_shared<GlobalArray<Scalar>>(m_typpair_idx.getNumElements(), m_exec_conf);
     nlist->addRCutMatrix(m_r_cut_nlist);
 
+#ifdef ENABLE_TBB
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        // optional: the tuner only activates once the threaded full neighbor list path runs
+        m_tuner_tasks.reset(new Autotuner<1>({AutotunerBase::getTasksPerThreadRange()},
+                                             m_exec_conf,
+                                             "pair_" + evaluator::getName(),
+                                             5,
+                                             true));
+        m_autotuners.push_back(m_tuner_tasks);
+        }
+#endif
+
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     if (m_pdata->getExecConf()->isCUDAEnabled())
         {
@@ -586,6 +765,73 @@ void PotentialPair<evaluator>::setROnPython(pybind11::tuple types, Scalar r_on)
 */
 template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t timestep)
     {
+#ifdef ENABLE_MPI
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
+
+    // when computeInterior() handled the interior particles with the current neighbor list, only
+    // the particles with ghost neighbors remain
+    bool has_interior = m_has_interior && m_interior_timestep == timestep
+                        && m_interior_nlist_builds == m_nlist->getNumBuilds();
+    m_has_interior = false;
+    if (has_interior)
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::readwrite);
+
+        computeForcesInto(timestep,
+                          h_force.data,
+                          h_virial.data,
+                          m_virial_pitch,
+                          &m_nlist->getBoundaryRanges());
+        return;
+        }
+#endif
+
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+    // need to start from a zero force, energy and virial
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+    computeForcesInto(timestep, h_force.data, h_virial.data, m_virial_pitch);
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+    \param force Force array to add into
+    \param virial Virial array to add into
+    \param virial_pitch Pitch of \a virial
+    \returns The potential energy added to the local particles
+
+    The pair forces, energies, and virials are added to the existing contents of \a force and
+    \a virial, so computeForces() passes the cleared per-particle arrays and accumulateForces() the
+    net force arrays.
+
+    When HOOMD is built with TBB and more than one thread is available, the particles are
+    partitioned across the task arena. With a full neighbor list, every particle only writes its own
+    force, and the total energy is summed over fixed chunks of particles in order, so the result is
+    identical to the serial loop for any number of threads and any tuned grain size. With a half
+    neighbor list, each contiguous block of particles accumulates into buffers that only cover the
+    particles it writes (see hoomd::detail::BlockScatter) and the buffers are summed in block order,
+    so the result is bitwise reproducible for a fixed number of threads.
+
+    When the neighbor list is a NeighborListCluster and the evaluator implements
+    evalForceAndEnergyN, the work items are i-clusters instead of particles and each i-cluster x
+    j-cluster tile is evaluated with computeForcesClusterKernel().
+
+    When \a ranges is given, only the particles in the listed [first, last) ranges are computed.
+    With a half neighbor list, the third law contributions to other particles are still added.
+    Subsets are only supported with per-particle neighbor lists.
+*/
+template<class evaluator>
+double PotentialPair<evaluator>::computeForcesInto(
+    uint64_t timestep,
+    Scalar4* force,
+    Scalar* virial,
+    size_t virial_pitch,
+    const std::vector<std::pair<unsigned int, unsigned int>>* ranges)
+    {
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
@@ -593,25 +839,32 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
-    // access the neighbor list, particle data, and system box
-    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
-                                        access_location::host,
-                                        access_mode::read);
-    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
-                                      access_location::host,
-                                      access_mode::read);
-    //     Index2D nli = m_nlist->getNListIndexer();
-    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
-                                    access_location::host,
-                                    access_mode::read);
+    // evaluate whole i-cluster x j-cluster tiles when the neighbor list provides them
+    std::shared_ptr<NeighborListCluster> cluster_nlist;
+    if constexpr (detail::has_batched_eval<evaluator>::value)
+        cluster_nlist = std::dynamic_pointer_cast<NeighborListCluster>(m_nlist);
 
+    // access the per-particle neighbor list, which a cluster list only fills when it is requested
+    std::unique_ptr<ArrayHandle<unsigned int>> h_n_neigh;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_nlist;
+    std::unique_ptr<ArrayHandle<size_t>> h_head_list;
+    if (!cluster_nlist)
+        {
+        h_n_neigh.reset(new ArrayHandle<unsigned int>(m_nlist->getNNeighArray(),
+                                                      access_location::host,
+                                                      access_mode::read));
+        h_nlist.reset(new ArrayHandle<unsigned int>(m_nlist->getNListArray(),
+                                                    access_location::host,
+                                                    access_mode::read));
+        h_head_list.reset(new ArrayHandle<size_t>(m_nlist->getHeadList(),
+                                                  access_location::host,
+                                                  access_mode::read));
+        }
+
+    // access the particle data and system box
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
-    // force arrays
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
-
     const BoxDim box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
@@ -619,178 +872,929 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-    // need to start from a zero force, energy and virial
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+    const unsigned int N = m_pdata->getN();
+    double energy = 0.0;
+
+    unsigned int n_items = cluster_nlist ? cluster_nlist->getNLocalClusters() : N;
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    // with a subset of particles, work item k is the k-th particle of the concatenated ranges
+    std::vector<unsigned int> range_offset;
+    if (ranges)
         {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        assert(!cluster_nlist);
+        range_offset.resize(ranges->size() + 1);
+        range_offset[0] = 0;
+        for (size_t r = 0; r < ranges->size(); r++)
+            range_offset[r + 1] = range_offset[r] + ((*ranges)[r].second - (*ranges)[r].first);
+        n_items = range_offset.back();
+        }
 
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+    // compute the forces of the particles (or i-clusters) in [first, last)
+    auto compute_particles = [&](unsigned int first,
+                                 unsigned int last,
+                                 Scalar4* range_force,
+                                 Scalar* range_virial,
+                                 size_t pitch,
+                                 unsigned int offset,
+                                 double& range_energy)
+    {
+        if (cluster_nlist)
+            {
+            computeForcesClusterRange(first,
+                                      last,
+                                      third_law,
+                                      compute_virial,
+                                      *cluster_nlist,
+                                      h_pos.data,
+                                      h_rcutsq.data,
+                                      h_ronsq.data,
+                                      box,
+                                      range_force,
+                                      range_virial,
+                                      pitch,
+                                      offset,
+                                      range_energy);
+            }
+        else
+            {
+            computeForcesRange(first,
+                               last,
+                               third_law,
+                               compute_virial,
+                               h_n_neigh->data,
+                               h_nlist->data,
+                               h_head_list->data,
+                               h_pos.data,
+                               h_charge.data,
+                               h_rcutsq.data,
+                               h_ronsq.data,
+                               box,
+                               range_force,
+                               range_virial,
+                               pitch,
+                               offset,
+                               range_energy);
+            }
+    };
 
-        // access charge (if needed)
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
+    // call f(begin, end) for the ranges of particles (or i-clusters) of the work items in
+    // [first, last)
+    auto for_each_item_range = [&](unsigned int first, unsigned int last, const auto& f)
+    {
+        if (!ranges)
+            {
+            f(first, last);
+            return;
+            }
 
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
+        size_t r = std::upper_bound(range_offset.begin(), range_offset.end(), first)
+                   - range_offset.begin() - 1;
+        for (; r < ranges->size() && range_offset[r] < last; r++)
+            {
+            unsigned int begin = std::max(first, range_offset[r]) - range_offset[r];
+            unsigned int end = std::min(last, range_offset[r + 1]) - range_offset[r];
+            f((*ranges)[r].first + begin, (*ranges)[r].first + end);
+            }
+    };
+
+    // compute the forces of the work items in [first, last)
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scalar4* range_force,
+                             Scalar* range_virial,
+                             size_t pitch,
+                             unsigned int offset,
+                             double& range_energy)
+    {
+        for_each_item_range(first,
+                            last,
+                            [&](unsigned int begin, unsigned int end)
+                            {
+                                compute_particles(begin,
+                                                  end,
+                                                  range_force,
+                                                  range_virial,
+                                                  pitch,
+                                                  offset,
+                                                  range_energy);
+                            });
+    };
+
+    // The energy is summed per fixed chunk of work items and then over the chunks in order, so
+    // that the total does not depend on the number of threads or the tuned grain size.
+    const unsigned int energy_chunk_size = 32;
+    const unsigned int n_chunks = (n_items + energy_chunk_size - 1) / energy_chunk_size;
+    auto compute_chunks = [&](unsigned int first_chunk,
+                              unsigned int last_chunk,
+                              std::vector<double>& chunk_energy)
+    {
+        for (unsigned int chunk = first_chunk; chunk < last_chunk; chunk++)
+            {
+            unsigned int first = chunk * energy_chunk_size;
+            unsigned int last = std::min(first + energy_chunk_size, n_items);
+            compute_range(first, last, force, virial, virial_pitch, 0, chunk_energy[chunk]);
+            }
+    };
 
-        // loop over all of the neighbors of this particle
-        const size_t myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+#ifdef ENABLE_TBB
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    if (num_threads > 1 && n_items > 0)
+        {
+        if (!third_law)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+            // with a full neighbor list, each particle only writes its own force
+            // the timing of partial passes would not be representative, so only tune full ones
+            if (!ranges)
+                m_tuner_tasks->begin();
+            const unsigned int n_tasks = num_threads * m_tuner_tasks->getParam()[0];
+            const unsigned int grain_size = std::max(n_chunks / n_tasks, 1u);
+            std::vector<double> chunk_energy(n_chunks, 0.0);
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks, grain_size),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      { compute_chunks(r.begin(), r.end(), chunk_energy); });
+                });
+            for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+                energy += chunk_energy[chunk];
+            if (!ranges)
+                m_tuner_tasks->end();
+            }
+        else
+            {
+            using Window = hoomd::detail::BlockScatter::Window;
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+            // add the particles that the work items in [begin, end) write to the window
+            auto add_reach = [&](unsigned int begin, unsigned int end, Window& window)
+            {
+                if (cluster_nlist)
+                    {
+                    const unsigned int M = cluster_nlist->getClusterSize();
+                    const std::vector<unsigned int>& particles
+                        = cluster_nlist->getClusterParticles();
+                    const std::vector<size_t>& head_list = cluster_nlist->getClusterHeadList();
+                    const std::vector<unsigned int>& n_neigh = cluster_nlist->getNClusterNeigh();
+                    const std::vector<unsigned int>& nlist = cluster_nlist->getClusterNList();
+                    auto add_cluster = [&](unsigned int c)
+                    {
+                        for (unsigned int a = 0; a < M; a++)
+                            {
+                            const unsigned int j = particles[size_t(c) * M + a];
+                            if (j < N)
+                                window.add(j);
+                            }
+                    };
+
+                    for (unsigned int ci = begin; ci < end; ci++)
+                        {
+                        add_cluster(ci);
+                        for (unsigned int k = 0; k < n_neigh[ci]; k++)
+                            {
+                            if (nlist[head_list[ci] + k] > ci)
+                                add_cluster(nlist[head_list[ci] + k]);
+                            }
+                        }
+                    }
+                else
+                    {
+                    for (unsigned int i = begin; i < end; i++)
+                        {
+                        window.add(i);
+                        const size_t head = h_head_list->data[i];
+                        for (unsigned int k = 0; k < h_n_neigh->data[i]; k++)
+                            {
+                            if (h_nlist->data[head + k] < N)
+                                window.add(h_nlist->data[head + k]);
+                            }
+                        }
+                    }
+            };
+
+            // Each block of work items accumulates into buffers that cover only the particles it
+            // writes, and the buffers are summed in block order.
+            m_scatter.partition(*m_exec_conf,
+                                n_items,
+                                N,
+                                N,
+                                [&](unsigned int first, unsigned int last, Window& window)
+                                {
+                                    for_each_item_range(first,
+                                                        last,
+                                                        [&](unsigned int begin, unsigned int end)
+                                                        { add_reach(begin, end, window); });
+                                });
+
+            const size_t pitch = m_scatter.getBufferSize();
+            m_thread_force.resize(pitch);
+            m_thread_virial.resize(compute_virial ? 6 * pitch : 0);
+            std::vector<double> block_energy(m_scatter.getNBlocks(), 0.0);
+
+            m_scatter.forEach(
+                *m_exec_conf,
+                [&](const hoomd::detail::BlockScatter::Block& b, unsigned int block)
+                {
+                    const size_t size = b.window.getLocalSize();
+                    Scalar4* block_force = m_thread_force.data() + b.offset;
+                    Scalar* block_virial = nullptr;
+                    memset((void*)block_force, 0, sizeof(Scalar4) * size);
+                    if (compute_virial)
+                        {
+                        block_virial = m_thread_virial.data() + b.offset;
+                        for (unsigned int k = 0; k < 6; ++k)
+                            memset((void*)(block_virial + k * pitch), 0, sizeof(Scalar) * size);
+                        }
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
+                    compute_range(b.first,
+                                  b.last,
+                                  block_force,
+                                  block_virial,
+                                  pitch,
+                                  b.window.lo,
+                                  block_energy[block]);
+                });
+
+            m_scatter.reduce(*m_exec_conf,
+                             N,
+                             [&](unsigned int i, size_t slot)
+                             {
+                                 const Scalar4& bf = m_thread_force[slot];
+                                 force[i].x += bf.x;
+                                 force[i].y += bf.y;
+                                 force[i].z += bf.z;
+                                 force[i].w += bf.w;
+                                 if (compute_virial)
+                                     {
+                                     for (unsigned int k = 0; k < 6; ++k)
+                                         virial[k * virial_pitch + i]
+                                             += m_thread_virial[k * pitch + slot];
+                                     }
+                             });
+
+            for (unsigned int block = 0; block < m_scatter.getNBlocks(); ++block)
+                energy += block_energy[block];
+            }
+        }
+    else
+#endif
+        {
+        std::vector<double> chunk_energy(n_chunks, 0.0);
+        compute_chunks(0, n_chunks, chunk_energy);
+        for (unsigned int chunk = 0; chunk < n_chunks; chunk++)
+            energy += chunk_energy[chunk];
+        }
 
-            // access charge (if needed)
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
+    computeTailCorrection();
+    return energy;
+    }
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+/*! \param first Index of the first particle to compute
+    \param last One past the index of the last particle to compute
+    \param third_law Set to true when the neighbor list is half
+    \param compute_virial Set to true to accumulate the virial
+    \param n_neigh Number of neighbors of each particle
+    \param nlist Neighbor list
+    \param head_list Offset of each particle's neighbors in \a nlist
+    \param pos Particle positions and types
+    \param charge Particle charges
+    \param rcutsq_table r_cut squared per type pair
+    \param ronsq_table r_on squared per type pair
+    \param box Global simulation box
+    \param force Output force array (accumulated into)
+    \param virial Output virial array (accumulated into)
+    \param virial_pitch Pitch of \a virial
+    \param offset Particle index stored in the first entry of \a force and \a virial
+    \param energy Potential energy added to the local particles (accumulated into)
+
+    Third law contributions to particles outside [\a first, \a last) are accumulated in \a force and
+    \a virial, so concurrent callers with a half neighbor list must use separate output arrays.
+
+    The shift mode, \a compute_virial, and \a third_law are resolved once here and the matching
+    instantiation of computeForcesKernel() is called, so the inner loop has no mode branches.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeForcesRange(unsigned int first,
+                                                  unsigned int last,
+                                                  bool third_law,
+                                                  bool compute_virial,
+                                                  const unsigned int* n_neigh,
+                                                  const unsigned int* nlist,
+                                                  const size_t* head_list,
+                                                  const Scalar4* pos,
+                                                  const Scalar* charge,
+                                                  const Scalar* rcutsq_table,
+                                                  const Scalar* ronsq_table,
+                                                  const BoxDim& box,
+                                                  Scalar4* force,
+                                                  Scalar* virial,
+                                                  size_t virial_pitch,
+                                                  unsigned int offset,
+                                                  double& energy)
+    {
+    detail::dispatchPairKernel<3>(
+        m_shift_mode,
+        compute_virial,
+        third_law,
+        [&](auto shift_mode_c, auto compute_virial_c, auto third_law_c)
+        {
+            this->template computeForcesKernel<decltype(shift_mode_c)::value,
+                                               decltype(compute_virial_c)::value,
+                                               decltype(third_law_c)::value>(first,
+                                                                             last,
+                                                                             n_neigh,
+                                                                             nlist,
+                                                                             head_list,
+                                                                             pos,
+                                                                             charge,
+                                                                             rcutsq_table,
+                                                                             ronsq_table,
+                                                                             box,
+                                                                             force,
+                                                                             virial,
+                                                                             virial_pitch,
+                                                                             offset,
+                                                                             energy);
+        });
+    }
 
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
+/*! \tparam shift_mode Energy shift mode (an energyShiftMode value)
+    \tparam compute_virial Set to true to accumulate the virial
+    \tparam third_law Set to true when the neighbor list is half
 
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            const param_type& param = m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
+    See computeForcesRange() for the arguments.
+*/
+template<class evaluator>
+template<unsigned int shift_mode, bool compute_virial, bool third_law>
+void PotentialPair<evaluator>::computeForcesKernel(unsigned int first,
+                                                   unsigned int last,
+                                                   const unsigned int* n_neigh,
+                                                   const unsigned int* nlist,
+                                                   const size_t* head_list,
+                                                   const Scalar4* pos,
+                                                   const Scalar* charge,
+                                                   const Scalar* rcutsq_table,
+                                                   const Scalar* ronsq_table,
+                                                   const BoxDim& box,
+                                                   Scalar4* force,
+                                                   Scalar* virial,
+                                                   size_t virial_pitch,
+                                                   unsigned int offset,
+                                                   double& energy)
+    {
+    const unsigned int N = m_pdata->getN();
 
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
-                {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
+    // for each particle in the range
+    for (unsigned int i = first; i < last; i++)
+        {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 pi = make_scalar3(pos[i].x, pos[i].y, pos[i].z);
+        unsigned int typei = __scalar_as_int(pos[i].w);
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
 
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+        // initialize current particle force, potential energy, and virial to 0
+        PairAccumulator acc_i;
 
-            if (evaluated)
+        // loop over all of the neighbors of this particle
+        const size_t myHead = head_list[i];
+        const unsigned int size = (unsigned int)n_neigh[i];
+
+        if constexpr (detail::has_batched_eval<evaluator>::value)
+            {
+            // gather batches of neighbors into structure of arrays form and evaluate them together
+            constexpr unsigned int W = detail::pair_batch_width;
+            unsigned int j_b[W];
+            Scalar3 dx_b[W];
+            Scalar rsq_b[W];
+            Scalar rcutsq_b[W];
+            Scalar ronsq_b[W];
+            const param_type* param_b[W];
+            bool energy_shift_b[W];
+            Scalar force_divr_b[W];
+            Scalar pair_eng_b[W];
+            bool evaluated_b[W];
+
+            for (unsigned int k_start = 0; k_start < size; k_start += W)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                const unsigned int n_batch = std::min(W, size - k_start);
+                for (unsigned int l = 0; l < W; l++)
                     {
-                    if (rsq >= ronsq && rsq < rcutsq)
+                    if (l >= n_batch)
                         {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
+                        // padding lanes are always outside the cutoff
+                        rsq_b[l] = Scalar(1.0);
+                        rcutsq_b[l] = Scalar(0.0);
+                        param_b[l] = &m_params[0];
+                        energy_shift_b[l] = false;
+                        continue;
+                        }
 
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+                    unsigned int j = nlist[myHead + k_start + l];
+                    assert(j < N + m_pdata->getNGhosts());
+
+                    Scalar3 pj = make_scalar3(pos[j].x, pos[j].y, pos[j].z);
+                    Scalar3 dx = box.minImage(pi - pj);
+                    unsigned int typej = __scalar_as_int(pos[j].w);
+                    assert(typej < m_pdata->getNTypes());
+
+                    unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                    j_b[l] = j;
+                    dx_b[l] = dx;
+                    rsq_b[l] = dot(dx, dx);
+                    rcutsq_b[l] = rcutsq_table[typpair_idx];
+                    ronsq_b[l] = Scalar(0.0);
+                    if constexpr (shift_mode == xplor)
+                        ronsq_b[l] = ronsq_table[typpair_idx];
+                    param_b[l] = &m_params[typpair_idx];
+                    energy_shift_b[l] = shift_mode == shift
+                                        || (shift_mode == xplor && ronsq_b[l] > rcutsq_b[l]);
+                    }
 
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+                detail::evalForceAndEnergyBatch<evaluator>(n_batch,
+                                                           rsq_b,
+                                                           rcutsq_b,
+                                                           param_b,
+                                                           energy_shift_b,
+                                                           force_divr_b,
+                                                           pair_eng_b,
+                                                           evaluated_b);
 
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a
-                        // + But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                for (unsigned int l = 0; l < n_batch; l++)
+                    {
+                    if (evaluated_b[l])
+                        {
+                        accumulatePair<shift_mode, compute_virial, third_law>(acc_i,
+                                                                              j_b[l],
+                                                                              dx_b[l],
+                                                                              rsq_b[l],
+                                                                              rcutsq_b[l],
+                                                                              ronsq_b[l],
+                                                                              force_divr_b[l],
+                                                                              pair_eng_b[l],
+                                                                              N,
+                                                                              force,
+                                                                              virial,
+                                                                              virial_pitch,
+                                                                              offset);
                         }
                     }
+                }
+            }
+        else
+            {
+            // access charge (if needed)
+            Scalar qi = Scalar(0.0);
+            if (evaluator::needsCharge())
+                qi = charge[i];
 
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx * force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
+            for (unsigned int k = 0; k < size; k++)
+                {
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int j = nlist[myHead + k];
+                assert(j < N + m_pdata->getNGhosts());
+
+                // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pj = make_scalar3(pos[j].x, pos[j].y, pos[j].z);
+                Scalar3 dx = pi - pj;
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                unsigned int typej = __scalar_as_int(pos[j].w);
+                assert(typej < m_pdata->getNTypes());
+
+                // access charge (if needed)
+                Scalar qj = Scalar(0.0);
+                if (evaluator::needsCharge())
+                    qj = charge[j];
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // calculate r_ij squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                const param_type& param = m_params[typpair_idx];
+                Scalar rcutsq = rcutsq_table[typpair_idx];
+                Scalar ronsq = Scalar(0.0);
+                if constexpr (shift_mode == xplor)
+                    ronsq = ronsq_table[typpair_idx];
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                bool energy_shift = false;
+                if constexpr (shift_mode == shift)
+                    energy_shift = true;
+                else if constexpr (shift_mode == xplor)
                     {
-                    virialxxi += force_div2r * dx.x * dx.x;
-                    virialxyi += force_div2r * dx.x * dx.y;
-                    virialxzi += force_div2r * dx.x * dx.z;
-                    virialyyi += force_div2r * dx.y * dx.y;
-                    virialyzi += force_div2r * dx.y * dx.z;
-                    virialzzi += force_div2r * dx.z * dx.z;
+                    if (ronsq > rcutsq)
+                        energy_shift = true;
                     }
 
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                // scalars / FLOPS: 8) only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                // compute the force and potential energy
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(rsq, rcutsq, param);
+                if (evaluator::needsCharge())
+                    eval.setCharge(qi, qj);
+
+                bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+                if (evaluated)
                     {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
-                        {
-                        h_virial.data[0 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
-                        h_virial.data[1 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
-                        h_virial.data[2 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
-                        h_virial.data[3 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
-                        h_virial.data[4 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
-                        h_virial.data[5 * m_virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
-                        }
+                    accumulatePair<shift_mode, compute_virial, third_law>(acc_i,
+                                                                          j,
+                                                                          dx,
+                                                                          rsq,
+                                                                          rcutsq,
+                                                                          ronsq,
+                                                                          force_divr,
+                                                                          pair_eng,
+                                                                          N,
+                                                                          force,
+                                                                          virial,
+                                                                          virial_pitch,
+                                                                          offset);
                     }
                 }
             }
 
         // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
+        addAccumulator<compute_virial>(i, acc_i, force, virial, virial_pitch, offset);
+        energy += double(acc_i.pe) + double(acc_i.pe_j);
+        }
+    }
+
+/*! \param first Index of the first i-cluster to compute
+    \param last One past the index of the last i-cluster to compute
+    \param third_law Set to true when the neighbor list is half
+    \param compute_virial Set to true to accumulate the virial
+    \param nlist Cluster neighbor list
+    \param pos Particle positions and types
+    \param rcutsq_table r_cut squared per type pair
+    \param ronsq_table r_on squared per type pair
+    \param box Global simulation box
+    \param force Output force array (accumulated into)
+    \param virial Output virial array (accumulated into)
+    \param virial_pitch Pitch of \a virial
+    \param offset Particle index stored in the first entry of \a force and \a virial
+    \param energy Potential energy added to the local particles (accumulated into)
+
+    Third law contributions to particles outside the i-clusters in [\a first, \a last) are
+    accumulated in \a force and \a virial, so concurrent callers with a half neighbor list must use
+    separate output arrays.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeForcesClusterRange(unsigned int first,
+                                                         unsigned int last,
+                                                         bool third_law,
+                                                         bool compute_virial,
+                                                         const NeighborListCluster& nlist,
+                                                         const Scalar4* pos,
+                                                         const Scalar* rcutsq_table,
+                                                         const Scalar* ronsq_table,
+                                                         const BoxDim& box,
+                                                         Scalar4* force,
+                                                         Scalar* virial,
+                                                         size_t virial_pitch,
+                                                         unsigned int offset,
+                                                         double& energy)
+    {
+    detail::dispatchPairKernel<3>(
+        m_shift_mode,
+        compute_virial,
+        third_law,
+        [&](auto shift_mode_c, auto compute_virial_c, auto third_law_c)
+        {
+            this->template computeForcesClusterKernel<decltype(shift_mode_c)::value,
+                                                      decltype(compute_virial_c)::value,
+                                                      decltype(third_law_c)::value>(first,
+                                                                                    last,
+                                                                                    nlist,
+                                                                                    pos,
+                                                                                    rcutsq_table,
+                                                                                    ronsq_table,
+                                                                                    box,
+                                                                                    force,
+                                                                                    virial,
+                                                                                    virial_pitch,
+                                                                                    offset,
+                                                                                    energy);
+        });
+    }
+
+/*! \tparam shift_mode Energy shift mode (an energyShiftMode value)
+    \tparam compute_virial Set to true to accumulate the virial
+    \tparam third_law Set to true when the neighbor list is half
+
+    See computeForcesClusterRange() for the arguments.
+
+    The particles of each i-cluster are loaded once and their forces are accumulated locally while
+    the set bits of every i-cluster x j-cluster interaction mask are gathered into batches of
+    detail::pair_batch_width pairs for evalForceAndEnergyBatch(). With a half neighbor list, only
+    j-clusters with an index of at least the i-cluster's are visited and the self tile is limited
+    to pairs a < b, so each pair is evaluated once.
+*/
+template<class evaluator>
+template<unsigned int shift_mode, bool compute_virial, bool third_law>
+void PotentialPair<evaluator>::computeForcesClusterKernel(unsigned int first,
+                                                          unsigned int last,
+                                                          const NeighborListCluster& nlist,
+                                                          const Scalar4* pos,
+                                                          const Scalar* rcutsq_table,
+                                                          const Scalar* ronsq_table,
+                                                          const BoxDim& box,
+                                                          Scalar4* force,
+                                                          Scalar* virial,
+                                                          size_t virial_pitch,
+                                                          unsigned int offset,
+                                                          double& energy)
+    {
+    const unsigned int N = m_pdata->getN();
+    const unsigned int M = nlist.getClusterSize();
+    const unsigned int* cluster_particles = nlist.getClusterParticles().data();
+    const size_t* cluster_head_list = nlist.getClusterHeadList().data();
+    const unsigned int* n_cluster_neigh = nlist.getNClusterNeigh().data();
+    const unsigned int* cluster_nlist = nlist.getClusterNList().data();
+    const uint64_t* cluster_masks = nlist.getClusterMasks().data();
+
+    // pairs a < b of the self tile
+    uint64_t upper_mask = 0;
+    for (unsigned int a = 0; a < M; a++)
+        for (unsigned int b = a + 1; b < M; b++)
+            upper_mask |= uint64_t(1) << (a * M + b);
+
+    constexpr unsigned int max_M = NeighborListCluster::max_cluster_size;
+    constexpr unsigned int W = detail::pair_batch_width;
+    unsigned int a_b[W];
+    unsigned int j_b[W];
+    Scalar3 dx_b[W];
+    Scalar rsq_b[W];
+    Scalar rcutsq_b[W];
+    Scalar ronsq_b[W];
+    const param_type* param_b[W];
+    bool energy_shift_b[W];
+    Scalar force_divr_b[W];
+    Scalar pair_eng_b[W];
+    bool evaluated_b[W];
+
+    for (unsigned int ci = first; ci < last; ci++)
+        {
+        // load the particles of the i-cluster, padding slots are never set in the masks
+        unsigned int idx_i[max_M];
+        Scalar3 pos_i[max_M];
+        unsigned int type_i[max_M];
+        PairAccumulator acc_i[max_M];
+        for (unsigned int a = 0; a < M; a++)
             {
-            h_virial.data[0 * m_virial_pitch + mem_idx] += virialxxi;
-            h_virial.data[1 * m_virial_pitch + mem_idx] += virialxyi;
-            h_virial.data[2 * m_virial_pitch + mem_idx] += virialxzi;
-            h_virial.data[3 * m_virial_pitch + mem_idx] += virialyyi;
-            h_virial.data[4 * m_virial_pitch + mem_idx] += virialyzi;
-            h_virial.data[5 * m_virial_pitch + mem_idx] += virialzzi;
+            idx_i[a] = cluster_particles[size_t(ci) * M + a];
+            if (idx_i[a] != NeighborListCluster::invalid_particle)
+                {
+                const Scalar4 postype = pos[idx_i[a]];
+                pos_i[a] = make_scalar3(postype.x, postype.y, postype.z);
+                type_i[a] = __scalar_as_int(postype.w);
+                }
+            }
+
+        // evaluate the first n_batch gathered pairs and accumulate them
+        unsigned int n_batch = 0;
+        auto evaluate_batch = [&]()
+        {
+            for (unsigned int l = n_batch; l < W; l++)
+                {
+                // padding lanes are always outside the cutoff
+                rsq_b[l] = Scalar(1.0);
+                rcutsq_b[l] = Scalar(0.0);
+                param_b[l] = &m_params[0];
+                energy_shift_b[l] = false;
+                }
+
+            detail::evalForceAndEnergyBatch<evaluator>(n_batch,
+                                                       rsq_b,
+                                                       rcutsq_b,
+                                                       param_b,
+                                                       energy_shift_b,
+                                                       force_divr_b,
+                                                       pair_eng_b,
+                                                       evaluated_b);
+
+            for (unsigned int l = 0; l < n_batch; l++)
+                {
+                if (evaluated_b[l])
+                    {
+                    accumulatePair<shift_mode, compute_virial, third_law>(acc_i[a_b[l]],
+                                                                          j_b[l],
+                                                                          dx_b[l],
+                                                                          rsq_b[l],
+                                                                          rcutsq_b[l],
+                                                                          ronsq_b[l],
+                                                                          force_divr_b[l],
+                                                                          pair_eng_b[l],
+                                                                          N,
+                                                                          force,
+                                                                          virial,
+                                                                          virial_pitch,
+                                                                          offset);
+                    }
+                }
+            n_batch = 0;
+        };
+
+        const size_t head = cluster_head_list[ci];
+        for (unsigned int k = 0; k < n_cluster_neigh[ci]; k++)
+            {
+            const unsigned int cj = cluster_nlist[head + k];
+            uint64_t mask = cluster_masks[head + k];
+            if constexpr (third_law)
+                {
+                if (cj < ci)
+                    continue;
+                if (cj == ci)
+                    mask &= upper_mask;
+                }
+
+            // gather the pairs of the tile
+            for (unsigned int bit = 0; mask != 0; bit++, mask >>= 1)
+                {
+                if (!(mask & 1))
+                    continue;
+
+                const unsigned int a = bit / M;
+                const unsigned int j = cluster_particles[size_t(cj) * M + bit % M];
+                assert(j < N + m_pdata->getNGhosts());
+
+                Scalar3 pj = make_scalar3(pos[j].x, pos[j].y, pos[j].z);
+                Scalar3 dx = box.minImage(pos_i[a] - pj);
+                unsigned int typej = __scalar_as_int(pos[j].w);
+                assert(typej < m_pdata->getNTypes());
+
+                unsigned int typpair_idx = m_typpair_idx(type_i[a], typej);
+                a_b[n_batch] = a;
+                j_b[n_batch] = j;
+                dx_b[n_batch] = dx;
+                rsq_b[n_batch] = dot(dx, dx);
+                rcutsq_b[n_batch] = rcutsq_table[typpair_idx];
+                ronsq_b[n_batch] = Scalar(0.0);
+                if constexpr (shift_mode == xplor)
+                    ronsq_b[n_batch] = ronsq_table[typpair_idx];
+                param_b[n_batch] = &m_params[typpair_idx];
+                energy_shift_b[n_batch]
+                    = shift_mode == shift
+                      || (shift_mode == xplor && ronsq_b[n_batch] > rcutsq_b[n_batch]);
+
+                if (++n_batch == W)
+                    evaluate_batch();
+                }
+            }
+
+        if (n_batch > 0)
+            evaluate_batch();
+
+        for (unsigned int a = 0; a < M; a++)
+            {
+            if (idx_i[a] != NeighborListCluster::invalid_particle)
+                {
+                addAccumulator<compute_virial>(idx_i[a],
+                                               acc_i[a],
+                                               force,
+                                               virial,
+                                               virial_pitch,
+                                               offset);
+                energy += double(acc_i[a].pe) + double(acc_i[a].pe_j);
+                }
             }
         }
+    }
 
-    computeTailCorrection();
+/*! \tparam shift_mode Energy shift mode (an energyShiftMode value)
+    \tparam compute_virial Set to true to accumulate the virial
+    \tparam third_law Set to true to also apply the force to particle j when it is local
+
+    \param acc_i Accumulator of particle i
+    \param j Index of particle j
+    \param dx Minimum image vector from j to i
+    \param rsq Squared length of \a dx
+    \param rcutsq r_cut squared of the type pair
+    \param ronsq r_on squared of the type pair
+    \param force_divr Force divided by r from the evaluator
+    \param pair_eng Pair energy from the evaluator
+    \param N Number of local particles
+    \param force Output force array (accumulated into)
+    \param virial Output virial array (accumulated into)
+    \param virial_pitch Pitch of \a virial
+    \param offset Particle index stored in the first entry of \a force and \a virial
+*/
+template<class evaluator>
+template<unsigned int shift_mode, bool compute_virial, bool third_law>
+inline void PotentialPair<evaluator>::accumulatePair(PairAccumulator& acc_i,
+                                                     unsigned int j,
+                                                     const Scalar3& dx,
+                                                     Scalar rsq,
+                                                     Scalar rcutsq,
+                                                     Scalar ronsq,
+                                                     Scalar force_divr,
+                                                     Scalar pair_eng,
+                                                     unsigned int N,
+                                                     Scalar4* force,
+                                                     Scalar* virial,
+                                                     size_t virial_pitch,
+                                                     unsigned int offset)
+    {
+    // modify the potential for xplor shifting
+    if constexpr (shift_mode == xplor)
+        {
+        if (rsq >= ronsq && rsq < rcutsq)
+            {
+            // Implement XPLOR smoothing (FLOPS: 16)
+            Scalar old_pair_eng = pair_eng;
+            Scalar old_force_divr = force_divr;
+
+            // calculate 1.0 / (xplor denominator)
+            Scalar xplor_denom_inv
+                = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                       * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
+                       * xplor_denom_inv;
+            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+            // make modifications to the old pair energy and force
+            pair_eng = old_pair_eng * s;
+            // note: I'm not sure why the minus sign needs to be there: my notes have a
+            // + But this is verified correct via plotting
+            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+            }
+        }
+
+    Scalar force_div2r = force_divr * Scalar(0.5);
+    // add the force, potential energy and virial to the particle i
+    // (FLOPS: 8)
+    acc_i.f += dx * force_divr;
+    acc_i.pe += pair_eng * Scalar(0.5);
+    if constexpr (compute_virial)
+        {
+        acc_i.virial[0] += force_div2r * dx.x * dx.x;
+        acc_i.virial[1] += force_div2r * dx.x * dx.y;
+        acc_i.virial[2] += force_div2r * dx.x * dx.z;
+        acc_i.virial[3] += force_div2r * dx.y * dx.y;
+        acc_i.virial[4] += force_div2r * dx.y * dx.z;
+        acc_i.virial[5] += force_div2r * dx.z * dx.z;
+        }
+
+    // add the force to particle j if we are using the third law (MEM TRANSFER: 10
+    // scalars / FLOPS: 8) only add force to local particles
+    if constexpr (third_law)
+        {
+        if (j < N)
+            {
+            unsigned int mem_idx = j - offset;
+            force[mem_idx].x -= dx.x * force_divr;
+            force[mem_idx].y -= dx.y * force_divr;
+            force[mem_idx].z -= dx.z * force_divr;
+            force[mem_idx].w += pair_eng * Scalar(0.5);
+            acc_i.pe_j += pair_eng * Scalar(0.5);
+            if constexpr (compute_virial)
+                {
+                virial[0 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
+                virial[1 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
+                virial[2 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
+                virial[3 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
+                virial[4 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
+                virial[5 * virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
+                }
+            }
+        }
+    }
+
+/*! \param i Index of the particle
+    \param acc_i Accumulated force, potential energy, and virial of particle i
+    \param force Output force array (accumulated into)
+    \param virial Output virial array (accumulated into)
+    \param virial_pitch Pitch of \a virial
+    \param offset Particle index stored in the first entry of \a force and \a virial
+*/
+template<class evaluator>
+template<bool compute_virial>
+inline void PotentialPair<evaluator>::addAccumulator(unsigned int i,
+                                                     const PairAccumulator& acc_i,
+                                                     Scalar4* force,
+                                                     Scalar* virial,
+                                                     size_t virial_pitch,
+                                                     unsigned int offset)
+    {
+    const unsigned int mem_idx = i - offset;
+    force[mem_idx].x += acc_i.f.x;
+    force[mem_idx].y += acc_i.f.y;
+    force[mem_idx].z += acc_i.f.z;
+    force[mem_idx].w += acc_i.pe;
+    if constexpr (compute_virial)
+        {
+        for (unsigned int k = 0; k < 6; k++)
+            virial[k * virial_pitch + mem_idx] += acc_i.virial[k];
+        }
     }
 
 #ifdef ENABLE_MPI
@@ -808,6 +1812,46 @@ CommFlags PotentialPair<evaluator>::getRequestedCommFlags(uint64_t timestep)
 
     return flags;
     }
+
+/*! \param timestep Current time step
+
+    Computes the forces on the particles whose neighbors are all local, so this can run before the
+    ghost positions are current. The next call to computeForces() at the same time step adds the
+    forces on the remaining particles, unless the neighbor list has been rebuilt in between.
+*/
+template<class evaluator> void PotentialPair<evaluator>::computeInterior(uint64_t timestep)
+    {
+    m_has_interior = false;
+
+    // the neighbor list check is collective, make it on all ranks before any early exit
+    if (!m_nlist->isUpToDate(timestep))
+        return;
+
+    // cluster tiles mix interior and boundary particles
+    if constexpr (detail::has_batched_eval<evaluator>::value)
+        {
+        if (std::dynamic_pointer_cast<NeighborListCluster>(m_nlist))
+            return;
+        }
+
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+        memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+        computeForcesInto(timestep,
+                          h_force.data,
+                          h_virial.data,
+                          m_virial_pitch,
+                          &m_nlist->getInteriorRanges());
+        }
+
+    m_has_interior = true;
+    m_interior_timestep = timestep;
+    m_interior_nlist_builds = m_nlist->getNumBuilds();
+    }
 #endif
 
 template<class evaluator> void PotentialPair<evaluator>::startAutotuning()
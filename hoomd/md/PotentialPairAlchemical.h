@@ -57,6 +57,17 @@ class PotentialPairAlchemical : public PotentialPair<evaluator>
     //! Destructor
     virtual ~PotentialPairAlchemical();
 
+    //! The alchemical forces are only computed into the per-particle arrays
+    virtual bool supportsNetForceAccumulation()
+        {
+        return false;
+        }
+
+#ifdef ENABLE_MPI
+    //! The alchemical forces are always computed in a single pass
+    virtual void computeInterior(uint64_t timestep) { }
+#endif
+
     std::shared_ptr<alpha_particle_type> getAlchemicalPairParticle(pybind11::tuple types,
                                                                    std::string param_name)
         {
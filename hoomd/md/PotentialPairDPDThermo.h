@@ -62,13 +62,37 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! The DPD forces are always computed in a single pass
+    virtual void computeInterior(uint64_t timestep) { }
 #endif
 
+    //! The DPD forces are only computed into the per-particle arrays
+    virtual bool supportsNetForceAccumulation()
+        {
+        return false;
+        }
+
     protected:
     std::shared_ptr<Variant> m_T; //!< Temperature for the DPD thermostat
 
     //! Actually compute the forces (overwrites PotentialPair::computeForces())
     virtual void computeForces(uint64_t timestep);
+
+    //! Pair force kernel specialized on the shift mode, virial, and neighbor list storage
+    template<unsigned int shift_mode, bool compute_virial, bool third_law>
+    void computeForcesKernel(uint64_t timestep,
+                             Scalar currentTemp,
+                             const unsigned int* n_neigh,
+                             const unsigned int* nlist,
+                             const size_t* head_list,
+                             const Scalar4* pos,
+                             const Scalar4* vel,
+                             const unsigned int* tag,
+                             const Scalar* rcutsq_table,
+                             const BoxDim& box,
+                             Scalar4* force,
+                             Scalar* virial);
     };
 
 /*! \param sysdef System to compute forces on
@@ -141,17 +165,86 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
     memset((void*)h_force.data, 0, sizeof(Scalar4) * this->m_force.getNumElements());
     memset((void*)h_virial.data, 0, sizeof(Scalar) * this->m_virial.getNumElements());
 
+    // Special Potential Pair DPD Requirements
+    const Scalar currentTemp = m_T->operator()(timestep);
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    // DPD only supports shifting the energy: xplor is treated as no shift
+    unsigned int shift_mode = this->m_shift_mode == this->shift ? this->shift : this->no_shift;
+
+    // select the kernel once so that the inner loop has no mode branches
+    detail::dispatchPairKernel<2>(
+        shift_mode,
+        compute_virial,
+        third_law,
+        [&](auto shift_mode_c, auto compute_virial_c, auto third_law_c)
+        {
+            this->template computeForcesKernel<decltype(shift_mode_c)::value,
+                                               decltype(compute_virial_c)::value,
+                                               decltype(third_law_c)::value>(timestep,
+                                                                             currentTemp,
+                                                                             h_n_neigh.data,
+                                                                             h_nlist.data,
+                                                                             h_head_list.data,
+                                                                             h_pos.data,
+                                                                             h_vel.data,
+                                                                             h_tag.data,
+                                                                             h_rcutsq.data,
+                                                                             box,
+                                                                             h_force.data,
+                                                                             h_virial.data);
+        });
+    }
+
+/*! \tparam shift_mode Energy shift mode (no_shift or shift)
+    \tparam compute_virial Set to true to accumulate the virial
+    \tparam third_law Set to true when the neighbor list is half
+
+    \param timestep Current time step (used to seed the random forces)
+    \param currentTemp Thermostat temperature at \a timestep
+    \param n_neigh Number of neighbors of each particle
+    \param nlist Neighbor list
+    \param head_list Offset of each particle's neighbors in \a nlist
+    \param pos Particle positions and types
+    \param vel Particle velocities
+    \param tag Particle tags
+    \param rcutsq_table r_cut squared per type pair
+    \param box Local simulation box
+    \param force Output force array (accumulated into)
+    \param virial Output virial array (accumulated into)
+*/
+template<class evaluator>
+template<unsigned int shift_mode, bool compute_virial, bool third_law>
+void PotentialPairDPDThermo<evaluator>::computeForcesKernel(uint64_t timestep,
+                                                            Scalar currentTemp,
+                                                            const unsigned int* n_neigh,
+                                                            const unsigned int* nlist,
+                                                            const size_t* head_list,
+                                                            const Scalar4* pos,
+                                                            const Scalar4* vel,
+                                                            const unsigned int* tag,
+                                                            const Scalar* rcutsq_table,
+                                                            const BoxDim& box,
+                                                            Scalar4* force,
+                                                            Scalar* virial)
+    {
     uint16_t seed = this->m_sysdef->getSeed();
 
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    const bool energy_shift = shift_mode == this->shift;
+
     // for each particle
     for (int i = 0; i < (int)this->m_pdata->getN(); i++)
         {
         // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        Scalar3 vi = make_scalar3(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
+        Scalar3 pi = make_scalar3(pos[i].x, pos[i].y, pos[i].z);
+        Scalar3 vi = make_scalar3(vel[i].x, vel[i].y, vel[i].z);
 
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const size_t head_i = h_head_list.data[i];
+        unsigned int typei = __scalar_as_int(pos[i].w);
+        const size_t head_i = head_list[i];
 
         // sanity check
         assert(typei < this->m_pdata->getNTypes());
@@ -164,23 +257,23 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             viriali[l] = 0.0;
 
         // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int size = (unsigned int)n_neigh[i];
         for (unsigned int k = 0; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[head_i + k];
+            unsigned int j = nlist[head_i + k];
             assert(j < this->m_pdata->getN() + this->m_pdata->getNGhosts());
 
             // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 pj = make_scalar3(pos[j].x, pos[j].y, pos[j].z);
             Scalar3 dx = pi - pj;
 
             // calculate dv_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 vj = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+            Scalar3 vj = make_scalar3(vel[j].x, vel[j].y, vel[j].z);
             Scalar3 dv = vi - vj;
 
             // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            unsigned int typej = __scalar_as_int(pos[j].w);
             assert(typej < this->m_pdata->getNTypes());
 
             // apply periodic boundary conditions
@@ -195,13 +288,7 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             // get parameters for this type pair
             unsigned int typpair_idx = this->m_typpair_idx(typei, typej);
             const param_type& param = this->m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            bool energy_shift = false;
-            if (this->m_shift_mode == this->shift)
-                energy_shift = true;
+            Scalar rcutsq = rcutsq_table[typpair_idx];
 
             // compute the force and potential energy
             Scalar force_divr = Scalar(0.0);
@@ -209,12 +296,9 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             Scalar pair_eng = Scalar(0.0);
             evaluator eval(rsq, rcutsq, param);
 
-            // Special Potential Pair DPD Requirements
-            const Scalar currentTemp = m_T->operator()(timestep);
-
             // set seed using global tags
-            unsigned int tagi = h_tag.data[i];
-            unsigned int tagj = h_tag.data[j];
+            unsigned int tagi = tag[i];
+            unsigned int tagj = tag[j];
             eval.set_seed_ij_timestep(seed, tagi, tagj, timestep);
             eval.setDeltaT(this->m_deltaT);
             eval.setRDotV(rdotv);
@@ -227,43 +311,55 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
                 {
                 // compute the virial (FLOPS: 2)
                 Scalar pair_virial[6];
-                pair_virial[0] = Scalar(0.5) * dx.x * dx.x * force_divr_cons;
-                pair_virial[1] = Scalar(0.5) * dx.x * dx.y * force_divr_cons;
-                pair_virial[2] = Scalar(0.5) * dx.x * dx.z * force_divr_cons;
-                pair_virial[3] = Scalar(0.5) * dx.y * dx.y * force_divr_cons;
-                pair_virial[4] = Scalar(0.5) * dx.y * dx.z * force_divr_cons;
-                pair_virial[5] = Scalar(0.5) * dx.z * dx.z * force_divr_cons;
+                if constexpr (compute_virial)
+                    {
+                    pair_virial[0] = Scalar(0.5) * dx.x * dx.x * force_divr_cons;
+                    pair_virial[1] = Scalar(0.5) * dx.x * dx.y * force_divr_cons;
+                    pair_virial[2] = Scalar(0.5) * dx.x * dx.z * force_divr_cons;
+                    pair_virial[3] = Scalar(0.5) * dx.y * dx.y * force_divr_cons;
+                    pair_virial[4] = Scalar(0.5) * dx.y * dx.z * force_divr_cons;
+                    pair_virial[5] = Scalar(0.5) * dx.z * dx.z * force_divr_cons;
+                    }
 
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
                 fi += dx * force_divr;
                 pei += pair_eng * Scalar(0.5);
-                for (unsigned int l = 0; l < 6; l++)
-                    viriali[l] += pair_virial[l];
+                if constexpr (compute_virial)
+                    {
+                    for (unsigned int l = 0; l < 6; l++)
+                        viriali[l] += pair_virial[l];
+                    }
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10
                 // scalars / FLOPS: 8)
-                if (third_law)
+                if constexpr (third_law)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    for (unsigned int l = 0; l < 6; l++)
-                        h_virial.data[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
+                    force[mem_idx].x -= dx.x * force_divr;
+                    force[mem_idx].y -= dx.y * force_divr;
+                    force[mem_idx].z -= dx.z * force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
+                    if constexpr (compute_virial)
+                        {
+                        for (unsigned int l = 0; l < 6; l++)
+                            virial[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
+                        }
                     }
                 }
             }
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        for (unsigned int l = 0; l < 6; l++)
-            h_virial.data[l * this->m_virial_pitch + mem_idx] += viriali[l];
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
+        if constexpr (compute_virial)
+            {
+            for (unsigned int l = 0; l < 6; l++)
+                virial[l * this->m_virial_pitch + mem_idx] += viriali[l];
+            }
         }
     }
 
@@ -51,6 +51,12 @@ template<class evaluator> class PotentialPairGPU : public PotentialPair<evaluato
     //! Destructor
     virtual ~PotentialPairGPU() { }
 
+    //! The GPU forces are summed by Integrator::computeNetForceGPU()
+    virtual bool supportsNetForceAccumulation()
+        {
+        return false;
+        }
+
     protected:
     std::shared_ptr<Autotuner<2>> m_tuner; //!< Autotuner for block size and threads per particle
 
@@ -4,12 +4,17 @@
 #ifndef __POTENTIAL_TERSOFF_H__
 #define __POTENTIAL_TERSOFF_H__
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "NeighborList.h"
+#include "hoomd/BlockScatter.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
 #include "hoomd/HOOMDMath.h"
@@ -135,8 +140,40 @@ template<class evaluator> class PotentialTersoff : public ForceCompute
     // r_cut (not squared) given to the neighborlist
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
-    // scratch pad memory per type
-    std::vector<Scalar> m_phi_ab;
+    //! Scratch memory of one block of particles i
+    struct Scratch
+        {
+        std::vector<unsigned int> idx;     //!< Index of each neighbor
+        std::vector<unsigned int> type;    //!< Type of each neighbor
+        std::vector<unsigned int> typpair; //!< Type pair index of i and each neighbor
+        std::vector<Scalar3> dx;           //!< Minimum image r_i - r_k of each neighbor
+        std::vector<Scalar> rsq;           //!< Squared distance to each neighbor
+        std::vector<char> active;          //!< True when k is a third body of the current pair
+        std::vector<Scalar> cos_th;        //!< Cosine of the angle between ij and ik
+        std::vector<Scalar> phi_ab;        //!< Per type sum of the per-neighbor scalar
+
+        //! Grow the arrays to hold at least \a n_neigh neighbors and \a n_types types
+        void grow(unsigned int n_neigh, unsigned int n_types)
+            {
+            if (idx.size() < n_neigh)
+                {
+                idx.resize(n_neigh);
+                type.resize(n_neigh);
+                typpair.resize(n_neigh);
+                dx.resize(n_neigh);
+                rsq.resize(n_neigh);
+                active.resize(n_neigh);
+                cos_th.resize(n_neigh);
+                }
+            if (phi_ab.size() < n_types)
+                phi_ab.resize(n_types);
+            }
+        };
+
+    std::vector<Scratch> m_scratch;        //!< Scratch memory, one per block of particles
+    std::vector<Scalar4> m_block_force;    //!< Per block forces and energies (multiple threads)
+    std::vector<Scalar> m_block_virial;    //!< Per block virials (multiple threads)
+    hoomd::detail::BlockScatter m_scatter; //!< Blocks of particles i and the indices they write
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -148,8 +185,7 @@ template<class evaluator> class PotentialTersoff : public ForceCompute
 template<class evaluator>
 PotentialTersoff<evaluator>::PotentialTersoff(std::shared_ptr<SystemDefinition> sysdef,
                                               std::shared_ptr<NeighborList> nlist)
-    : ForceCompute(sysdef), m_nlist(nlist), m_typpair_idx(m_pdata->getNTypes()),
-      m_phi_ab(m_pdata->getNTypes())
+    : ForceCompute(sysdef), m_nlist(nlist), m_typpair_idx(m_pdata->getNTypes())
     {
     this->m_exec_conf->msg->notice(5) << "Constructing PotentialTersoff" << std::endl;
 
@@ -276,699 +312,673 @@ template<class evaluator> Scalar PotentialTersoff<evaluator>::getRCut(pybind11::
 */
 template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64_t timestep)
     {
-    // *****  check if we need the structure of the Tersoff or the RevCross potential for evaluation
-    if (evaluator::flag_for_RevCross)
-        {
-        // ***** RevCross potential
-        // start by updating the neighborlist
-        m_nlist->compute(timestep);
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
 
-        // The three-body potentials can't handle a half neighbor list, so check now.
-        bool third_law = m_nlist->getStorageMode() == NeighborList::half;
-        if (third_law)
-            {
-            m_exec_conf->msg->error()
-                << std::endl
-                << "PotentialRevCross cannot handle a half neighborlist" << std::endl;
-            throw std::runtime_error("Error computing forces in PotentialRevCross");
-            }
+    // The three-body potentials can't handle a half neighbor list, so check now.
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+    if (third_law)
+        {
+        const std::string name
+            = evaluator::flag_for_RevCross ? "PotentialRevCross" : "PotentialTersoff";
+        m_exec_conf->msg->error() << std::endl
+                                  << name << " cannot handle a half neighborlist" << std::endl;
+        throw std::runtime_error("Error computing forces in " + name);
+        }
 
-        // access the neighbor list, particle data, and system box
-        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
-                                            access_location::host,
-                                            access_mode::read);
-        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+    // access the neighbor list, particle data, and system box
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
 
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
-
-        // force and virial arrays
-        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
+    // force and virial arrays
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
 
-        const BoxDim box = m_pdata->getBox();
-        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-        // need to start from a zero force, energy
-        memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
-        memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+    const BoxDim box = m_pdata->getBox();
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_all = N + m_pdata->getNGhosts();
+    const unsigned int ntypes = m_pdata->getNTypes();
+
+    // need to start from a zero force, energy
+    memset(h_force.data, 0, sizeof(Scalar4) * n_all);
+    memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+
+    // Every triplet also updates the forces of neighbors j and k, which may be ghosts. With more
+    // than one thread, each block of particles i accumulates into buffers that cover the local
+    // and ghost particles it writes. The buffers are summed in block order so that results are
+    // reproducible for a fixed thread count.
+    const bool use_buffers = m_exec_conf->getNumThreads() > 1 && N > 1;
+    size_t buffer_pitch = 0;
+    if (use_buffers)
+        {
+        m_scatter.partition(
+            *m_exec_conf,
+            N,
+            N,
+            n_all,
+            [&](unsigned int first, unsigned int last, hoomd::detail::BlockScatter::Window& window)
             {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            const size_t head_i = h_head_list.data[i];
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
-
-            // initialize current force and potential energy of particle i to 0
-            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pei = 0.0;
-
-            Scalar virialixx(0.0);
-            Scalar virialixy(0.0);
-            Scalar virialixz(0.0);
-            Scalar virialiyy(0.0);
-            Scalar virialiyz(0.0);
-            Scalar virializz(0.0);
-
-            // loop over all of the neighbors of this particle
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            for (unsigned int j = 0; j < size; j++)
-                {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
+                for (unsigned int i = first; i < last; i++)
+                    {
+                    window.add(i);
+                    const size_t head_i = h_head_list.data[i];
+                    for (unsigned int j = 0; j < h_n_neigh.data[i]; j++)
+                        window.add(h_nlist.data[head_i + j]);
+                    }
+            });
+        buffer_pitch = m_scatter.getBufferSize();
+        m_block_force.resize(buffer_pitch);
+        m_block_virial.resize(compute_virial ? 6 * buffer_pitch : 0);
+        }
+    const unsigned int n_blocks = use_buffers ? m_scatter.getNBlocks() : 1;
+    if (m_scratch.size() < n_blocks)
+        m_scratch.resize(n_blocks);
 
-                // initialize the current force and potential energy of particle j to 0
-                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-                Scalar pej = 0.0;
+    // compute the displacement, squared distance, and type pair of every neighbor of particle i
+    // once, the j and k loops below read them from the cache
+    auto cache_neighbors = [&](unsigned int i, Scratch& scratch)
+    {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        const size_t head_i = h_head_list.data[i];
+        // sanity check
+        assert(typei < ntypes);
+
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        scratch.grow(size, ntypes);
+        for (unsigned int j = 0; j < size; j++)
+            {
+            // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+            unsigned int jj = h_nlist.data[head_i + j];
+            assert(jj < n_all);
+
+            // access the position and type of particle j
+            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+            unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
+            assert(typej < ntypes);
+
+            // calculate dr_ij and apply periodic boundary conditions
+            Scalar3 dxij = box.minImage(posi - posj);
+
+            scratch.idx[j] = jj;
+            scratch.type[j] = typej;
+            scratch.typpair[j] = m_typpair_idx(typei, typej);
+            scratch.dx[j] = dxij;
+            scratch.rsq[j] = dot(dxij, dxij);
+            }
+        return size;
+    };
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
+    // ***** RevCross potential
+    auto compute_revcross
+        = [&](unsigned int i,
+              Scratch& scratch,
+              Scalar4* force,
+              Scalar* virial,
+              size_t pitch,
+              const hoomd::detail::BlockScatter::Window& window)
+    {
+        const unsigned int size = cache_neighbors(i, scratch);
 
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
+        // initialize current force and potential energy of particle i to 0
+        Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+        Scalar pei = 0.0;
 
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+        Scalar virialixx(0.0);
+        Scalar virialixy(0.0);
+        Scalar virialixz(0.0);
+        Scalar virialiyy(0.0);
+        Scalar virialiyz(0.0);
+        Scalar virializz(0.0);
 
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                const param_type& param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+        // loop over all of the neighbors of this particle
+        for (unsigned int j = 0; j < size; j++)
+            {
+            unsigned int jj = scratch.idx[j];
+            Scalar3 dxij = scratch.dx[j];
+            Scalar rij_sq = scratch.rsq[j];
+
+            // initialize the current force and potential energy of particle j to 0
+            Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+            Scalar pej = 0.0;
+
+            // get parameters for this type pair
+            const param_type& param = h_params.data[scratch.typpair[j]];
+            Scalar rcutsq = h_rcutsq.data[scratch.typpair[j]];
+
+            // evaluate the base repulsive and attractive terms
+            Scalar invratio = 0.0;
+            Scalar invratio2 = 0.0;
+            evaluator eval(rij_sq, rcutsq, param);
+            bool evaluated = eval.evalRepulsiveAndAttractive(invratio, invratio2);
+
+            // Even though the i-j interaction is symmetric so in principle I could consider i>j
+            // only, I have to loop over both i-j-k and j-i-k because I search only in neighbors
+            // of of the first element (since nl are type-wise I can not even merge them because
+            // i, j and k could be different types)
+            if (evaluated)
+                {
+                // evaluate the force and energy from the ij interaction
+                Scalar force_divr = Scalar(0.0);
+                Scalar potential_eng = Scalar(0.0);
+                Scalar bij = Scalar(0.0); // not used
+                eval.evalForceij(invratio,
+                                 invratio2,
+                                 Scalar(0.0),
+                                 Scalar(0.0),
+                                 bij,
+                                 force_divr,
+                                 potential_eng);
+
+                // add this force to particle i
+                fi += force_divr * dxij;
+                pei += potential_eng;
+
+                // add this force to particle j
+                fj += Scalar(-1.0) * force_divr * dxij;
+                pej += potential_eng;
+
+                // vir contribute for i j direct interaction on particle i and j
+                if (compute_virial)
+                    {
+                    virialixx += force_divr * dxij.x * dxij.x;
+                    virialixy += force_divr * dxij.x * dxij.y;
+                    virialixz += force_divr * dxij.x * dxij.z;
+                    virialiyy += force_divr * dxij.y * dxij.y;
+                    virialiyz += force_divr * dxij.y * dxij.z;
+                    virializz += force_divr * dxij.z * dxij.z;
+                    }
 
-                // evaluate the base repulsive and attractive terms
-                Scalar invratio = 0.0;
-                Scalar invratio2 = 0.0;
-                evaluator eval(rij_sq, rcutsq, param);
-                bool evaluated = eval.evalRepulsiveAndAttractive(invratio, invratio2);
-
-                // Even though the i-j interaction is symmetric so in principle I could consider i>j
-                // only, I have to loop over both i-j-k and j-i-k because I search only in neighbors
-                // of of the first element (since nl are type-wise I can not even merge them because
-                // i, j and k could be different types)
-                if (evaluated)
+                // evaluate the force from the ik interactions
+                for (unsigned int k = j + 1; k < size;
+                     k++) // I want to account only a single time for each triplets
                     {
-                    // printf("\nEvaluating the pair (i,j)=(%d, %d)  from inside HOOMD CPU",i,jj);
-                    // evaluate the force and energy from the ij interaction
-                    Scalar force_divr = Scalar(0.0);
-                    Scalar potential_eng = Scalar(0.0);
-                    Scalar bij = Scalar(0.0); // not used
-                    eval.evalForceij(invratio,
-                                     invratio2,
-                                     Scalar(0.0),
-                                     Scalar(0.0),
-                                     bij,
-                                     force_divr,
-                                     potential_eng);
-
-                    // add this force to particle i
-                    fi += force_divr * dxij;
-                    pei += potential_eng;
-
-                    // add this force to particle j
-                    fj += Scalar(-1.0) * force_divr * dxij;
-                    pej += potential_eng;
-
-                    // vir contribute for i j direct interaction on particle i and j
-                    if (compute_virial)
+                    unsigned int kk = scratch.idx[k];
+                    Scalar3 dxik = scratch.dx[k];
+                    Scalar rik_sq = scratch.rsq[k];
+
+                    // check if k interacts using a temporary evaluator to analyze i-k
+                    // parameters
+                    evaluator temp_eval(rij_sq, rcutsq, h_params.data[scratch.typpair[k]]);
+                    temp_eval.setRik(rik_sq);
+                    bool temp_evaluated = temp_eval.areInteractive();
+
+                    // 3 Body interaction ******
+                    if (temp_evaluated)
                         {
-                        virialixx += force_divr * dxij.x * dxij.x;
-                        virialixy += force_divr * dxij.x * dxij.y;
-                        virialixz += force_divr * dxij.x * dxij.z;
-                        virialiyy += force_divr * dxij.y * dxij.y;
-                        virialiyz += force_divr * dxij.y * dxij.z;
-                        virializz += force_divr * dxij.z * dxij.z;
-                        }
+                        eval.setRik(rik_sq);
+                        // compute the total force and energy
+                        Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
+                        Scalar3 force_divr_ij_vec = make_scalar3(0.0, 0.0, 0.0);
+                        Scalar3 force_divr_ik_vec = make_scalar3(0.0, 0.0, 0.0);
+                        bool evaluatedk = eval.evalForceik(invratio,
+                                                           invratio2,
+                                                           Scalar(0.0),
+                                                           Scalar(0.0),
+                                                           force_divr_ij_vec,
+                                                           force_divr_ik_vec);
+                        // k interacts with the i-j as an additional third body
+                        if (evaluatedk)
+                            {
+                            // I stored the modulus of the force in the first component
+                            Scalar force_divr_ij = force_divr_ij_vec.x;
+                            Scalar force_divr_ik = force_divr_ik_vec.x;
 
-                    // evaluate the force from the ik interactions
-                    for (unsigned int k = j + 1; k < size;
-                         k++) // I want to account only a single time for each triplets
-                        {
-                        // access the index of neighbor k
-                        unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
-
-                        // access the position and type of neighbor k
-                        Scalar3 posk
-                            = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                        unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                        assert(typek < m_pdata->getNTypes());
-
-                        // access the type pair parameters for i and k
-                        typpair_idx = m_typpair_idx(typei, typek);
-                        param_type temp_param
-                            = h_params.data[typpair_idx]; // use this to control the species wich
-                                                          // have to interact
-
-                        // compute dr_ik
-                        Scalar3 dxik = posi - posk;
-                        // apply periodic boundary conditions
-                        dxik = box.minImage(dxik);
-                        // compute rik_sq
-                        Scalar rik_sq = dot(dxik, dxik);
+                            // add the force to particle i
+                            fi += force_divr_ij * dxij + force_divr_ik * dxik;
 
-                        // check if k interacts using a temporary evaluator to analyze i-k
-                        // parameters
-                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                        temp_eval.setRik(rik_sq);
-                        bool temp_evaluated = temp_eval.areInteractive();
+                            // add the force to particle j (FLOPS: 17)
+                            fj += force_divr_ij * dxij * Scalar(-1.0);
 
-                        // 3 Body interaction ******
-                        if (temp_evaluated)
-                            {
-                            eval.setRik(rik_sq);
-                            // compute the total force and energy
-                            Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-                            Scalar3 force_divr_ij_vec = make_scalar3(0.0, 0.0, 0.0);
-                            Scalar3 force_divr_ik_vec = make_scalar3(0.0, 0.0, 0.0);
-                            bool evaluatedk = eval.evalForceik(invratio,
-                                                               invratio2,
-                                                               Scalar(0.0),
-                                                               Scalar(0.0),
-                                                               force_divr_ij_vec,
-                                                               force_divr_ik_vec);
-                            // k interacts with the i-j as an additional third body
-                            if (evaluatedk)
+                            // add the force to particle k
+                            fk += force_divr_ik * dxik * Scalar(-1.0);
+
+                            if (compute_virial)
                                 {
-                                // I stored the modulus of the force in the first component
-                                Scalar force_divr_ij = force_divr_ij_vec.x;
-                                Scalar force_divr_ik = force_divr_ik_vec.x;
-
-                                // add the force to particle i
-                                fi += force_divr_ij * dxij + force_divr_ik * dxik;
-
-                                // add the force to particle j (FLOPS: 17)
-                                fj += force_divr_ij * dxij * Scalar(-1.0);
-
-                                // add the force to particle k
-                                fk += force_divr_ik * dxik * Scalar(-1.0);
-
-                                if (compute_virial)
-                                    {
-                                    //***look at 3 body pressure notes
-                                    // i just need a single term to account for all of the 3 body
-                                    // virial that i decide to store in the i particle's data and i
-                                    // just defined the diagonal component of pressure tensor, I
-                                    // don't know how the off diagonal terms can be included
-                                    virialixx += (force_divr_ij * dxij.x * dxij.x
-                                                  + force_divr_ik * dxik.x * dxik.x);
-                                    virialiyy += (force_divr_ij * dxij.y * dxij.y
-                                                  + force_divr_ik * dxik.y * dxik.y);
-                                    virializz += (force_divr_ij * dxij.z * dxij.z
-                                                  + force_divr_ik * dxik.z * dxik.z);
-                                    virialixy += (force_divr_ij * dxij.x * dxij.y
-                                                  + force_divr_ik * dxik.x * dxik.y);
-                                    virialixz += (force_divr_ij * dxij.x * dxij.z
-                                                  + force_divr_ik * dxik.x * dxik.z);
-                                    virialiyz += (force_divr_ij * dxij.y * dxij.z
-                                                  + force_divr_ik * dxik.y * dxik.z);
-                                    }
-
-                                // increment the force for particle k
-                                unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
+                                //***look at 3 body pressure notes
+                                // i just need a single term to account for all of the 3 body
+                                // virial that i decide to store in the i particle's data and i
+                                // just defined the diagonal component of pressure tensor, I
+                                // don't know how the off diagonal terms can be included
+                                virialixx += (force_divr_ij * dxij.x * dxij.x
+                                              + force_divr_ik * dxik.x * dxik.x);
+                                virialiyy += (force_divr_ij * dxij.y * dxij.y
+                                              + force_divr_ik * dxik.y * dxik.y);
+                                virializz += (force_divr_ij * dxij.z * dxij.z
+                                              + force_divr_ik * dxik.z * dxik.z);
+                                virialixy += (force_divr_ij * dxij.x * dxij.y
+                                              + force_divr_ik * dxik.x * dxik.y);
+                                virialixz += (force_divr_ij * dxij.x * dxij.z
+                                              + force_divr_ik * dxik.x * dxik.z);
+                                virialiyz += (force_divr_ij * dxij.y * dxij.z
+                                              + force_divr_ik * dxik.y * dxik.z);
                                 }
+
+                            // increment the force for particle k
+                            const size_t mem_kk = window.getIndex(kk);
+                            force[mem_kk].x += fk.x;
+                            force[mem_kk].y += fk.y;
+                            force[mem_kk].z += fk.z;
                             }
                         }
                     }
-
-                // increment the force and potential energy for particle j
-                unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
                 }
 
-            // finally, increment the force and potential energy for particle i
-            unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
-
-            // imcrement vir for i
-            if (compute_virial)
-                {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += virialixx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += virialixy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += virialixz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += virialiyy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += virialiyz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += virializz;
-                }
+            // increment the force and potential energy for particle j
+            const size_t mem_jj = window.getIndex(jj);
+            force[mem_jj].x += fj.x;
+            force[mem_jj].y += fj.y;
+            force[mem_jj].z += fj.z;
+            force[mem_jj].w += pej;
             }
-        }
-    else
-        {
-        // ****** Tersoff or SquareDensity potential
-        // start by updating the neighborlist
-        m_nlist->compute(timestep);
 
-        // The three-body potentials can't handle a half neighbor list, so check now.
-        bool third_law = m_nlist->getStorageMode() == NeighborList::half;
-        if (third_law)
+        // finally, increment the force and potential energy for particle i
+        const size_t mem_i = window.getIndex(i);
+        force[mem_i].x += fi.x;
+        force[mem_i].y += fi.y;
+        force[mem_i].z += fi.z;
+        force[mem_i].w += pei;
+
+        // imcrement vir for i
+        if (compute_virial)
             {
-            m_exec_conf->msg->error()
-                << std::endl
-                << "PotentialTersoff cannot handle a half neighborlist" << std::endl;
-            throw std::runtime_error("Error computing forces in PotentialTersoff");
+            virial[0 * pitch + mem_i] += virialixx;
+            virial[1 * pitch + mem_i] += virialixy;
+            virial[2 * pitch + mem_i] += virialixz;
+            virial[3 * pitch + mem_i] += virialiyy;
+            virial[4 * pitch + mem_i] += virialiyz;
+            virial[5 * pitch + mem_i] += virializz;
             }
+    };
 
-        // access the neighbor list, particle data, and system box
-        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
-                                            access_location::host,
-                                            access_mode::read);
-        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
-                                        access_location::host,
-                                        access_mode::read);
-
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
-
-        // force and virial arrays
-        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
-
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
-
-        const BoxDim box = m_pdata->getBox();
-        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    // ****** Tersoff or SquareDensity potential
+    auto compute_tersoff
+        = [&](unsigned int i,
+              Scratch& scratch,
+              Scalar4* force,
+              Scalar* virial,
+              size_t pitch,
+              const hoomd::detail::BlockScatter::Window& window)
+    {
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        const unsigned int size = cache_neighbors(i, scratch);
+
+        // initialize current force and potential energy of particle i to 0
+        Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+        Scalar pei = 0.0;
+
+        Scalar viriali_xx(0.0);
+        Scalar viriali_xy(0.0);
+        Scalar viriali_xz(0.0);
+        Scalar viriali_yy(0.0);
+        Scalar viriali_yz(0.0);
+        Scalar viriali_zz(0.0);
+
+        // reset phi
+        Scalar* phi_ab = scratch.phi_ab.data();
+        for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+            {
+            phi_ab[typ_b] = Scalar(0.0);
+            }
 
-        // need to start from a zero force, energy
-        memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
-        memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+        if (evaluator::hasPerParticleEnergy())
+            {
+            for (unsigned int j = 0; j < size; j++)
+                {
+                // get parameters for this type pair
+                const param_type& param = h_params.data[scratch.typpair[j]];
+                Scalar rcutsq = h_rcutsq.data[scratch.typpair[j]];
 
-        unsigned int ntypes = m_pdata->getNTypes();
+                // evaluate the scalar per-neighbor contribution
+                evaluator eval(scratch.rsq[j], rcutsq, param);
+                eval.evalPhi(phi_ab[scratch.type[j]]);
+                }
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
-            {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            const size_t head_i = h_head_list.data[i];
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
-
-            // initialize current force and potential energy of particle i to 0
-            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pei = 0.0;
-
-            Scalar viriali_xx(0.0);
-            Scalar viriali_xy(0.0);
-            Scalar viriali_xz(0.0);
-            Scalar viriali_yy(0.0);
-            Scalar viriali_yz(0.0);
-            Scalar viriali_zz(0.0);
-
-            // reset phi
+            // self-energy
             for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
                 {
-                m_phi_ab[typ_b] = Scalar(0.0);
+                unsigned int typpair_idx = m_typpair_idx(typei, typ_b);
+                const param_type& param = h_params.data[typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                evaluator eval(Scalar(0.0), rcutsq, param);
+                Scalar energy(0.0);
+                eval.evalSelfEnergy(energy, phi_ab[typ_b]);
+                pei += energy;
                 }
+            }
 
-            // all neighbors of this particle
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            if (evaluator::hasPerParticleEnergy())
+        // loop over all of the neighbors of this particle
+        for (unsigned int j = 0; j < size; j++)
+            {
+            unsigned int jj = scratch.idx[j];
+            Scalar3 dxij = scratch.dx[j];
+            Scalar rij_sq = scratch.rsq[j];
+
+            // initialize the current force and potential energy of particle j to 0
+            Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+            Scalar pej = 0.0;
+
+            // get parameters for this type pair
+            const param_type& param = h_params.data[scratch.typpair[j]];
+            Scalar rcutsq = h_rcutsq.data[scratch.typpair[j]];
+
+            // evaluate the base repulsive and attractive terms
+            Scalar fR = 0.0;
+            Scalar fA = 0.0;
+            evaluator eval(rij_sq, rcutsq, param);
+            bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
+
+            Scalar virialj_xx(0.0);
+            Scalar virialj_xy(0.0);
+            Scalar virialj_xz(0.0);
+            Scalar virialj_yy(0.0);
+            Scalar virialj_yz(0.0);
+            Scalar virialj_zz(0.0);
+
+            if (evaluated)
                 {
-                for (unsigned int j = 0; j < size; j++)
+                // find the third bodies k of the pair and their bond angles, the chi and ik force
+                // loops both use them
+                if (evaluator::needsChi() || evaluator::hasIkForce())
                     {
-                    // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                    unsigned int jj = h_nlist.data[head_i + j];
-                    assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                    // access the position and type of particle j
-                    Scalar3 posj
-                        = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                    unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                    assert(typej < m_pdata->getNTypes());
-
-                    // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                    Scalar3 dxij = posi - posj;
-
-                    // apply periodic boundary conditions
-                    dxij = box.minImage(dxij);
-
-                    // compute rij_sq (FLOPS: 5)
-                    Scalar rij_sq = dot(dxij, dxij);
-
-                    // get parameters for this type pair
-                    unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                    const param_type& param = h_params.data[typpair_idx];
-                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                    for (unsigned int k = 0; k < size; k++)
+                        {
+                        // check if k interacts using a temporary evaluator to analyze i-k
+                        // parameters
+                        evaluator temp_eval(rij_sq, rcutsq, h_params.data[scratch.typpair[k]]);
+                        scratch.active[k] = k != j && temp_eval.areInteractive();
 
-                    // evaluate the scalar per-neighbor contribution
-                    evaluator eval(rij_sq, rcutsq, param);
-                    eval.evalPhi(m_phi_ab[typej]);
+                        // compute the bond angle (if needed)
+                        if (evaluator::needsAngle() && scratch.active[k])
+                            {
+                            scratch.cos_th[k] = dot(dxij, scratch.dx[k])
+                                                / fast::sqrt(rij_sq * scratch.rsq[k]);
+                            }
+                        }
                     }
 
-                // self-energy
-                for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+                // evaluate chi
+                Scalar chi = 0.0;
+                if (evaluator::needsChi())
                     {
-                    unsigned int typpair_idx = m_typpair_idx(typei, typ_b);
-                    const param_type& param = h_params.data[typpair_idx];
-                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
-                    evaluator eval(Scalar(0.0), rcutsq, param);
-                    Scalar energy(0.0);
-                    eval.evalSelfEnergy(energy, m_phi_ab[typ_b]);
-                    pei += energy;
-                    }
-                }
-
-            // loop over all of the neighbors of this particle
-            for (unsigned int j = 0; j < size; j++)
-                {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
-
-                // initialize the current force and potential energy of particle j to 0
-                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-                Scalar pej = 0.0;
-
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
+                    for (unsigned int k = 0; k < size; k++)
+                        {
+                        if (scratch.active[k])
+                            {
+                            // evaluate the partial chi term
+                            eval.setRik(scratch.rsq[k]);
+                            if (evaluator::needsAngle())
+                                eval.setAngle(scratch.cos_th[k]);
 
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
+                            eval.evalChi(chi);
+                            }
+                        }
+                    }
 
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+                // evaluate the force and energy from the ij interaction
+                Scalar force_divr = Scalar(0.0);
+                Scalar potential_eng = Scalar(0.0);
+                Scalar bij = Scalar(0.0);
+                eval.evalForceij(fR,
+                                 fA,
+                                 chi,
+                                 phi_ab[scratch.type[j]],
+                                 bij,
+                                 force_divr,
+                                 potential_eng);
+
+                // add this force to particle i
+                fi += force_divr * dxij;
+                pei += potential_eng * Scalar(0.5);
 
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                const param_type& param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                if (compute_virial)
+                    {
+                    Scalar force_div2r = Scalar(0.5) * force_divr;
+
+                    viriali_xx += force_div2r * dxij.x * dxij.x;
+                    viriali_xy += force_div2r * dxij.x * dxij.y;
+                    viriali_xz += force_div2r * dxij.x * dxij.z;
+                    viriali_yy += force_div2r * dxij.y * dxij.y;
+                    viriali_yz += force_div2r * dxij.y * dxij.z;
+                    viriali_zz += force_div2r * dxij.z * dxij.z;
+                    }
 
-                // evaluate the base repulsive and attractive terms
-                Scalar fR = 0.0;
-                Scalar fA = 0.0;
-                evaluator eval(rij_sq, rcutsq, param);
-                bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
+                // add this force to particle j
+                fj += Scalar(-1.0) * force_divr * dxij;
+                pej += potential_eng * Scalar(0.5);
 
-                Scalar virialj_xx(0.0);
-                Scalar virialj_xy(0.0);
-                Scalar virialj_xz(0.0);
-                Scalar virialj_yy(0.0);
-                Scalar virialj_yz(0.0);
-                Scalar virialj_zz(0.0);
+                if (compute_virial)
+                    {
+                    Scalar force_div2r = Scalar(0.5) * force_divr;
+
+                    virialj_xx += force_div2r * dxij.x * dxij.x;
+                    virialj_xy += force_div2r * dxij.x * dxij.y;
+                    virialj_xz += force_div2r * dxij.x * dxij.z;
+                    virialj_yy += force_div2r * dxij.y * dxij.y;
+                    virialj_yz += force_div2r * dxij.y * dxij.z;
+                    virialj_zz += force_div2r * dxij.z * dxij.z;
+                    }
 
-                if (evaluated)
+                if (evaluator::hasIkForce())
                     {
-                    // evaluate chi
-                    Scalar chi = 0.0;
-                    if (evaluator::needsChi())
+                    // evaluate the force from the ik interactions
+                    for (unsigned int k = 0; k < size; k++)
                         {
-                        for (unsigned int k = 0; k < size; k++)
-                            {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
-
-                            // access the type pair parameters for i and k
-                            typpair_idx = m_typpair_idx(typei, typek);
-                            const param_type& temp_param = h_params.data[typpair_idx];
-
-                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                            bool temp_evaluated = temp_eval.areInteractive();
+                        if (!scratch.active[k])
+                            continue;
 
-                            if (kk != jj && temp_evaluated)
-                                {
-                                // compute drik
-                                Scalar3 dxik = posi - posk;
+                        unsigned int kk = scratch.idx[k];
+                        Scalar3 dxik = scratch.dx[k];
 
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
+                        // create variable for the force on k
+                        Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
 
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                        // set up the evaluator
+                        eval.setRik(scratch.rsq[k]);
+                        if (evaluator::needsAngle())
+                            eval.setAngle(scratch.cos_th[k]);
 
-                                // compute the bond angle (if needed)
-                                Scalar cos_th = Scalar(0.0);
-                                if (evaluator::needsAngle())
-                                    cos_th = dot(dxij, dxik) / fast::sqrt(rij_sq * rik_sq);
+                        // compute the total force and energy
+                        Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
+                        Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
+                        eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
 
-                                // evaluate the partial chi term
-                                eval.setRik(rik_sq);
-                                if (evaluator::needsAngle())
-                                    eval.setAngle(cos_th);
+                        // add the force to particle i
+                        // (FLOPS: 17)
+                        fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
+                        fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
+                        fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
 
-                                eval.evalChi(chi);
-                                }
+                        // NOTE: virial for ik forces not tested
+                        if (compute_virial)
+                            {
+                            Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.x;
+                            Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.x;
+                            viriali_xx += force_div2r_ij * dxij.x * dxij.x
+                                          + force_div2r_ik * dxik.x * dxik.x;
+                            viriali_xy += force_div2r_ij * dxij.x * dxij.y
+                                          + force_div2r_ik * dxik.x * dxik.y;
+                            viriali_xz += force_div2r_ij * dxij.x * dxij.z
+                                          + force_div2r_ik * dxik.x * dxik.z;
+                            viriali_yy += force_div2r_ij * dxij.y * dxij.y
+                                          + force_div2r_ik * dxik.y * dxik.y;
+                            viriali_yz += force_div2r_ij * dxij.y * dxij.z
+                                          + force_div2r_ik * dxik.y * dxik.z;
+                            viriali_zz += force_div2r_ij * dxij.z * dxij.z
+                                          + force_div2r_ik * dxik.z * dxik.z;
                             }
-                        }
-
-                    // evaluate the force and energy from the ij interaction
-                    Scalar force_divr = Scalar(0.0);
-                    Scalar potential_eng = Scalar(0.0);
-                    Scalar bij = Scalar(0.0);
-                    eval.evalForceij(fR, fA, chi, m_phi_ab[typej], bij, force_divr, potential_eng);
 
-                    // add this force to particle i
-                    fi += force_divr * dxij;
-                    pei += potential_eng * Scalar(0.5);
+                        // add the force to particle j (FLOPS: 17)
+                        fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
+                        fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
+                        fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
 
-                    if (compute_virial)
-                        {
-                        Scalar force_div2r = Scalar(0.5) * force_divr;
-
-                        viriali_xx += force_div2r * dxij.x * dxij.x;
-                        viriali_xy += force_div2r * dxij.x * dxij.y;
-                        viriali_xz += force_div2r * dxij.x * dxij.z;
-                        viriali_yy += force_div2r * dxij.y * dxij.y;
-                        viriali_yz += force_div2r * dxij.y * dxij.z;
-                        viriali_zz += force_div2r * dxij.z * dxij.z;
-                        }
-
-                    // add this force to particle j
-                    fj += Scalar(-1.0) * force_divr * dxij;
-                    pej += potential_eng * Scalar(0.5);
-
-                    if (compute_virial)
-                        {
-                        Scalar force_div2r = Scalar(0.5) * force_divr;
-
-                        virialj_xx += force_div2r * dxij.x * dxij.x;
-                        virialj_xy += force_div2r * dxij.x * dxij.y;
-                        virialj_xz += force_div2r * dxij.x * dxij.z;
-                        virialj_yy += force_div2r * dxij.y * dxij.y;
-                        virialj_yz += force_div2r * dxij.y * dxij.z;
-                        virialj_zz += force_div2r * dxij.z * dxij.z;
-                        }
-
-                    if (evaluator::hasIkForce())
-                        {
-                        // evaluate the force from the ik interactions
-                        for (unsigned int k = 0; k < size; k++)
+                        // NOTE: virial for ik forces not tested
+                        if (compute_virial)
                             {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
+                            Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.y;
+                            Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.y;
+                            virialj_xx += force_div2r_ij * dxij.x * dxij.x
+                                          + force_div2r_ik * dxik.x * dxik.x;
+                            virialj_xy += force_div2r_ij * dxij.x * dxij.y
+                                          + force_div2r_ik * dxik.x * dxik.y;
+                            virialj_xz += force_div2r_ij * dxij.x * dxij.z
+                                          + force_div2r_ik * dxik.x * dxik.z;
+                            virialj_yy += force_div2r_ij * dxij.y * dxij.y
+                                          + force_div2r_ik * dxik.y * dxik.y;
+                            virialj_yz += force_div2r_ij * dxij.y * dxij.z
+                                          + force_div2r_ik * dxik.y * dxik.z;
+                            virialj_zz += force_div2r_ij * dxij.z * dxij.z
+                                          + force_div2r_ik * dxik.z * dxik.z;
+                            }
 
-                            // access the type pair parameters for i and k
-                            typpair_idx = m_typpair_idx(typei, typek);
-                            const param_type& temp_param = h_params.data[typpair_idx];
+                        // add the force to particle k
+                        fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
+                        fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
+                        fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
 
-                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                            bool temp_evaluated = temp_eval.areInteractive();
+                        // increment the force for particle k
+                        const size_t mem_kk = window.getIndex(kk);
+                        force[mem_kk].x += fk.x;
+                        force[mem_kk].y += fk.y;
+                        force[mem_kk].z += fk.z;
 
-                            if (kk != jj && temp_evaluated)
-                                {
-                                // create variable for the force on k
-                                Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-
-                                // compute dr_ik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
-
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
-
-                                // compute the bond angle (if needed)
-                                Scalar cos_th = Scalar(0.0);
-                                if (evaluator::needsAngle())
-                                    cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
-
-                                // set up the evaluator
-                                eval.setRik(rik_sq);
-                                if (evaluator::needsAngle())
-                                    eval.setAngle(cos_th);
-
-                                // compute the total force and energy
-                                Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
-                                Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
-                                eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
-
-                                // add the force to particle i
-                                // (FLOPS: 17)
-                                fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
-                                fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
-                                fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
-
-                                // NOTE: virial for ik forces not tested
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.x;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.x;
-                                    viriali_xx += force_div2r_ij * dxij.x * dxij.x
-                                                  + force_div2r_ik * dxik.x * dxik.x;
-                                    viriali_xy += force_div2r_ij * dxij.x * dxij.y
-                                                  + force_div2r_ik * dxik.x * dxik.y;
-                                    viriali_xz += force_div2r_ij * dxij.x * dxij.z
-                                                  + force_div2r_ik * dxik.x * dxik.z;
-                                    viriali_yy += force_div2r_ij * dxij.y * dxij.y
-                                                  + force_div2r_ik * dxik.y * dxik.y;
-                                    viriali_yz += force_div2r_ij * dxij.y * dxij.z
-                                                  + force_div2r_ik * dxik.y * dxik.z;
-                                    viriali_zz += force_div2r_ij * dxij.z * dxij.z
-                                                  + force_div2r_ik * dxik.z * dxik.z;
-                                    }
-
-                                // add the force to particle j (FLOPS: 17)
-                                fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
-                                fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
-                                fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
-
-                                // NOTE: virial for ik forces not tested
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.y;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.y;
-                                    virialj_xx += force_div2r_ij * dxij.x * dxij.x
-                                                  + force_div2r_ik * dxik.x * dxik.x;
-                                    virialj_xy += force_div2r_ij * dxij.x * dxij.y
-                                                  + force_div2r_ik * dxik.x * dxik.y;
-                                    virialj_xz += force_div2r_ij * dxij.x * dxij.z
-                                                  + force_div2r_ik * dxik.x * dxik.z;
-                                    virialj_yy += force_div2r_ij * dxij.y * dxij.y
-                                                  + force_div2r_ik * dxik.y * dxik.y;
-                                    virialj_yz += force_div2r_ij * dxij.y * dxij.z
-                                                  + force_div2r_ik * dxik.y * dxik.z;
-                                    virialj_zz += force_div2r_ij * dxij.z * dxij.z
-                                                  + force_div2r_ik * dxik.z * dxik.z;
-                                    }
-
-                                // add the force to particle k
-                                fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
-                                fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
-                                fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
-
-                                // increment the force for particle k
-                                unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
-
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.z;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.z;
-                                    h_virial.data[0 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.x
-                                           + force_div2r_ik * dxik.x * dxik.x;
-                                    h_virial.data[1 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.y
-                                           + force_div2r_ik * dxik.x * dxik.y;
-                                    h_virial.data[2 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.z
-                                           + force_div2r_ik * dxik.x * dxik.z;
-                                    h_virial.data[3 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.y * dxij.y
-                                           + force_div2r_ik * dxik.y * dxik.y;
-                                    h_virial.data[4 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.y * dxij.z
-                                           + force_div2r_ik * dxik.y * dxik.z;
-                                    h_virial.data[5 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.z * dxij.z
-                                           + force_div2r_ik * dxik.z * dxik.z;
-                                    }
-                                }
+                        if (compute_virial)
+                            {
+                            Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.z;
+                            Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.z;
+                            virial[0 * pitch + mem_kk] += force_div2r_ij * dxij.x * dxij.x
+                                                      + force_div2r_ik * dxik.x * dxik.x;
+                            virial[1 * pitch + mem_kk] += force_div2r_ij * dxij.x * dxij.y
+                                                      + force_div2r_ik * dxik.x * dxik.y;
+                            virial[2 * pitch + mem_kk] += force_div2r_ij * dxij.x * dxij.z
+                                                      + force_div2r_ik * dxik.x * dxik.z;
+                            virial[3 * pitch + mem_kk] += force_div2r_ij * dxij.y * dxij.y
+                                                      + force_div2r_ik * dxik.y * dxik.y;
+                            virial[4 * pitch + mem_kk] += force_div2r_ij * dxij.y * dxij.z
+                                                      + force_div2r_ik * dxik.y * dxik.z;
+                            virial[5 * pitch + mem_kk] += force_div2r_ij * dxij.z * dxij.z
+                                                      + force_div2r_ik * dxik.z * dxik.z;
                             }
                         }
                     }
-                // increment the force and potential energy for particle j
-                unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
-
-                if (compute_virial)
-                    {
-                    h_virial.data[0 * m_virial_pitch + mem_idx] += virialj_xx;
-                    h_virial.data[1 * m_virial_pitch + mem_idx] += virialj_xy;
-                    h_virial.data[2 * m_virial_pitch + mem_idx] += virialj_xz;
-                    h_virial.data[3 * m_virial_pitch + mem_idx] += virialj_yy;
-                    h_virial.data[4 * m_virial_pitch + mem_idx] += virialj_yz;
-                    h_virial.data[5 * m_virial_pitch + mem_idx] += virialj_zz;
-                    }
                 }
-            // finally, increment the force and potential energy for particle i
-            unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
+            // increment the force and potential energy for particle j
+            const size_t mem_jj = window.getIndex(jj);
+            force[mem_jj].x += fj.x;
+            force[mem_jj].y += fj.y;
+            force[mem_jj].z += fj.z;
+            force[mem_jj].w += pej;
 
             if (compute_virial)
                 {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += viriali_xx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += viriali_xy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += viriali_xz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += viriali_yy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += viriali_yz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += viriali_zz;
+                virial[0 * pitch + mem_jj] += virialj_xx;
+                virial[1 * pitch + mem_jj] += virialj_xy;
+                virial[2 * pitch + mem_jj] += virialj_xz;
+                virial[3 * pitch + mem_jj] += virialj_yy;
+                virial[4 * pitch + mem_jj] += virialj_yz;
+                virial[5 * pitch + mem_jj] += virialj_zz;
                 }
             }
+        // finally, increment the force and potential energy for particle i
+        const size_t mem_i = window.getIndex(i);
+        force[mem_i].x += fi.x;
+        force[mem_i].y += fi.y;
+        force[mem_i].z += fi.z;
+        force[mem_i].w += pei;
+
+        if (compute_virial)
+            {
+            virial[0 * pitch + mem_i] += viriali_xx;
+            virial[1 * pitch + mem_i] += viriali_xy;
+            virial[2 * pitch + mem_i] += viriali_xz;
+            virial[3 * pitch + mem_i] += viriali_yy;
+            virial[4 * pitch + mem_i] += viriali_yz;
+            virial[5 * pitch + mem_i] += viriali_zz;
+            }
+    };
+
+    // compute the forces of particles [first, last) and their neighbors
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scratch& scratch,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t pitch,
+                             const hoomd::detail::BlockScatter::Window& window)
+    {
+        for (unsigned int i = first; i < last; i++)
+            {
+            if (evaluator::flag_for_RevCross)
+                compute_revcross(i, scratch, force, virial, pitch, window);
+            else
+                compute_tersoff(i, scratch, force, virial, pitch, window);
+            }
+    };
+
+    if (use_buffers)
+        {
+        m_scatter.forEach(
+            *m_exec_conf,
+            [&](const hoomd::detail::BlockScatter::Block& b, unsigned int block)
+            {
+                const size_t size = size_t(b.window.getLocalSize()) + b.window.getGhostSize();
+                Scalar4* force = m_block_force.data() + b.offset;
+                Scalar* virial = m_block_virial.data() + (compute_virial ? b.offset : 0);
+                memset((void*)force, 0, sizeof(Scalar4) * size);
+                if (compute_virial)
+                    for (unsigned int l = 0; l < 6; l++)
+                        memset((void*)(virial + l * buffer_pitch), 0, sizeof(Scalar) * size);
+                compute_range(b.first,
+                              b.last,
+                              m_scratch[block],
+                              force,
+                              virial,
+                              buffer_pitch,
+                              b.window);
+            });
+
+        // sum the per block results in block order, including the ghosts
+        m_scatter.reduce(*m_exec_conf,
+                         n_all,
+                         [&](unsigned int i, size_t slot)
+                         {
+                             h_force.data[i].x += m_block_force[slot].x;
+                             h_force.data[i].y += m_block_force[slot].y;
+                             h_force.data[i].z += m_block_force[slot].z;
+                             h_force.data[i].w += m_block_force[slot].w;
+                             if (compute_virial)
+                                 for (unsigned int l = 0; l < 6; l++)
+                                     h_virial.data[l * m_virial_pitch + i]
+                                         += m_block_virial[l * buffer_pitch + slot];
+                         });
+        }
+    else
+        {
+        // write directly to the outputs: the window maps every index to itself
+        hoomd::detail::BlockScatter::Window window;
+        window.n_local = N;
+        window.lo = 0;
+        window.hi = N;
+        window.ghost_lo = N;
+        window.ghost_hi = n_all;
+        compute_range(0, N, m_scratch[0], h_force.data, h_virial.data, m_virial_pitch, window);
         }
     }
 
@@ -596,6 +596,7 @@ void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
     const std::array<Scalar, 2> rescaleFactors = {rf[0] * mtk, rf[1] * mtk};
 
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
+    ComputeThermo::KineticSums kinetic;
 
         {
         ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
@@ -605,6 +606,12 @@ void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
                                      access_location::host,
                                      access_mode::readwrite);
         ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
 
         // perform second half step of NPT integration
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -638,68 +645,105 @@ void TwoStepConstantPressure::integrateStepTwo(uint64_t timestep)
             h_vel.data[j].x = v.x;
             h_vel.data[j].y = v.y;
             h_vel.data[j].z = v.z;
+
+            // sum the kinetic tensor for the barostat, ignoring rigid body constituents
+            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+                {
+                kinetic.xx += m * ((double)v.x * (double)v.x);
+                kinetic.xy += m * ((double)v.x * (double)v.y);
+                kinetic.xz += m * ((double)v.x * (double)v.z);
+                kinetic.yy += m * ((double)v.y * (double)v.y);
+                kinetic.yz += m * ((double)v.y * (double)v.z);
+                kinetic.zz += m * ((double)v.z * (double)v.z);
+                }
             }
+        } // end GPUArray scope
 
-        if (m_aniso)
-            {
-            // angular degrees of freedom
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                          access_location::host,
-                                          access_mode::readwrite);
-            ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+    // The full step thermo reads the angular momenta only for the rotational kinetic energy.
+    // Otherwise, start it (and its MPI reduction) now so that it overlaps the angular update.
+    // Isotropic systems have no angular update, and advanceBarostat() below needs the reduced
+    // pressure right away, so for them the reduction does not overlap any work.
+    bool thermo_after_angular
+        = m_aniso && m_pdata->getFlags()[pdata_flag::rotational_kinetic_energy];
+    if (!thermo_after_angular)
+        computeThermoFullStep(timestep + 1, kinetic);
+
+    if (m_aniso)
+        {
+        // angular degrees of freedom
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                      access_location::host,
+                                      access_mode::readwrite);
+        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                       access_location::host,
+                                       access_mode::read);
 
-            // precompute loop invariant quantity
+        // precompute loop invariant quantity
 
-            // apply rotational (NO_SQUISH) equations of motion
-            for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-                {
-                unsigned int j = m_group->getMemberIndex(group_idx);
+        // apply rotational (NO_SQUISH) equations of motion
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
 
-                quat<Scalar> q(h_orientation.data[j]);
-                quat<Scalar> p(h_angmom.data[j]);
-                vec3<Scalar> t(h_net_torque.data[j]);
-                vec3<Scalar> I(h_inertia.data[j]);
+            quat<Scalar> q(h_orientation.data[j]);
+            quat<Scalar> p(h_angmom.data[j]);
+            vec3<Scalar> t(h_net_torque.data[j]);
+            vec3<Scalar> I(h_inertia.data[j]);
 
-                // rotate torque into principal frame
-                t = rotate(conj(q), t);
+            // rotate torque into principal frame
+            t = rotate(conj(q), t);
 
-                // check for zero moment of inertia
-                bool x_zero, y_zero, z_zero;
-                x_zero = (I.x == 0);
-                y_zero = (I.y == 0);
-                z_zero = (I.z == 0);
+            // check for zero moment of inertia
+            bool x_zero, y_zero, z_zero;
+            x_zero = (I.x == 0);
+            y_zero = (I.y == 0);
+            z_zero = (I.z == 0);
 
-                // ignore torque component along an axis for which the moment of inertia zero
-                if (x_zero)
-                    t.x = 0;
-                if (y_zero)
-                    t.y = 0;
-                if (z_zero)
-                    t.z = 0;
+            // ignore torque component along an axis for which the moment of inertia zero
+            if (x_zero)
+                t.x = 0;
+            if (y_zero)
+                t.y = 0;
+            if (z_zero)
+                t.z = 0;
 
-                // thermostat angular degrees of freedom
-                p = p * rescaleFactors[1];
+            // thermostat angular degrees of freedom
+            p = p * rescaleFactors[1];
 
-                // advance p(t+deltaT/2)->p(t+deltaT)
-                p += m_deltaT * q * t;
+            // advance p(t+deltaT/2)->p(t+deltaT)
+            p += m_deltaT * q * t;
 
-                h_angmom.data[j] = quat_to_scalar4(p);
-                }
+            h_angmom.data[j] = quat_to_scalar4(p);
             }
-        } // end GPUArray scope
+        }
+
+    if (thermo_after_angular)
+        computeThermoFullStep(timestep + 1, kinetic);
 
     // advance barostat (m_barostat.nu_xx, m_barostat.nu_yy, m_barostat.nu_zz) half a time step
     advanceBarostat(timestep + 1);
     }
 
+/*! \param timestep Time step to compute the thermodynamic quantities at
+    \param kinetic Kinetic tensor summed over the group during the velocity update
+
+    Reuses \a kinetic when the full step thermo is computed over the same group as this method.
+*/
+void TwoStepConstantPressure::computeThermoFullStep(uint64_t timestep,
+                                                    const ComputeThermo::KineticSums& kinetic)
+    {
+    if (m_thermo_full_step->getGroup() == m_group)
+        m_thermo_full_step->computeWithKineticSums(timestep, kinetic);
+    else
+        m_thermo_full_step->compute(timestep);
+    }
+
 pybind11::tuple TwoStepConstantPressure::getBarostatDOF()
     {
     return pybind11::make_tuple(m_barostat.nu_xx,
@@ -227,6 +227,9 @@ class PYBIND11_EXPORT TwoStepConstantPressure : public IntegrationMethodTwoStep
 
     /// Helper function to advance the barostat parameters.
     virtual void advanceBarostat(uint64_t timestep);
+
+    /// Compute the full step thermo, reusing the kinetic tensor summed in integrateStepTwo.
+    void computeThermoFullStep(uint64_t timestep, const ComputeThermo::KineticSums& kinetic);
     };
 
     } // namespace hoomd::md
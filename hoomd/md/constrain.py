@@ -22,7 +22,7 @@ Warning:
 from hoomd.md import _md
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyIf, OnlyFrom, to_type_converter
 from hoomd.md.force import Force
 import hoomd
 
@@ -56,6 +56,10 @@ class Distance(Constraint):
 
     Args:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Linear solver for the constraint equations: ``'direct'``
+            or ``'iterative'``.
+        solver_tolerance (float): Relative residual tolerance of the
+            iterative solver.
 
     `Distance` applies forces between particles that constrain the distances
     between particles to specific values. The algorithm implemented is described
@@ -100,14 +104,34 @@ class Distance(Constraint):
         issue a warning message. It does not influence the computation of the
         constraint force.
 
+    The constraint matrix is sparse: two constraints are coupled only when they
+    share a particle. The ``'direct'`` solver factorizes the sparse matrix every
+    step. The ``'iterative'`` solver uses BiCGSTAB, starting from the Lagrange
+    multipliers of the previous step, and needs less time and memory for
+    systems with many constraints. On the GPU, the ``'iterative'`` solver
+    only takes effect in builds without cuSOLVER.
+
     Attributes:
         tolerance (float): Relative tolerance for constraint violation warnings.
+
+        solver (str): Linear solver for the constraint equations: ``'direct'``
+            or ``'iterative'``.
+
+        solver_tolerance (float): Relative residual tolerance of the
+            iterative solver.
     """
 
     _cpp_class_name = "ForceDistanceConstraint"
 
-    def __init__(self, tolerance=1e-3):
-        self._param_dict.update(ParameterDict(tolerance=float(tolerance)))
+    def __init__(self,
+                 tolerance=1e-3,
+                 solver='direct',
+                 solver_tolerance=1e-10):
+        self._param_dict.update(
+            ParameterDict(tolerance=float(tolerance),
+                          solver=OnlyFrom(['direct', 'iterative']),
+                          solver_tolerance=float(solver_tolerance)))
+        self.solver = solver
 
 
 class Rigid(Constraint):
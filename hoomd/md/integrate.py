@@ -153,6 +153,21 @@ class Integrator(_DynamicIntegrator):
         half_step_hook (hoomd.md.HalfStepHook): Enables the user to perform
             arbitrary computations during the half-step of the integration.
 
+        accumulate_forces (bool): When True, forces that support it add their
+            contributions directly to the net force instead of summing them
+            in a separate pass. Defaults to ``False``.
+
+        overlap_ghost_update (bool): When True, forces on particles with no
+            ghost neighbors are computed while ghost positions are exchanged
+            between MPI ranks. Defaults to ``False``.
+
+        slow_forces (Sequence[hoomd.md.force.Force]): Sequence of forces
+          evaluated every `slow_force_interval` steps. The default value of
+          ``None`` initializes an empty list.
+
+        slow_force_interval (int): Number of steps between evaluations of the
+            forces in `slow_forces`. Defaults to 1.
+
     `Integrator` is the top level class that orchestrates the time integration
     step in molecular dynamics simulations. The integration `methods` define
     the equations of motion to integrate under the influence of the given
@@ -208,6 +223,60 @@ class Integrator(_DynamicIntegrator):
         By default, `integrate_rotational_dof` is ``False``. `gsd` and
         `hoomd.Snapshot` also set particle moments of inertia to 0 by default.
 
+    .. rubric:: Net force accumulation
+
+    When `accumulate_forces` is ``True`` and the simulation runs on the CPU,
+    pair forces (`hoomd.md.pair`) and bond forces (`hoomd.md.bond`) add their
+    forces, energies, and virials directly to the net force arrays. The other
+    forces are summed as usual. The total energy of each force remains
+    available every step, while the per-particle arrays (such as
+    `hoomd.md.force.Force.forces`) are computed again on demand when accessed.
+    Enable `accumulate_forces` when the per-particle force arrays are accessed
+    less often than every few steps. It has no effect on the GPU.
+
+    .. rubric:: Overlapped ghost updates
+
+    When `overlap_ghost_update` is ``True`` in domain decomposed simulations on
+    the CPU, pair forces (`hoomd.md.pair`) and bond forces (`hoomd.md.bond`)
+    compute the forces on particles that interact only with particles in the
+    same domain while ghost positions are in flight, and compute the remaining
+    particles once the ghost update completes. Steps that rebuild the neighbor
+    list, forces using `hoomd.md.nlist.Cluster`, forces with
+    `accumulate_forces`, and integrators with `rigid` bodies compute all
+    particles after the ghost update. Enable `overlap_ghost_update` when the
+    ghost communication takes a large fraction of the step time.
+
+    .. rubric:: Multiple time stepping
+
+    `Integrator` evaluates the forces in `slow_forces` only at the start of
+    each outer step of `slow_force_interval` :math:`k` steps and applies them
+    as impulses (r-RESPA):
+
+    .. math::
+
+        \vec{F}_{\mathrm{net},i} = \sum_{f \in \mathrm{forces}} \vec{F}_i^f
+        + w \sum_{f \in \mathrm{slow\_forces}} \vec{F}_i^f
+
+    where :math:`w = k` at the start of an outer step and :math:`w = 0`
+    otherwise. The same weight applies to torques. The outer steps start at
+    the first step the integrator runs with `slow_forces` (or changes
+    `slow_force_interval`), whatever its timestep, and repeat every :math:`k`
+    steps after that. The two half step velocity updates next to the start of
+    each outer step apply the slow force impulse :math:`k \Delta t / 2` each,
+    so `dt` is the time step of the fast forces. Put slowly varying forces,
+    such as `hoomd.md.long_range.pppm.Coulomb` and long range tails of pair
+    potentials, in `slow_forces` and the bonded and short ranged forces in
+    `forces`. A force must not be in both lists.
+
+    The net energy and virial always include the slow forces with weight 1.
+    Between evaluations, they hold the values from the last evaluation, so the
+    thermodynamic quantities are exact at the start of each outer step.
+    Particles that migrate to another MPI rank between evaluations carry no
+    slow energy or virial until the next evaluation, but the system totals are
+    unchanged. Constraints and rigid bodies act on the whole slow impulse,
+    but their virials include the slow forces with weight 1. `slow_forces`
+    are supported only on the CPU.
+
     .. rubric:: Classes
 
     Classes of the following modules can be used as elements in `methods`:
@@ -262,6 +331,18 @@ class Integrator(_DynamicIntegrator):
 
         half_step_hook (hoomd.md.HalfStepHook): User defined implementation to
             perform computations during the half-step of the integration.
+
+        accumulate_forces (bool): When True, forces that support it add their
+            contributions directly to the net force.
+
+        overlap_ghost_update (bool): When True, forces on interior particles
+            are computed during the ghost position update.
+
+        slow_forces (list[hoomd.md.force.Force]): List of forces evaluated
+            every `slow_force_interval` steps.
+
+        slow_force_interval (int): Number of steps between evaluations of the
+            forces in `slow_forces`.
     """
 
     def __init__(self,
@@ -271,14 +352,25 @@ class Integrator(_DynamicIntegrator):
                  constraints=None,
                  methods=None,
                  rigid=None,
-                 half_step_hook=None):
+                 half_step_hook=None,
+                 accumulate_forces=False,
+                 overlap_ghost_update=False,
+                 slow_forces=None,
+                 slow_force_interval=1):
 
         super().__init__(forces, constraints, methods, rigid)
 
+        slow_forces = [] if slow_forces is None else slow_forces
+        self._slow_forces = syncedlist.SyncedList(
+            Force, syncedlist._PartialGetAttr('_cpp_obj'), iterable=slow_forces)
+
         self._param_dict.update(
             ParameterDict(
                 dt=float(dt),
                 integrate_rotational_dof=bool(integrate_rotational_dof),
+                accumulate_forces=bool(accumulate_forces),
+                overlap_ghost_update=bool(overlap_ghost_update),
+                slow_force_interval=int(slow_force_interval),
                 half_step_hook=OnlyTypes(hoomd.md.HalfStepHook,
                                          allow_none=True)))
 
@@ -288,10 +380,23 @@ class Integrator(_DynamicIntegrator):
         # initialize the reflected c++ class
         self._cpp_obj = _md.IntegratorTwoStep(
             self._simulation.state._cpp_sys_def, self.dt)
+        self._slow_forces._sync(self._simulation, self._cpp_obj.slow_forces)
         # Call attach from DynamicIntegrator which attaches forces,
         # constraint_forces, and methods, and calls super()._attach() itself.
         super()._attach_hook()
 
+    def _detach_hook(self):
+        self._slow_forces._unsync()
+        super()._detach_hook()
+
+    @property
+    def slow_forces(self):
+        return self._slow_forces
+
+    @slow_forces.setter
+    def slow_forces(self, value):
+        _set_synced_list(self._slow_forces, value)
+
     def __setattr__(self, attr, value):
         """Hande group DOF update when setting integrate_rotational_dof."""
         super().__setattr__(attr, value)
@@ -6,7 +6,7 @@ r"""Neighbor list acceleration structures.
 Pair forces (`hoomd.md.pair`) use neighbor list data structures to find
 neighboring particle pairs (those within a distance of :math:`r_\mathrm{cut}`)
 efficiently. HOOMD-blue provides a several types of neighbor list construction
-algorithms that you can select from: `Cell`, `Tree`, and `Stencil`.
+algorithms that you can select from: `Cell`, `Cluster`, `Tree`, and `Stencil`.
 
 Multiple pair force objects can share a single neighbor list, or use independent
 neighbor list objects. When neighbor lists are shared, they find neighbors
@@ -412,12 +412,102 @@ class Cell(NeighborList):
     def allocated_particles_per_cell(self):
         """int: Number of particle slots allocated per cell.
 
-        The total memory usage of `Cell` is proportional to the product of the
-        three cell list `dimensions` and the `allocated_particles_per_cell`.
+        The total memory usage of `Cell` on the GPU is proportional to the
+        product of the three cell list `dimensions` and the
+        `allocated_particles_per_cell`. On the CPU, the cell list is stored in
+        compressed form and `allocated_particles_per_cell` is the largest number
+        of particles in any one cell.
         """
         return self._cpp_obj.getNmax()
 
 
+class Cluster(NeighborList):
+    r"""Neighbor list of particle clusters computed via a cell list.
+
+    Args:
+        buffer (float): Buffer width :math:`[\mathrm{length}]`.
+        exclusions (tuple[str]): Defines which particles to exclude from the
+            neighbor list, see more details in `NeighborList`.
+        rebuild_check_delay (int): How often to attempt to rebuild the neighbor
+            list.
+        check_dist (bool): Flag to enable / disable distance checking.
+        cluster_size (int): Number of particles in each cluster (4 or 8).
+        mesh (Mesh): When a mesh object is passed, the neighbor list uses the
+            mesh to determine the bond exclusions in addition to all other
+            set exclusions.
+        default_r_cut (float): Default cutoff distance
+            :math:`[\mathrm{length}]`.
+
+    `Cluster` groups the particles in each cell of a cell list (sized like
+    `Cell`) into clusters of `cluster_size` particles and finds the pairs of
+    clusters with bounding spheres within
+    :math:`r_\mathrm{cut} + r_\mathrm{buffer}` of each other. Each cluster
+    pair stores a bitmask that marks which of its particle pairs interact, with
+    exclusions already removed.
+    `hoomd.md.pair.Pair` potentials that support batched evaluation evaluate
+    whole cluster pair tiles at once, which keeps the particle data of a
+    cluster in registers and evaluates several pairs per vector instruction.
+    All other forces use a per-particle neighbor list that `Cluster` also
+    builds from the cluster pairs.
+
+    Cluster pairs include particle pairs that are somewhat farther apart than
+    :math:`r_\mathrm{cut} + r_\mathrm{buffer}`. Choose a `cluster_size` of 4
+    when cells hold few particles, as the unused slots in partially filled
+    clusters are wasted work.
+
+    Note:
+        `Cluster` is only available on the CPU.
+
+    Examples::
+
+        cluster = nlist.Cluster(buffer=0.4, cluster_size=4)
+
+    Attributes:
+        cluster_size (int): Number of particles in each cluster (4 or 8).
+    """
+
+    def __init__(self,
+                 buffer,
+                 exclusions=('bond',),
+                 rebuild_check_delay=1,
+                 check_dist=True,
+                 cluster_size=4,
+                 mesh=None,
+                 default_r_cut=0.0):
+
+        super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
+                         mesh, default_r_cut)
+
+        self._param_dict.update(
+            ParameterDict(cluster_size=OnlyFrom([4, 8])))
+        self.cluster_size = cluster_size
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("Cluster is not supported on the GPU.")
+        self._cpp_obj = _md.NeighborListCluster(
+            self._simulation.state._cpp_sys_def, self.buffer)
+        super()._attach_hook()
+
+    @log(requires_run=True, default=False, category='sequence')
+    def dimensions(self):
+        """tuple[int, int, int]: Cell list dimensions.
+
+        `dimensions` is the number of cells in the x, y, and z directions.
+        """
+        dimensions = self._cpp_obj.getDim()
+        return (dimensions.x, dimensions.y, dimensions.z)
+
+    @log(requires_run=True, default=False)
+    def num_local_clusters(self):
+        """int: Number of clusters of local particles.
+
+        `num_local_clusters` is the number of clusters formed from the particles
+        in the local simulation domain.
+        """
+        return self._cpp_obj.getNLocalClusters()
+
+
 class Stencil(NeighborList):
     """Cell list based neighbor list using stencils.
 
@@ -77,6 +77,11 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     assert d.tolerance == 1e-5
     d.tolerance = 1e-3
     assert d.tolerance == 1e-3
+    assert d.solver == 'direct'
+    d.solver = 'iterative'
+    assert d.solver == 'iterative'
+    with pytest.raises(hoomd.error.TypeConversionError):
+        d.solver = 'unknown'
 
     # attached
     sim = simulation_factory(polymer_snapshot_factory())
@@ -90,6 +95,11 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     assert d.tolerance == 1e-3
     d.tolerance = 1e-5
     assert d.tolerance == 1e-5
+    assert d.solver == 'iterative'
+    d.solver = 'direct'
+    assert d.solver == 'direct'
+    d.solver_tolerance = 1e-12
+    assert d.solver_tolerance == 1e-12
 
 
 def test_pickling(simulation_factory, polymer_snapshot_factory):
@@ -109,9 +119,11 @@ def test_pickling(simulation_factory, polymer_snapshot_factory):
     pickling_check(d)
 
 
-def test_basic_simulation(simulation_factory, polymer_snapshot_factory):
+@pytest.mark.parametrize("solver", ['direct', 'iterative'])
+def test_basic_simulation(simulation_factory, polymer_snapshot_factory,
+                          solver):
     """Ensure that distances are constrained in a basic simulation."""
-    d = hoomd.md.constrain.Distance()
+    d = hoomd.md.constrain.Distance(solver=solver)
 
     sim = simulation_factory(polymer_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
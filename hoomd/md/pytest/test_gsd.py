@@ -541,3 +541,173 @@ def test_write_gsd_no_dynamic(simulation_factory, hoomd_snapshot, tmp_path):
             assert not f.chunk_exists(frame=1, name='configuration/box')
             assert not f.chunk_exists(frame=1, name='particles/N')
             assert not f.chunk_exists(frame=1, name='particles/position')
+
+
+# A small write buffer writes the log chunks straight to the file, so the
+# reserved chunks follow both buffered and unbuffered chunks. Enough frames are
+# written to expand the file index several times while chunks are reserved. In
+# serial simulations, the one rank writes all particle data through the same
+# path.
+@pytest.mark.parametrize('maximum_write_buffer_size', [1, 64 * 1024 * 1024])
+def test_write_gsd_distributed(create_md_sim, tmp_path,
+                               maximum_write_buffer_size):
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    logger = hoomd.logging.Logger(categories=['scalar'])
+    logger.add(sim, quantities=['timestep'])
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum'],
+                                 logger=logger)
+    gsd_writer.maximum_write_buffer_size = maximum_write_buffer_size
+    gsd_writer.distributed_write = True
+    assert gsd_writer.distributed_write
+    sim.operations.writers.append(gsd_writer)
+
+    n_frames = 50
+    snapshots = []
+    for _ in range(n_frames):
+        sim.run(1)
+        snapshots.append(sim.state.get_snapshot())
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            assert len(traj) == n_frames
+            for gsd_snap, snapshot in zip(traj, snapshots):
+                assert_equivalent_snapshots(gsd_snap, snapshot)
+                assert (gsd_snap.log['Simulation/timestep']
+                        == gsd_snap.configuration.step)
+
+
+@pytest.mark.parametrize('queue_size', [1, 3])
+def test_write_gsd_async(create_md_sim, tmp_path, queue_size):
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    thermo = hoomd.md.compute.ThermodynamicQuantities(filter=hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    logger = hoomd.logging.Logger()
+    logger.add(thermo, quantities=['kinetic_energy'])
+
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum'],
+                                 logger=logger)
+    gsd_writer.async_write = True
+    gsd_writer.maximum_write_queue_size = queue_size
+    assert gsd_writer.async_write
+    assert gsd_writer.maximum_write_queue_size == queue_size
+    sim.operations.writers.append(gsd_writer)
+
+    snapshots = []
+    kinetic_energy_list = []
+    for _ in range(5):
+        sim.run(1)
+        snapshots.append(sim.state.get_snapshot())
+        kinetic_energy_list.append(thermo.kinetic_energy)
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            assert len(traj) == 5
+            for gsd_snap, snapshot, kinetic_energy in zip(
+                    traj, snapshots, kinetic_energy_list):
+                assert_equivalent_snapshots(gsd_snap, snapshot)
+                e = gsd_snap.log[
+                    'md/compute/ThermodynamicQuantities/kinetic_energy']
+                assert e == kinetic_energy
+
+    gsd_writer.async_write = False
+    assert not gsd_writer.async_write
+
+
+@pytest.mark.parametrize('keyframe_interval', [1, 3])
+def test_write_gsd_compressed(simulation_factory, create_md_sim, tmp_path,
+                              keyframe_interval):
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum'])
+    gsd_writer.position_precision = 1e-3
+    gsd_writer.velocity_precision = 1e-4
+    gsd_writer.keyframe_interval = keyframe_interval
+    assert gsd_writer.position_precision == pytest.approx(1e-3)
+    assert gsd_writer.velocity_precision == pytest.approx(1e-4)
+    assert gsd_writer.orientation_precision == 0
+    assert gsd_writer.keyframe_interval == keyframe_interval
+    sim.operations.writers.append(gsd_writer)
+
+    snapshots = []
+    for _ in range(7):
+        sim.run(1)
+        snapshots.append(sim.state.get_snapshot())
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.fl.open(name=filename, mode='r') as f:
+            assert f.nframes == 7
+            for frame in range(7):
+                assert f.chunk_exists(frame=frame,
+                                      name='compressed/particles/position')
+                assert f.chunk_exists(frame=frame,
+                                      name='compressed/particles/velocity')
+                # zero row marker for readers that do not decode the chunk
+                assert f.chunk_exists(frame=frame, name='particles/position')
+
+    for frame, snapshot in enumerate(snapshots):
+        read_sim = simulation_factory()
+        read_sim.create_state_from_gsd(filename=filename, frame=frame)
+        read_snapshot = read_sim.state.get_snapshot()
+
+        if snapshot.communicator.rank == 0:
+            np.testing.assert_allclose(read_snapshot.particles.position,
+                                       snapshot.particles.position,
+                                       rtol=0,
+                                       atol=0.5e-3 + 1e-5)
+            np.testing.assert_allclose(read_snapshot.particles.velocity,
+                                       snapshot.particles.velocity,
+                                       rtol=0,
+                                       atol=0.5e-4 + 1e-6)
+            np.testing.assert_array_equal(read_snapshot.particles.typeid,
+                                          snapshot.particles.typeid)
+            np.testing.assert_array_equal(read_snapshot.particles.image,
+                                          snapshot.particles.image)
+
+            # the Python helper decodes the same values as the reader
+            with gsd.fl.open(name=filename, mode='r') as f:
+                position = hoomd.write.GSD.read_chunk(
+                    f, frame=frame, name='particles/position')
+                velocity = hoomd.write.GSD.read_chunk(
+                    f, frame=frame, name='particles/velocity')
+                typeid = hoomd.write.GSD.read_chunk(f,
+                                                    frame=0,
+                                                    name='particles/typeid')
+            assert position.dtype == np.float32
+            np.testing.assert_array_equal(position,
+                                          read_snapshot.particles.position)
+            np.testing.assert_array_equal(velocity,
+                                          read_snapshot.particles.velocity)
+            np.testing.assert_array_equal(typeid, snapshot.particles.typeid)
+
+        # a distributed read decodes only the blocks that hold each rank's rows
+        distributed_sim = simulation_factory()
+        distributed_sim.create_state_from_gsd(filename=filename,
+                                              frame=frame,
+                                              distributed_read=True)
+        distributed_snapshot = distributed_sim.state.get_snapshot()
+
+        if snapshot.communicator.rank == 0:
+            np.testing.assert_array_equal(
+                distributed_snapshot.particles.position,
+                read_snapshot.particles.position)
+            np.testing.assert_array_equal(
+                distributed_snapshot.particles.velocity,
+                read_snapshot.particles.velocity)
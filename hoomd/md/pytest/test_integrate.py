@@ -164,3 +164,311 @@ def test_logging():
             "category": hoomd.logging.LoggerCategories.sequence
         }
     })
+
+
+def _net_force_and_energies(simulation_factory, snapshot, **integrator_args):
+    sim = simulation_factory(snapshot)
+    sim.always_compute_pressure = True
+
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    harmonic = md.bond.Harmonic()
+    harmonic.params['A-A'] = dict(k=100.0, r0=1.0)
+    periodic = md.external.field.Periodic()
+    periodic.params['A'] = dict(A=1.0, i=0, w=0.02, p=3)
+
+    integrator = md.Integrator(
+        dt=0.001,
+        methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+        forces=[lj, harmonic, periodic],
+        **integrator_args)
+    sim.operations.integrator = integrator
+    sim.run(10)
+
+    with sim.state.cpu_local_snapshot as data:
+        order = numpy.argsort(data.particles.tag)
+        net_force = numpy.array(data.particles.net_force[order], copy=True)
+        net_virial = numpy.array(data.particles.net_virial[order], copy=True)
+
+    return (net_force, net_virial, lj.energy, harmonic.energy, lj.forces,
+            harmonic.forces)
+
+
+@pytest.mark.cpu
+def test_accumulate_forces(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.N = snapshot.particles.N // 2
+        snapshot.bonds.types = ['A-A']
+        snapshot.bonds.group[:] = numpy.arange(snapshot.particles.N).reshape(
+            (-1, 2))
+
+    reference = _net_force_and_energies(simulation_factory, snapshot)
+    accumulated = _net_force_and_energies(simulation_factory,
+                                          snapshot,
+                                          accumulate_forces=True)
+
+    for a, b in zip(reference, accumulated):
+        if a is not None:
+            numpy.testing.assert_allclose(a, b, rtol=1e-5, atol=1e-5)
+
+
+@pytest.mark.cpu
+def test_overlap_ghost_update(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.N = snapshot.particles.N // 2
+        snapshot.bonds.types = ['A-A']
+        snapshot.bonds.group[:] = numpy.arange(snapshot.particles.N).reshape(
+            (-1, 2))
+
+    reference = _net_force_and_energies(simulation_factory, snapshot)
+    overlapped = _net_force_and_energies(simulation_factory,
+                                         snapshot,
+                                         overlap_ghost_update=True)
+
+    for a, b in zip(reference, overlapped):
+        if a is not None:
+            numpy.testing.assert_allclose(a, b, rtol=1e-5, atol=1e-5)
+
+
+def test_accumulate_forces_attribute(make_simulation, integrator_elements):
+    integrator = hoomd.md.Integrator(0.005, **integrator_elements)
+    assert not integrator.accumulate_forces
+
+    integrator.accumulate_forces = True
+    sim = make_simulation()
+    sim.operations.integrator = integrator
+    sim.run(0)
+    assert integrator.accumulate_forces
+
+
+def test_overlap_ghost_update_attribute(make_simulation, integrator_elements):
+    integrator = hoomd.md.Integrator(0.005, **integrator_elements)
+    assert not integrator.overlap_ghost_update
+
+    integrator.overlap_ghost_update = True
+    sim = make_simulation()
+    sim.operations.integrator = integrator
+    sim.run(0)
+    assert integrator.overlap_ghost_update
+
+
+def _net_force_by_tag(sim):
+    with sim.state.cpu_local_snapshot as data:
+        order = numpy.argsort(data.particles.tag)
+        return numpy.array(data.particles.net_force[order], copy=True)
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+def test_slow_forces(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.N = snapshot.particles.N // 2
+        snapshot.bonds.types = ['A-A']
+        snapshot.bonds.group[:] = numpy.arange(snapshot.particles.N).reshape(
+            (-1, 2))
+    sim = simulation_factory(snapshot)
+
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    harmonic = md.bond.Harmonic()
+    harmonic.params['A-A'] = dict(k=100.0, r0=1.0)
+
+    integrator = md.Integrator(
+        dt=0.001,
+        methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+        forces=[harmonic],
+        slow_forces=[lj],
+        slow_force_interval=3)
+    sim.operations.integrator = integrator
+    thermo = md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    # on multiples of the interval, the slow forces enter with weight 3
+    sim.run(9)
+    net_force = _net_force_by_tag(sim)
+    numpy.testing.assert_allclose(net_force[:, :3],
+                                  harmonic.forces + 3 * lj.forces,
+                                  rtol=1e-5,
+                                  atol=1e-5)
+    numpy.testing.assert_allclose(thermo.potential_energy,
+                                  harmonic.energy + lj.energy,
+                                  rtol=1e-5)
+
+    # in between, only the energy of the last evaluation is included
+    slow_energy = lj.energy
+    sim.run(1)
+    net_force = _net_force_by_tag(sim)
+    numpy.testing.assert_allclose(net_force[:, :3],
+                                  harmonic.forces,
+                                  rtol=1e-5,
+                                  atol=1e-5)
+    numpy.testing.assert_allclose(thermo.potential_energy,
+                                  harmonic.energy + slow_energy,
+                                  rtol=1e-5)
+
+
+def test_slow_force_interval_attribute(make_simulation, integrator_elements):
+    integrator = hoomd.md.Integrator(0.005, **integrator_elements)
+    assert integrator.slow_force_interval == 1
+    assert len(integrator.slow_forces) == 0
+
+    integrator.slow_force_interval = 4
+    sim = make_simulation()
+    sim.operations.integrator = integrator
+    sim.run(0)
+    assert integrator.slow_force_interval == 4
+    assert integrator._slow_forces._synced
+
+    with pytest.raises(ValueError):
+        integrator.slow_force_interval = 0
+
+
+def _run_lj_trajectory(simulation_factory, snapshot, slow):
+    sim = simulation_factory(snapshot)
+    for tuner in sim.operations.tuners:
+        if isinstance(tuner, hoomd.tune.ParticleSorter):
+            tuner.trigger = hoomd.trigger.Periodic(10)
+
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.2), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    methods = [md.methods.ConstantVolume(hoomd.filter.All())]
+    if slow:
+        integrator = md.Integrator(dt=0.005,
+                                   methods=methods,
+                                   slow_forces=[lj],
+                                   slow_force_interval=1)
+    else:
+        integrator = md.Integrator(dt=0.005, methods=methods, forces=[lj])
+    sim.operations.integrator = integrator
+    sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.5)
+    thermo = md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    # long enough for several sorts, neighbor list updates, and migrations
+    sim.run(100)
+    snapshot = sim.state.get_snapshot()
+    return snapshot, thermo.potential_energy, thermo.pressure_tensor
+
+
+@pytest.mark.cpu
+def test_slow_forces_interval_one(simulation_factory, lattice_snapshot_factory):
+    """With k=1, slow forces follow the same trajectory as plain forces."""
+    snapshot = lattice_snapshot_factory(n=8, a=1.2, r=0.05)
+    plain, plain_energy, plain_pressure = _run_lj_trajectory(
+        simulation_factory, snapshot, slow=False)
+    slow, slow_energy, slow_pressure = _run_lj_trajectory(simulation_factory,
+                                                          snapshot,
+                                                          slow=True)
+
+    if plain.communicator.rank == 0:
+        numpy.testing.assert_allclose(slow.particles.position,
+                                      plain.particles.position,
+                                      rtol=1e-5,
+                                      atol=1e-5)
+        numpy.testing.assert_allclose(slow.particles.velocity,
+                                      plain.particles.velocity,
+                                      rtol=1e-5,
+                                      atol=1e-5)
+    numpy.testing.assert_allclose(slow_energy, plain_energy, rtol=1e-5)
+    numpy.testing.assert_allclose(slow_pressure,
+                                  plain_pressure,
+                                  rtol=1e-5,
+                                  atol=1e-5)
+
+
+def _run_constant_force(simulation_factory, snapshot, slow):
+    sim = simulation_factory()
+    sim.timestep = 3
+    sim.create_state_from_snapshot(snapshot)
+
+    constant = md.force.Constant(filter=hoomd.filter.All())
+    constant.constant_force['A'] = (1.0, 0.5, -0.25)
+    methods = [md.methods.ConstantVolume(hoomd.filter.All())]
+    if slow:
+        integrator = md.Integrator(dt=0.005,
+                                   methods=methods,
+                                   slow_forces=[constant],
+                                   slow_force_interval=4)
+    else:
+        integrator = md.Integrator(dt=0.005, methods=methods, forces=[constant])
+    sim.operations.integrator = integrator
+
+    # two outer steps
+    sim.run(8)
+    return sim.state.get_snapshot()
+
+
+@pytest.mark.cpu
+def test_slow_forces_first_step_phase(simulation_factory,
+                                      lattice_snapshot_factory):
+    """The first outer step starts at the first step, whatever its phase.
+
+    With a constant force, the r-RESPA impulses reproduce the plain trajectory
+    exactly at the end of each outer step.
+    """
+    snapshot = lattice_snapshot_factory(n=4, a=2.0)
+    if snapshot.communicator.rank == 0:
+        rng = numpy.random.default_rng(7)
+        snapshot.particles.velocity[:] = rng.normal(
+            size=(snapshot.particles.N, 3))
+
+    plain = _run_constant_force(simulation_factory, snapshot, slow=False)
+    slow = _run_constant_force(simulation_factory, snapshot, slow=True)
+
+    if plain.communicator.rank == 0:
+        numpy.testing.assert_allclose(slow.particles.position,
+                                      plain.particles.position,
+                                      rtol=1e-5,
+                                      atol=1e-5)
+        numpy.testing.assert_allclose(slow.particles.velocity,
+                                      plain.particles.velocity,
+                                      rtol=1e-5,
+                                      atol=1e-5)
+
+
+def _rigid_pressure(simulation_factory, snapshot, slow):
+    sim = simulation_factory(snapshot)
+
+    rigid = md.constrain.Rigid()
+    rigid.body['A'] = {
+        "constituent_types": ['B', 'B'],
+        "positions": [[1, 0, 0], [-1, 0, 0]],
+        "orientations": [(1.0, 0.0, 0.0, 0.0)] * 2,
+    }
+    rigid.create_bodies(sim.state)
+
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+    lj.params.default = dict(epsilon=0.0, sigma=1.0)
+    lj.params[('B', 'B')] = dict(epsilon=1.0, sigma=1.0)
+    methods = [md.methods.ConstantVolume(hoomd.filter.Rigid(("center",)))]
+    if slow:
+        integrator = md.Integrator(dt=0.005,
+                                   methods=methods,
+                                   slow_forces=[lj],
+                                   slow_force_interval=3)
+    else:
+        integrator = md.Integrator(dt=0.005, methods=methods, forces=[lj])
+    integrator.rigid = rigid
+    sim.operations.integrator = integrator
+    thermo = md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    sim.run(0)
+    return thermo.pressure_tensor
+
+
+@pytest.mark.cpu
+def test_slow_forces_rigid_virial(simulation_factory,
+                                  two_particle_snapshot_factory):
+    """Rigid body virials include the slow forces with weight 1."""
+    snapshot = two_particle_snapshot_factory(d=2.9)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.types = ['A', 'B']
+
+    plain = _rigid_pressure(simulation_factory, snapshot, slow=False)
+    slow = _rigid_pressure(simulation_factory, snapshot, slow=True)
+    assert numpy.any(numpy.abs(plain) > 1e-3)
+    numpy.testing.assert_allclose(slow, plain, rtol=1e-5, atol=1e-8)
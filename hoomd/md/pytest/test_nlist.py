@@ -10,7 +10,7 @@ import json
 import random
 import collections
 from pathlib import Path
-from hoomd.md.nlist import Cell, Stencil, Tree
+from hoomd.md.nlist import Cell, Cluster, Stencil, Tree
 from hoomd.conftest import (logging_check, pickling_check,
                             autotuned_kernel_parameter_check)
 
@@ -100,6 +100,15 @@ def test_stencil_specific_params():
     _assert_nlist_params(nlist, dict(deterministic=True, cell_width=x))
 
 
+def test_cluster_specific_params():
+    nlist = Cluster(buffer=0.4)
+    _assert_nlist_params(nlist, dict(cluster_size=4))
+    nlist.cluster_size = 8
+    _assert_nlist_params(nlist, dict(cluster_size=8))
+    with pytest.raises(hoomd.error.TypeConversionError):
+        nlist.cluster_size = 5
+
+
 def test_simple_simulation(nlist_params, simulation_factory,
                            lattice_snapshot_factory):
     nlist_cls, required_args = nlist_params
@@ -217,6 +226,19 @@ def test_logging():
             },
         })
 
+    logging_check(
+        hoomd.md.nlist.Cluster, ('md', 'nlist'), {
+            **base_loggables,
+            'dimensions': {
+                'category': LoggerCategories.sequence,
+                'default': False
+            },
+            'num_local_clusters': {
+                'category': LoggerCategories.scalar,
+                'default': False
+            },
+        })
+
 
 _path = Path(__file__).parent / "true_pair_list.json"
 TRUE_PAIR_LIST = set([frozenset(pair) for pair in json.load(_path.open())])
@@ -571,3 +593,75 @@ void get_local_pairs(
         global_pairs = _check_local_pairs_with_mpi(local_pairs, broadcast=True)
 
         _check_local_pair_counts(sim, global_pairs, half_nlist)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads are not enabled in this build")
+def test_threaded_pair_list(device, nlist_params, simulation_factory,
+                            lattice_snapshot_factory):
+    """Test that threaded neighbor list builds find the same pairs."""
+    nlist_cls, required_args = nlist_params
+    for num_threads in (1, 2, 3):
+        device.num_cpu_threads = num_threads
+        nlist = nlist_cls(buffer=0.0, default_r_cut=1.1, **required_args)
+        sim = simulation_factory(lattice_snapshot_factory())
+        sim.operations.computes.append(nlist)
+        sim.run(0)
+
+        _check_pair_set(sim, nlist, TRUE_PAIR_LIST)
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("cluster_size", [4, 8])
+def test_cluster_pair_list(simulation_factory, lattice_snapshot_factory,
+                           cluster_size):
+    """Test that the per-particle list expanded from cluster pairs is exact."""
+    nlist = Cluster(buffer=0.0, default_r_cut=1.1, cluster_size=cluster_size)
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.computes.append(nlist)
+    sim.run(0)
+
+    _check_pair_set(sim, nlist, TRUE_PAIR_LIST)
+    assert nlist.num_local_clusters >= 1
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("cluster_size", [4, 8])
+@pytest.mark.parametrize("mode", ['none', 'shift', 'xplor'])
+def test_cluster_pair_forces(simulation_factory, lattice_snapshot_factory,
+                             cluster_size, mode):
+    """Test that pair forces evaluated on cluster pairs match `Cell`."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=6,
+                                    a=1.2,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::2] = 1
+
+    results = []
+    for nlist in (Cell(buffer=0.4),
+                  Cluster(buffer=0.4, cluster_size=cluster_size)):
+        lj = hoomd.md.pair.LJ(nlist,
+                              default_r_cut=2.5,
+                              default_r_on=2.0,
+                              mode=mode)
+        lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+        lj.params[('A', 'B')] = dict(epsilon=1.5, sigma=0.9)
+        lj.params[('B', 'B')] = dict(epsilon=0.5, sigma=1.1)
+        lj.r_cut[('B', 'B')] = 0.0
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = hoomd.md.Integrator(0.005, forces=[lj])
+        sim.run(0)
+        results.append((lj.forces, lj.energies))
+
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(results[1][0],
+                                   results[0][0],
+                                   rtol=1e-5,
+                                   atol=1e-5)
+        np.testing.assert_allclose(results[1][1],
+                                   results[0][1],
+                                   rtol=1e-5,
+                                   atol=1e-5)
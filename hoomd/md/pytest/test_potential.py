@@ -1384,3 +1384,117 @@ def test_shift(simulation_factory, two_particle_snapshot_factory,
     # is much closer to 0 than V.
     tolerance = max(math.fabs(V / 1e4), 1e-8)
     assert V_shifted == pytest.approx(expected=0, abs=tolerance)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads are not enabled in this build")
+def test_threaded_forces(device, simulation_factory, lattice_snapshot_factory):
+    """Test that threaded pair forces match the single threaded result."""
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+
+    def compute_forces(num_threads):
+        device.num_cpu_threads = num_threads
+        sim = simulation_factory(snapshot)
+        lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+        sim.operations.computes.append(lj)
+        sim.run(0)
+        return lj.forces, lj.energies
+
+    forces_serial, energies_serial = compute_forces(1)
+    for num_threads in (2, 3):
+        forces, energies = compute_forces(num_threads)
+        if device.communicator.rank == 0:
+            np.testing.assert_allclose(forces, forces_serial, atol=1e-12)
+            np.testing.assert_allclose(energies, energies_serial, atol=1e-12)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads are not enabled in this build")
+def test_threaded_tuning_energy(device, simulation_factory,
+                                lattice_snapshot_factory):
+    """Test that tuning the pair grain size keeps the energy exact."""
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+
+    def make_simulation(num_threads):
+        device.num_cpu_threads = num_threads
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+        # many body forces switch the shared neighbor list to full storage,
+        # which is the tuned code path
+        density = md.many_body.SquareDensity(nlist=nlist, default_r_cut=1.6)
+        density.params[('A', 'A')] = dict(A=0.0, B=0.0)
+        # without integration methods, the particles do not move
+        sim.operations.integrator = md.Integrator(dt=0.001,
+                                                  forces=[lj, density],
+                                                  accumulate_forces=True)
+        sim.run(0)
+        return sim, lj
+
+    sim_serial, lj_serial = make_simulation(1)
+    energy_serial = lj_serial.energy
+
+    sim, lj = make_simulation(3)
+    assert 'pair_lj' in lj.kernel_parameters
+    lj.tune_kernel_parameters()
+    for _ in range(40):
+        sim.run(1)
+        assert lj.energy == energy_serial
+    assert lj.is_tuning_complete
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads are not enabled in this build")
+@pytest.mark.parametrize("triplet_class, params", [
+    (md.many_body.Tersoff,
+     dict(cutoff_thickness=0.2,
+          magnitudes=(1.0, 0.5),
+          exp_factors=(2.0, 1.0),
+          lambda3=0.5,
+          dimer_r=1.1,
+          n=1.0,
+          gamma=0.5,
+          c=1.0,
+          d=1.0,
+          m=1.0,
+          alpha=3.0)),
+    (md.many_body.RevCross, dict(sigma=1.0, n=6.0, epsilon=0.5, lambda3=1.0)),
+    (md.many_body.SquareDensity, dict(A=1.0, B=0.5)),
+])
+def test_threaded_triplet_forces(device, simulation_factory,
+                                 lattice_snapshot_factory, triplet_class,
+                                 params):
+    """Test that threaded many body forces match the single threaded result."""
+    snapshot = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+
+    def compute_forces(num_threads):
+        device.num_cpu_threads = num_threads
+        sim = simulation_factory(snapshot)
+        sim.always_compute_pressure = True
+        pot = triplet_class(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=1.6)
+        pot.params[('A', 'A')] = params
+        sim.operations.computes.append(pot)
+        sim.run(0)
+        return pot.forces, pot.energies, pot.virials
+
+    forces_serial, energies_serial, virials_serial = compute_forces(1)
+    for num_threads in (2, 3):
+        forces, energies, virials = compute_forces(num_threads)
+        if device.communicator.rank == 0:
+            np.testing.assert_allclose(forces,
+                                       forces_serial,
+                                       rtol=1e-5,
+                                       atol=1e-6)
+            np.testing.assert_allclose(energies,
+                                       energies_serial,
+                                       rtol=1e-5,
+                                       atol=1e-6)
+            np.testing.assert_allclose(virials,
+                                       virials_serial,
+                                       rtol=1e-5,
+                                       atol=1e-6)
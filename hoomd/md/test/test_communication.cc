@@ -3637,6 +3637,29 @@ base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
     return std::shared_ptr<hoomd::Communicator>(new hoomd::Communicator(sysdef, decomposition));
     }
 
+//! Ghost overlap callback that does no work
+void ghost_overlap_noop(uint64_t timestep) { }
+
+//! Communicator creator that enables the split ghost update
+std::shared_ptr<hoomd::Communicator>
+overlap_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<hoomd::Communicator> comm(new hoomd::Communicator(sysdef, decomposition));
+    comm->getGhostOverlapCallbackSignal().connect<ghost_overlap_noop>();
+    return comm;
+    }
+
+//! Communicator creator that sends ghosts directly to all neighbors
+std::shared_ptr<hoomd::Communicator>
+direct_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<hoomd::Communicator> comm(new hoomd::Communicator(sysdef, decomposition));
+    comm->setDirectGhostExchange(true);
+    return comm;
+    }
+
 #ifdef ENABLE_HIP
 std::shared_ptr<hoomd::Communicator>
 gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -3800,6 +3823,66 @@ UP_TEST(communicator_ghosts_test)
         }
     }
 
+//! Tests the split ghost update with corner and edge ghosts
+UP_TEST(communicator_ghosts_overlap_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_overlap
+        = bind(overlap_communicator_creator, _1, _2);
+
+    BoxDim box(2.0);
+    test_communicator_ghosts(communicator_creator_overlap,
+                             exec_conf_cpu,
+                             box,
+                             std::shared_ptr<DomainDecomposition>(
+                                 new DomainDecomposition(exec_conf_cpu, box.getL())),
+                             make_scalar3(0.0, 0.0, 0.0));
+    }
+
+//! Tests the single round ghost exchange with corner and edge ghosts
+UP_TEST(communicator_ghosts_direct_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_direct = bind(direct_communicator_creator, _1, _2);
+
+        // test in a cubic box
+        {
+        BoxDim box(2.0);
+        test_communicator_ghosts(communicator_creator_direct,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
+        // triclinic box
+        {
+        BoxDim box(1.0, -.6, .7, .5);
+        test_communicator_ghosts(communicator_creator_direct,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
+        // bonded ghosts
+        {
+        BoxDim box(2.0);
+        std::shared_ptr<DomainDecomposition> decomposition(
+            new DomainDecomposition(exec_conf_cpu, box.getL()));
+        test_communicator_bonded_ghosts(communicator_creator_direct,
+                                        exec_conf_cpu,
+                                        box,
+                                        decomposition);
+        }
+    }
+
 UP_TEST(communicator_bonded_ghosts_test)
     {
     if (!exec_conf_cpu)
@@ -3874,6 +3957,15 @@ UP_TEST(communicator_ghost_fields_test)
 
     communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
     test_communicator_ghost_fields(communicator_creator_base, exec_conf_cpu);
+
+    // split ghost update
+    communicator_creator communicator_creator_overlap
+        = bind(overlap_communicator_creator, _1, _2);
+    test_communicator_ghost_fields(communicator_creator_overlap, exec_conf_cpu);
+
+    // single round ghost exchange
+    communicator_creator communicator_creator_direct = bind(direct_communicator_creator, _1, _2);
+    test_communicator_ghost_fields(communicator_creator_direct, exec_conf_cpu);
     }
 
 UP_TEST(communicator_ghost_layer_width_test)
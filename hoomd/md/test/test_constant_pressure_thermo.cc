@@ -0,0 +1,130 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/Variant.h"
+#include "hoomd/filter/ParticleFilterAll.h"
+#include "hoomd/md/ComputeThermo.h"
+#include "hoomd/md/TwoStepConstantPressure.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace hoomd;
+using namespace hoomd::md;
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+/*! \file test_constant_pressure_thermo.cc
+    \brief Checks the kinetic sums that TwoStepConstantPressure hands to its full step thermo
+    \ingroup unit_tests
+*/
+
+//! Compare the full step pressure tensor of an NPT step against a fresh ComputeThermo
+/*! TwoStepConstantPressure::integrateStepTwo() sums the kinetic tensor while it writes the
+    velocities and passes it to ComputeThermo::computeWithKineticSums(). The resulting pressure
+    tensor and kinetic energy must match what compute() finds from the same velocities.
+*/
+void constant_pressure_thermo_test(bool aniso, bool rotational_flag)
+    {
+    const unsigned int n = 1000;
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n, BoxDim(20.0), 1));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    // random positions, masses, velocities, and angular momenta
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (unsigned int tag = 0; tag < n; tag++)
+        {
+        pdata->setPosition(tag,
+                           make_scalar3(Scalar(9.0 * uniform(rng)),
+                                        Scalar(9.0 * uniform(rng)),
+                                        Scalar(9.0 * uniform(rng))));
+        pdata->setVelocity(
+            tag,
+            make_scalar3(Scalar(uniform(rng)), Scalar(uniform(rng)), Scalar(uniform(rng))));
+        pdata->setMass(tag, Scalar(1.5 + uniform(rng)));
+        pdata->setMomentsOfInertia(tag, make_scalar3(1.0, 2.0, 0.0));
+        pdata->setAngularMomentum(tag, make_scalar4(0.0, 0.5, -0.25, 0.0));
+        }
+
+    PDataFlags flags;
+    flags[pdata_flag::pressure_tensor] = 1;
+    flags[pdata_flag::rotational_kinetic_energy] = rotational_flag;
+    pdata->setFlags(flags);
+
+    std::shared_ptr<ParticleGroup> group_all(
+        new ParticleGroup(sysdef, std::make_shared<ParticleFilterAll>()));
+    std::shared_ptr<ComputeThermo> thermo(new ComputeThermo(sysdef, group_all));
+
+    std::vector<std::shared_ptr<Variant>> S;
+    for (unsigned int i = 0; i < 6; i++)
+        S.push_back(std::make_shared<VariantConstant>(i < 3 ? 1.0 : 0.0));
+    std::vector<bool> box_flags = {true, true, true, false, false, false};
+    std::shared_ptr<TwoStepConstantPressure> npt(new TwoStepConstantPressure(sysdef,
+                                                                             group_all,
+                                                                             thermo,
+                                                                             Scalar(1.0),
+                                                                             S,
+                                                                             "xyz",
+                                                                             box_flags,
+                                                                             nullptr,
+                                                                             Scalar(0.0)));
+    npt->setDeltaT(Scalar(0.005));
+    npt->setAnisotropic(aniso);
+
+    thermo->compute(0);
+    for (uint64_t timestep = 0; timestep < 3; timestep++)
+        {
+        npt->integrateStepOne(timestep);
+        npt->integrateStepTwo(timestep);
+
+        // integrateStepTwo computed the full step thermo at timestep + 1
+        std::shared_ptr<ComputeThermo> fresh(new ComputeThermo(sysdef, group_all));
+        fresh->compute(timestep + 1);
+
+        PressureTensor fused_P = thermo->getPressureTensor();
+        PressureTensor fresh_P = fresh->getPressureTensor();
+        MY_CHECK_CLOSE(fused_P.xx, fresh_P.xx, tol_small);
+        MY_CHECK_CLOSE(fused_P.xy, fresh_P.xy, tol_small);
+        MY_CHECK_CLOSE(fused_P.xz, fresh_P.xz, tol_small);
+        MY_CHECK_CLOSE(fused_P.yy, fresh_P.yy, tol_small);
+        MY_CHECK_CLOSE(fused_P.yz, fresh_P.yz, tol_small);
+        MY_CHECK_CLOSE(fused_P.zz, fresh_P.zz, tol_small);
+        MY_CHECK_CLOSE(thermo->getTranslationalKineticEnergy(),
+                       fresh->getTranslationalKineticEnergy(),
+                       tol_small);
+        MY_CHECK_CLOSE(thermo->getPressure(), fresh->getPressure(), tol_small);
+
+        if (aniso && rotational_flag)
+            {
+            MY_CHECK_CLOSE(thermo->getRotationalKineticEnergy(),
+                           fresh->getRotationalKineticEnergy(),
+                           tol_small);
+            }
+        }
+    }
+
+//! test case for the fused kinetic sums of an isotropic NPT step
+UP_TEST(constant_pressure_thermo_isotropic)
+    {
+    constant_pressure_thermo_test(false, false);
+    }
+
+//! test case for the fused kinetic sums when the thermo runs before the angular update
+UP_TEST(constant_pressure_thermo_aniso)
+    {
+    constant_pressure_thermo_test(true, false);
+    }
+
+//! test case for the fused kinetic sums when the thermo runs after the angular update
+UP_TEST(constant_pressure_thermo_aniso_rotational)
+    {
+    constant_pressure_thermo_test(true, true);
+    }
@@ -0,0 +1,333 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/md/EvaluatorPairGauss.h"
+#include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/EvaluatorPairTable.h"
+#include "hoomd/md/EvaluatorPairYukawa.h"
+#include "hoomd/md/NeighborListCluster.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/PairEvaluatorBatch.h"
+#include "hoomd/md/PotentialPair.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace hoomd;
+using namespace hoomd::md;
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+/*! \file test_pair_evaluator_batch.cc
+    \brief Checks the batched pair evaluators and the batched PotentialPair loops against the
+           scalar evaluators
+    \ingroup unit_tests
+*/
+
+//! Check that a batched value matches the scalar value relative to the scale of the sum
+void check_batch_close(Scalar batched, Scalar scalar)
+    {
+    UP_ASSERT(std::abs(batched - scalar) <= tol_small * std::max(Scalar(1.0), std::abs(scalar)));
+    }
+
+//! Type pair parameters of a two type system in type pair index order (0-0, 0-1, 1-1)
+template<class evaluator> struct BatchParams
+    {
+    std::vector<typename evaluator::param_type> params;
+    Scalar r_cut;
+    };
+
+BatchParams<EvaluatorPairLJ> lj_params()
+    {
+    BatchParams<EvaluatorPairLJ> result;
+    const Scalar sigma[] = {1.0, 1.1, 0.9};
+    const Scalar epsilon[] = {1.0, 0.5, 1.5};
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        EvaluatorPairLJ::param_type param;
+        param.sigma_6 = sigma[i] * sigma[i] * sigma[i] * sigma[i] * sigma[i] * sigma[i];
+        param.epsilon_x_4 = Scalar(4.0) * epsilon[i];
+        result.params.push_back(param);
+        }
+    result.r_cut = Scalar(2.5);
+    return result;
+    }
+
+BatchParams<EvaluatorPairGauss> gauss_params()
+    {
+    BatchParams<EvaluatorPairGauss> result;
+    result.params.push_back(EvaluatorPairGauss::param_type(1.0, 0.5));
+    result.params.push_back(EvaluatorPairGauss::param_type(2.0, 0.75));
+    result.params.push_back(EvaluatorPairGauss::param_type(0.5, 1.0));
+    result.r_cut = Scalar(2.0);
+    return result;
+    }
+
+BatchParams<EvaluatorPairYukawa> yukawa_params()
+    {
+    BatchParams<EvaluatorPairYukawa> result;
+    result.params.push_back(EvaluatorPairYukawa::param_type(1.0, 1.0));
+    result.params.push_back(EvaluatorPairYukawa::param_type(0.5, 2.0));
+    result.params.push_back(EvaluatorPairYukawa::param_type(2.0, 0.5));
+    result.r_cut = Scalar(2.5);
+    return result;
+    }
+
+BatchParams<EvaluatorPairTable> table_params()
+    {
+    BatchParams<EvaluatorPairTable> result;
+    result.r_cut = Scalar(2.0);
+    const unsigned int width = 100;
+    const Scalar r_min = 0.5;
+    const Scalar amplitude[] = {1.0, 2.0, 0.5};
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        // U = a (r_cut - r)^2 tabulated on [r_min, r_cut)
+        EvaluatorPairTable::param_type param;
+        param.rmin = r_min;
+        param.V_table = ManagedArray<Scalar>(width, false);
+        param.F_table = ManagedArray<Scalar>(width, false);
+        for (unsigned int k = 0; k < width; k++)
+            {
+            Scalar r = r_min + (result.r_cut - r_min) * Scalar(k) / Scalar(width);
+            param.V_table[k] = amplitude[i] * (result.r_cut - r) * (result.r_cut - r);
+            param.F_table[k] = Scalar(2.0) * amplitude[i] * (result.r_cut - r);
+            }
+        result.params.push_back(param);
+        }
+    return result;
+    }
+
+//! Compare evalForceAndEnergyBatch() lane by lane with the scalar evaluator
+/*! Every batch size from 1 to pair_batch_width is tried with padding lanes like the ones
+    PotentialPair passes, and with pairs inside and outside the cutoff.
+*/
+template<class evaluator> void batch_lanes_test(const BatchParams<evaluator>& bp)
+    {
+    constexpr unsigned int W = md::detail::pair_batch_width;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<Scalar> r_dist(Scalar(0.75), Scalar(1.1) * bp.r_cut);
+    std::uniform_int_distribution<unsigned int> param_dist(0, 2);
+    std::uniform_int_distribution<unsigned int> shift_dist(0, 1);
+
+    for (unsigned int trial = 0; trial < 20; trial++)
+        {
+        for (unsigned int n = 1; n <= W; n++)
+            {
+            Scalar rsq[W];
+            Scalar rcutsq[W];
+            const typename evaluator::param_type* params[W];
+            bool energy_shift[W];
+            for (unsigned int l = 0; l < W; l++)
+                {
+                if (l < n)
+                    {
+                    Scalar r = r_dist(rng);
+                    rsq[l] = r * r;
+                    rcutsq[l] = bp.r_cut * bp.r_cut;
+                    params[l] = &bp.params[param_dist(rng)];
+                    energy_shift[l] = shift_dist(rng) == 1;
+                    }
+                else
+                    {
+                    rsq[l] = Scalar(1.0);
+                    rcutsq[l] = Scalar(0.0);
+                    params[l] = &bp.params[0];
+                    energy_shift[l] = false;
+                    }
+                }
+
+            Scalar force_divr[W];
+            Scalar pair_eng[W];
+            bool evaluated[W];
+            md::detail::evalForceAndEnergyBatch<evaluator>(n,
+                                                           rsq,
+                                                           rcutsq,
+                                                           params,
+                                                           energy_shift,
+                                                           force_divr,
+                                                           pair_eng,
+                                                           evaluated);
+
+            for (unsigned int l = 0; l < n; l++)
+                {
+                Scalar scalar_force_divr = Scalar(0.0);
+                Scalar scalar_pair_eng = Scalar(0.0);
+                evaluator eval(rsq[l], rcutsq[l], *params[l]);
+                bool scalar_evaluated
+                    = eval.evalForceAndEnergy(scalar_force_divr, scalar_pair_eng, energy_shift[l]);
+
+                UP_ASSERT_EQUAL(evaluated[l], scalar_evaluated);
+                if (scalar_evaluated)
+                    {
+                    check_batch_close(force_divr[l], scalar_force_divr);
+                    check_batch_close(pair_eng[l], scalar_pair_eng);
+                    }
+                }
+            }
+        }
+    }
+
+//! Build a jittered cubic lattice of two particle types
+std::shared_ptr<SystemDefinition> make_lattice_system()
+    {
+    const unsigned int n_side = 7;
+    const Scalar spacing = 1.1;
+    const Scalar L = n_side * spacing;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(n_side * n_side * n_side, BoxDim(L), 2));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<Scalar> jitter(Scalar(-0.15), Scalar(0.15));
+    std::uniform_int_distribution<unsigned int> type_dist(0, 1);
+    for (unsigned int tag = 0; tag < pdata->getNGlobal(); tag++)
+        {
+        Scalar3 lattice_pos = make_scalar3(Scalar(tag % n_side),
+                                           Scalar(tag / n_side % n_side),
+                                           Scalar(tag / (n_side * n_side)));
+        Scalar3 pos = (lattice_pos + make_scalar3(0.5, 0.5, 0.5)) * spacing
+                      - make_scalar3(L / 2, L / 2, L / 2);
+        pos.x += jitter(rng);
+        pos.y += jitter(rng);
+        pos.z += jitter(rng);
+        pdata->setPosition(tag, pos);
+        pdata->setType(tag, type_dist(rng));
+        }
+
+    PDataFlags flags;
+    flags[pdata_flag::pressure_tensor] = 1;
+    pdata->setFlags(flags);
+    return sysdef;
+    }
+
+//! Compare the PotentialPair forces, energies, and virials with a sum over scalar evaluators
+/*! \param bp Potential parameters
+    \param cluster Use a NeighborListCluster (cluster tile kernel) instead of a NeighborListTree
+    \param storage_mode Neighbor list storage mode
+    \param shift Shift the energy to 0 at the cutoff
+*/
+template<class evaluator>
+void potential_pair_batch_test(const BatchParams<evaluator>& bp,
+                               bool cluster,
+                               NeighborList::storageMode storage_mode,
+                               bool shift)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = make_lattice_system();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<NeighborList> nlist;
+    if (cluster)
+        nlist = std::make_shared<NeighborListCluster>(sysdef, Scalar(0.3));
+    else
+        nlist = std::make_shared<NeighborListTree>(sysdef, Scalar(0.3));
+    nlist->setStorageMode(storage_mode);
+
+    std::shared_ptr<PotentialPair<evaluator>> pair(
+        new PotentialPair<evaluator>(sysdef, nlist));
+    pair->setParams(0, 0, bp.params[0]);
+    pair->setParams(0, 1, bp.params[1]);
+    pair->setParams(1, 1, bp.params[2]);
+    pair->setRcut(0, 0, bp.r_cut);
+    pair->setRcut(0, 1, bp.r_cut);
+    pair->setRcut(1, 1, bp.r_cut);
+    if (shift)
+        pair->setShiftMode(PotentialPair<evaluator>::shift);
+    pair->compute(0);
+
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force(pair->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial(pair->getVirialArray(), access_location::host, access_mode::read);
+    const size_t pitch = pair->getVirialArray().getPitch();
+    const BoxDim box = pdata->getBox();
+    const unsigned int N = pdata->getN();
+    const Scalar rcutsq = bp.r_cut * bp.r_cut;
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+
+        Scalar3 f = make_scalar3(0, 0, 0);
+        Scalar pe = 0;
+        Scalar virial[6] = {0, 0, 0, 0, 0, 0};
+        for (unsigned int j = 0; j < N; j++)
+            {
+            if (i == j)
+                continue;
+
+            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            Scalar3 dx = box.minImage(pi - pj);
+            Scalar rsq = dot(dx, dx);
+
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+            evaluator eval(rsq, rcutsq, bp.params[typei + typej]);
+            if (!eval.evalForceAndEnergy(force_divr, pair_eng, shift))
+                continue;
+
+            f += dx * force_divr;
+            pe += pair_eng * Scalar(0.5);
+            virial[0] += Scalar(0.5) * force_divr * dx.x * dx.x;
+            virial[1] += Scalar(0.5) * force_divr * dx.x * dx.y;
+            virial[2] += Scalar(0.5) * force_divr * dx.x * dx.z;
+            virial[3] += Scalar(0.5) * force_divr * dx.y * dx.y;
+            virial[4] += Scalar(0.5) * force_divr * dx.y * dx.z;
+            virial[5] += Scalar(0.5) * force_divr * dx.z * dx.z;
+            }
+
+        check_batch_close(h_force.data[i].x, f.x);
+        check_batch_close(h_force.data[i].y, f.y);
+        check_batch_close(h_force.data[i].z, f.z);
+        check_batch_close(h_force.data[i].w, pe);
+        for (unsigned int k = 0; k < 6; k++)
+            check_batch_close(h_virial.data[k * pitch + i], virial[k]);
+        }
+    }
+
+//! Run the lane and PotentialPair comparisons for one potential
+template<class evaluator> void pair_evaluator_batch_test(const BatchParams<evaluator>& bp)
+    {
+    batch_lanes_test<evaluator>(bp);
+    for (bool cluster : {false, true})
+        {
+        for (bool shift : {false, true})
+            {
+            potential_pair_batch_test<evaluator>(bp, cluster, NeighborList::half, shift);
+            potential_pair_batch_test<evaluator>(bp, cluster, NeighborList::full, shift);
+            }
+        }
+    }
+
+//! test case for the batched Lennard-Jones evaluator
+UP_TEST(pair_evaluator_batch_lj)
+    {
+    pair_evaluator_batch_test<EvaluatorPairLJ>(lj_params());
+    }
+
+//! test case for the batched Gaussian evaluator
+UP_TEST(pair_evaluator_batch_gauss)
+    {
+    pair_evaluator_batch_test<EvaluatorPairGauss>(gauss_params());
+    }
+
+//! test case for the batched Yukawa evaluator
+UP_TEST(pair_evaluator_batch_yukawa)
+    {
+    pair_evaluator_batch_test<EvaluatorPairYukawa>(yukawa_params());
+    }
+
+//! test case for the batched table evaluator
+UP_TEST(pair_evaluator_batch_table)
+    {
+    pair_evaluator_batch_test<EvaluatorPairTable>(table_params());
+    }
@@ -16,10 +16,12 @@
 #endif
 
 #include "hoomd/Initializers.h"
+#include "hoomd/filter/ParticleFilterAll.h"
 #include "hoomd/filter/ParticleFilterTags.h"
 #include "hoomd/md/NeighborListTree.h"
 
 #include <math.h>
+#include <random>
 
 using namespace std;
 using namespace std::placeholders;
@@ -221,6 +223,105 @@ void pppm_force_particle_test_triclinic(pppmforce_creator pppm_creator,
     MY_CHECK_SMALL(h_virial.data[5 * pitch + 1], rough_tol);
     }
 
+//! Compute PPPM forces of a random neutral system on the given execution configuration
+/*! \returns the per particle forces followed by a single entry holding the external energy, and
+    the external virial in \a virial
+*/
+std::vector<Scalar4> pppm_random_forces(pppmforce_creator pppm_creator,
+                                        std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                        int Nz,
+                                        int order,
+                                        std::vector<Scalar>& virial)
+    {
+    const unsigned int N = 500;
+    const Scalar L = 10.0;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(N, BoxDim(L), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> uniform(-L / 2, L / 2);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            h_pos.data[i].x = Scalar(uniform(rng));
+            h_pos.data[i].y = Scalar(uniform(rng));
+            h_pos.data[i].z = Scalar(uniform(rng));
+            h_charge.data[i] = (i % 2) ? Scalar(-1.0) : Scalar(1.0);
+            }
+        }
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(0.4)));
+    auto r_cut
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 2.0;
+        }
+    nlist->addRCutMatrix(r_cut);
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterAll());
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::shared_ptr<PPPMForceCompute> fc = pppm_creator(sysdef, nlist, group_all);
+    fc->setParams(16, 20, Nz, order, Scalar(1.5), Scalar(2.0));
+    fc->compute(0);
+
+    std::vector<Scalar4> result(N + 1);
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        result[i] = h_force.data[i];
+    result[N] = make_scalar4(0, 0, 0, fc->getExternalEnergy());
+
+    virial.resize(6);
+    for (unsigned int l = 0; l < 6; l++)
+        virial[l] = fc->getExternalVirial(l);
+    return result;
+    }
+
+//! Compare PPPM forces computed with several threads against the serial ones
+/*! The mesh sizes and orders give periodic z slabs of the charge spreading with an even number of
+    slabs, two slabs, and a remainder in the last slab.
+*/
+void pppm_force_threads_test(pppmforce_creator pppm_creator,
+                             std::shared_ptr<ExecutionConfiguration> exec_conf_serial,
+                             std::shared_ptr<ExecutionConfiguration> exec_conf_threads)
+    {
+    for (auto mesh : {std::make_pair(32, 5), std::make_pair(15, 7), std::make_pair(27, 4)})
+        {
+        std::vector<Scalar> virial_serial, virial_threads;
+        std::vector<Scalar4> serial = pppm_random_forces(pppm_creator,
+                                                         exec_conf_serial,
+                                                         mesh.first,
+                                                         mesh.second,
+                                                         virial_serial);
+        std::vector<Scalar4> threads = pppm_random_forces(pppm_creator,
+                                                          exec_conf_threads,
+                                                          mesh.first,
+                                                          mesh.second,
+                                                          virial_threads);
+
+        // the charges on the mesh are summed in a different order
+        for (size_t i = 0; i < serial.size(); i++)
+            {
+            UP_ASSERT_SMALL(threads[i].x - serial[i].x, tol_small);
+            UP_ASSERT_SMALL(threads[i].y - serial[i].y, tol_small);
+            UP_ASSERT_SMALL(threads[i].z - serial[i].z, tol_small);
+            UP_ASSERT_SMALL(threads[i].w - serial[i].w, tol_small);
+            }
+        for (unsigned int l = 0; l < 6; l++)
+            UP_ASSERT_SMALL(virial_threads[l] - virial_serial[l], tol_small);
+        }
+    }
+
 //! PPPMForceCompute creator for unit tests
 std::shared_ptr<PPPMForceCompute> base_class_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                           std::shared_ptr<NeighborList> nlist,
@@ -259,6 +360,21 @@ UP_TEST(PPPMForceCompute_triclinic)
             new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! test case for threaded charge spreading on the CPU
+UP_TEST(PPPMForceCompute_threads)
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    std::shared_ptr<ExecutionConfiguration> exec_conf_threads(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf_threads->setNumThreads(4);
+    pppm_force_threads_test(pppm_creator,
+                            std::shared_ptr<ExecutionConfiguration>(
+                                new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+                            exec_conf_threads);
+    }
+#endif
+
 #ifdef ENABLE_HIP
 //! test case for bond forces on the GPU
 UP_TEST(PPPMForceComputeGPU_basic)
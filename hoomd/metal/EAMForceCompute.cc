@@ -3,6 +3,12 @@
 
 #include "EAMForceCompute.h"
 
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 using namespace std;
@@ -236,6 +242,11 @@ void EAMForceCompute::loadFile(char* filename, int type_of_file)
     interpolation(nrho * m_ntypes, nrho, drho, &h_F, &h_dF);
     interpolation(nr * m_ntypes * m_ntypes, nr, dr, &h_rho, &h_drho);
     interpolation((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), nr, dr, &h_rphi, &h_drphi);
+
+    // copy the coefficients into the tables used on the CPU
+    m_F_table.assign(h_F.data, nrho * m_ntypes);
+    m_rho_table.assign(h_rho.data, nr * m_ntypes * m_ntypes);
+    m_rphi_table.assign(h_rphi.data, (unsigned int)(0.5 * nr * (m_ntypes + 1) * m_ntypes));
     }
 
 /*! compute cubic interpolation coefficients
@@ -319,237 +330,331 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
     size_t virial_pitch = m_virial.getPitch();
 
-    // access potential table
-    ArrayHandle<Scalar4> h_F(m_F, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
-
-    // index and remainder
-    Scalar position;           // look up position, scalar
-    unsigned int int_position; // look up index for position, integer
-    unsigned int idxs;         // look up index in F, rho, rphi array, considering shift, integer
-    Scalar remainder;          // look up remainder in array, integer
-    Scalar4 v, dv;             // value, d(value)
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_F.data);
-    assert(h_dF.data);
-    assert(h_rho.data);
-    assert(h_drho.data);
-    assert(h_rphi.data);
-    assert(h_drphi.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
     memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
 
     // get a local copy of the simulation box too
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim box = m_pdata->getBox();
 
     // create a temporary copy of r_cut squared
-    Scalar r_cut_sq = m_r_cut * m_r_cut;
-
-    // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
-    unsigned int ntypes = m_pdata->getNTypes();
-
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    const Scalar r_cut_sq = m_r_cut * m_r_cut;
+
+    const unsigned int ntypes = m_pdata->getNTypes();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_ghosts = m_pdata->getNGhosts();
+
+    // Passes that only write to particle i are split into several blocks per thread for load
+    // balance. With a half neighbor list, the pair passes also update particle k, so each block
+    // accumulates into buffers that cover only the particles it writes. The buffers are summed in
+    // block order so that results are reproducible for a fixed thread count.
+    const unsigned int num_threads = m_exec_conf->getNumThreads();
+    const unsigned int n_blocks = std::max(std::min(8 * num_threads, N), 1u);
+    const bool use_buffers = third_law && num_threads > 1;
+    const unsigned int n_pair_blocks = third_law ? 1 : n_blocks;
+
+    m_density.assign(N, Scalar(0.0));
+    m_dFdrho.resize(N + n_ghosts);
+    size_t buffer_pitch = 0;
+    if (use_buffers)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const size_t head_i = h_head_list.data[i];
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-
-        for (unsigned int j = 0; j < size; j++)
+        m_scatter.partition(
+            *m_exec_conf,
+            N,
+            N,
+            N,
+            [&](unsigned int first, unsigned int last, hoomd::detail::BlockScatter::Window& window)
             {
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+                for (unsigned int i = first; i < last; i++)
+                    {
+                    window.add(i);
+                    for (unsigned int j = 0; j < h_n_neigh.data[i]; j++)
+                        {
+                        const unsigned int k = h_nlist.data[h_head_list.data[i] + j];
+                        if (k < N)
+                            window.add(k);
+                        }
+                    }
+            });
+        buffer_pitch = m_scatter.getBufferSize();
+        m_block_density.resize(buffer_pitch);
+        m_block_force.resize(buffer_pitch);
+        m_block_virial.resize(6 * buffer_pitch);
+        }
 
-            // calculate dr
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+    // look up the interval of a table position and the remainder within it
+    auto lookup = [](Scalar position, unsigned int n_points, Scalar& remainder)
+    {
+        unsigned int int_position = min((unsigned int)position, n_points - 1);
+        remainder = position - int_position;
+        return int_position;
+    };
+
+    // sum the electron density of particles [first, last), and of their neighbors with a half
+    // neighbor list. Ghost densities are computed by the processors that own them. Entry 0 of
+    // density holds particle offset.
+    auto compute_density
+        = [&](unsigned int first, unsigned int last, Scalar* density, unsigned int offset)
+    {
+        for (unsigned int i = first; i < last; i++)
+            {
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const size_t head_i = h_head_list.data[i];
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
             // sanity check
-            assert(typej < m_pdata->getNTypes());
+            assert(typei < ntypes);
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+            Scalar density_i = 0.0;
 
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-            ;
-            // only compute the force if the particles are closer than the cut-off
-            if (rsq < r_cut_sq)
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                // calculate position r for rho(r)
-                position = sqrt(rsq) * rdr;
-                int_position = (unsigned int)position;
-                int_position = min(int_position, nr - 1);
-                remainder = position - int_position;
+                // access the index and type of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                assert(k < N + n_ghosts);
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                assert(typej < ntypes);
+
+                // apply periodic boundary conditions
+                Scalar3 dx = box.minImage(pi - pk);
+                Scalar rsq = dot(dx, dx);
+
+                // only compute the density if the particles are closer than the cut-off
+                if (rsq >= r_cut_sq)
+                    continue;
+
                 // calculate P = sum{rho}
-                idxs = int_position + nr * (typej * ntypes + typei);
-                v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                                          + v.x * remainder * remainder * remainder;
+                Scalar remainder;
+                unsigned int int_position = lookup(sqrt(rsq) * rdr, nr, remainder);
+                density_i
+                    += m_rho_table.value(int_position + nr * (typej * ntypes + typei), remainder);
+
                 // if third_law, pair it
-                if (third_law)
+                if (third_law && k < N)
                     {
-                    idxs = int_position + nr * (typei * ntypes + typej);
-                    v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
-                                              + v.x * remainder * remainder * remainder;
+                    density[k - offset]
+                        += m_rho_table.value(int_position + nr * (typei * ntypes + typej),
+                                             remainder);
                     }
                 }
+            density[i - offset] += density_i;
             }
-        }
+    };
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    if (use_buffers)
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int)position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                             + v.x * remainder * remainder * remainder;
+        m_scatter.forEach(*m_exec_conf,
+                          [&](const hoomd::detail::BlockScatter::Block& b, unsigned int block)
+                          {
+                              Scalar* density = m_block_density.data() + b.offset;
+                              memset((void*)density, 0, sizeof(Scalar) * b.window.getLocalSize());
+                              compute_density(b.first, b.last, density, b.window.lo);
+                          });
+        m_scatter.reduce(*m_exec_conf,
+                         N,
+                         [&](unsigned int i, size_t slot)
+                         { m_density[i] += m_block_density[slot]; });
         }
-
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    else
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const size_t head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar fxi = 0.0;
-        Scalar fyi = 0.0;
-        Scalar fzi = 0.0;
-        Scalar pei = 0.0;
-        Scalar viriali[6];
-        for (int k = 0; k < 6; k++)
-            viriali[k] = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
-            {
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+        hoomd::detail::forEachBlock(*m_exec_conf,
+                                    N,
+                                    n_pair_blocks,
+                                    [&](unsigned int first, unsigned int last, unsigned int block)
+                                    { compute_density(first, last, m_density.data(), 0); });
+        }
 
-            // calculate \Delta r
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+    // compute the embedded energy F(P) and dF / dP of each local particle
+    hoomd::detail::forEachBlock(
+        *m_exec_conf,
+        N,
+        n_blocks,
+        [&](unsigned int first, unsigned int last, unsigned int block)
+        {
+            for (unsigned int i = first; i < last; i++)
+                {
+                unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+                Scalar remainder;
+                unsigned int idxs = lookup(m_density[i] * rdrho, nrho, remainder) + typei * nrho;
+                m_dFdrho[i] = m_F_table.derivative(idxs, remainder) * rdrho;
+                h_force.data[i].w += m_F_table.value(idxs, remainder);
+                }
+        });
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-
-            // calculate position r for phi(r)
-            if (rsq >= r_cut_sq)
-                continue;
-            Scalar r = sqrt(rsq);
-            Scalar inverseR = 1.0 / r;
-            position = r * rdr;
-            int_position = (unsigned int)position;
-            int_position = min(int_position, nr - 1);
-            remainder = position - int_position;
-            // calculate the shift position for type ij
-            int shift = (typei >= typej)
-                            ? (int)(0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr
-                            : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
-
-            idxs = int_position + shift;
-            v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
-            // pair_eng = phi
-            Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
-                               + v.x * remainder * remainder * remainder)
-                              * inverseR;
-            // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
-            Scalar derivativePhi
-                = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
-            // derivativeRhoI = drho / dr of i
-            idxs = int_position + typei * ntypes * nr + typej * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // derivativeRhoJ = drho / dr of j
-            idxs = int_position + typej * ntypes * nr + typei * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                                       + atomDerivativeEmbeddingFunction[k] * derivativeRhoI
-                                       + derivativePhi;
-            // compute forces
-            Scalar pairForce = -fullDerivativePhi * inverseR;
-            viriali[0] += dx.x * dx.x * pairForce;
-            viriali[1] += dx.x * dx.y * pairForce;
-            viriali[2] += dx.x * dx.z * pairForce;
-            viriali[3] += dx.y * dx.y * pairForce;
-            viriali[4] += dx.y * dx.z * pairForce;
-            viriali[5] += dx.z * dx.z * pairForce;
-            fxi += dx.x * pairForce;
-            fyi += dx.y * pairForce;
-            fzi += dx.z * pairForce;
-            pei += pair_eng * 0.5;
-
-            if (third_law)
+#ifdef ENABLE_MPI
+    // the pair forces need dF / dP of the ghosts, which the processors owning them computed
+    if (m_sysdef->isDomainDecomposed())
+        {
+        auto comm = m_sysdef->getCommunicator().lock();
+        assert(comm);
+        comm->updateGhostScalar(m_dFdrho.data());
+        }
+#endif
+
+    // compute the forces, energies, and virials of particles [first, last), and of their
+    // neighbors with a half neighbor list. Entry 0 of force and virial holds particle offset.
+    auto compute_forces = [&](unsigned int first,
+                              unsigned int last,
+                              Scalar4* force,
+                              Scalar* virial,
+                              size_t pitch,
+                              unsigned int offset)
+    {
+        for (unsigned int i = first; i < last; i++)
+            {
+            // access the particle's position and type
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const size_t head_i = h_head_list.data[i];
+            const Scalar dFdrho_i = m_dFdrho[i];
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar fxi = 0.0;
+            Scalar fyi = 0.0;
+            Scalar fzi = 0.0;
+            Scalar pei = 0.0;
+            Scalar viriali[6];
+            for (int l = 0; l < 6; l++)
+                viriali[l] = 0.0;
+
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < size; j++)
                 {
-                h_force.data[k].x -= dx.x * pairForce;
-                h_force.data[k].y -= dx.y * pairForce;
-                h_force.data[k].z -= dx.z * pairForce;
-                h_force.data[k].w += pair_eng * 0.5;
+                // access the index and type of this neighbor
+                unsigned int k = h_nlist.data[head_i + j];
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+
+                // apply periodic boundary conditions
+                Scalar3 dx = box.minImage(pi - pk);
+                Scalar rsq = dot(dx, dx);
+
+                if (rsq >= r_cut_sq)
+                    continue;
+
+                // calculate position r for phi(r)
+                Scalar r = sqrt(rsq);
+                Scalar inverseR = 1.0 / r;
+                Scalar remainder;
+                unsigned int int_position = lookup(r * rdr, nr, remainder);
+
+                // calculate the shift position for type ij
+                int shift = (typei >= typej)
+                                ? (int)(0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr
+                                : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
+                unsigned int idxs = int_position + shift;
+
+                // pair_eng = phi
+                Scalar pair_eng = m_rphi_table.value(idxs, remainder) * inverseR;
+                // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
+                Scalar derivativePhi
+                    = (m_rphi_table.derivative(idxs, remainder) * rdr - pair_eng) * inverseR;
+                // derivativeRhoI = drho / dr of i
+                Scalar derivativeRhoI
+                    = m_rho_table.derivative(int_position + nr * (typei * ntypes + typej),
+                                             remainder)
+                      * rdr;
+                // derivativeRhoJ = drho / dr of j
+                Scalar derivativeRhoJ
+                    = m_rho_table.derivative(int_position + nr * (typej * ntypes + typei),
+                                             remainder)
+                      * rdr;
+                // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
+                Scalar fullDerivativePhi = dFdrho_i * derivativeRhoJ
+                                           + m_dFdrho[k] * derivativeRhoI + derivativePhi;
+
+                // compute forces, each particle of the pair gets half of the virial
+                Scalar pairForce = -fullDerivativePhi * inverseR;
+                Scalar pairForceover2 = Scalar(0.5) * pairForce;
+                Scalar pair_virial[6];
+                pair_virial[0] = dx.x * dx.x * pairForceover2;
+                pair_virial[1] = dx.x * dx.y * pairForceover2;
+                pair_virial[2] = dx.x * dx.z * pairForceover2;
+                pair_virial[3] = dx.y * dx.y * pairForceover2;
+                pair_virial[4] = dx.y * dx.z * pairForceover2;
+                pair_virial[5] = dx.z * dx.z * pairForceover2;
+                for (int l = 0; l < 6; l++)
+                    viriali[l] += pair_virial[l];
+                fxi += dx.x * pairForce;
+                fyi += dx.y * pairForce;
+                fzi += dx.z * pairForce;
+                pei += pair_eng * 0.5;
+
+                // ghost forces are computed by the processors that own them
+                if (third_law && k < N)
+                    {
+                    const unsigned int mem_k = k - offset;
+                    force[mem_k].x -= dx.x * pairForce;
+                    force[mem_k].y -= dx.y * pairForce;
+                    force[mem_k].z -= dx.z * pairForce;
+                    force[mem_k].w += pair_eng * 0.5;
+                    for (int l = 0; l < 6; l++)
+                        virial[l * pitch + mem_k] += pair_virial[l];
+                    }
                 }
+            const unsigned int mem_i = i - offset;
+            force[mem_i].x += fxi;
+            force[mem_i].y += fyi;
+            force[mem_i].z += fzi;
+            force[mem_i].w += pei;
+            for (int l = 0; l < 6; l++)
+                virial[l * pitch + mem_i] += viriali[l];
             }
-        h_force.data[i].x += fxi;
-        h_force.data[i].y += fyi;
-        h_force.data[i].z += fzi;
-        h_force.data[i].w += pei;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k * virial_pitch + i] += viriali[k];
+    };
+
+    if (use_buffers)
+        {
+        m_scatter.forEach(*m_exec_conf,
+                          [&](const hoomd::detail::BlockScatter::Block& b, unsigned int block)
+                          {
+                              const size_t size = b.window.getLocalSize();
+                              Scalar4* block_force = m_block_force.data() + b.offset;
+                              Scalar* block_virial = m_block_virial.data() + b.offset;
+                              memset((void*)block_force, 0, sizeof(Scalar4) * size);
+                              for (unsigned int l = 0; l < 6; l++)
+                                  memset((void*)(block_virial + l * buffer_pitch),
+                                         0,
+                                         sizeof(Scalar) * size);
+                              compute_forces(b.first,
+                                             b.last,
+                                             block_force,
+                                             block_virial,
+                                             buffer_pitch,
+                                             b.window.lo);
+                          });
+
+        // sum the per block results in block order
+        m_scatter.reduce(*m_exec_conf,
+                         N,
+                         [&](unsigned int i, size_t slot)
+                         {
+                             h_force.data[i].x += m_block_force[slot].x;
+                             h_force.data[i].y += m_block_force[slot].y;
+                             h_force.data[i].z += m_block_force[slot].z;
+                             h_force.data[i].w += m_block_force[slot].w;
+                             for (unsigned int l = 0; l < 6; l++)
+                                 h_virial.data[l * virial_pitch + i]
+                                     += m_block_virial[l * buffer_pitch + slot];
+                         });
+        }
+    else
+        {
+        hoomd::detail::forEachBlock(
+            *m_exec_conf,
+            N,
+            n_pair_blocks,
+            [&](unsigned int first, unsigned int last, unsigned int block)
+            { compute_forces(first, last, h_force.data, h_virial.data, virial_pitch, 0); });
         }
     }
 
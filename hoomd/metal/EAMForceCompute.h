@@ -1,10 +1,12 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "hoomd/BlockScatter.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/md/NeighborList.h"
 
 #include <memory>
+#include <vector>
 
 /*! \file EAMForceCompute.h
  \brief Declares the EAMForceCompute class
@@ -43,6 +45,18 @@ namespace metal
  h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
  function.
 
+ The CPU code path looks up the same coefficients in CubicTable copies of m_F, m_rho, and m_rphi,
+ which store each coefficient in an array of its own. Derivatives are evaluated from the value
+ coefficients, so m_dF, m_drho, and m_drphi are only used on the GPU.
+
+ \b Computation
+ The forces are computed in two passes over the neighbor list. The first pass sums the electron
+ density of each local particle and evaluates the embedding function F and its derivative dF/drho.
+ With domain decomposition, dF/drho of the ghosts is then copied from the processors that own them
+ with Communicator::updateGhostScalar(), and the second pass computes the pair forces. Ghost pairs
+ are only visited on the processors of their local particles, so both half and full neighbor lists
+ are supported. Both passes run in parallel on the TBB task arena when threads are available.
+
  \ingroup computes
  */
 class EAMForceCompute : public ForceCompute
@@ -64,6 +78,45 @@ class EAMForceCompute : public ForceCompute
     virtual void loadFile(char* filename, int type_of_file);
 
     protected:
+    //! Cubic interpolation coefficients in structure of arrays layout
+    /*! The value in interval \a idx at remainder \a t is c0 + c1 t + c2 t^2 + c3 t^3.
+     */
+    struct CubicTable
+        {
+        std::vector<Scalar> c0; //!< Value at the start of each interval
+        std::vector<Scalar> c1; //!< Linear coefficients
+        std::vector<Scalar> c2; //!< Quadratic coefficients
+        std::vector<Scalar> c3; //!< Cubic coefficients
+
+        //! Copy \a n coefficient sets stored as (x, y, z, w) = (c3, c2, c1, c0)
+        void assign(const Scalar4* coeff, unsigned int n)
+            {
+            c0.resize(n);
+            c1.resize(n);
+            c2.resize(n);
+            c3.resize(n);
+            for (unsigned int i = 0; i < n; i++)
+                {
+                c0[i] = coeff[i].w;
+                c1[i] = coeff[i].z;
+                c2[i] = coeff[i].y;
+                c3[i] = coeff[i].x;
+                }
+            }
+
+        //! Interpolated value
+        Scalar value(unsigned int idx, Scalar t) const
+            {
+            return c0[idx] + t * (c1[idx] + t * (c2[idx] + t * c3[idx]));
+            }
+
+        //! Derivative with respect to the remainder, multiply by 1 / interval to get d/dx
+        Scalar derivative(unsigned int idx, Scalar t) const
+            {
+            return c1[idx] + t * (Scalar(2.0) * c2[idx] + t * Scalar(3.0) * c3[idx]);
+            }
+        };
+
     std::shared_ptr<md::NeighborList> m_nlist; //!< the neighborlist to use for the computation
     Scalar m_r_cut;                            //!< cut-off radius
     unsigned int m_ntypes;                     //!< number of potential element types
@@ -88,6 +141,19 @@ class EAMForceCompute : public ForceCompute
     GPUArray<Scalar4> m_drphi; //!< derivative pair wise function and its coefficients
     GPUArray<Scalar> m_dFdP;   //!< derivative F / derivative P
 
+    CubicTable m_F_table;    //!< embedded function coefficients used on the CPU
+    CubicTable m_rho_table;  //!< electron density coefficients used on the CPU
+    CubicTable m_rphi_table; //!< pair wise function coefficients used on the CPU
+
+    std::vector<Scalar> m_density;       //!< electron density of the local particles
+    std::vector<Scalar> m_dFdrho;        //!< dF / drho of the local particles and ghosts
+    std::vector<Scalar> m_block_density; //!< Per block electron density (half neighbor lists)
+    std::vector<Scalar4> m_block_force;  //!< Per block forces (half neighbor lists)
+    std::vector<Scalar> m_block_virial;  //!< Per block virials (half neighbor lists)
+
+    /// Blocks of particles and the windows of the per block buffers (half neighbor lists)
+    hoomd::detail::BlockScatter m_scatter;
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
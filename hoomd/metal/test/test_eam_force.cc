@@ -0,0 +1,132 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/metal/EAMForceCompute.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace hoomd;
+using namespace hoomd::md;
+
+/*! \file test_eam_force.cc
+    \brief Implements unit tests for EAMForceCompute
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+//! Compute the EAM forces and energies of all particles, indexed by tag
+std::vector<Scalar4> compute_eam(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                 std::shared_ptr<SnapshotSystemData<Scalar>> snap,
+                                 const std::string& filename,
+                                 NeighborList::storageMode mode)
+    {
+    auto sysdef = std::make_shared<SystemDefinition>(snap, exec_conf);
+    auto pdata = sysdef->getParticleData();
+
+    auto eam = std::make_shared<metal::EAMForceCompute>(sysdef,
+                                                        const_cast<char*>(filename.c_str()),
+                                                        0);
+    auto nlist = std::make_shared<NeighborListTree>(sysdef, Scalar(0.4));
+    auto r_cut
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = eam->get_r_cut();
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(mode);
+    eam->set_neighbor_list(nlist);
+    eam->compute(0);
+
+    std::vector<Scalar4> result(pdata->getN());
+    ArrayHandle<Scalar4> h_force(eam->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        result[h_tag.data[i]] = h_force.data[i];
+    return result;
+    }
+
+//! Check that two sets of forces and energies agree within \a eps
+void check_forces(const std::vector<Scalar4>& a, const std::vector<Scalar4>& b, Scalar eps)
+    {
+    UP_ASSERT_EQUAL(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++)
+        {
+        UP_ASSERT_SMALL(a[i].x - b[i].x, eps);
+        UP_ASSERT_SMALL(a[i].y - b[i].y, eps);
+        UP_ASSERT_SMALL(a[i].z - b[i].z, eps);
+        UP_ASSERT_SMALL(a[i].w - b[i].w, eps);
+        }
+    }
+
+//! Compare EAM forces with half and full neighbor lists against a direct summation
+void eam_force_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const std::string filename = "test_eam_force.eam.alloy";
+    test::AnalyticEAM::writeFile(filename);
+
+    auto snap = test::makeEAMSnapshot(Scalar(16.0), 12);
+    std::vector<Scalar4> reference
+        = test::AnalyticEAM::reference(snap->particle_data, *snap->global_box);
+
+    std::vector<Scalar4> half = compute_eam(exec_conf, snap, filename, NeighborList::half);
+    std::vector<Scalar4> full = compute_eam(exec_conf, snap, filename, NeighborList::full);
+    std::remove(filename.c_str());
+
+    // the tables are interpolated, so only agree approximately with the analytic functions
+    check_forces(half, reference, tol_small);
+    check_forces(full, reference, tol_small);
+
+    // both storage modes sum the same terms
+    check_forces(half, full, Scalar(1e-5));
+    }
+
+//! Compare threaded EAM forces against the serial ones
+void eam_force_threads_test(std::shared_ptr<ExecutionConfiguration> exec_conf_serial,
+                            std::shared_ptr<ExecutionConfiguration> exec_conf_threads)
+    {
+    const std::string filename = "test_eam_force_threads.eam.alloy";
+    test::AnalyticEAM::writeFile(filename);
+
+    auto snap = test::makeEAMSnapshot(Scalar(16.0), 12);
+    for (auto mode : {NeighborList::half, NeighborList::full})
+        {
+        std::vector<Scalar4> serial = compute_eam(exec_conf_serial, snap, filename, mode);
+        std::vector<Scalar4> threads = compute_eam(exec_conf_threads, snap, filename, mode);
+        check_forces(threads, serial, Scalar(1e-5));
+        }
+    std::remove(filename.c_str());
+    }
+
+//! test case for EAM forces on the CPU
+UP_TEST(EAMForceCompute_force)
+    {
+    eam_force_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! test case for threaded EAM forces on the CPU
+UP_TEST(EAMForceCompute_threads)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf_threads(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf_threads->setNumThreads(4);
+    eam_force_test(exec_conf_threads);
+    eam_force_threads_test(std::shared_ptr<ExecutionConfiguration>(
+                               new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+                           exec_conf_threads);
+    }
+#endif
@@ -0,0 +1,123 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/Communicator.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/metal/EAMForceCompute.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace hoomd;
+using namespace hoomd::md;
+
+/*! \file test_eam_force_mpi.cc
+    \brief Implements unit tests for EAMForceCompute on domain decomposed systems
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+//! Compare EAM forces of particles near domain boundaries against a direct summation
+/*! Particles within r_cut of a domain boundary need the electron density and dF / dP of ghost
+    particles, which exercises Communicator::updateGhostScalar.
+*/
+void eam_force_mpi_test(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                        NeighborList::storageMode mode)
+    {
+    UP_ASSERT_EQUAL(exec_conf->getNRanks(), 8);
+
+    // every rank writes its own copy of the potential file
+    const std::string filename
+        = "test_eam_force_mpi_" + std::to_string(exec_conf->getRank()) + ".eam.alloy";
+    test::AnalyticEAM::writeFile(filename);
+
+    // every rank builds the same snapshot, so the reference is available everywhere
+    auto snap = test::makeEAMSnapshot(Scalar(16.0), 12);
+    std::vector<Scalar4> reference
+        = test::AnalyticEAM::reference(snap->particle_data, *snap->global_box);
+
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, snap->global_box->getL(), 2, 2, 2));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    sysdef->setCommunicator(comm);
+    auto pdata = sysdef->getParticleData();
+
+    auto eam = std::make_shared<metal::EAMForceCompute>(sysdef,
+                                                        const_cast<char*>(filename.c_str()),
+                                                        0);
+    auto nlist = std::make_shared<NeighborListTree>(sysdef, Scalar(0.4));
+    auto r_cut
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = eam->get_r_cut();
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(mode);
+    eam->set_neighbor_list(nlist);
+
+    // migrate the particles and exchange the ghosts
+    comm->communicate(0);
+    eam->compute(0);
+    std::remove(filename.c_str());
+
+    UP_ASSERT(pdata->getNGhosts() > 0);
+
+    ArrayHandle<Scalar4> h_force(eam->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        const Scalar4& ref = reference[h_tag.data[i]];
+        UP_ASSERT_SMALL(h_force.data[i].x - ref.x, tol_small);
+        UP_ASSERT_SMALL(h_force.data[i].y - ref.y, tol_small);
+        UP_ASSERT_SMALL(h_force.data[i].z - ref.z, tol_small);
+        UP_ASSERT_SMALL(h_force.data[i].w - ref.w, tol_small);
+        }
+    }
+
+//! test case for EAM forces with a half neighbor list
+UP_TEST(EAMForceCompute_mpi_half)
+    {
+    eam_force_mpi_test(std::shared_ptr<ExecutionConfiguration>(
+                           new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+                       NeighborList::half);
+    }
+
+//! test case for EAM forces with a full neighbor list
+UP_TEST(EAMForceCompute_mpi_full)
+    {
+    eam_force_mpi_test(std::shared_ptr<ExecutionConfiguration>(
+                           new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+                       NeighborList::full);
+    }
+
+#ifdef ENABLE_TBB
+//! test case for threaded EAM forces with a half neighbor list
+UP_TEST(EAMForceCompute_mpi_half_threads)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setNumThreads(4);
+    eam_force_mpi_test(exec_conf, NeighborList::half);
+    }
+
+//! test case for threaded EAM forces with a full neighbor list
+UP_TEST(EAMForceCompute_mpi_full_threads)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setNumThreads(4);
+    eam_force_mpi_test(exec_conf, NeighborList::full);
+    }
+#endif
@@ -0,0 +1,171 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef METAL_TEST_UTILS_H_
+#define METAL_TEST_UTILS_H_
+
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/VectorMath.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace hoomd
+    {
+namespace test
+    {
+//! Analytic single type EAM potential used to write a test potential file and compute references
+/*! The electron density rho(r) = exp(1 - r) s(r), the pair potential
+    phi(r) = (exp(4 (1 - r)) - 2 exp(2 (1 - r))) s(r), and the embedding function
+    F(rho) = rho (rho - 4) / 2, where s(r) = (1 - r / r_cut)^3 smoothly goes to zero at r_cut.
+*/
+struct AnalyticEAM
+    {
+    static constexpr double r_cut = 3.0;
+    static constexpr unsigned int nr = 3001;
+    static constexpr double dr = r_cut / (nr - 1);
+    static constexpr unsigned int nrho = 2001;
+    static constexpr double drho = 0.01;
+
+    static double s(double r)
+        {
+        double x = 1.0 - r / r_cut;
+        return x * x * x;
+        }
+
+    static double ds(double r)
+        {
+        double x = 1.0 - r / r_cut;
+        return -3.0 * x * x / r_cut;
+        }
+
+    static double rho(double r)
+        {
+        return std::exp(1.0 - r) * s(r);
+        }
+
+    static double drho_dr(double r)
+        {
+        return std::exp(1.0 - r) * (ds(r) - s(r));
+        }
+
+    static double phi(double r)
+        {
+        return (std::exp(4.0 * (1.0 - r)) - 2.0 * std::exp(2.0 * (1.0 - r))) * s(r);
+        }
+
+    static double dphi_dr(double r)
+        {
+        double a = std::exp(4.0 * (1.0 - r)) - 2.0 * std::exp(2.0 * (1.0 - r));
+        double da = -4.0 * std::exp(4.0 * (1.0 - r)) + 4.0 * std::exp(2.0 * (1.0 - r));
+        return da * s(r) + a * ds(r);
+        }
+
+    static double F(double density)
+        {
+        return 0.5 * density * (density - 4.0);
+        }
+
+    static double dF(double density)
+        {
+        return density - 2.0;
+        }
+
+    //! Write the potential in the EAM/alloy (setfl) format for the single type A
+    static void writeFile(const std::string& filename)
+        {
+        FILE* fp = fopen(filename.c_str(), "w");
+        fprintf(fp, "analytic EAM test potential\n\n\n");
+        fprintf(fp, "1 A\n");
+        fprintf(fp, "%u %.17g %u %.17g %.17g\n", nrho, drho, nr, dr, r_cut);
+        fprintf(fp, "1 1.0 1.0 fcc\n");
+        for (unsigned int i = 0; i < nrho; i++)
+            fprintf(fp, "%.17g\n", F(i * drho));
+        for (unsigned int i = 0; i < nr; i++)
+            fprintf(fp, "%.17g\n", rho(i * dr));
+        for (unsigned int i = 0; i < nr; i++)
+            fprintf(fp, "%.17g\n", i * dr * phi(i * dr));
+        fclose(fp);
+        }
+
+    //! Compute the force (xyz) and energy (w) of every particle by direct summation over all pairs
+    static std::vector<Scalar4> reference(const SnapshotParticleData<Scalar>& snap,
+                                          const BoxDim& box)
+        {
+        const unsigned int n = snap.size;
+        auto pair_dx = [&](unsigned int i, unsigned int j)
+        {
+            vec3<Scalar> d = snap.pos[i] - snap.pos[j];
+            return box.minImage(make_scalar3(d.x, d.y, d.z));
+        };
+
+        std::vector<double> density(n, 0.0);
+        for (unsigned int i = 0; i < n; i++)
+            for (unsigned int j = 0; j < n; j++)
+                {
+                Scalar3 dx = pair_dx(i, j);
+                double r = std::sqrt(double(dot(dx, dx)));
+                if (i != j && r < r_cut)
+                    density[i] += rho(r);
+                }
+
+        std::vector<Scalar4> result(n);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            double f[3] = {0, 0, 0};
+            double energy = F(density[i]);
+            for (unsigned int j = 0; j < n; j++)
+                {
+                Scalar3 dx = pair_dx(i, j);
+                double r = std::sqrt(double(dot(dx, dx)));
+                if (i == j || r >= r_cut)
+                    continue;
+
+                double dU = dF(density[i]) * drho_dr(r) + dF(density[j]) * drho_dr(r)
+                            + dphi_dr(r);
+                f[0] -= dU * dx.x / r;
+                f[1] -= dU * dx.y / r;
+                f[2] -= dU * dx.z / r;
+                energy += 0.5 * phi(r);
+                }
+            result[i] = make_scalar4(Scalar(f[0]), Scalar(f[1]), Scalar(f[2]), Scalar(energy));
+            }
+        return result;
+        }
+    };
+
+//! Place particles of type A on a jittered simple cubic lattice with n_side sites per side
+inline std::shared_ptr<SnapshotSystemData<Scalar>> makeEAMSnapshot(Scalar L, unsigned int n_side)
+    {
+    auto snap = std::make_shared<SnapshotSystemData<Scalar>>();
+    snap->global_box = std::make_shared<BoxDim>(L);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->particle_data.resize(n_side * n_side * n_side);
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+    const Scalar a = L / Scalar(n_side);
+    unsigned int tag = 0;
+    for (unsigned int i = 0; i < n_side; i++)
+        for (unsigned int j = 0; j < n_side; j++)
+            for (unsigned int k = 0; k < n_side; k++)
+                {
+                vec3<Scalar> pos(-L / 2 + (Scalar(i) + Scalar(0.5)) * a,
+                                 -L / 2 + (Scalar(j) + Scalar(0.5)) * a,
+                                 -L / 2 + (Scalar(k) + Scalar(0.5)) * a);
+                pos.x += Scalar(jitter(rng));
+                pos.y += Scalar(jitter(rng));
+                pos.z += Scalar(jitter(rng));
+                snap->particle_data.pos[tag++] = pos;
+                }
+    return snap;
+    }
+
+    } // end namespace test
+    } // end namespace hoomd
+
+#endif // METAL_TEST_UTILS_H_
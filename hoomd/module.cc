@@ -13,6 +13,7 @@
 #include "ExecutionConfiguration.h"
 #include "ForceCompute.h"
 #include "ForceConstraint.h"
+#include "GSDCompression.h"
 #include "GSDDequeWriter.h"
 #include "GSDDumpWriter.h"
 #include "GSDReader.h"
@@ -319,6 +320,7 @@ PYBIND11_MODULE(_hoomd, m)
     export_PythonAnalyzer(m);
     export_DCDDumpWriter(m);
     export_GSDDumpWriter(m);
+    export_GSDCompressor(m);
     export_GSDDequeWriter(m);
 
     // updaters
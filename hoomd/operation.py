@@ -405,6 +405,12 @@ class AutotunedObject(_HOOMDBaseObject):
     complete tuning. Some may take tens of thousands or more depending on the
     parameters you set.
 
+    On the CPU, some operations tune parameters of their threaded loops (such
+    as the number of tasks each thread processes) in the same way, using the
+    wall clock time of each step. These parameters do not change the results.
+    The cell neighbor list width changes the order of the neighbors, so it is
+    only tuned after you call `tune_kernel_parameters`.
+
     Tip:
         When you significantly change your system during the simulation (e.g.
         compress to a higher density), then you can tune the parameters again
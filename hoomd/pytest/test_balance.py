@@ -3,7 +3,7 @@
 
 import hoomd
 import pytest
-from hoomd.conftest import operation_pickling_check
+from hoomd.conftest import operation_pickling_check, logging_check
 
 
 def test_balance_properties():
@@ -37,6 +37,10 @@ def test_balance_properties():
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert balance.weight == 'particles'
+    balance.weight = 'time'
+    assert balance.weight == 'time'
+
 
 def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -75,6 +79,10 @@ def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert balance.weight == 'particles'
+    balance.weight = 'time'
+    assert balance.weight == 'time'
+
     sim.operations.tuners.remove(balance)
 
 
@@ -114,3 +122,79 @@ def test_balance_action(device, simulation_factory, lattice_snapshot_factory):
 
     # the load balance should move the split place down toward the particles
     assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+    assert balance.max_imbalance >= 1.0
+
+
+def test_balance_time(device, simulation_factory, lattice_snapshot_factory):
+    """Test that the time weighted load balancer follows the force cost."""
+    if device.communicator.num_ranks != 2:
+        pytest.skip("Test supports only 2 ranks")
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("Time is only measured on the CPU")
+
+    snapshot = lattice_snapshot_factory(n=10, a=1.5)
+
+    # place all particles in the lower MPI domain, so only one rank computes
+    # forces
+    box = list(snapshot.configuration.box)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.position[:, 2] -= box[2] / 2
+    box[2] *= 2
+    snapshot.configuration.box = box
+    sim = simulation_factory(snapshot, domain_decomposition=(1, 1, 2))
+
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(dt=0.001, forces=[lj])
+    sim.operations.integrator = integrator
+
+    balance = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(10),
+                                      weight='time')
+    sim.operations.tuners.append(balance)
+    sim.run(10)
+
+    assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+    assert balance.max_imbalance >= 1.0
+    assert balance.max_max_imbalance >= balance.max_imbalance
+
+
+def test_logging():
+    logging_check(
+        hoomd.tune.LoadBalancer, ('tune',), {
+            'max_imbalance': {
+                'category': hoomd.logging.LoggerCategories.scalar,
+                'default': True
+            },
+            'max_max_imbalance': {
+                'category': hoomd.logging.LoggerCategories.scalar,
+                'default': True
+            },
+            'average_max_imbalance': {
+                'category': hoomd.logging.LoggerCategories.scalar,
+                'default': True
+            }
+        })
+
+
+def test_max_imbalance_on_one_rank(simulation_factory,
+                                   lattice_snapshot_factory):
+    """Test that reading max_imbalance needs no collective communication."""
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.001)
+
+    # the trigger does not fire before the reads below
+    balance = hoomd.tune.LoadBalancer(
+        trigger=hoomd.trigger.Periodic(period=1000, phase=500))
+    sim.operations.tuners.append(balance)
+    sim.run(1)
+
+    # reading on a single rank would deadlock if the getter communicated
+    if sim.device.communicator.rank == 0:
+        assert balance.max_imbalance == 1.0
+        assert balance.max_max_imbalance >= 1.0
+
+    balance.trigger = hoomd.trigger.Periodic(1)
+    sim.run(1)
+    if sim.device.communicator.rank == 0:
+        assert balance.max_imbalance >= 1.0
@@ -307,6 +307,42 @@ def test_state_from_gsd_frame(simulation_factory, lattice_snapshot_factory,
         assert_equivalent_snapshots(snap, sim.state.get_snapshot())
 
 
+def test_state_from_gsd_distributed(device, simulation_factory,
+                                    lattice_snapshot_factory, tmp_path):
+    """Compare a distributed GSD read to a read on the root rank."""
+    snap = lattice_snapshot_factory(n=6, particle_types=['A', 'B'])
+    if snap.communicator.rank == 0:
+        N = snap.particles.N
+        snap.particles.typeid[:] = np.arange(N) % 2
+        snap.particles.velocity[:] = np.random.uniform(-1, 1, size=(N, 3))
+        snap.bonds.types = ['bond_a', 'bond_b']
+        snap.bonds.N = N - 1
+        snap.bonds.group[:] = [[i, i + 1] for i in range(N - 1)]
+        snap.bonds.typeid[:] = np.arange(N - 1) % 2
+        snap.angles.types = ['angle']
+        snap.angles.N = N - 2
+        snap.angles.group[:] = [[i, i + 1, i + 2] for i in range(N - 2)]
+
+    sim = simulation_factory(snap)
+    filename = tmp_path / "distributed.gsd"
+    hoomd.write.GSD.write(state=sim.state, filename=str(filename), mode='wb')
+
+    sim = simulation_factory()
+    sim.create_state_from_gsd(filename=str(filename))
+    snap = sim.state.get_snapshot()
+
+    sim = simulation_factory()
+    sim.create_state_from_gsd(filename=str(filename), distributed_read=True)
+    assert sim.state.N_particles == snap.particles.N
+    assert sim.state.N_bonds == snap.bonds.N
+    assert sim.state.N_angles == snap.angles.N
+    assert_equivalent_snapshots(snap, sim.state.get_snapshot())
+
+    # the state must remain consistent after particles migrate between ranks
+    sim.run(0)
+    assert_equivalent_snapshots(snap, sim.state.get_snapshot())
+
+
 def test_writer_order(simulation_factory, two_particle_snapshot_factory):
     """Ensure that writers run at the end of the loop step."""
 
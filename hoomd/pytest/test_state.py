@@ -320,3 +320,47 @@ def test_domain_decomposition(device, simulation_factory,
                                                                   [0.25])
     else:
         raise RuntimeError("Test only supports 1 and 2 ranks")
+
+
+def _lj_forces_after_run(simulation_factory, snapshot, direct):
+    sim = simulation_factory(snapshot)
+    sim.state.direct_ghost_exchange = direct
+    assert sim.state.direct_ghost_exchange == direct
+
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                          default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    sim.operations.integrator = hoomd.md.Integrator(
+        dt=0.005,
+        methods=[hoomd.md.methods.ConstantVolume(hoomd.filter.All())],
+        forces=[lj])
+
+    # the run exchanges ghosts, updates them every step, and migrates
+    sim.run(50)
+    return lj.forces, lj.energies, sim.state.get_snapshot()
+
+
+def test_direct_ghost_exchange(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.velocity[:] = numpy.random.default_rng(1).normal(
+            0, 1, size=(snapshot.particles.N, 3))
+
+    staged_forces, staged_energies, staged = _lj_forces_after_run(
+        simulation_factory, snapshot, direct=False)
+    direct_forces, direct_energies, direct = _lj_forces_after_run(
+        simulation_factory, snapshot, direct=True)
+
+    if snapshot.communicator.rank == 0:
+        numpy.testing.assert_allclose(direct_forces,
+                                      staged_forces,
+                                      rtol=1e-5,
+                                      atol=1e-5)
+        numpy.testing.assert_allclose(direct_energies,
+                                      staged_energies,
+                                      rtol=1e-5,
+                                      atol=1e-5)
+        numpy.testing.assert_allclose(direct.particles.position,
+                                      staged.particles.position,
+                                      rtol=1e-5,
+                                      atol=1e-5)
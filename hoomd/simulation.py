@@ -188,7 +188,8 @@ class Simulation(metaclass=Loggable):
     def create_state_from_gsd(self,
                               filename,
                               frame=-1,
-                              domain_decomposition=(None, None, None)):
+                              domain_decomposition=(None, None, None),
+                              distributed_read=False):
         """Create the simulation state from a GSD file.
 
         Args:
@@ -205,6 +206,14 @@ class Simulation(metaclass=Loggable):
                 to include in each domain. The sum of each list of floats must
                 be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
 
+            distributed_read (bool): When `True` and there is more than one MPI
+                rank, every rank reads a contiguous part of the particles and
+                bonded groups from the file and sends them directly to the
+                ranks that own them. Use this for large systems where reading
+                and scattering the whole frame from rank 0 is slow or does not
+                fit in rank 0's memory. All ranks must be able to open the
+                file.
+
         When `timestep` is `None` before calling, `create_state_from_gsd`
         sets `timestep` to the value in the selected GSD frame in the file.
 
@@ -228,12 +237,13 @@ class Simulation(metaclass=Loggable):
         filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
         # Grab snapshot and timestep
         reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
-                                  abs(frame), frame < 0)
+                                  abs(frame), frame < 0, distributed_read)
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
-        self._state = State(self, snapshot, domain_decomposition)
+        self._state = State(self, snapshot, domain_decomposition,
+                            reader.isDistributed())
 
         reader.clearSnapshot()
 
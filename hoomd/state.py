@@ -231,7 +231,8 @@ class State:
     (`domain_decomposition_split_fractions`). Each MPI rank communicates with
     its neighbors to obtain the properties of particles near the boundary
     between ranks (ghost particles) so that it can compute interactions across
-    the boundary.
+    the boundary. Set `direct_ghost_exchange` to exchange ghost particles with
+    all neighbors in a single round.
 
     .. rubric:: Accessing Data
 
@@ -248,7 +249,11 @@ class State:
     .. _Kamberaj 2005: http://dx.doi.org/10.1063/1.1906216
     """
 
-    def __init__(self, simulation, snapshot, domain_decomposition):
+    def __init__(self,
+                 simulation,
+                 snapshot,
+                 domain_decomposition,
+                 distributed_snapshot=False):
         self._simulation = simulation
         snapshot._broadcast_box()
         decomposition = _create_domain_decomposition(
@@ -258,7 +263,7 @@ class State:
         if decomposition is not None:
             self._cpp_sys_def = _hoomd.SystemDefinition(
                 snapshot._cpp_obj, simulation.device._cpp_exec_conf,
-                decomposition)
+                decomposition, distributed_snapshot)
         else:
             self._cpp_sys_def = _hoomd.SystemDefinition(
                 snapshot._cpp_obj, simulation.device._cpp_exec_conf)
@@ -266,6 +271,7 @@ class State:
         # Necessary for local snapshot API. This is used to ensure two local
         # snapshots are not contexted at once.
         self._in_context_manager = False
+        self._direct_ghost_exchange = False
 
         # self._groups provides a cache of C++ group objects of the form:
         # {type(filter): {filter: C++ group}}
@@ -829,6 +835,39 @@ class State:
                 dir)) - 1 for dir in range(3)
         ])
 
+    @property
+    def direct_ghost_exchange(self):
+        """bool: Send ghost particles directly to all neighboring ranks.
+
+        By default, each MPI rank exchanges ghost particles with the ranks
+        across its faces in up to three rounds, one per direction, and forwards
+        the ghosts that belong to edge and corner neighbors. When
+        `direct_ghost_exchange` is `True`, each rank sends ghosts directly to
+        all of its (up to 26) neighbors in a single round. This reduces the
+        latency of the ghost exchange and the ghost updates on every step,
+        which helps most when there are few particles per rank.
+
+        The forces are the same with either setting. The setting applies to
+        the CPU only and has no effect in simulations that are not domain
+        decomposed. Forces that send net forces back to the ghosts' owners
+        (the Tersoff family of three body potentials) use the staged exchange
+        regardless of this setting.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.state.direct_ghost_exchange = True
+        """
+        return self._direct_ghost_exchange
+
+    @direct_ghost_exchange.setter
+    def direct_ghost_exchange(self, value):
+        self._direct_ghost_exchange = bool(value)
+        communicator = self._simulation._system_communicator
+        if communicator is not None:
+            communicator.direct_ghost_exchange = self._direct_ghost_exchange
+
     @property
     def _simulation(self):
         sim = self._simulation_
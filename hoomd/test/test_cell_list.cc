@@ -583,3 +583,94 @@ UP_TEST(CellListGPU_large)
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+//! Validate that the compressed cell list matches the padded cell list
+void celllist_compressed_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    unsigned int N = 10000;
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap;
+    snap = rand_init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // ********* initialize a padded and a compressed cell list *********
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    cl->setNominalWidth(Scalar(3.0));
+    cl->setRadius(1);
+    cl->setFlagIndex();
+    cl->setComputeSoA(true);
+    cl->compute(0);
+
+    std::shared_ptr<CellList> cl_csr(new CellList(sysdef));
+    cl_csr->setNominalWidth(Scalar(3.0));
+    cl_csr->setRadius(1);
+    cl_csr->setFlagIndex();
+    cl_csr->setComputeSoA(true);
+    cl_csr->setCompressed(true);
+    cl_csr->compute(0);
+
+    UP_ASSERT(cl_csr->getCompressed());
+    CHECK_EQUAL_UINT(cl_csr->getNmax(), cl->getNmax());
+
+    unsigned int ncell = cl->getCellIndexer().getNumElements();
+    CHECK_EQUAL_UINT(cl_csr->getCellIndexer().getNumElements(), ncell);
+    CHECK_EQUAL_UINT(cl_csr->getCellStartArray().getNumElements(), ncell + 1);
+
+    ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf(cl->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_csr_size(cl_csr->getCellSizeArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<unsigned int> h_csr_start(cl_csr->getCellStartArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_csr_xyzf(cl_csr->getXYZFArray(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<Scalar> h_csr_x(cl_csr->getXArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_csr_y(cl_csr->getYArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_csr_z(cl_csr->getZArray(), access_location::host, access_mode::read);
+    Index2D cli = cl->getCellListIndexer();
+
+    // the compressed list holds the same particles in the same order
+    CHECK_EQUAL_UINT(h_csr_start.data[0], 0);
+    CHECK_EQUAL_UINT(h_csr_start.data[ncell], N);
+    for (unsigned int cell = 0; cell < ncell; cell++)
+        {
+        CHECK_EQUAL_UINT(h_csr_size.data[cell], h_cell_size.data[cell]);
+        CHECK_EQUAL_UINT(h_csr_start.data[cell + 1] - h_csr_start.data[cell],
+                         h_cell_size.data[cell]);
+
+        for (unsigned int offset = 0; offset < h_cell_size.data[cell]; offset++)
+            {
+            Scalar4 padded = h_xyzf.data[cli(offset, cell)];
+            unsigned int slot = h_csr_start.data[cell] + offset;
+            Scalar4 compressed = h_csr_xyzf.data[slot];
+            CHECK_EQUAL_UINT(__scalar_as_int(compressed.w), __scalar_as_int(padded.w));
+            UP_ASSERT_EQUAL(compressed.x, padded.x);
+            UP_ASSERT_EQUAL(h_csr_x.data[slot], padded.x);
+            UP_ASSERT_EQUAL(h_csr_y.data[slot], padded.y);
+            UP_ASSERT_EQUAL(h_csr_z.data[slot], padded.z);
+            }
+        }
+    }
+
+//! test case for celllist_compressed_test
+UP_TEST(CellList_compressed)
+    {
+    celllist_compressed_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! test case for celllist_compressed_test with multiple threads
+UP_TEST(CellList_compressed_threaded)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setNumThreads(4);
+    celllist_compressed_test(exec_conf);
+    }
+#endif
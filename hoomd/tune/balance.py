@@ -4,6 +4,8 @@
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
+from hoomd.logging import log
 from hoomd.operation import Tuner
 from hoomd import _hoomd
 import hoomd
@@ -21,6 +23,8 @@ class LoadBalancer(Tuner):
         tolerance (float): Load imbalance tolerance.
         max_iterations (int): Maximum number of iterations to
             attempt in a single step.
+        weight (str): Quantity that defines the load of each rank
+            (``'particles'`` or ``'time'``).
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -49,6 +53,26 @@ class LoadBalancer(Tuner):
     significantly more pair force neighbors than others, this estimate of the
     load imbalance may not produce the optimal results.
 
+    .. rubric:: Time weighted balancing
+
+    When *weight* is ``'time'``, each rank measures the wall clock time it
+    spends computing forces between load balancing steps and assigns it evenly
+    to the particles it owns. The load of a rank is then the sum of the costs
+    of its particles, and `LoadBalancer` balances the load instead of the
+    particle number:
+
+    .. math::
+
+        I = \frac{W_i}{\sum_j W_j / P}
+
+    where :math:`W_i` is the load of rank :math:`i`. Use this mode when the cost
+    per particle varies through the box, for example in systems with dense and
+    dilute regions, rigid bodies, or walls. The measured time includes waiting
+    in forces that communicate between ranks (such as long range
+    electrostatics). Time is only measured when the forces are computed on the
+    CPU. `LoadBalancer` balances the particle number before the first
+    measurement and when no time is measured.
+
     A load balancing adjustment is only performed when the maximum load
     imbalance exceeds a *tolerance*. The ideal load balance is 1.0, so setting
     *tolerance* less than 1.0 will force an adjustment every update. The load
@@ -83,6 +107,8 @@ class LoadBalancer(Tuner):
         tolerance (float): Load imbalance tolerance.
         max_iterations (int): Maximum number of iterations to
             attempt in a single step.
+        weight (str): Quantity that defines the load of each rank
+            (``'particles'`` or ``'time'``).
     """
 
     def __init__(self,
@@ -91,19 +117,23 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 weight='particles'):
         super().__init__(trigger)
 
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
-                        max_iterations=max_iterations)
+                        max_iterations=max_iterations,
+                        weight=weight)
         load_balancer_params = ParameterDict(x=bool,
                                              y=bool,
                                              z=bool,
                                              max_iterations=int,
-                                             tolerance=float)
+                                             tolerance=float,
+                                             weight=OnlyFrom(
+                                                 ['particles', 'time']))
         self._param_dict.update(load_balancer_params)
         self._param_dict.update(defaults)
 
@@ -115,3 +145,26 @@ class LoadBalancer(Tuner):
 
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
                                 self.trigger)
+
+    @log(requires_run=True)
+    def max_imbalance(self):
+        """float: Maximum load imbalance over all ranks.
+
+        Computed at the end of the most recent load balancing step (1.0 before
+        the first one). Reading it does not communicate between ranks.
+        """
+        return self._cpp_obj.max_imbalance
+
+    @log(requires_run=True)
+    def max_max_imbalance(self):
+        """float: Largest maximum load imbalance found since the last run."""
+        return self._cpp_obj.max_max_imbalance
+
+    @log(requires_run=True)
+    def average_max_imbalance(self):
+        """float: Average maximum load imbalance found since the last run.
+
+        `LoadBalancer` computes the maximum imbalance at the start of each load
+        balancing step, before adjusting the domains.
+        """
+        return self._cpp_obj.average_max_imbalance
@@ -145,10 +145,11 @@ class GSD(Writer):
     ``'attribute'``), `GSD` makes all the category member's fields dynamic.
 
     Warning:
-        `GSD` buffers writes in memory. Abnormal exits (e.g. ``kill``,
-        ``scancel``, reaching walltime limits) may cause loss of data. Ensure
-        that your scripts exit cleanly and call `flush()` as needed to write
-        buffered frames to the file.
+        `GSD` buffers writes in memory (and queues frames when `async_write`
+        is `True`). Abnormal exits (e.g. ``kill``, ``scancel``, reaching
+        walltime limits) may cause loss of data. Ensure that your scripts exit
+        cleanly and call `flush()` as needed to write buffered frames to the
+        file.
 
     See Also:
         See the `GSD documentation <https://gsd.readthedocs.io/>`__, `GSD HOOMD
@@ -251,6 +252,122 @@ class GSD(Writer):
             .. code-block:: python
 
                 gsd.maximum_write_buffer_size = 128 * 1024**2
+
+        distributed_write (bool): When `True` in MPI simulations, every rank
+            writes its share of the particle data directly to the file. When
+            `False`, `GSD` gathers all particle data on rank 0 which writes the
+            whole frame. Defaults to `False`.
+
+            With distributed writes, the ranks exchange particles so that each
+            holds a contiguous range of the particles in the file. Rank 0
+            reserves space for each particle data chunk in the frame and writes
+            the frame index, and each rank writes its range of every chunk. The
+            file is a standard GSD file. Distributed writes require a file
+            system that all ranks can write to, such as a parallel file system.
+            In serial simulations, the one rank writes all particle data with
+            the same code path. Distributed writes require a build with MPI
+            support and have no effect otherwise.
+
+            The ranks wait for each other after writing their particle data,
+            so rank 0 adds each frame to the index only after the frame is
+            complete. Call `flush()` to sync the writes of all ranks to disk.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.distributed_write = True
+
+        async_write (bool): When `True`, `GSD` copies each frame into a queue
+            and a background thread writes the queued frames to the file while
+            the simulation continues. When `False`, the simulation waits for
+            each frame to be written. Defaults to `False`.
+
+            In MPI simulations, rank 0 writes the queued frames after `GSD`
+            gathers the particle data. Asynchronous writes have no effect when
+            `distributed_write` is `True`. `flush()` waits for all queued
+            frames to be written.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.async_write = True
+
+        maximum_write_queue_size (int): Maximum number of frames (including
+            the one being written) that may wait in the queue when
+            `async_write` is `True`. When the queue is full, the simulation
+            waits for the background thread to write a frame. Each queued frame
+            holds a full copy of the written particle data. Defaults to 2.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.maximum_write_queue_size = 4
+
+        position_precision (float): When positive, write
+            ``particles/position`` in a compressed encoding that rounds each
+            coordinate to the nearest multiple of *position_precision*
+            :math:`[\mathrm{length}]`. Set to 0 to write uncompressed
+            positions. Defaults to 0.
+
+            Compressed fields are stored as fixed point integers. Key frames
+            predict each value from the previous particle in tag order and the
+            other frames predict each value from the previous frame. Key frames
+            compress well only when particles with consecutive tags are close
+            to each other, such as in systems initialized on a lattice. The
+            residuals are entropy coded in independent blocks, which `GSD`
+            encodes in parallel when HOOMD-blue is built with TBB. `GSD` writes
+            values that cannot be represented at the given precision (such as
+            NaN) uncompressed.
+
+            `hoomd.Simulation.create_state_from_gsd` and `read_chunk` decode
+            compressed fields. Other readers, such as ``gsd.hoomd`` and OVITO,
+            do not. `GSD` writes the encoded fields as ``uint8`` chunks named
+            ``compressed/particles/*`` and the uncompressed fields with zero
+            rows. These readers then find an empty field (or report an error)
+            instead of silently reading the fields of frame 0 or default
+            values.
+            Distributed writes always write uncompressed fields.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.position_precision = 1e-4
+
+        orientation_precision (float): When positive, write
+            ``particles/orientation`` in the compressed encoding with the given
+            precision :math:`[\mathrm{dimensionless}]`. Defaults to 0.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.orientation_precision = 1e-5
+
+        velocity_precision (float): When positive, write
+            ``particles/velocity`` in the compressed encoding with the given
+            precision :math:`[\mathrm{velocity}]`. Defaults to 0.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.velocity_precision = 1e-4
+
+        keyframe_interval (int): Maximum number of frames between key frames
+            of compressed fields. Reading frame *i* decodes every frame back to
+            the previous key frame, so smaller values make random access faster
+            and larger values make the file smaller. Set to 1 to encode every
+            frame independently. Defaults to 10.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.keyframe_interval = 20
     """
 
     def __init__(self,
@@ -295,6 +412,13 @@ class GSD(Writer):
                           dynamic=[dynamic_validation],
                           write_diameter=False,
                           maximum_write_buffer_size=64 * 1024 * 1024,
+                          distributed_write=False,
+                          async_write=False,
+                          maximum_write_queue_size=2,
+                          position_precision=0.0,
+                          orientation_precision=0.0,
+                          velocity_precision=0.0,
+                          keyframe_interval=10,
                           _defaults=dict(filter=filter, dynamic=dynamic)))
 
         self._logger = None if logger is None else _GSDLogWriter(logger)
@@ -338,6 +462,51 @@ class GSD(Writer):
         writer.analyze(state._simulation.timestep)
         writer.flush()
 
+    @staticmethod
+    def read_chunk(file, frame, name):
+        """Read a particle data chunk that `GSD` may have compressed.
+
+        Args:
+            file (gsd.fl.GSDFile): GSD file open for reading.
+            frame (int): Index of the frame to read.
+            name (str): Name of the uncompressed chunk, such as
+                ``'particles/position'``.
+
+        Returns:
+            numpy.ndarray: The decoded ``float32`` values with one row per
+            particle when the frame has the compressed chunk (see
+            `position_precision`). Otherwise, the uncompressed chunk.
+
+        Raises:
+            KeyError: When the frame has neither chunk.
+
+        Example::
+
+            with gsd.fl.open(name=filename, mode='r') as f:
+                position = hoomd.write.GSD.read_chunk(
+                    f, frame=0, name='particles/position')
+        """
+        compressed_name = 'compressed/' + name
+        if not file.chunk_exists(frame=frame, name=compressed_name):
+            return file.read_chunk(frame=frame, name=name)
+
+        # Collect the chunks back to the key frame, then decode them forward.
+        chunks = []
+        while True:
+            chunk = file.read_chunk(frame=frame, name=compressed_name)
+            chunks.append(chunk)
+            frames_back = _hoomd.GSDCompressor.readHeader(chunk)[3]
+            if frames_back == 0:
+                break
+            frame -= frames_back
+
+        values = None
+        for chunk in reversed(chunks):
+            values = _hoomd.GSDCompressor.decode(chunk, values)
+
+        N, M, precision, _ = _hoomd.GSDCompressor.readHeader(chunks[0])
+        return (values.reshape(M, N).T * precision).astype(np.float32)
+
     @property
     def logger(self):
         """hoomd.logging.Logger: Provide log quantities to write.
@@ -361,6 +530,9 @@ class GSD(Writer):
     def flush(self):
         """Flush the write buffer to the file.
 
+        With `distributed_write`, `flush` also syncs the particle data written
+        by all ranks to disk.
+
         Example::
 
             gsd_writer.flush()